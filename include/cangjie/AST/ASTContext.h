@@ -40,16 +40,14 @@ struct InvertedIndex {
     std::unordered_map<uint32_t, std::set<AST::Symbol*>> scopeLevelIndexes;
     /** Inverted index of Symbol's ast kind. */
     std::unordered_map<std::string, std::set<AST::Symbol*>> astKindIndexes;
-    /** Put @c name into a trie, easy to do prefix search. */
-    std::unique_ptr<Trie> nameTrie = std::make_unique<Trie>();
-    /** Put @c scopeName into a trie, easy to do prefix search. */
-    std::unique_ptr<Trie> scopeNameTrie = std::make_unique<Trie>();
-    /** Put @c astKind into a trie, easy to do suffix search. */
-    std::unique_ptr<Trie> astKindTrie = std::make_unique<Trie>();
-    /** Put the begin position of a symbol into a trie, easy to do range search. */
-    std::unique_ptr<Trie> posBeginTrie = std::make_unique<Trie>();
-    /** Put the begin position of a symbol into a trie, easy to do range search. */
-    std::unique_ptr<Trie> posEndTrie = std::make_unique<Trie>();
+    /** Keep @c name sorted, easy to do prefix search. */
+    StringIndex sortedNames;
+    /** Keep @c scopeName sorted, easy to do prefix search. */
+    StringIndex sortedScopeNames;
+    /** Keep @c astKind sorted, easy to do suffix search. */
+    StringIndex sortedASTKinds;
+    /** Keep the begin and end positions of symbols sorted, easy to do range search. */
+    PosIndex posIndex;
     /** The minimum possible position. */
     Position minPos = BEGIN_POSITION;
     /** The maximum possible position. */
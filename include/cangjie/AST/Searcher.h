@@ -14,7 +14,10 @@
 #define CANGJIE_AST_SEACHER_H
 
 #include <functional>
+#include <map>
 #include <memory>
+#include <set>
+#include <tuple>
 #include <unordered_map>
 
 #include "cangjie/AST/Query.h"
@@ -24,133 +27,113 @@ namespace Cangjie {
 class ASTContext;
 
 /**
- * The Node of @p Trie tree, which contains the information of the next node and the value, prefix, suffix of current
- * node. If current node is the end of a path which represents a string, the @p rawValue contains the value of the
- * string.
+ * @p StringIndex keeps a set of strings sorted, each string being stored once, to do prefix and suffix string pattern
+ * match.
  */
-class TrieNode {
+class StringIndex {
 public:
-    using Next = std::map<char, std::unique_ptr<TrieNode>>;
-    Next next;                                      /**< Next trie node map. */
-    char c;                                         /**< Trie node's value. */
-    std::string value;                              /**< Store string value at the leaf node. */
-    std::string prefix;                             /**< Store prefix string of current node. */
-    std::set<std::string> suffixes;                 /**< Store suffix strings of current node. */
-    std::set<AST::Symbol*> ids;                     /**< Symbol ID set. */
-    uint32_t depth = 0;                             /**< Depth of the node in the tree. */
-    TrieNode* parent{nullptr};                      /**< Pointer to the parent node. */
-    explicit TrieNode(char c) : c(c)
+    StringIndex() = default;
+    explicit StringIndex(const std::string& value)
     {
-    }
-};
-
-/**
- * @p Trie is a class which contains a tree whose single path represents a string. Trie tree is used to do prefix and
- * suffix string pattern match.
- */
-class Trie {
-public:
-    std::unique_ptr<TrieNode> root;
-    Trie()
-    {
-        root = std::make_unique<TrieNode>('R');
-    }
-    explicit Trie(const std::string& value)
-    {
-        root = std::make_unique<TrieNode>('R');
         Insert(value);
     }
 
     void Reset()
     {
-        root = std::make_unique<TrieNode>('R');
+        values.clear();
     }
     void Reset(const std::string& value)
     {
-        root = std::make_unique<TrieNode>('R');
+        values.clear();
         Insert(value);
     }
     /**
-     * Insert a string, the prefix string and the suffix strings of current
-     * node are stored in @c prefix and @c suffixes.
-     * The value of the given string is stored in @c value at the leaf node.
+     * Insert a string, inserting it again or inserting an empty string has no effect.
      * @param value String value to be inserted.
      */
     void Insert(const std::string& value);
     /**
-     * Insert a string, the prefix string and the suffix strings of current
-     * node are stored in @c prefix and @c suffixes.
-     * The value of the given string is stored in @c value at the leaf node.
-     * @param value String value to be inserted.
-     * @param id Symbol id.
-     */
-    void Insert(const std::string& value, AST::Symbol& id);
-    /**
-     * Delete the node that has been inserted by insert method above.
-     */
-    void Delete(const std::string& value, AST::Symbol& id);
-    /**
-     * Get the root node to begin traverse for prefix search.
-     * @param prefix Prefix search string.
-     * @return The last node of the @p prefix string, when input @a0b, will point to the node of b.
-     */
-    TrieNode* GetPrefixRootNode(const std::string& prefix) const;
-    /**
-     * Traverse from the prefix root node to the bottom, get value from the leaf and add to match results.
+     * Get the strings starting with @p prefix, in ascending order.
      * @param prefix Prefix search string.
      */
     std::vector<std::string> PrefixMatch(const std::string& prefix) const;
     /**
-     * Traverse from the root node to the bottom, when suffix value matched, concatenate the prefix and suffix, add to
-     * match results.
+     * Get the strings ending with @p suffix and longer than it, in ascending order.
      * @param suffix Suffix search string.
      */
     std::vector<std::string> SuffixMatch(const std::string& suffix) const;
+
+private:
+    std::set<std::string> values;
 };
 
 /**
- * Simplified range query realization.
+ * @p PosIndex keeps the ranges of the nodes of symbols sorted by begin and by end, for range queries in a file. All
+ * the queries only return symbols in the file of the given position.
  */
-class PosSearchApi {
+class PosIndex {
 public:
+    void Reset();
     /**
-     * Cast position to a string monotonously.
+     * Insert the range of the node of @p id.
      */
-    static std::string PosToStr(const Position& pos);
-
+    void Insert(AST::Symbol& id);
     /**
-     * Find the common root TrieNode of the given position in PosTrie.
+     * Delete the range inserted by @c Insert, the node must not have moved in between.
      */
-    static TrieNode* FindCommonRootInPosTrie(const Trie& posTrie, const Position& pos);
+    void Delete(AST::Symbol& id);
 
     /**
-     * Find the common root TrieNode of the given position string in PosTrie.
+     * Get IDs of symbols which begin after @p pos.
+     * @param isClose Default is true, [pos, ...).
      */
-    static TrieNode* FindCommonRootInPosTrie(const Trie& posTrie, const std::string& pos);
-
+    std::set<AST::Symbol*> GetIDsBeginAfter(const Position& pos, bool isClose = true) const;
     /**
-     * Get IDs of symbols which is within a position range.
+     * Get IDs of symbols which begin before @p pos.
+     * @param isClose Default is true, (..., pos].
      */
-    static std::set<AST::Symbol*> GetIDsWithinPosXByRange(const Trie& posTrie, const Position& startPos,
-        const Position& endPos, bool isLeftClose = true, bool isRightClose = false);
-
+    std::set<AST::Symbol*> GetIDsBeginBefore(const Position& pos, bool isClose = true) const;
+    /**
+     * Get IDs of symbols which begin within a position range.
+     */
+    std::set<AST::Symbol*> GetIDsBeginWithin(const Position& startPos, const Position& endPos,
+        bool isLeftClose = true, bool isRightClose = false) const;
+    /**
+     * Get IDs of symbols which end before @p pos.
+     * @param isClose Default is true, (..., pos].
+     */
+    std::set<AST::Symbol*> GetIDsEndBefore(const Position& pos, bool isClose = true) const;
     /**
-     * Get IDs of symbols which is greater than the @p pos.
-     * @param pos The position to compare.
+     * Whether some symbols end after @p pos.
      * @param isClose Default is true, [pos, ...).
-     * @return Symbol IDs which are greater than @p pos.
      */
-    static std::set<AST::Symbol*> GetIDsGreaterThanPos(const Trie& posTrie, const Position& pos, bool isClose = true);
+    bool HasIDsEndAfter(const Position& pos, bool isClose = true) const;
+    /**
+     * Get IDs of symbols whose range contains @p pos, i.e. which begin before @p pos and end after it.
+     * @param isLeftClose Whether a symbol beginning at @p pos contains it.
+     * @param isRightClose Whether a symbol ending at @p pos contains it.
+     */
+    std::set<AST::Symbol*> GetIDsContaining(
+        const Position& pos, bool isLeftClose = true, bool isRightClose = true) const;
 
+private:
+    /** File ID, line and column, compared in this order. */
+    using Key = std::tuple<unsigned int, int, int>;
+    /** Begin -> end and symbol. */
+    std::multimap<Key, std::pair<Key, AST::Symbol*>> byBegin;
+    /** End -> symbol. */
+    std::multimap<Key, AST::Symbol*> byEnd;
+};
+
+/**
+ * Simplified range query realization.
+ */
+class PosSearchApi {
+public:
     /**
-     * Get IDs of symbols which is less than the @p pos.
-     * @param pos The position to compare.
-     * @param isClose Default is true, (..., pos].
-     * @return Symbol IDs which are less than @p pos.
+     * Cast position to a string monotonously.
      */
-    static std::set<AST::Symbol*> GetIDsLessThanPos(const Trie& posTrie, const Position& pos, bool isClose = true);
-    static void GetIDsLessThanPosOfDepth(
-        TrieNode& n, const std::string& posStr, std::set<AST::Symbol*>& ids, bool& isClose);
+    static std::string PosToStr(const Position& pos);
 
     const static int MAX_DIGITS_FILE = 4;   /**< Max num of files to compile once is 9999. */
     const static int MAX_DIGITS_LINE = 5;   /**< Max num of lines of a file is 99999. */
@@ -239,7 +222,6 @@ private:
     std::vector<AST::Symbol*> FilterAndSortSearchResult(
         const std::set<AST::Symbol*>& ids, const Query& query, const Order& order) const;
     std::unordered_map<std::string, std::vector<AST::Symbol*>> cache;
-    friend class PosSearchApi;
 };
 } // namespace Cangjie
 
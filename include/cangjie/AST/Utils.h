@@ -191,6 +191,14 @@ inline bool CanBeSrcExported(const AST::FuncDecl& fd)
     return !IsInDeclWithAttribute(*decl, Attribute::GENERIC_INSTANTIATED) && IsDefaultImplementation(*decl);
 }
 
+/**
+ * Whether @p fd is an instantiation of a public global generic function which is shared with the downstream packages,
+ * made by the package of the generic function. It is compiled with weak linkage and exported in cjo, so the importers
+ * reference it instead of instantiating the generic function again. The check only depends on the information saved
+ * in cjo, so the package instantiating the function and the packages importing it always agree.
+ */
+bool IsReusableInstantiatedFunc(const AST::FuncDecl& fd);
+
 inline bool IsInstMemberVarInGenericDecl(const AST::VarDecl& vd)
 {
     return vd.astKind == ASTKind::VAR_DECL && !vd.TestAttr(AST::Attribute::STATIC) &&
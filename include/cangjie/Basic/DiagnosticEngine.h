@@ -742,6 +742,9 @@ public:
     static DiagCacheKey ExtractKey(const DiagnosticEngine& diag);
     bool NoError() const;
     std::vector<Diagnostic> cachedDiags;
+
+private:
+    size_t excludedCount{0};
 };
 enum class DiagEngineErrorCode : uint8_t { NO_ERRORS, DIAG_RANGE_ERROR, UNKNOWN };
 /**
@@ -778,10 +781,12 @@ public:
     std::lock_guard<std::mutex> LockFirstErrorCategory();
     const std::optional<DiagCategory>& FirstErrorCategory() const;
     int32_t GetDisableDiagDeep() const;
-    const std::vector<Diagnostic>& GetStoredDiags() const;
-    void SetStoredDiags(std::vector<Diagnostic>&& value);
+    /// The number of diagnoses stored by the innermost suppression.
+    size_t GetStoredDiagsCount() const;
+    bool HasStoredError() const;
+    /// Copy the diagnoses stored by the innermost suppression, skipping the first @p from ones.
+    std::vector<Diagnostic> GetStoredDiags(size_t from = 0) const;
     bool GetEnableDiagnose() const;
-    void EnableDiagnose(const std::vector<Diagnostic>& diags);
     std::vector<Diagnostic> ConsumeStoredDiags();
 
     bool DiagFilter(Diagnostic& diagnostic) noexcept;
@@ -1030,7 +1035,8 @@ public:
         DiagnosticEngine* engine;
         bool enableDiagnose{true};
         int32_t disableDiagDeep = 0;
-        std::vector<Diagnostic> storedDiags;
+        size_t storedDiagsBegin{0};
+        size_t storedDiagsEnd{0};
         bool hasTargetType{true};
     };
 
@@ -1045,8 +1051,10 @@ private:
     void CheckRange(DiagCategory cate, const Range& range);
     Range MakeRealRange(
         const AST::Node& node, const Position begin, const Position end, bool begLowBound = false) const;
-    std::vector<Diagnostic> DisableDiagnose();
+    size_t DisableDiagnose();
     void EnableDiagnose();
+    void EnableDiagnose(size_t outerBegin);
+    void StoreDiag(Diagnostic&& diagnostic);
 };
 } // namespace Cangjie
 
@@ -143,6 +143,43 @@ public:
         return std::nullopt;
     }
 
+    /// abstract function to check whether the state flowing out of @p terminator differs between its successors.
+    virtual bool HasEdgeEffect(const Terminator* terminator)
+    {
+        (void)terminator;
+        return false;
+    }
+
+    /// abstract function to refine the state flowing from @p terminator to its successor @p succ, e.g. with the
+    /// condition of a branch. Only called if `HasEdgeEffect` returns true for @p terminator.
+    virtual void PropagateEdgeEffect(Domain& state, const Terminator* terminator, const Block* succ)
+    {
+        (void)state;
+        (void)terminator;
+        (void)succ;
+    }
+
+    /// abstract function to join @p incoming into the entry state @p entry of @p block. Analyses whose domain has
+    /// infinite ascending chains override this to widen the entry states of loops.
+    virtual bool JoinEntryState(Domain& entry, const Domain& incoming, const Block* block)
+    {
+        (void)block;
+        return entry.Join(incoming);
+    }
+
+    /// abstract function to check whether this analysis can be run in sparse mode, see `Engine::IterateSparsely`.
+    virtual bool SupportsSparseMode() const
+    {
+        return false;
+    }
+
+    /// abstract function to drop the flow-sensitive part of @p state, i.e. what is known about the memory, at the
+    /// entry of each block in sparse mode.
+    virtual void ForgetFlowSensitiveState(Domain& state)
+    {
+        (void)state;
+    }
+
     /// abstract function
     static bool Filter(const Func& method)
     {
@@ -164,7 +201,7 @@ public:
         return name;
     }
 
-    /// get block limit number to check whether a function should be analysed
+    /// get block limit number to check whether a function should be analysed densely
     static std::optional<unsigned> GetBlockLimit()
     {
         return blockLimit;
@@ -196,7 +233,8 @@ protected:
     /// The name of this data-flow analysis.
     static const std::string name;
 
-    /// Limit on the number of blocks of a function that can be analysed.
+    /// Limit on the number of blocks of a function that can be analysed densely, larger functions are analysed in
+    /// sparse mode if it's supported, or not analysed.
     static const std::optional<unsigned> blockLimit;
 };
 
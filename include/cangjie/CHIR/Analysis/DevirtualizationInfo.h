@@ -62,6 +62,14 @@ public:
      */
     bool CheckCustomTypeInternal(const CustomTypeDef& def) const;
 
+    /**
+     * @brief check all subtypes of custom type are known in current package, i.e. it's internal, or it's sealed and
+     * defined in current package.
+     * @param def custom type to check.
+     * @return flag whether the subtypes of custom type are all known.
+     */
+    bool CheckCustomTypeClosed(const CustomTypeDef& def) const;
+
     /**
      * @brief collect const members to devirt.
      */
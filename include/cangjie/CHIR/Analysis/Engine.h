@@ -85,7 +85,7 @@ public:
      */
     std::unique_ptr<Results<Domain>> IterateToFixpoint()
     {
-        if (!func->GetBody() || DoesExceedBlockLimit()) {
+        if (!func->GetBody()) {
             // the perpose of checking entry block is to skip invalid IR after function inline in CHIR
             // delele it if IR is valid after fix error in function inline
             return nullptr;
@@ -93,6 +93,9 @@ public:
         if (func->TestAttr(Attribute::SKIP_ANALYSIS)) {
             return nullptr;
         }
+        if (DoesExceedBlockLimit()) {
+            return analysis->SupportsSparseMode() ? IterateSparsely() : nullptr;
+        }
         for (auto bb : func->GetBody()->GetBlocks()) {
             entrySets->emplace(bb, analysis->Bottom());
         }
@@ -233,13 +236,21 @@ public:
                 targetSucc = std::nullopt;
             }
             auto succs = targetSucc.has_value() ? std::vector<Block*>{targetSucc.value()} : bb->GetSuccessors();
+            bool hasEdgeEffect = analysis->HasEdgeEffect(terminator);
             for (auto succ : succs) {
 #ifdef AnalysisDevDebug
                 std::cout << succ->GetIdentifier() << " is joining with " << bb->GetIdentifier() << std::endl;
                 std::cout << succ->GetIdentifier() << ":\n" << entryStates->at(succ).ToString() << std::endl;
                 std::cout << bb->GetIdentifier() << ":\n" << state.ToString() << std::endl;
 #endif
-                auto hasChanged = entryStates->at(succ).Join(state);
+                bool hasChanged = false;
+                if (hasEdgeEffect) {
+                    auto edgeState = state; // should be a copy
+                    analysis->PropagateEdgeEffect(edgeState, terminator, succ);
+                    hasChanged = analysis->JoinEntryState(entryStates->at(succ), edgeState, succ);
+                } else {
+                    hasChanged = analysis->JoinEntryState(entryStates->at(succ), state, succ);
+                }
                 if (hasChanged && worklistSet.find(succ) == worklistSet.end()) {
                     worklist.push_back(succ);
                     worklistSet.insert(succ);
@@ -248,7 +259,82 @@ public:
         }
     }
 
+    /**
+     * @brief analyse the function in sparse mode, which visits each block only once.
+     *
+     * The values of CHIR are in SSA form, so the state of a value computed at its definition holds wherever the
+     * value is used. Instead of iterating to a fixpoint over the entry states of each block, the blocks are
+     * analysed once in reverse post order with a single state shared by all of them, following the def-use chains.
+     * Only the memory is flow-sensitive, what is known about it is forgotten at the entry of each block, and the
+     * state is not refined on the edges.
+     * @return analysis results.
+     */
+    std::unique_ptr<Results<Domain>> IterateSparsely()
+    {
+        auto state = std::make_unique<Domain>(analysis->Bottom());
+        analysis->InitializeFuncEntryState(*state);
+        std::vector<Block*> executedBlocks;
+        std::vector<const Lambda*> lambdas;
+        IterateSingleUnitSparsely(func->GetEntryBlock(), *state, executedBlocks, lambdas);
+        for (size_t i = 0; i < lambdas.size(); ++i) {
+            auto lambda = lambdas[i];
+            analysis->UpdateCurrentLambda(lambda);
+            analysis->HandleVarStateCapturedByLambda(*state, lambda);
+            analysis->InitializeLambdaEntryState(*state);
+            IterateSingleUnitSparsely(lambda->GetEntryBlock(), *state, executedBlocks, lambdas);
+        }
+        analysis->SetToStable();
+        return std::make_unique<Results<Domain>>(func, std::move(analysis), std::move(state), executedBlocks);
+    }
+
 private:
+    void IterateSingleUnitSparsely(
+        Block* entryBlock, Domain& state, std::vector<Block*>& executedBlocks, std::vector<const Lambda*>& lambdas)
+    {
+        auto blocks = TopologicalSort(entryBlock);
+        std::unordered_set<Block*> executable{entryBlock};
+        std::unordered_set<Block*> visited;
+        // in reverse post order, a block is visited after all its predecessors unless it's the header of a loop,
+        // which is only reached by the back edge once it's executable, so one round is enough unless the CFG is
+        // irreducible
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (auto bb : blocks) {
+                if (executable.count(bb) == 0 || !visited.emplace(bb).second) {
+                    continue;
+                }
+                changed = true;
+                executedBlocks.emplace_back(bb);
+                analysis->ForgetFlowSensitiveState(state);
+                for (auto exp : bb->GetNonTerminatorExpressions()) {
+                    if (exp->GetExprKind() == ExprKind::LAMBDA) {
+                        auto lambda = StaticCast<const Lambda*>(exp);
+                        analysis->PreHandleLambdaExpression(state, lambda);
+                        if (lambdaWorklistSet.emplace(lambda).second) {
+                            lambdas.emplace_back(lambda);
+                        }
+                        continue;
+                    }
+                    if (auto lambda = IsApplyToLambda(exp); lambda) {
+                        analysis->HandleVarStateCapturedByLambda(state, lambda);
+                    }
+                    analysis->PropagateExpressionEffect(state, exp);
+                }
+                auto terminator = bb->GetTerminator();
+                if (terminator == nullptr) {
+                    continue;
+                }
+                if (auto lambda = IsApplyToLambda(terminator); lambda) {
+                    analysis->HandleVarStateCapturedByLambda(state, lambda);
+                }
+                auto targetSucc = analysis->PropagateTerminatorEffect(state, terminator);
+                auto succs = targetSucc.has_value() ? std::vector<Block*>{targetSucc.value()} : bb->GetSuccessors();
+                executable.insert(succs.begin(), succs.end());
+            }
+        }
+    }
+
     /**
      * @brief check whether exceed block limit to ensure whether do opt in this function.
      * @return flag whether exceed block limit.
@@ -0,0 +1,57 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#ifndef CANGJIE_CHIR_ANALYSIS_ESCAPE_ANALYSIS_H
+#define CANGJIE_CHIR_ANALYSIS_ESCAPE_ANALYSIS_H
+
+#include "cangjie/CHIR/Package.h"
+#include "cangjie/CHIR/Value.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace Cangjie::CHIR {
+/**
+ * @brief How far a reference can be reached from outside the function creating it.
+ */
+enum class EscapeState : uint8_t {
+    NO_ESCAPE,    ///< only accessed in its own block group, and never passed to a call.
+    ARG_ESCAPE,   ///< passed to callees which do not let it escape, so it still dies with its creator.
+    GLOBAL_ESCAPE ///< may be reachable after its creator returns, or accessed in an unknown way.
+};
+
+/**
+ * @brief Interprocedural escape analysis over a package.
+ *
+ * Each function gets a summary telling whether its parameters escape, computed to a fixpoint over the package,
+ * so a reference passed to a function of the package whose parameter does not escape still does not escape.
+ * Calls to functions outside the package, dynamic dispatch, stores to memory other than a local variable,
+ * returns, throws and captures by lambdas make a reference escape globally.
+ */
+class EscapeAnalysis {
+public:
+    explicit EscapeAnalysis(const Package& package);
+
+    /**
+     * @brief Get the escape state of @p obj in its function, which is usually the result of `Allocate` or `Box`.
+     */
+    EscapeState GetEscapeState(const Value& obj) const;
+
+    /**
+     * @brief check whether the @p index-th parameter of @p func is proven not to escape.
+     */
+    bool IsParamNoEscape(const Func& func, size_t index) const;
+
+private:
+    EscapeState GetArgEscapeState(const Expression& call, const Value& arg) const;
+    bool DoesFieldAddrEscape(const Value& addr) const;
+
+    /// Whether each parameter of each function with body in the package escapes.
+    std::unordered_map<const Func*, std::vector<bool>> paramEscapes;
+};
+} // namespace Cangjie::CHIR
+
+#endif
@@ -0,0 +1,126 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#ifndef CANGJIE_CHIR_ANALYSIS_LOOP_ANALYSIS_H
+#define CANGJIE_CHIR_ANALYSIS_LOOP_ANALYSIS_H
+
+#include "cangjie/CHIR/Value.h"
+
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Cangjie::CHIR {
+/**
+ * @brief A natural loop in the CFG of a block group, identified by its header which dominates all the blocks of
+ * the loop. Back edges to the same header are merged into one loop.
+ */
+class NaturalLoop {
+public:
+    explicit NaturalLoop(Block* header) : header(header)
+    {
+    }
+
+    NaturalLoop(const NaturalLoop&) = delete;
+    NaturalLoop& operator=(const NaturalLoop&) = delete;
+
+    /// Get the header of this loop, the only block in the loop that can be entered from outside.
+    Block* GetHeader() const;
+
+    /// Get the innermost loop that contains this loop, null if this is a top-level loop.
+    NaturalLoop* GetParentLoop() const;
+
+    /// Get the loops directly nested in this loop.
+    const std::vector<NaturalLoop*>& GetSubLoops() const;
+
+    /// Get all the blocks of this loop, including the blocks of its sub loops, the header comes first and the others
+    /// are in reverse post order.
+    const std::vector<Block*>& GetBlocks() const;
+
+    /// Get the blocks in this loop with a back edge to the header.
+    const std::vector<Block*>& GetLatches() const;
+
+    /// Get the blocks in this loop with a successor outside this loop.
+    std::vector<Block*> GetExitingBlocks() const;
+
+    /// Get the blocks outside this loop that are successors of a block in this loop.
+    std::vector<Block*> GetExitBlocks() const;
+
+    /// Get the only predecessor of the header outside this loop if it only jumps to the header, null otherwise.
+    Block* GetPreheader() const;
+
+    /// Get the nesting depth of this loop, which is 1 for a top-level loop.
+    size_t GetDepth() const;
+
+    /// check whether @p block is in this loop.
+    bool Contains(const Block* block) const;
+
+    /// check whether @p loop is this loop or nested in this loop.
+    bool Contains(const NaturalLoop* loop) const;
+
+private:
+    friend class LoopInfo;
+
+    Block* header;
+    NaturalLoop* parent{nullptr};
+    std::vector<NaturalLoop*> subLoops;
+    std::vector<Block*> blocks;
+    std::unordered_set<const Block*> blockSet;
+    std::vector<Block*> latches;
+    size_t depth{1};
+};
+
+/**
+ * @brief Loop nest and dominator tree of a block group. Lambdas are separate block groups and are not analysed.
+ * The result is invalidated by any change to the CFG of the block group.
+ */
+class LoopInfo {
+public:
+    explicit LoopInfo(const BlockGroup& blockGroup);
+
+    LoopInfo(const LoopInfo&) = delete;
+    LoopInfo& operator=(const LoopInfo&) = delete;
+
+    /// Get the loops that are not nested in another loop.
+    const std::vector<NaturalLoop*>& GetTopLevelLoops() const;
+
+    /// Get all the loops, inner loops come before the loops they are nested in.
+    std::vector<NaturalLoop*> GetLoopsInnermostFirst() const;
+
+    /// Get the innermost loop that contains @p block, null if it is not in a loop.
+    NaturalLoop* GetLoopFor(const Block* block) const;
+
+    /// Get the number of loops that contain @p block, 0 if it is not in a loop.
+    size_t GetLoopDepth(const Block* block) const;
+
+    /// check whether every path from the entry to @p b goes through @p a, unreachable blocks are dominated by none.
+    bool Dominates(const Block* a, const Block* b) const;
+
+    /// Get the immediate dominator of @p block, null for the entry and unreachable blocks.
+    Block* GetIDom(const Block* block) const;
+
+private:
+    void ComputeDominators(const BlockGroup& blockGroup);
+    void ComputeLoops();
+
+    /// Blocks reachable from the entry, in reverse post order.
+    std::vector<Block*> rpo;
+    std::unordered_map<const Block*, size_t> rpoIndex;
+    std::unordered_map<const Block*, Block*> idom;
+    std::vector<std::unique_ptr<NaturalLoop>> loops;
+    std::vector<NaturalLoop*> topLevelLoops;
+    std::unordered_map<const Block*, NaturalLoop*> innermostLoop;
+};
+
+/**
+ * @brief Get the loop depth of expression @p expr in the block group it belongs to. Computes a new `LoopInfo`, so
+ * passes querying many expressions should build one `LoopInfo` per block group instead.
+ */
+size_t GetLoopDepth(const Expression& expr);
+} // namespace Cangjie::CHIR
+
+#endif
@@ -0,0 +1,48 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#ifndef CANGJIE_CHIR_ANALYSIS_PGO_PROFILE_INFO_H
+#define CANGJIE_CHIR_ANALYSIS_PGO_PROFILE_INFO_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace Cangjie::CHIR {
+/**
+ * @brief Function hotness read from the instrumentation profile given by `--pgo-instr-use`.
+ *
+ * CHIR does not depend on LLVM, so only profiles in the LLVM text format (`llvm-profdata merge --text`) are read
+ * here. Indexed profiles are still used by LLVM, and CHIR treats every function as `UNKNOWN` for them.
+ */
+class PGOProfileInfo {
+public:
+    enum class Hotness : uint8_t { UNKNOWN, COLD, NORMAL, HOT };
+
+    /**
+     * @brief Load the profile from @p path.
+     * @return the profile, or null if it is not a readable text profile.
+     */
+    static std::unique_ptr<PGOProfileInfo> Load(const std::string& path);
+
+    /// Get the hotness of the function whose mangled name is @p mangledName.
+    Hotness GetFuncHotness(const std::string& mangledName) const;
+
+private:
+    bool Parse(const std::string& content);
+    void ComputeHotThreshold();
+
+    /// max counter of each function, which approximates the execution count of its hottest block.
+    std::unordered_map<std::string, uint64_t> funcMaxCount;
+    /// the smallest count among the counters covering most of the executed blocks.
+    uint64_t hotThreshold{UINT64_MAX};
+};
+
+std::string HotnessToString(PGOProfileInfo::Hotness hotness);
+} // namespace Cangjie::CHIR
+
+#endif
@@ -44,6 +44,22 @@ public:
         }
     }
 
+    /**
+     * @brief constructor of the results of an analysis in sparse mode, see `Engine::IterateSparsely`.
+     * @param func function to analyse.
+     * @param analysis analysis pass.
+     * @param sparseState the state shared by all blocks.
+     * @param executedBlocks the blocks that may be executed, including those of the lambdas, in the analysed order.
+     */
+    Results(const Func* func, std::unique_ptr<Analysis<Domain>> analysis, std::unique_ptr<Domain> sparseState,
+        std::vector<Block*> executedBlocks)
+        : func(func),
+          analysis(std::move(analysis)),
+          sparseState(std::move(sparseState)),
+          executedBlocks(std::move(executedBlocks))
+    {
+    }
+
     /**
      * @brief main method to generate results
      * @param actionBeforeVisitExpr lambda function before visit.
@@ -54,6 +70,14 @@ public:
         std::function<void(const Domain&, Expression*, size_t)> actionAfterVisitExpr,
         std::function<void(const Domain&, Terminator*, std::optional<Block*>)> actionOnTerminator)
     {
+        if (sparseState != nullptr) {
+            for (auto bb : executedBlocks) {
+                auto state = *sparseState; // should be a copy
+                analysis->ForgetFlowSensitiveState(state);
+                VisitBlockFromStateWith(actionBeforeVisitExpr, actionAfterVisitExpr, actionOnTerminator, *bb, state);
+            }
+            return;
+        }
         for (auto bb : func->GetBody()->GetBlocks()) {
             VisitBlockWith(actionBeforeVisitExpr, actionAfterVisitExpr, actionOnTerminator, *bb, entrySets.get());
         }
@@ -125,6 +149,14 @@ private:
         if (state.IsBottom()) {
             return;
         }
+        VisitBlockFromStateWith(actionBeforeVisitExpr, actionAfterVisitExpr, actionOnTerminator, block, state);
+    }
+
+    void VisitBlockFromStateWith(std::function<void(const Domain&, Expression*, size_t)> actionBeforeVisitExpr,
+        std::function<void(const Domain&, Expression*, size_t)> actionAfterVisitExpr,
+        std::function<void(const Domain&, Terminator*, std::optional<Block*>)> actionOnTerminator, Block& block,
+        Domain& state)
+    {
 #ifdef CANGJIE_CODEGEN_CJNATIVE_BACKEND
         VisitBlockNonTerminatorExpressionsWith(actionBeforeVisitExpr, actionAfterVisitExpr, block, state);
 #endif
@@ -157,6 +189,11 @@ private:
 
     std::unordered_map<const Lambda*, std::unordered_map<Block*, Domain>*> lambdaResultsMap;
     std::vector<LambdaState<Domain>> lambdaResults;
+
+    /// The state shared by all blocks if the analysis is done in sparse mode, null otherwise.
+    std::unique_ptr<Domain> sparseState;
+    /// The blocks that may be executed if the analysis is done in sparse mode.
+    std::vector<Block*> executedBlocks;
 };
 
 } // namespace Cangjie::CHIR
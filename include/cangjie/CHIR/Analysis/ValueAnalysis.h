@@ -124,6 +124,19 @@ public:
         }
     }
 
+    /**
+     * @brief widen the values of this state against their previous values in @p prev, mainly happen in loop headers.
+     * @param prev state before the latest join.
+     */
+    void Widen(const State<ValueDomain>& prev)
+    {
+        for (auto& [value, domain] : programState) {
+            if (auto it = prev.programState.find(value); it != prev.programState.end()) {
+                domain.Widen(it->second);
+            }
+        }
+    }
+
     /**
      * @brief output string with beauty format.
      * @return output string.
@@ -421,6 +434,27 @@ public:
         }
     }
 
+    /// set the states of all objects, i.e. the memory, to top, the states of the values are kept.
+    void ClearMemoryState()
+    {
+        for (auto& [value, domain] : programState) {
+            if (dynamic_cast<AbstractObject*>(value) == nullptr) {
+                continue;
+            }
+            if (domain.GetKind() == ValueDomain::ValueKind::REF) {
+                domain = Ref::GetTopRefInstance();
+            } else {
+                domain.SetSelfToBound(/* isTop = */ true);
+            }
+        }
+        for (auto& [_, target] : refMap) {
+            // a reference to a reference may be changed by a store, while a reference to an object is fixed
+            if (std::holds_alternative<Ref*>(target)) {
+                target = Ref::GetTopRefInstance();
+            }
+        }
+    }
+
 private:
     Ref* CreateNewRef(const Expression* expr = nullptr, bool createTwoLevelRef = false)
     {
@@ -805,6 +839,16 @@ public:
         state.SetToBound(lambda->GetResult(), /* isTop = */ true);
     }
 
+    /**
+     * @brief forget what is known about the memory at the entry of a block in sparse mode, value analyses track the
+     * memory in the same state as the values, see `State::ClearMemoryState`.
+     * @param state state to store all domain.
+     */
+    void ForgetFlowSensitiveState(State<ValueDomain>& state) override
+    {
+        state.ClearMemoryState();
+    }
+
     /**
      * @brief propagate state in normal expression.
      * @param state state to store all domain.
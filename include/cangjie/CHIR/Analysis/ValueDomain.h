@@ -281,6 +281,18 @@ public:
         return false;
     }
 
+    /// widen this domain against its previous value @p prev, only available if the abstract value supports widening.
+    void Widen(const ValueDomain<AbstractValue>& prev)
+    {
+        if (this->kind != ValueKind::VAL || prev.kind != ValueKind::VAL) {
+            return;
+        }
+        CJC_ASSERT(this->absVal && prev.absVal);
+        if (auto res = this->absVal->Widen(*(prev.absVal)); res) {
+            this->absVal = std::move(res);
+        }
+    }
+
     /// check if domain is bottom.
     bool IsBottom() const override
     {
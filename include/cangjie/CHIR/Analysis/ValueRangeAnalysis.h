@@ -33,6 +33,9 @@ public:
 
     virtual std::unique_ptr<ValueRange> Clone() const = 0;
 
+    /// widen this range against its previous value @p prev, return nullptr if no widening happened.
+    virtual std::unique_ptr<ValueRange> Widen(const ValueRange& prev) const = 0;
+
     /// get range kind, now suppert BOOL or SINT.
     RangeKind GetRangeKind() const;
 
@@ -42,7 +45,7 @@ protected:
 
 class BoolRange : public ValueRange {
 public:
-    explicit BoolRange(BoolDomain domain);
+    explicit BoolRange(BoolDomain domain, const BinaryExpression* predicate = nullptr);
 
     ~BoolRange() override = default;
 
@@ -53,11 +56,18 @@ public:
 
     std::unique_ptr<ValueRange> Clone() const override;
 
+    std::unique_ptr<ValueRange> Widen(const ValueRange& prev) const override;
+
     /// get range kind, get BOOL for this range type.
     const BoolDomain& GetVal() const;
 
+    /// get the integer comparison this bool value is the result of, null if unknown.
+    const BinaryExpression* GetPredicate() const;
+
 private:
     BoolDomain domain;
+    /// The comparison whose result is this bool value, used to refine its operands on branch edges.
+    const BinaryExpression* predicate;
 };
 
 class SIntRange : public ValueRange {
@@ -73,6 +83,10 @@ public:
 
     std::unique_ptr<ValueRange> Clone() const override;
 
+    /// widen the numeric bound that grows against @p prev to the bound of its type, and drop the symbolic bounds
+    /// that changed.
+    std::unique_ptr<ValueRange> Widen(const ValueRange& prev) const override;
+
     /// get range kind, get BOOL for this range type.
     const SIntDomain& GetVal() const;
 
@@ -155,6 +169,20 @@ public:
      */
     bool CheckInQueueTimes(const Block* block, RangeDomain& curState) override;
 
+    /// Only conditional branches on an integer comparison refine the state flowing to their successors.
+    bool HasEdgeEffect(const Terminator* terminator) override;
+
+    /// Refine the operands of the comparison a branch depends on, with the comparison on the true edge and its
+    /// negation on the false edge.
+    void PropagateEdgeEffect(RangeDomain& state, const Terminator* terminator, const Block* succ) override;
+
+    /// Widen the entry state of a block in a loop once it has been joined a few times, so that induction variables
+    /// converge in a bounded number of iterations instead of exhausting `CheckInQueueTimes`.
+    bool JoinEntryState(RangeDomain& entry, const RangeDomain& incoming, const Block* block) override;
+
+    /// Functions over the block limit are analysed in sparse mode, so that large functions still get ranges.
+    bool SupportsSparseMode() const override;
+
 private:
     template <class Domain,
         typename = typename std::enable_if<std::is_same_v<Domain, SIntDomain> || std::is_same_v<Domain, BoolDomain>>>
@@ -179,6 +207,34 @@ private:
 
     void HandleOthersExpr(RangeDomain& state, const Expression* expression);
 
+    void HandleLoadExpr(RangeDomain& state, const Load* load);
+
+    void HandleStoreExpr(RangeDomain& state, const Store* store) const;
+
+    void HandleFieldExpr(RangeDomain& state, const Field* field);
+
+    void HandleIntrinsicExpr(RangeDomain& state, const Intrinsic* intrinsic);
+
+    /// Bind @p value to the first value known to be equal to it, which is recorded in @p canonical.
+    void BindToCanonicalSymbol(RangeDomain& state, Value* value, Value*& canonical);
+
+    // ==================== Helpers for loop-aware refinement ==================== //
+
+    /// check whether @p block can reach itself.
+    bool IsInCycle(const Block* block);
+
+    /// check whether @p value is defined at most once per execution of the function, so that relations against it
+    /// never refer to a value of a previous loop iteration.
+    bool IsStableSymbol(const Value* value);
+
+    /// check whether the result of @p binary can be used to refine its operands where it is branched on.
+    bool IsRefinablePredicate(const BinaryExpression& binary);
+
+    const BinaryExpression* GetBranchPredicate(const RangeDomain& state, const Branch& branch) const;
+
+    /// Refine the operand @p value of a comparison with `value rel other`.
+    void RefineOperand(RangeDomain& state, Value* value, RelationalOperation rel, Value* other, bool isUnsigned);
+
     // ======================= Transfer functions for terminators ======================= //
 
     std::optional<Block*> HandleTerminatorEffect(RangeDomain& state, const Terminator* terminator) override;
@@ -214,6 +270,16 @@ private:
     DiagAdapter* diag;
 
     std::unordered_map<const Block*, uint32_t> inqueueTimes;
+
+    std::unordered_map<const Block*, uint32_t> joinTimes;
+
+    std::unordered_map<const Block*, bool> inCycleCache;
+
+    /// The first `Field` result of each (base, path), which the later `Field` results of the same member are bound to.
+    std::map<std::pair<const Value*, std::vector<uint64_t>>, Value*> canonicalFields;
+
+    /// The first `ARRAY_SIZE` result of each raw array.
+    std::unordered_map<const Value*, Value*> canonicalArraySizes;
 };
 } // namespace Cangjie::CHIR
 #endif
\ No newline at end of file
@@ -10,13 +10,16 @@
 #include "cangjie/Basic/Linkage.h"
 #include "cangjie/CHIR/DebugLocation.h"
 #include "cangjie/Utils/ConstantsUtils.h"
+#include <algorithm>
+#include <array>
 #include <map>
 #include <memory>
 #include <optional>
 #include <string>
+#include <type_traits>
 #include <typeindex>
 #include <typeinfo>
-#include <unordered_map>
+#include <vector>
 
 namespace Cangjie::CHIR {
 
@@ -28,7 +31,7 @@ struct Annotation {
     virtual ~Annotation() = default;
     virtual std::unique_ptr<Annotation> Clone() = 0;
 
-    virtual std::string ToString() = 0;
+    virtual std::string ToString() const = 0;
 };
 
 /**
@@ -52,7 +55,7 @@ public:
         return std::make_unique<NeedCheckArrayBound>(need);
     }
 
-    std::string ToString() override
+    std::string ToString() const override
     {
         std::string needStr = need ? "true" : "false";
         return "checkArrayBound: " + needStr;
@@ -83,7 +86,7 @@ public:
         return std::make_unique<NeedCheckCast>(need);
     }
 
-    std::string ToString() override
+    std::string ToString() const override
     {
         std::string needStr = need ? "true" : "false";
         return "checkTypeCast: " + needStr;
@@ -110,7 +113,7 @@ public:
         return std::make_unique<DebugLocationInfoForWarning>(location);
     }
 
-    std::string ToString() override
+    std::string ToString() const override
     {
         return "warning " + location.ToString();
     }
@@ -134,7 +137,7 @@ public:
         return std::make_unique<LinkTypeInfo>(linkType);
     }
 
-    std::string ToString() override
+    std::string ToString() const override
     {
         std::map<Cangjie::Linkage, std::string> linkToString = {{Cangjie::Linkage::EXTERNAL, "external"},
             {Cangjie::Linkage::WEAK_ODR, "weak_odr"}, {Cangjie::Linkage::INTERNAL, "internal"},
@@ -163,7 +166,7 @@ public:
         return std::make_unique<WrappedRawMethod>(rawMethod);
     }
 
-    std::string ToString() override;
+    std::string ToString() const override;
 
 private:
     FuncBase* rawMethod{nullptr};
@@ -199,7 +202,7 @@ public:
         return std::make_unique<SkipCheck>(kind);
     }
 
-    std::string ToString() override;
+    std::string ToString() const override;
 
 private:
     SkipKind kind{SkipKind::NO_SKIP};
@@ -220,7 +223,7 @@ public:
         return std::make_unique<NeverOverflowInfo>(neverOverflowInfo);
     }
 
-    std::string ToString() override
+    std::string ToString() const override
     {
         std::string str = neverOverflowInfo ? "true" : "false";
         return "NeverOverflowInfo: " + str;
@@ -245,7 +248,7 @@ public:
         return std::make_unique<IsAutoEnvClass>(isAutoEnv);
     }
 
-    std::string ToString() override
+    std::string ToString() const override
     {
         std::string str = isAutoEnv ? "true" : "false";
         return "IsAutoEnvClass: " + str;
@@ -270,7 +273,7 @@ public:
         return std::make_unique<IsCapturedClassInCC>(flag);
     }
 
-    std::string ToString() override
+    std::string ToString() const override
     {
         std::string str = flag ? "true" : "false";
         return "IsCapturedClassInCC: " + str;
@@ -295,7 +298,7 @@ public:
         return std::make_unique<EnumCaseIndex>(index);
     }
 
-    std::string ToString() override
+    std::string ToString() const override
     {
         if (index.has_value()) {
             return "EnumCaseIndex: " + std::to_string(index.value());
@@ -322,7 +325,7 @@ public:
         return std::make_unique<VirMethodOffset>(offset);
     }
 
-    std::string ToString() override
+    std::string ToString() const override
     {
         if (offset.has_value()) {
             return "VirMethodOffset: " + std::to_string(offset.value());
@@ -334,34 +337,87 @@ private:
     std::optional<size_t> offset{std::nullopt};
 };
 
+struct GeneratedFromForIn;
+
+template <typename... Ts> struct AnnotationTypeList {};
+
+/**
+ * Annotations whose whole state is a single byte-sized value (bool or uint8_t enum). They are set on most
+ * expressions, so AnnotationMap keeps them in fixed inline slots instead of allocating an object per annotation.
+ * Such an annotation must be constructible from the value returned by its `Extract`.
+ */
+using InlineAnnotationTypes = AnnotationTypeList<NeedCheckArrayBound, NeedCheckCast, LinkTypeInfo, SkipCheck,
+    NeverOverflowInfo, IsAutoEnvClass, IsCapturedClassInCC, GeneratedFromForIn>;
+
+template <typename T, typename... Ts> constexpr size_t GetInlineAnnotationSlot(AnnotationTypeList<Ts...>)
+{
+    constexpr bool matches[] = {std::is_same_v<T, Ts>...};
+    for (size_t i = 0; i < sizeof...(Ts); ++i) {
+        if (matches[i]) {
+            return i;
+        }
+    }
+    return sizeof...(Ts);
+}
+
+template <typename... Ts> constexpr size_t GetInlineAnnotationNum(AnnotationTypeList<Ts...>)
+{
+    return sizeof...(Ts);
+}
+
 // This class is used to manage CHIR Annotation's.
+// Inline annotations live in `inlineValues`, the rest in `rareAnnos`, which is sorted by type and shared between
+// copies until one of them is modified, so copying a node during inlining or block group cloning doesn't allocate per
+// annotation.
 class AnnotationMap final {
 public: // Set annotation T for this node, updating its value if it already exists
     template <typename T, typename... Args> void Set(Args&&... args)
     {
-        auto index = std::type_index(typeid(T));
-        annotations[index] = std::make_unique<T>(std::forward<Args>(args)...);
+        if constexpr (IS_INLINE<T>) {
+            const T anno(std::forward<Args>(args)...);
+            SetInline<T>(T::Extract(&anno));
+        } else {
+            auto index = std::type_index(typeid(T));
+            auto it = FindRare(index);
+            if (it != rareAnnos.end() && it->first == index) {
+                it->second = std::make_shared<T>(std::forward<Args>(args)...);
+            } else {
+                rareAnnos.emplace(it, index, std::make_shared<T>(std::forward<Args>(args)...));
+            }
+        }
     }
 
     // Get the value of the annotation T associated to this node
     template <typename T> typename std::invoke_result_t<decltype(T::Extract), const T*> Get() const
     {
-        auto index = std::type_index(typeid(T));
-        auto location = annotations.find(index);
-        // Check if we have a recorded annotation. Otherwise we return a default
-        // empty value for this kind of annotation.
-        if (location != annotations.end()) {
-            return T::Extract(static_cast<const T*>(location->second.get()));
+        if constexpr (IS_INLINE<T>) {
+            constexpr size_t slot = GetInlineAnnotationSlot<T>(InlineAnnotationTypes{});
+            if (inlineMask & (1U << slot)) {
+                return static_cast<ExtractResultT<T>>(inlineValues[slot]);
+            }
         } else {
-            auto emptyT = T();
-            return T::Extract(&emptyT);
+            auto index = std::type_index(typeid(T));
+            auto it = FindRare(index);
+            if (it != rareAnnos.end() && it->first == index) {
+                return T::Extract(static_cast<const T*>(it->second.get()));
+            }
         }
+        // We don't have a recorded annotation, return a default empty value for this kind of annotation.
+        auto emptyT = T();
+        return T::Extract(&emptyT);
     }
-    
+
     template <typename T> void Remove()
     {
-        auto index = std::type_index(typeid(T));
-        annotations.erase(index);
+        if constexpr (IS_INLINE<T>) {
+            constexpr size_t slot = GetInlineAnnotationSlot<T>(InlineAnnotationTypes{});
+            inlineMask &= static_cast<InlineMaskT>(~(1U << slot));
+        } else {
+            auto index = std::type_index(typeid(T));
+            if (auto it = FindRare(index); it != rareAnnos.end() && it->first == index) {
+                rareAnnos.erase(it);
+            }
+        }
     }
 
     /// Returns a reference to the annotation. Adds a new one if none exists. This API is used to change the associated
@@ -369,12 +425,16 @@ public: // Set annotation T for this node, updating its value if it already exis
     template <class T>
     T& GetAnno()
     {
-        if (auto location = annotations.find(std::type_index(typeid(T))); location != annotations.end()) {
-            return static_cast<T&>(*location->second);
-        } else {
-            auto inserted = annotations.emplace(std::type_index(typeid(T)), std::make_unique<T>());
-            return static_cast<T&>(*inserted.first->second);
+        static_assert(!IS_INLINE<T>, "inline annotations have no standalone object, update them with Set");
+        auto index = std::type_index(typeid(T));
+        auto it = FindRare(index);
+        if (it == rareAnnos.end() || it->first != index) {
+            it = rareAnnos.emplace(it, index, std::make_shared<T>());
+        } else if (it->second.use_count() > 1) {
+            // still shared with the node this map was copied from, detach before handing out a mutable reference
+            it->second = std::shared_ptr<Annotation>(it->second->Clone());
         }
+        return static_cast<T&>(*it->second);
     }
 
     inline const DebugLocation& GetDebugLocation() const
@@ -390,47 +450,74 @@ public: // Set annotation T for this node, updating its value if it already exis
         loc = std::move(newLoc);
     }
 
+    /// Calls `visitor(std::type_index, const Annotation&)` for every annotation of this node, except debug location.
+    /// Inline annotations are materialized into a temporary object for the duration of the call.
+    template <typename Visitor> void ForEachAnnotation(Visitor&& visitor) const
+    {
+        VisitInlineAnnotations(visitor, InlineAnnotationTypes{});
+        for (auto& [index, anno] : rareAnnos) {
+            visitor(index, static_cast<const Annotation&>(*anno));
+        }
+    }
+
     std::string ToString() const;
 
     AnnotationMap() = default;
+    AnnotationMap(const AnnotationMap& other) = default;
+    AnnotationMap(AnnotationMap&& other) = default;
+    AnnotationMap& operator=(const AnnotationMap& other) = default;
+    AnnotationMap& operator=(AnnotationMap&& other) = default;
+
+private:
+    template <typename T> using ExtractResultT = typename std::invoke_result_t<decltype(T::Extract), const T*>;
+    using InlineMaskT = uint8_t;
+    static constexpr size_t INLINE_ANNO_NUM = GetInlineAnnotationNum(InlineAnnotationTypes{});
+    static_assert(INLINE_ANNO_NUM <= sizeof(InlineMaskT) * 8U, "too many inline annotations for the mask");
+    template <typename T>
+    static constexpr bool IS_INLINE = GetInlineAnnotationSlot<T>(InlineAnnotationTypes{}) < INLINE_ANNO_NUM;
+    using RareAnnoVec = std::vector<std::pair<std::type_index, std::shared_ptr<Annotation>>>;
 
-    AnnotationMap(const AnnotationMap& other)
+    template <typename T, typename V> void SetInline(V value)
     {
-        for (auto& anno : other.annotations) {
-            annotations[anno.first] = anno.second->Clone();
-        }
-        loc = other.loc;
+        static_assert(sizeof(V) == sizeof(uint8_t), "inline annotation value must fit in one byte");
+        constexpr size_t slot = GetInlineAnnotationSlot<T>(InlineAnnotationTypes{});
+        inlineValues[slot] = static_cast<uint8_t>(value);
+        inlineMask |= static_cast<InlineMaskT>(1U << slot);
     }
-    AnnotationMap(AnnotationMap&& other) = default;
 
-    AnnotationMap& operator=(const AnnotationMap& other)
+    template <typename Visitor, typename... Ts>
+    void VisitInlineAnnotations(Visitor& visitor, AnnotationTypeList<Ts...>) const
     {
-        if (this == &other) {
-            return *this;
-        }
-        annotations.clear();
-        for (auto& anno : other.annotations) {
-            annotations[anno.first] = anno.second->Clone();
-        }
-        loc = other.loc;
-        return *this;
+        (VisitInlineAnnotation<Ts>(visitor), ...);
     }
-    AnnotationMap& operator=(AnnotationMap&& other)
+
+    template <typename T, typename Visitor> void VisitInlineAnnotation(Visitor& visitor) const
     {
-        swap(annotations, other.annotations);
-        loc = other.loc;
-        return *this;
+        constexpr size_t slot = GetInlineAnnotationSlot<T>(InlineAnnotationTypes{});
+        if ((inlineMask & (1U << slot)) == 0) {
+            return;
+        }
+        const T anno(static_cast<ExtractResultT<T>>(inlineValues[slot]));
+        visitor(std::type_index(typeid(T)), static_cast<const Annotation&>(anno));
     }
 
-    const std::unordered_map<std::type_index, std::unique_ptr<Annotation>>& GetAnnos() const
+    RareAnnoVec::iterator FindRare(const std::type_index& index)
+    {
+        return std::lower_bound(rareAnnos.begin(), rareAnnos.end(), index,
+            [](const auto& entry, const std::type_index& key) { return entry.first < key; });
+    }
+    RareAnnoVec::const_iterator FindRare(const std::type_index& index) const
     {
-        return annotations;
+        return std::lower_bound(rareAnnos.begin(), rareAnnos.end(), index,
+            [](const auto& entry, const std::type_index& key) { return entry.first < key; });
     }
 
-private:
-    std::unordered_map<std::type_index, std::unique_ptr<Annotation>> annotations;
+    // Rarely set annotations, sorted by type. The objects are immutable once shared, see `GetAnno`.
+    RareAnnoVec rareAnnos;
     // DebugLocation is a specialised field for better performance, since most expression/value/decl/type has one.
     DebugLocation loc{};
+    std::array<uint8_t, INLINE_ANNO_NUM> inlineValues{};
+    InlineMaskT inlineMask{0};
 };
 } // namespace Cangjie::CHIR
 #endif
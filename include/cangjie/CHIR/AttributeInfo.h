@@ -63,6 +63,7 @@ enum class Attribute {
     // Native FFI attributes
     JAVA_MIRROR,      ///< Mark whether it's @JavaMirror declaration (binding for a java class).
     JAVA_IMPL,        ///< Mark whether it's @JavaImpl declaration.
+    NO_ESCAPE,        ///< Mark a Parameter of reference type doesn't escape from its function.
 
     ATTR_END
 };
@@ -81,7 +82,8 @@ const std::unordered_map<Attribute, std::string> ATTR_TO_STRING{{Attribute::STAT
     {Attribute::COMMON, "common"}, {Attribute::PLATFORM, "platform"},
     {Attribute::SKIP_ANALYSIS, "skip_analysis"}, {Attribute::DESERIALIZED, "deserialized"},
     {Attribute::INITIALIZER, "initializer"},
-    {Attribute::UNSAFE, "unsafe"}, {Attribute::JAVA_MIRROR, "javaMirror"}, {Attribute::JAVA_IMPL, "javaImpl"}};
+    {Attribute::UNSAFE, "unsafe"}, {Attribute::JAVA_MIRROR, "javaMirror"}, {Attribute::JAVA_IMPL, "javaImpl"},
+    {Attribute::NO_ESCAPE, "noEscape"}};
 
 constexpr uint64_t ATTR_SIZE = 64;
 
@@ -14,6 +14,7 @@
 #define CANGJIE_CHIR_CHIR_H
 
 #include "cangjie/CHIR/AST2CHIR/AST2CHIR.h"
+#include "cangjie/CHIR/Analysis/PGOProfileInfo.h"
 #include "cangjie/CHIR/Analysis/ValueRangeAnalysis.h"
 #include "cangjie/CHIR/CHIRBuilder.h"
 #include "cangjie/CHIR/DiagAdapter.h"
@@ -154,10 +155,16 @@ private:
     void RunRangePropagation();
     bool RunNativeFFIChecks();
     void RunArrayListConstStartOpt();
+    void RunGenericSpecialization();
     void RunFunctionInline(DevirtualizationInfo& devirtInfo);
+    const PGOProfileInfo* GetPGOProfile();
     void RunArrayLambdaOpt();
     void RunRedundantFutureOpt();
     void RunNoSideEffectMarkerOpt();
+    void RunLoopInvariantCodeMotion();
+    void RunScalarReplacement();
+    void RunMem2Reg();
+    void RunNoEscapeMarker();
     void RunSanitizerCoverage();
     bool RunOptimizationPassAndRulesChecking();
     void MarkNoSideEffect();
@@ -223,6 +230,10 @@ private:
     std::unordered_map<std::string, FuncBase*> implicitFuncs;
     std::vector<CHIR::FuncBase*> initFuncsForConstVar;
     std::unordered_map<Block*, Terminator*> maybeUnreachable;
+    /// Profile given by `--pgo-instr-use`, loaded when it's first needed.
+    std::unique_ptr<PGOProfileInfo> pgoProfile;
+    /// Copies of generic functions created by GenericSpecialization, reused by Devirtualization.
+    std::vector<Func*> specializedFuncs;
     /// Whether this CHIR convertor is translating Annotations
     bool isComputingAnnos{false};
     std::vector<std::pair<const AST::Decl*, Func*>> annoFactoryFuncs;
@@ -310,6 +310,8 @@ private:
     static std::mutex dynamicAllocatedTysMtx;
 
     size_t threadsNum;
+    // released after the values are deleted, the interned strings of this compilation are dropped with the last one
+    InternedString::PoolLease internedStringLease;
 };
 } // namespace Cangjie::CHIR
 #endif // CANGJIE_CHIR_CHIRCONTEXT_H
\ No newline at end of file
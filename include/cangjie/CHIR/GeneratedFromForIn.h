@@ -13,13 +13,13 @@ namespace Cangjie::CHIR {
 /// them even in O0.
 struct GeneratedFromForIn final : public Annotation {
     GeneratedFromForIn() : value{false} {}
-    explicit GeneratedFromForIn(bool) : value{true} {}
+    explicit GeneratedFromForIn(bool b) : value{b} {}
     std::unique_ptr<Annotation> Clone() override
     {
-        return std::make_unique<GeneratedFromForIn>();
+        return std::make_unique<GeneratedFromForIn>(value);
     }
  
-    std::string ToString() override
+    std::string ToString() const override
     {
         return "// generated-from-forin ";
     }
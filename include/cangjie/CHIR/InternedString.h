@@ -0,0 +1,94 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#ifndef CANGJIE_CHIR_INTERNED_STRING_H
+#define CANGJIE_CHIR_INTERNED_STRING_H
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace Cangjie::CHIR {
+
+/**
+ * @brief A string stored once in a shared, thread-safe pool and referred to by a 32-bit id.
+ *
+ * Two interned strings are equal iff their ids are equal, so equality and hashing are O(1). The text is only
+ * materialized when it is really needed, e.g. for printing and serialization. Note that the order of ids depends on
+ * the order of interning, so it must not be used as a stable order.
+ *
+ * The pool lives as long as a `PoolLease` exists, e.g. as long as a `CHIRContext`, and it is emptied when the last
+ * lease is released, so a long-lived process like the LSP server doesn't keep the strings of finished compilations.
+ */
+class InternedString {
+public:
+    InternedString() = default;
+    // Implicit conversions keep the constructors which take `std::string` unchanged.
+    InternedString(std::string_view str);
+    InternedString(const std::string& str) : InternedString(std::string_view{str})
+    {
+    }
+    InternedString(const char* str) : InternedString(std::string_view{str})
+    {
+    }
+
+    /**
+     * @brief Keep the strings of the pool alive. No interned string may be used after the last lease is released.
+     */
+    class PoolLease {
+    public:
+        PoolLease();
+        ~PoolLease();
+        PoolLease(const PoolLease&) = delete;
+        PoolLease& operator=(const PoolLease&) = delete;
+    };
+
+    /**
+     * @brief Return the text of this string, the reference is valid until the pool is emptied.
+     */
+    const std::string& Str() const;
+
+    uint32_t GetId() const
+    {
+        return id;
+    }
+
+    bool Empty() const
+    {
+        return id == 0;
+    }
+
+    bool operator==(const InternedString& other) const
+    {
+        return id == other.id;
+    }
+
+    bool operator!=(const InternedString& other) const
+    {
+        return id != other.id;
+    }
+
+    /**
+     * @brief Return the number of strings and the bytes of text held by the pool, used for memory statistics.
+     */
+    static std::pair<size_t, size_t> GetPoolUsage();
+
+private:
+    uint32_t id{0}; // 0 is always the empty string
+};
+
+std::ostream& operator<<(std::ostream& out, const InternedString& str);
+} // namespace Cangjie::CHIR
+
+template <> struct std::hash<Cangjie::CHIR::InternedString> {
+    size_t operator()(const Cangjie::CHIR::InternedString& str) const
+    {
+        return std::hash<uint32_t>{}(str.GetId());
+    }
+};
+#endif
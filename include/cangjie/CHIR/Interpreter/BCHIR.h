@@ -15,6 +15,7 @@
 
 #include <functional>
 #include <iostream>
+#include <unordered_set>
 #include <vector>
 
 #include "cangjie/CHIR/Interpreter/OpCodes.h"
@@ -33,6 +34,10 @@ public:
         defaultFuncPtrs.resize(static_cast<size_t>(DefaultFunctionKind::INVALID));
     }
 
+    /** @brief Deep copy of this BCHIR. An interpreter writes its inline caches and playgrounds to the bytecode it
+     * runs, so interpreters running at the same time need their own copy. The values referring to the string arrays
+     * of this BCHIR, e.g. the initial values of the global vars returned by the linker, remain valid as long as this
+     * BCHIR is alive. */
     Bchir Clone() const;
 
     /** @brief the type of each cell in the bytecode. */
@@ -70,6 +75,8 @@ public:
         void Push(Bchir::ByteCodeContent value);
         /** @brief push a 8 bytes value */
         void Push8bytes(uint64_t value);
+        /** @brief pushes an empty inline cache. */
+        void PushInlineCache();
         /** @brief sets value at index in the bytecode. */
         void Set(ByteCodeIndex index, Bchir::ByteCodeContent value);
         /** @brief sets opcode at index in the bytecode. */
@@ -201,19 +208,27 @@ public:
     using SClassTable = std::unordered_map<std::string, SClassInfo>;
 
     // For execution
-    // method id -> func body index
-    using VTable = std::unordered_map<ByteCodeContent, ByteCodeIndex>;
+    // (method id, func body index), sorted by method id
+    using VTable = std::vector<std::pair<ByteCodeContent, ByteCodeIndex>>;
     struct ClassInfo {
-        // Transitive closure of superclasses, required for instanceof
-        std::set<ByteCodeContent> superClasses;
+        // Transitive closure of superclasses, required for instanceof, sorted by class id
+        std::vector<ByteCodeContent> superClasses;
         VTable vtable;
         ByteCodeIndex finalizerIdx = 0; // func body index
         // Required to go from `ClassId` to CHIR `Class*` during constant evaluation.
+        // Empty if the class with this id has not been linked yet.
         std::string mangledName;
     };
-    // OPTIMIZE: we can do better to make this as a vector
-    // class id -> class info
-    using ClassTable = std::unordered_map<ByteCodeContent, ClassInfo>;
+    // indexed by class id
+    using ClassTable = std::vector<ClassInfo>;
+
+    /** @brief Number of entries of an inline cache. The inline caches are stored in the bytecode of the operations
+     * that look up the class of an object, e.g. INVOKE :: number_of_args :: method_id :: CLASS_0 :: VALUE_0 ::
+     * CLASS_1 :: VALUE_1. An entry caches the value looked up for the class, and is empty if its class is
+     * BYTECODE_CONTENT_MAX. */
+    static const ByteCodeContent INLINE_CACHE_ENTRIES = 2;
+    /** @brief Number of cells of an inline cache. */
+    static const ByteCodeContent INLINE_CACHE_SIZE = INLINE_CACHE_ENTRIES * 2;
 
     /** @brief get linkedByteCode */
     const Definition& GetLinkedByteCode() const;
@@ -306,6 +321,9 @@ public:
     /** @brief remove the function/variable/class with the provided mangled name */
     void RemoveDefinition(const std::string& name);
     std::vector<std::string> initFuncsForConsts;
+    /** @brief The const evaluable functions that weren't translated for const evaluation, as they aren't reachable
+     * from the initializers of the const variables. */
+    std::unordered_set<std::string> skippedConstEvalFuncs;
 
 private:
     // before linking (needs serializing)
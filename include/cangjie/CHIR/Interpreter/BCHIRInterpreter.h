@@ -32,6 +32,7 @@
 #include <cmath>
 #include <cstring>
 #include <fstream>
+#include <mutex>
 #ifdef _WIN32
 #include <windows.h>
 // we need to undefine THIS, INTERFACE, and FASTCALL which are defined by MinGW
@@ -91,6 +92,10 @@ public:
     /** @brief returns the result of the previous run, or INotRun if interpreter never ran */
     const IResult& GetLastResult() const;
 
+    /** @brief Stop interpreting with an error once the live values take more than `maxMemory` bytes, or after
+     * `maxSteps` jumps and calls. There is no limit by default. */
+    void SetLimits(size_t maxMemory, size_t maxSteps);
+
     /** @brief the max size of the internal playground, the part of the bytecode
      * where this interpreter instance can generate code. */
     static const size_t INTERNAL_PLAYGROUND_SIZE = 20;
@@ -166,6 +171,9 @@ private:
 
     // Is the interpreter being used for constant evaluation?
     bool isConstEval = false;
+    /** @brief see `SetLimits` */
+    size_t memoryLimit{std::numeric_limits<size_t>::max()};
+    size_t stepsLeft{std::numeric_limits<size_t>::max()};
     /** @brief interpreter last result */
     IResult result{INotRun{}};
 
@@ -195,10 +203,27 @@ private:
     void InterpretReturn();
 
     IVal* AllocateValue(IVal&& value);
+    /** @brief Collect the arena if enough was allocated since the last collection. The roots are the values held by
+     * the environment, the stacks and the interpreter itself, so this must be called before the current operation
+     * takes any value from them. */
+    void CollectGarbageIfNeeded();
+    /** @brief Count a jump or a call against the step limit. */
+    void ChargeStep()
+    {
+        if (--stepsLeft == 0) {
+            FailWith(pc, "step limit exceeded", DiagKind::const_eval_limit_exceeded, "step");
+        }
+    }
 
     // Invoke support
     Bchir::ByteCodeIndex FindMethod(Bchir::ByteCodeContent classId, Bchir::ByteCodeContent nameId);
 
+    /** @brief Get the value cached for `classId` in the inline cache at `cacheIdx`. On a miss, the value is computed
+     * by `lookUp` and cached if the inline cache is not full yet. */
+    template <typename LookUp>
+    Bchir::ByteCodeContent LookUpInlineCache(
+        Bchir::ByteCodeIndex cacheIdx, Bchir::ByteCodeContent classId, LookUp lookUp);
+
     // Switch support
     template <typename Ty> void InterpretSwitchWithType();
 
@@ -215,6 +240,9 @@ private:
     void RaiseArithmeticExceptionMsg(Bchir::ByteCodeIndex sourcePc, const std::string& str);
     void RaiseOutOfMemoryError(Bchir::ByteCodeIndex sourcePc);
     void RaiseError(Bchir::ByteCodeIndex, const std::string&);
+    /** @brief Report aborting in the abort function generated by the linker for a const evaluable function that
+     * wasn't translated, as `CHIR2BCHIR::CollectConstEvalFuncs` missed that it is reachable. */
+    void CheckAbortedInSkippedConstEvalFunc(Bchir::ByteCodeIndex abortIdx) const;
 
     /* Binary operations */
     /** @brief Perform binary operation */
@@ -290,6 +318,9 @@ private:
      * @param opIdx for the operation that caused the failure. We use it to extract the position.
      */
     DiagnosticEngine& diag;
+    /** @brief guards the source manager and the diagnostics, since const evaluation runs several interpreters at the
+     * same time */
+    static std::mutex sourceManagerMtx;
     template <typename... Args>
     void FailWith(Bchir::ByteCodeIndex opIdx, std::string excErrorMsg, DiagKind kind, Args... args)
     {
@@ -297,16 +328,19 @@ private:
         auto pos = bchir.GetLinkedByteCode().GetCodePositionAnnotation(opIdx);
         // convert file name (bchir) ID to (source manager) ID
         auto fileName = bchir.GetFileName(pos.fileID);
-        auto fileId = sm.GetFileID(fileName);
-        if (fileId == -1) {
-            fileId = static_cast<int>(sm.AddSource(fileName, ""));
-        }
-        Cangjie::Position cjPos{
-            static_cast<unsigned int>(fileId), static_cast<int>(pos.line), static_cast<int>(pos.column)};
-        if (cjPos.IsZero()) {
-            diag.Diagnose(kind, args...);
-        } else {
-            diag.Diagnose(cjPos, kind, args...);
+        {
+            std::lock_guard<std::mutex> lock(sourceManagerMtx);
+            auto fileId = sm.GetFileID(fileName);
+            if (fileId == -1) {
+                fileId = static_cast<int>(sm.AddSource(fileName, ""));
+            }
+            Cangjie::Position cjPos{
+                static_cast<unsigned int>(fileId), static_cast<int>(pos.line), static_cast<int>(pos.column)};
+            if (cjPos.IsZero()) {
+                diag.Diagnose(kind, args...);
+            } else {
+                diag.Diagnose(cjPos, kind, args...);
+            }
         }
         RaiseError(opIdx, excErrorMsg);
     }
@@ -33,6 +33,8 @@ public:
     std::unordered_map<Bchir::ByteCodeIndex, IVal> Run(std::vector<Bchir>& packages, const GlobalOptions& options);
 
     int GetGVARId(const std::string& name) const;
+    /** @brief the index of the body of the function `name` in the linked bytecode, or -1 if it wasn't linked */
+    int GetFuncBodyIdx(const std::string& name) const;
 
 private:
     Bchir& topBchir;
@@ -59,6 +61,8 @@ private:
 
     /** Index of a dummy function of the form FRAME :: 0 :: ABORT */
     Bchir::ByteCodeIndex dummyAbortFuncIdx{Bchir::BYTECODE_CONTENT_MAX};
+    /** @brief location in the bytecode of the abort functions generated for the functions that weren't linked */
+    std::unordered_map<std::string, Bchir::ByteCodeIndex> mName2AbortFuncIdx;
 
     void LinkClasses(const Bchir& bchir);
     void LinkClass(const Bchir& bchir, const std::string& mangledName);
@@ -66,12 +70,22 @@ private:
         const Bchir& bchir, std::unordered_map<Bchir::ByteCodeIndex, IVal>& gvarId2InitIVal, bool isLast);
     /** @brief Generates a dummy function that simply aborts interpretation. */
     void GenerateDummyAbortFunction();
+    /** @brief Generates a function FRAME :: 0 :: ABORT whose FRAME is annotated with `mangledName`, so that the
+     * interpreter can tell which missing function was called. */
+    Bchir::ByteCodeIndex GenerateAbortFunction(const std::string& mangledName);
+    /** @brief The abort function standing for the missing function `mangledName`, generated the first time. */
+    Bchir::ByteCodeIndex GetAbortFunction(const std::string& mangledName);
+    /** @brief Point the calls to the functions that are still not linked to their abort functions. */
+    void GenerateAbortFunctionsForMissingFunctions();
     void LinkFunctions(const std::vector<Bchir>& packages);
     void GenerateCallsToConstInitFunctions(const std::vector<std::string>& constInitFuncs);
     /** @brief Traverse currentDef and append it to topBCHIR */
     void TraverseAndLink(const Bchir& bchir, const Bchir::Definition& currentDef,
         const std::vector<Bchir::ByteCodeContent>& fileMap, const std::vector<Bchir::ByteCodeContent>& typeMap,
         const std::vector<Bchir::ByteCodeContent>& stringMap);
+    /** @brief Replace common sequences of the linked operations starting at `ops` with superinstructions, which
+     * are interpreted with a single dispatch. */
+    void FuseSuperInstructions(const std::vector<Bchir::ByteCodeIndex>& ops);
 
     void AddPosition(const std::unordered_map<Bchir::ByteCodeIndex, Bchir::CodePosition>& positions,
         const std::vector<Bchir::ByteCodeContent>& fileMap, Bchir::ByteCodeIndex curr);
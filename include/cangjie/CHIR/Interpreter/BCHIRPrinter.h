@@ -69,6 +69,7 @@ private:
         void PrintOpCode();
         void PrintAtIndex();
         void PrintAtIndex8bytes();
+        void PrintInlineCache();
 
         // This function is not used by the interpreter directly, but it's
         // necessary when debugging the interpreter runtime
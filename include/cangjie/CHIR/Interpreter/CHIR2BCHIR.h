@@ -31,13 +31,16 @@ namespace Cangjie::CHIR::Interpreter {
 class CHIR2BCHIR {
 public:
     /** @brief Compile CHIR `chirPkg` into BCHIR `destBchir`. Set ForConstEval to true if BCHIR is intended
-     * to evaluate constants. */
+     * to evaluate constants, in which case only the const evaluable functions reachable from the initializers of the
+     * const variables are translated, unless `translateUnreachable` is set. */
     template <bool ForConstEval = false>
     static void CompileToBCHIR(const Package& chirPkg, Bchir& destBchir,
         const std::vector<CHIR::FuncBase*>& initFuncsForConstVar, SourceManager& sm,
-        const GlobalOptions& options, bool printBchir = false, bool incremental = false)
+        const GlobalOptions& options, bool printBchir = false, bool incremental = false,
+        bool translateUnreachable = false)
     {
         CHIR2BCHIR chir2bchir(destBchir, sm, incremental);
+        chir2bchir.translateUnreachable = translateUnreachable;
         chir2bchir.TranslatePackage<ForConstEval>(chirPkg, initFuncsForConstVar);
         if (printBchir) {
             auto stageName = ForConstEval ? "ce-chir2bchir" : "chir2bchir";
@@ -59,6 +62,9 @@ private:
     std::unordered_map<const LocalVar*, Bchir::ByteCodeContent> const2CLVarId;
     /** @brief Whether this is incremental, with the previous BCHIR having been restored */
     bool isIncremental;
+    /** @brief Whether const evaluation translates every const evaluable function, as it did before
+     * `CollectConstEvalFuncs`, rather than only the reachable ones */
+    bool translateUnreachable{false};
 
     CHIR2BCHIR(Bchir& bchir, SourceManager& sm, bool isIncremental)
         : bchir(bchir), sourceManager(sm), isIncremental(isIncremental)
@@ -209,6 +215,17 @@ private:
 #endif
 
     bool IsConstClass(const CustomTypeDef& def) const;
+    /** @brief Whether `func` can be run by const evaluation. */
+    bool IsConstEvalFunc(const Func& func) const;
+
+    /** @brief The functions translated for const evaluation: the const evaluable functions reachable from the
+     * initializers of the const variables, see `CollectConstEvalFuncs`. */
+    std::unordered_set<const Func*> constEvalFuncs;
+    /** @brief Collect the functions that may be run by the initializers of the const variables, so that const
+     * evaluation doesn't translate and link the whole package. A function is reachable if it is used by a reachable
+     * function, or it is in the vtable of a translated type and a reachable function invokes a method with its
+     * name. */
+    void CollectConstEvalFuncs(const Package& chirPkg, const std::vector<CHIR::FuncBase*>& initFuncsForConstVar);
 };
 } // namespace Cangjie::CHIR::Interpreter
 
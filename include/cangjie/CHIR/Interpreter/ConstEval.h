@@ -64,6 +64,18 @@ private:
     const Package& package;
 };
 
+/**
+ * @brief Split the const initializers into at most `maxBatches` batches that can be evaluated independently of each
+ * other, keeping their order in each batch. Few initializers are kept in a single batch.
+ *
+ * Two initializers are dependent if one of them may access a global var initialized by the other, or both may
+ * access a global var initialized by a third one. The accesses are found through the functions with a body that
+ * they may call, an INVOKE being assumed to call all the methods with its name. Const code can't write the other
+ * global vars, so reading them doesn't make initializers dependent.
+ */
+std::vector<std::vector<const Func*>> SplitIndependentInitFuncs(
+    const Package& package, const std::vector<FuncBase*>& initFuncsForConstVar, size_t maxBatches);
+
 class ConstEvalPass {
 public:
     explicit ConstEvalPass(CompilerInstance& ci, CHIRBuilder& builder, SourceManager& sourceManager,
@@ -17,6 +17,16 @@
 
 namespace Cangjie::CHIR::Interpreter {
 
+/**
+ * @brief The heap of the interpreter.
+ *
+ * Values are never moved, because IPointer refers to them, or to their elements, by address. Unreachable values are
+ * reclaimed by a mark-sweep collection driven by the interpreter:
+ * 1. `BeginCollection`;
+ * 2. `MarkReachable` on every root, i.e. the values held by the interpreter outside of the arena;
+ * 3. `FinishCollection`, which destroys the unmarked values and reuses their slots for later allocations.
+ * The objects with a finalizer are always kept, since the interpreter doesn't run finalizers.
+ */
 class Arena {
 public:
     /* list of objects that needs to run finalizer on them */
@@ -31,12 +41,22 @@ public:
     }
     IVal* Allocate(IVal&& value)
     {
+        bytesSinceCollection += sizeof(IVal) + GetElementsSize(value);
+        if (!freeSlots.empty()) {
+            auto slot = freeSlots.back();
+            freeSlots.pop_back();
+            isFree[slot] = false;
+            auto ptr = GetSlot(slot);
+            *ptr = std::move(value);
+            return ptr;
+        }
         if (buckets.back()->size() == BUCKET_SIZE) {
             buckets.emplace_back(std::make_unique<std::vector<IVal>>());
             buckets.back()->reserve(BUCKET_SIZE);
         }
         auto& lastBucket = buckets.back();
         lastBucket->emplace_back(std::move(value));
+        isFree.emplace_back(false);
         auto ptr = &lastBucket->back();
         return ptr;
     }
@@ -49,13 +69,66 @@ public:
     int64_t GetAllocatedSize()
     {
         CJC_ASSERT(buckets.size() >= 1);
-        size_t r = ((buckets.size() - 1) * BUCKET_SIZE + buckets.back()->size()) * sizeof(IVal);
+        size_t r = (GetNumberOfSlots() - freeSlots.size()) * sizeof(IVal);
         return static_cast<int64_t>(r);
     }
 
+    /** @brief Whether enough memory was allocated since the last collection to run a new one. */
+    bool ShouldCollect() const
+    {
+        return bytesSinceCollection >= collectionThreshold;
+    }
+
+    /**
+     * @brief Collect at least once every `limit` bytes allocated, so that exceeding a memory limit below the default
+     * collection threshold is noticed.
+     */
+    void SetMemoryLimit(size_t limit)
+    {
+        minCollectionThreshold = std::min(MIN_COLLECTION_THRESHOLD, limit);
+        collectionThreshold = std::min(collectionThreshold, minCollectionThreshold);
+    }
+
+    /** @brief Start a collection, all the values are unmarked. */
+    void BeginCollection();
+    /** @brief Mark the values of the arena reachable from `root`, which is not in the arena. */
+    void MarkReachable(const IVal& root);
+    /**
+     * @brief Finish a collection, the values not marked so far are destroyed.
+     * @return the memory used by the remaining values, including the elements of tuples, arrays and objects.
+     */
+    size_t FinishCollection();
+
+    /** @brief The memory used by the elements of `value` and of the aggregates nested in it. */
+    static size_t GetElementsSize(const IVal& value);
+
 private:
     static const size_t BUCKETS = 2048;
     static const size_t BUCKET_SIZE = 2048;
+    /** @brief the arena is never collected before this many bytes are allocated, unless the memory limit is lower */
+    static constexpr size_t MIN_COLLECTION_THRESHOLD = 64 * 1024 * 1024;
+
+    /** @brief Memory referred to by IPointer, either a bucket or the elements of an aggregate in a slot. */
+    struct Region {
+        const IVal* begin;
+        const IVal* end;
+        /** @brief the first slot of the bucket, or the slot owning the elements */
+        size_t slot;
+        bool isBucket;
+    };
+
+    size_t GetNumberOfSlots() const
+    {
+        return (buckets.size() - 1) * BUCKET_SIZE + buckets.back()->size();
+    }
+    IVal* GetSlot(size_t slot)
+    {
+        return &(*buckets[slot / BUCKET_SIZE])[slot % BUCKET_SIZE];
+    }
+    void AddElementRegions(const IVal& value, size_t slot);
+    void MarkPointee(const IVal* pointee);
+    void MarkPointees(const IVal& value);
+    void TraceMarked();
 
     // Why unique_ptr? Because in C++ vector reallocation may either copy or move its contents.
     // It sohuld move if possible -- and it should be possible in this case.
@@ -65,8 +138,20 @@ private:
     // after profiling. T0D0!!
     using Bucket = std::unique_ptr<std::vector<IVal>>;
     std::vector<Bucket> buckets;
+
+    /** @brief slots of the values destroyed by the collections, reused by `Allocate` */
+    std::vector<size_t> freeSlots;
+    std::vector<bool> isFree;
+    size_t bytesSinceCollection{0};
+    size_t minCollectionThreshold{MIN_COLLECTION_THRESHOLD};
+    size_t collectionThreshold{MIN_COLLECTION_THRESHOLD};
+
+    // state of the current collection
+    std::vector<Region> regions;
+    std::vector<bool> isMarked;
+    std::vector<size_t> markStack;
 };
 
 } // namespace Cangjie::CHIR::Interpreter
 
-#endif // CANGJIE_CHIR_INTERRETER_INTERPREVERARENA_H
\ No newline at end of file
+#endif // CANGJIE_CHIR_INTERRETER_INTERPREVERARENA_H
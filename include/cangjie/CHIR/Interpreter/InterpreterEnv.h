@@ -83,6 +83,13 @@ struct Env {
         return bp;
     }
 
+    /** @brief Call `f` on each global variable and each local variable of all the stack frames. */
+    template <typename F> void ForEachVar(F f) const
+    {
+        std::for_each(global.begin(), global.end(), f);
+        std::for_each(local.begin(), local.end(), f);
+    }
+
 private:
     size_t numberOfGlobals;
     /** @brief environment for global variables */
@@ -52,21 +52,11 @@ struct InterpreterStack {
             [&](auto&& arg) -> IVal {
                 using T = std::decay_t<decltype(arg)>;
                 if constexpr (std::is_same_v<T, ITuplePtr>) {
-                    ITuple res;
-                    std::swap(res.content, *arg.contentPtr);
-                    delete arg.contentPtr;
-                    return res;
+                    return ITuple{IValVector::Adopt(arg.contentPtr)};
                 } else if constexpr (std::is_same_v<T, IArrayPtr>) {
-                    IArray res;
-                    std::swap(res.content, *arg.contentPtr);
-                    delete arg.contentPtr;
-                    return res;
+                    return IArray{IValVector::Adopt(arg.contentPtr)};
                 } else if constexpr (std::is_same_v<T, IObjectPtr>) {
-                    IObject res;
-                    std::swap(res.content, *arg.contentPtr);
-                    res.classId = arg.classId;
-                    delete arg.contentPtr;
-                    return res;
+                    return IObject{arg.classId, IValVector::Adopt(arg.contentPtr)};
                 } else {
                     return arg;
                 }
@@ -83,20 +73,11 @@ struct InterpreterStack {
             [&](auto&& arg) -> IValStack {
                 using T = std::decay_t<decltype(arg)>;
                 if constexpr (std::is_same_v<T, ITuple>) {
-                    std::vector<IVal>* ptr = new std::vector<IVal>();
-                    std::swap(*ptr, arg.content);
-                    ITuplePtr res{ptr};
-                    return res;
+                    return ITuplePtr{arg.content.Release()};
                 } else if constexpr (std::is_same_v<T, IArray>) {
-                    std::vector<IVal>* ptr = new std::vector<IVal>();
-                    std::swap(*ptr, arg.content);
-                    IArrayPtr res{ptr};
-                    return res;
+                    return IArrayPtr{arg.content.Release()};
                 } else if constexpr (std::is_same_v<T, IObject>) {
-                    std::vector<IVal>* ptr = new std::vector<IVal>();
-                    std::swap(*ptr, arg.content);
-                    IObjectPtr res{arg.classId, ptr};
-                    return res;
+                    return IObjectPtr{arg.classId, arg.content.Release()};
                 } else {
                     return arg;
                 }
@@ -118,21 +99,12 @@ struct InterpreterStack {
         argStack.pop_back();
 
         if constexpr (std::is_same_v<S, ITuple>) {
-            ITuple res;
-            std::swap(res.content, *std::get<ITuplePtr>(arg).contentPtr);
-            delete std::get<ITuplePtr>(arg).contentPtr;
-            return res;
+            return ITuple{IValVector::Adopt(std::get<ITuplePtr>(arg).contentPtr)};
         } else if constexpr (std::is_same_v<S, IArray>) {
-            IArray res;
-            std::swap(res.content, *std::get<IArrayPtr>(arg).contentPtr);
-            delete std::get<IArrayPtr>(arg).contentPtr;
-            return res;
+            return IArray{IValVector::Adopt(std::get<IArrayPtr>(arg).contentPtr)};
         } else if constexpr (std::is_same_v<S, IObject>) {
-            IObject res;
-            std::swap(res.content, *std::get<IObjectPtr>(arg).contentPtr);
-            res.classId = std::get<IObjectPtr>(arg).classId;
-            delete std::get<IObjectPtr>(arg).contentPtr;
-            return res;
+            auto& obj = std::get<IObjectPtr>(arg);
+            return IObject{obj.classId, IValVector::Adopt(obj.contentPtr)};
         } else {
             return std::get<S>(arg);
         }
@@ -165,12 +137,10 @@ struct InterpreterStack {
         std::visit(
             [&](auto& arg) {
                 using T = std::decay_t<decltype(arg)>;
-                if constexpr (std::is_same_v<T, ITuplePtr>) {
-                    delete arg.contentPtr;
-                } else if constexpr (std::is_same_v<T, IArrayPtr>) {
-                    delete arg.contentPtr;
-                } else if constexpr (std::is_same_v<T, IObjectPtr>) {
-                    delete arg.contentPtr;
+                if constexpr (std::is_same_v<T, ITuplePtr> || std::is_same_v<T, IArrayPtr> ||
+                    std::is_same_v<T, IObjectPtr>) {
+                    // the elements are destroyed with the temporary vector
+                    (void)IValVector::Adopt(arg.contentPtr);
                 }
             },
             argStack.back());
@@ -183,7 +153,7 @@ struct InterpreterStack {
      *
      * elems will be cleared before using it.
      */
-    void ArgsPop(size_t size, std::vector<IVal>& elems)
+    void ArgsPop(size_t size, IValVector& elems)
     {
         // OPTIMIZE
         CJC_ASSERT(size <= argStack.size());
@@ -252,14 +222,11 @@ struct InterpreterStack {
             [&](auto&& arg) -> IVal {
                 using T = std::decay_t<decltype(arg)>;
                 if constexpr (std::is_same_v<T, ITuplePtr>) {
-                    ITuple res{*arg.contentPtr};
-                    return res;
+                    return ITuple{IValVector::CopyOf(arg.contentPtr)};
                 } else if constexpr (std::is_same_v<T, IArrayPtr>) {
-                    IArray res{*arg.contentPtr};
-                    return res;
+                    return IArray{IValVector::CopyOf(arg.contentPtr)};
                 } else if constexpr (std::is_same_v<T, IObjectPtr>) {
-                    IObject res{arg.classId, *arg.contentPtr};
-                    return res;
+                    return IObject{arg.classId, IValVector::CopyOf(arg.contentPtr)};
                 } else {
                     return arg;
                 }
@@ -281,17 +248,11 @@ struct InterpreterStack {
         static_assert(!std::is_same_v<S, IVal>, "ArgsPush can't be used with IVal, only the internal values of IVal");
 
         if constexpr (std::is_same_v<S, ITuple>) {
-            ITuplePtr t{new std::vector<IVal>};
-            std::swap(*t.contentPtr, node.content);
-            (void)argStack.emplace_back(t);
+            (void)argStack.emplace_back(ITuplePtr{node.content.Release()});
         } else if constexpr (std::is_same_v<S, IArray>) {
-            IArrayPtr t{new std::vector<IVal>};
-            std::swap(*t.contentPtr, node.content);
-            (void)argStack.emplace_back(t);
+            (void)argStack.emplace_back(IArrayPtr{node.content.Release()});
         } else if constexpr (std::is_same_v<S, IObject>) {
-            IObjectPtr t{node.classId, new std::vector<IVal>};
-            std::swap(*t.contentPtr, node.content);
-            (void)argStack.emplace_back(t);
+            (void)argStack.emplace_back(IObjectPtr{node.classId, node.content.Release()});
         } else {
             (void)argStack.emplace_back(std::forward<T>(node));
         }
@@ -363,6 +324,28 @@ struct InterpreterStack {
         return controlStack.size();
     }
 
+    /** @brief Call `f` on each value on the argument stack that may hold a pointer. Tuples, arrays and objects are
+     * visited by their elements, pointers are passed as an IVal. */
+    template <typename F> void ArgsForEach(F f) const
+    {
+        for (auto& arg : argStack) {
+            std::visit(
+                [&f](auto&& val) {
+                    using T = std::decay_t<decltype(val)>;
+                    if constexpr (std::is_same_v<T, ITuplePtr> || std::is_same_v<T, IArrayPtr> ||
+                        std::is_same_v<T, IObjectPtr>) {
+                        if (val.contentPtr != nullptr) {
+                            auto elems = IValVector::ElementsOf(val.contentPtr);
+                            std::for_each(elems, elems + val.contentPtr->size, f);
+                        }
+                    } else if constexpr (std::is_same_v<T, IPointer>) {
+                        f(IVal(val));
+                    }
+                },
+                arg);
+        }
+    }
+
 private:
     /** @brief stack for arguments */
     std::vector<IValStack> argStack;
@@ -13,10 +13,18 @@
 #ifndef CANGJIE_CHIR_INTERRETER_INTERPREVERVALUE_H
 #define CANGJIE_CHIR_INTERRETER_INTERPREVERVALUE_H
 
+#include <algorithm>
 #include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <utility>
 #include <variant>
 #include <vector>
 
+#include "cangjie/Utils/CheckUtils.h"
+
 namespace Cangjie::CHIR::Interpreter {
 
 struct IInvalid;
@@ -114,6 +122,88 @@ using IValStack = std::variant<
     IFunc // 22
     >;
 
+/**
+ * @brief The elements of tuples, arrays and objects.
+ *
+ * A subset of std::vector<IVal> that takes the size of a pointer: the size and the capacity are stored in front of
+ * the elements, in the same heap block. This makes the aggregates, and thus IVal, smaller, and lets the interpreter
+ * stack hold the elements of an aggregate as a raw pointer to the block (see `Release` and `Adopt`) instead of
+ * allocating a std::vector to move them into.
+ */
+class IValVector {
+public:
+    /** @brief Heap block of a non-empty vector, followed by `capacity` elements. */
+    struct Storage {
+        std::uint32_t size;
+        std::uint32_t capacity;
+    };
+
+    IValVector() = default;
+    IValVector(std::initializer_list<IVal> init);
+    template <typename It> IValVector(It first, It last);
+    IValVector(const IValVector& other);
+    IValVector(IValVector&& other) noexcept : storage(std::exchange(other.storage, nullptr))
+    {
+    }
+    IValVector& operator=(const IValVector& other);
+    IValVector& operator=(IValVector&& other) noexcept;
+    ~IValVector();
+
+    std::size_t size() const
+    {
+        return storage == nullptr ? 0 : storage->size;
+    }
+    bool empty() const
+    {
+        return size() == 0;
+    }
+    std::size_t capacity() const
+    {
+        return storage == nullptr ? 0 : storage->capacity;
+    }
+    std::size_t max_size() const
+    {
+        return std::numeric_limits<std::uint32_t>::max();
+    }
+    IVal* data();
+    const IVal* data() const;
+    IVal* begin();
+    IVal* end();
+    const IVal* begin() const;
+    const IVal* end() const;
+    IVal& operator[](std::size_t i);
+    const IVal& operator[](std::size_t i) const;
+    IVal& back();
+    const IVal& back() const;
+
+    void reserve(std::size_t newCapacity);
+    template <typename... Args> IVal& emplace_back(Args&&... args);
+    void push_back(const IVal& value);
+    void push_back(IVal&& value);
+    void pop_back();
+    void clear();
+
+    /** @brief Give up the ownership of the elements, the vector becomes empty. */
+    Storage* Release()
+    {
+        return std::exchange(storage, nullptr);
+    }
+    /** @brief Take the ownership of `block`, which was returned by `Release`. */
+    static IValVector Adopt(Storage* block)
+    {
+        IValVector res;
+        res.storage = block;
+        return res;
+    }
+    /** @brief Copy the elements of `block`, which was returned by `Release`. */
+    static IValVector CopyOf(const Storage* block);
+    /** @brief The elements of `block`, which was returned by `Release` and mustn't be nullptr. */
+    static const IVal* ElementsOf(const Storage* block);
+
+private:
+    Storage* storage{nullptr};
+};
+
 // Note: in the following structs we are not making the content field const, otherwise
 // operator= becomes deleted. This is being used for instance in InterpreterStack::ArgsSet.
 // In the future we can possibly eliminate this API method if there is a performance gain.
@@ -178,29 +268,198 @@ struct IPointer {
     IVal* content;
 };
 struct ITuple {
-    std::vector<IVal> content;
+    IValVector content;
 };
 struct IArray {
-    std::vector<IVal> content;
+    IValVector content;
 };
 struct IObject {
     std::uint32_t classId;
-    std::vector<IVal> content;
+    IValVector content;
 };
+// the elements released from the IValVector of the aggregate, nullptr if it's empty
 struct ITuplePtr {
-    std::vector<IVal>* contentPtr;
+    IValVector::Storage* contentPtr;
 };
 struct IArrayPtr {
-    std::vector<IVal>* contentPtr;
+    IValVector::Storage* contentPtr;
 };
 struct IObjectPtr {
     std::uint32_t classId;
-    std::vector<IVal>* contentPtr;
+    IValVector::Storage* contentPtr;
 };
 struct IFunc {
     std::size_t content; // program pointer to the function declaration
 };
 
+static_assert(sizeof(IValVector) == sizeof(void*));
+static_assert(alignof(IVal) <= sizeof(IValVector::Storage), "the elements must be aligned after the header");
+
+inline IVal* IValVector::data()
+{
+    return storage == nullptr ? nullptr : reinterpret_cast<IVal*>(storage + 1);
+}
+
+inline const IVal* IValVector::data() const
+{
+    return storage == nullptr ? nullptr : reinterpret_cast<const IVal*>(storage + 1);
+}
+
+inline IVal* IValVector::begin()
+{
+    return data();
+}
+
+inline IVal* IValVector::end()
+{
+    return data() + size();
+}
+
+inline const IVal* IValVector::begin() const
+{
+    return data();
+}
+
+inline const IVal* IValVector::end() const
+{
+    return data() + size();
+}
+
+inline IVal& IValVector::operator[](std::size_t i)
+{
+    return data()[i];
+}
+
+inline const IVal& IValVector::operator[](std::size_t i) const
+{
+    return data()[i];
+}
+
+inline IVal& IValVector::back()
+{
+    return data()[size() - 1];
+}
+
+inline const IVal& IValVector::back() const
+{
+    return data()[size() - 1];
+}
+
+inline void IValVector::reserve(std::size_t newCapacity)
+{
+    if (newCapacity <= capacity()) {
+        return;
+    }
+    // the size and the capacity are stored as 32-bit integers
+    CJC_ASSERT(newCapacity <= max_size());
+    auto block = static_cast<Storage*>(::operator new(sizeof(Storage) + newCapacity * sizeof(IVal)));
+    block->size = static_cast<std::uint32_t>(size());
+    block->capacity = static_cast<std::uint32_t>(newCapacity);
+    auto elems = reinterpret_cast<IVal*>(block + 1);
+    for (std::size_t i = 0; i < block->size; ++i) {
+        new (elems + i) IVal(std::move((*this)[i]));
+    }
+    clear();
+    ::operator delete(storage);
+    storage = block;
+}
+
+template <typename... Args> IVal& IValVector::emplace_back(Args&&... args)
+{
+    IVal* elem = nullptr;
+    if (size() == capacity()) {
+        // the arguments may refer to an element of this vector, so the new element is created before growing
+        IVal value(std::forward<Args>(args)...);
+        // grow by half like most implementations of std::vector
+        CJC_ASSERT(size() < max_size());
+        reserve(capacity() == 0 ? 1 : std::min(capacity() + (capacity() + 1) / 2, max_size()));
+        elem = new (data() + size()) IVal(std::move(value));
+    } else {
+        elem = new (data() + size()) IVal(std::forward<Args>(args)...);
+    }
+    ++storage->size;
+    return *elem;
+}
+
+inline void IValVector::push_back(const IVal& value)
+{
+    (void)emplace_back(value);
+}
+
+inline void IValVector::push_back(IVal&& value)
+{
+    (void)emplace_back(std::move(value));
+}
+
+inline void IValVector::pop_back()
+{
+    back().~IVal();
+    --storage->size;
+}
+
+inline void IValVector::clear()
+{
+    for (auto& elem : *this) {
+        elem.~IVal();
+    }
+    if (storage != nullptr) {
+        storage->size = 0;
+    }
+}
+
+inline const IVal* IValVector::ElementsOf(const Storage* block)
+{
+    return reinterpret_cast<const IVal*>(block + 1);
+}
+
+inline IValVector IValVector::CopyOf(const Storage* block)
+{
+    if (block == nullptr) {
+        return IValVector();
+    }
+    auto elems = ElementsOf(block);
+    return IValVector(elems, elems + block->size);
+}
+
+inline IValVector::IValVector(std::initializer_list<IVal> init) : IValVector(init.begin(), init.end())
+{
+}
+
+template <typename It> IValVector::IValVector(It first, It last)
+{
+    reserve(static_cast<std::size_t>(std::distance(first, last)));
+    for (; first != last; ++first) {
+        (void)emplace_back(*first);
+    }
+}
+
+inline IValVector::IValVector(const IValVector& other) : IValVector(other.begin(), other.end())
+{
+}
+
+inline IValVector& IValVector::operator=(const IValVector& other)
+{
+    if (this != &other) {
+        *this = IValVector(other);
+    }
+    return *this;
+}
+
+inline IValVector& IValVector::operator=(IValVector&& other) noexcept
+{
+    if (this != &other) {
+        // `other` may be an element of this vector, so it's detached before the old elements are destroyed
+        IValVector old = Adopt(std::exchange(storage, std::exchange(other.storage, nullptr)));
+    }
+    return *this;
+}
+
+inline IValVector::~IValVector()
+{
+    clear();
+    ::operator delete(storage);
+}
+
 } // namespace Cangjie::CHIR::Interpreter
 
 #endif // CANGJIE_CHIR_INTERRETER_INTERPREVERVALUE_H
\ No newline at end of file
@@ -171,7 +171,7 @@ struct IValUtils {
 private:
 
     /** @brief Auxiliary printing function */
-    static void PrintVector(const std::vector<IVal>& vec, std::ostream& os);
+    static void PrintVector(const IValVector& vec, std::ostream& os);
     /** @brief Auxiliary printing function */
     static void PrintNonNumeric(const IVal& v, std::ostream& os);
 
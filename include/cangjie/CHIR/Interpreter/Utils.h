@@ -13,6 +13,9 @@
 #ifndef CANGJIE_CHIR_INTERRETER_UTILS_H
 #define CANGJIE_CHIR_INTERRETER_UTILS_H
 
+#include <functional>
+#include <unordered_set>
+
 #include "cangjie/CHIR/Expression/Terminator.h"
 #include "cangjie/CHIR/Interpreter/BCHIR.h"
 #include "cangjie/CHIR/Interpreter/InterpreterValue.h"
@@ -28,6 +31,17 @@ OpCode BinExprKind2OpCode(Cangjie::CHIR::ExprKind exprKind);
 OpCode BinExprKindWitException2OpCode(Cangjie::CHIR::ExprKind exprKind);
 IVal ByteCodeToIval(const Bchir::Definition& def, const Bchir& bchir, Bchir& topBchir);
 
+/** @brief The methods with a body of some types by name, which an INVOKE of the name is assumed to call. */
+using MethodsByName = std::unordered_map<std::string, std::vector<const Func*>>;
+/** @brief Add the methods with a body in the vtable of `def` to `methods`. */
+void CollectMethodsByName(const CustomTypeDef& def, MethodsByName& methods);
+/**
+ * @brief Call `onCallee` on the functions with a body that `expr` may call: its function operands, and all the
+ * `methods` with the name of an INVOKE, unless the name is already in `invokedMethods`, to which it is added.
+ */
+void ForEachCallee(const Expression& expr, const MethodsByName& methods,
+    std::unordered_set<std::string>& invokedMethods, const std::function<void(const Func&)>& onCallee);
+
 template <bool OmitFirstArg = false>
 std::string MangleMethodName(const std::string& methodName, const FuncType& funcTy)
 {
@@ -74,6 +74,22 @@ private:
 };
 
 void FixCastProblemAfterInst(Ptr<BlockGroup> group, CHIRBuilder& builder);
+
+/**
+ * @brief get the mangled name of the copy of the generic callee of @p apply instantiated with its type arguments,
+ * i.e. the type arguments of the parent custom type of the callee followed by the type arguments of the callee.
+ */
+std::string GetInstFuncMangleName(const Apply& apply, CHIRBuilder& builder);
+
+/**
+ * @brief create a copy of the generic callee of @p apply instantiated with the argument and result types of
+ * @p apply. The copy is internal to the current package.
+ * @param apply apply expression to a generic function with a body.
+ * @param mangledName mangled name of the copy, see `GetInstFuncMangleName`.
+ * @param builder CHIR builder for generating IR.
+ * @return the instantiated function.
+ */
+Func* CreateInstFunc(const Apply& apply, const std::string& mangledName, CHIRBuilder& builder);
 }  // namespace Cangjie::CHIR
 
 #endif
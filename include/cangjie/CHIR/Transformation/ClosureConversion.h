@@ -73,6 +73,8 @@ private:
     LocalVar* CreateBoxClassObj(const LocalVar& env, const ClassDef& classDef);
     void ReplaceEnvWithBoxObjMemberVar(LocalVar& env, LocalVar& boxObj, LocalVar& lValue);
     void LiftNestedFunctionWithCFuncType(Lambda& nestedFunc);
+    bool CanElideAutoEnv(const Lambda& func) const;
+    void LiftNonEscapingLambda(Lambda& nestedFunc, const std::vector<Value*>& boxedEnvs);
     std::pair<LocalVar*, LocalVar*> SetBoxClassAsMutableVar(LocalVar& rValue);
     void RecordDuplicateLambdaName(const Lambda& func);
     std::string GenerateGlobalFuncIdentifier(const Lambda& lambda);
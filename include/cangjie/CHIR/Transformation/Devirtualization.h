@@ -9,6 +9,7 @@
 
 #include "cangjie/CHIR/Analysis/AnalysisWrapper.h"
 #include "cangjie/CHIR/Analysis/DevirtualizationInfo.h"
+#include "cangjie/CHIR/Analysis/PGOProfileInfo.h"
 #include "cangjie/CHIR/Analysis/TypeAnalysis.h"
 #include "cangjie/CHIR/Package.h"
 #include "cangjie/CHIR/Value.h"
@@ -33,6 +34,15 @@ public:
         Apply* newApply = nullptr;
     };
 
+    /**
+     * @brief rewrite info if a invoke can be de-virtualized speculatively, i.e. its receiver is one of a few classes.
+     */
+    struct GuardedRewriteInfo {
+        Invoke* invoke;
+        /// receiver classes to be tested in order, and the callee for each of them.
+        std::vector<std::pair<ClassType*, FuncBase*>> guards;
+    };
+
     Devirtualization() = delete;
 
     /**
@@ -50,6 +60,22 @@ public:
      */
     void RunOnFuncs(const std::vector<Func*>& funcs, CHIRBuilder& builder, bool isDebug);
 
+    /**
+     * @brief set the profile used to choose the receivers worth a guarded fast path.
+     * @param pgoProfile profile given by `--pgo-instr-use`, may be null.
+     */
+    void SetProfile(const PGOProfileInfo* pgoProfile);
+
+    /// get functions in which some invokes are rewritten to applies, they may be worth inlining again.
+    const std::vector<Func*>& GetDevirtualizedFuncs() const;
+
+    /**
+     * @brief reuse the instantiated copies of generic functions created by an earlier pass, such as
+     * GenericSpecialization, when a devirtualized call needs the same instantiation.
+     * @param instFuncs copies created by `CreateInstFunc`.
+     */
+    void AddInstFuncs(const std::vector<Func*>& instFuncs);
+
     /**
      * @brief get functions containing invoke expression.
      * @param package user package to optimization.
@@ -74,6 +100,9 @@ public:
 private:
     void RunOnFunc(const Func* func, CHIRBuilder& builder);
 
+    std::vector<std::pair<ClassType*, FuncBase*>> FindGuardedCallees(
+        CHIRBuilder& builder, const TypeValue* typeState, const FuncSig& method, const Func& caller) const;
+
     std::pair<FuncBase*, Type*> FindRealCallee(
         CHIRBuilder& builder, const TypeValue* typeState, const FuncSig& method) const;
 
@@ -84,8 +113,14 @@ private:
     
     void InstantiateFuncIfPossible(CHIRBuilder& builder, std::vector<RewriteInfo>& rewriteInfoList);
     
-    void CollectCandidates(
+    bool CollectCandidates(
         CHIRBuilder& builder, ClassType* specific, std::pair<FuncBase*, Type*>& res, const FuncSig& method) const;
+
+    bool CollectImplementations(CHIRBuilder& builder, ClassType& specific, const FuncSig& method,
+        std::vector<std::pair<Type*, FuncBase*>>& impls) const;
+
+    std::vector<std::pair<ClassType*, FuncBase*>> SelectGuards(
+        const std::vector<std::pair<Type*, FuncBase*>>& impls, CHIRBuilder& builder) const;
     
     FuncBase* GetCandidateFromSpecificType(
         CHIRBuilder& builder, ClassType& specific, const FuncSig& method) const;
@@ -94,6 +129,9 @@ private:
     
     static bool RewriteToBuiltinOp(CHIRBuilder& builder, const RewriteInfo& info, bool isDebug);
 
+    static void RewriteToGuardedApplies(
+        CHIRBuilder& builder, std::vector<GuardedRewriteInfo>& guardedRewriteInfos, bool isDebug);
+
     /**
      * check func whether has invoke expression, implement func for CollectContainInvokeExprFuncs
      */
@@ -102,12 +140,17 @@ private:
     TypeAnalysisWrapper* analysisWrapper;
     DevirtualizationInfo& devirtFuncInfo;
     std::vector<RewriteInfo> rewriteInfos{};
+    std::vector<GuardedRewriteInfo> guardedRewriteInfos{};
+    std::vector<Func*> devirtualizedFuncs;
+    const PGOProfileInfo* profile{nullptr};
 
     // frozen inst functions after devirt, these func need a devirt optimization too after first devirt opt
     std::vector<Func*> frozenInstFuns;
     // extra type state from outside
     std::unordered_map<const Func*, std::unique_ptr<Results<TypeDomain>>> frozenStates;
 
+    // all instantiated copies of generic functions, keyed by `GetInstFuncMangleName`, including those created by
+    // earlier passes, so the same instantiation is never created twice
     std::unordered_map<std::string, Func*> frozenInstFuncMap;
 };
 } // namespace Cangjie::CHIR
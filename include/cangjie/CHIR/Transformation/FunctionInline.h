@@ -13,6 +13,7 @@
 #ifndef CANGJIE_CHIR_TRANSFORMATION_FUNCTION_INLINE_H
 #define CANGJIE_CHIR_TRANSFORMATION_FUNCTION_INLINE_H
 
+#include "cangjie/CHIR/Analysis/PGOProfileInfo.h"
 #include "cangjie/CHIR/CHIRBuilder.h"
 #include "cangjie/CHIR/Expression/Terminator.h"
 #include "cangjie/CHIR/Package.h"
@@ -42,6 +43,27 @@ public:
      */
     void Run(Func& func);
 
+    /**
+     * @brief Use the function hotness in @p profile to adjust the inline threshold of call sites.
+     * @param profile profile read from `--pgo-instr-use`, it must outlive this pass.
+     */
+    void SetProfile(const PGOProfileInfo* profile);
+
+    /**
+     * @brief Limit the total size of inlined functions to a percentage of the size of @p funcs.
+     * @param funcs all the functions this pass will run on.
+     */
+    void SetCodeGrowthBudget(const std::vector<Func*>& funcs);
+
+    /// Record every inline decision, so they can be written by `WriteRemarks`.
+    void EnableRemarks();
+
+    /**
+     * @brief Write the recorded inline decisions to @p path, one JSON object per line.
+     * @return whether the file is written successfully.
+     */
+    bool WriteRemarks(const std::string& path) const;
+
     /**
      * @brief Get effect map after this pass.
      * @return effect map affected by this pass.
@@ -56,7 +78,16 @@ public:
     void DoFunctionInline(const Apply& apply, const std::string& name);
 
 private:
+    /// Information of a call site that is computed before any call in its function is inlined.
+    struct CallSiteInfo {
+        size_t loopDepth{0};
+        bool inExceptionHandler{false};
+    };
+
     bool CheckCanRewrite(const Apply& apply);
+    bool Decide(const Apply& apply, bool inlined, const std::string& reason, size_t size = 0, size_t threshold = 0);
+    size_t GetFuncSize(Func& func);
+    PGOProfileInfo::Hotness GetCallSiteHotness(const Func& callee) const;
     void RecordEffectMap(const Apply& apply);
     void ReplaceFuncResult(LocalVar* resNew, LocalVar* resOld);
 
@@ -73,6 +104,12 @@ private:
     Func* globalFunc{nullptr};
     std::unordered_map<Func*, size_t> inlinedCountMap;
     std::unordered_map<Func*, size_t> funcSizeMap;
+    std::unordered_map<const Apply*, CallSiteInfo> callSiteInfo;
+    const PGOProfileInfo* profile{nullptr};
+    size_t codeGrowthBudget{SIZE_MAX};
+    size_t codeGrowth{0};
+    bool remarksEnabled{false};
+    std::vector<std::string> remarks;
     const std::string optName{"Function Inline"};
     OptEffectCHIRMap effectMap;
 };
@@ -0,0 +1,77 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#ifndef CANGJIE_CHIR_TRANSFORMATION_GENERIC_SPECIALIZATION_H
+#define CANGJIE_CHIR_TRANSFORMATION_GENERIC_SPECIALIZATION_H
+
+#include "cangjie/CHIR/Analysis/PGOProfileInfo.h"
+#include "cangjie/CHIR/CHIRBuilder.h"
+#include "cangjie/CHIR/Package.h"
+
+namespace Cangjie::CHIR {
+/**
+ * CHIR Opt Pass: specialize hot generic functions for concrete value types.
+ * A generic function is compiled once, and its generic parameters and results of value type are boxed. A call to
+ * a generic function with a body in this package, whose arguments or result are of value type where the function
+ * is generic, e.g. `id<Int64>(1)` with `func id<T>(x: T): T` declared in this package, is rewritten to call a copy of
+ * the function instantiated with the types at the call site. Functions of imported packages, such as the methods of
+ * `ArrayList`, have no body here and are left to the instantiation of the frontend. The instantiations are chosen by the number of their call sites, weighted by loop depth
+ * and the hotness of the callers, within a code size budget. The copies are scanned again, so the generic calls
+ * they contain can be specialized too.
+ */
+class GenericSpecialization {
+public:
+    /**
+     * @brief constructor for generic specialization pass.
+     * @param builder CHIR builder for generating IR.
+     * @param isDebug flag whether print debug log.
+     */
+    GenericSpecialization(CHIRBuilder& builder, bool isDebug) : builder(builder), isDebug(isDebug)
+    {
+    }
+
+    /**
+     * @brief Use the function hotness in @p profile to weight the call sites.
+     * @param profile profile read from `--pgo-instr-use`, it must outlive this pass.
+     */
+    void SetProfile(const PGOProfileInfo* profile);
+
+    /**
+     * @brief Main process to specialize generic functions.
+     * @param package package to do optimization.
+     */
+    void RunOnPackage(const Package& package);
+
+    /**
+     * @brief Get the specialized functions created by this pass.
+     * @return specialized functions in creation order.
+     */
+    const std::vector<Func*>& GetSpecializedFuncs() const;
+
+private:
+    /// All the call sites of the same instantiation of a generic function.
+    struct Candidate {
+        std::vector<Apply*> applies;
+        size_t weight{0};
+    };
+
+    void CollectCandidates(const Func& caller, const BlockGroup& blockGroup, size_t outerLoopDepth);
+    void Specialize(const std::string& mangledName, const Candidate& candidate);
+    size_t GetCallerWeight(const Func& caller) const;
+
+    CHIRBuilder& builder;
+    bool isDebug;
+    const PGOProfileInfo* profile{nullptr};
+    size_t budget{0};
+    /// the candidates found by the current round, in the order they are found for a stable output.
+    std::unordered_map<std::string, Candidate> candidates;
+    std::vector<std::string> candidateOrder;
+    std::unordered_map<std::string, Func*> specializedFuncMap;
+    std::vector<Func*> specializedFuncs;
+};
+} // namespace Cangjie::CHIR
+
+#endif
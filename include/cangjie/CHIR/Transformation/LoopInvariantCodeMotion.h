@@ -0,0 +1,39 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#ifndef CANGJIE_CHIR_TRANSFORMATION_LOOP_INVARIANT_CODE_MOTION_H
+#define CANGJIE_CHIR_TRANSFORMATION_LOOP_INVARIANT_CODE_MOTION_H
+
+#include "cangjie/CHIR/Analysis/LoopAnalysis.h"
+#include "cangjie/CHIR/CHIRBuilder.h"
+#include "cangjie/CHIR/Package.h"
+
+namespace Cangjie::CHIR {
+/**
+ * CHIR Opt Pass: hoist loop invariant expressions into the preheader of their loop.
+ * Only expressions that neither write memory nor throw are hoisted, so they can be executed speculatively, besides:
+ * 1. loads from a local variable that does not escape and is not written in the loop;
+ * 2. applies to a function marked with `NO_SIDE_EFFECT` that are executed in every iteration of a loop which
+ *    does not write memory.
+ */
+class LoopInvariantCodeMotion {
+public:
+    /**
+     * @brief Main process to do loop invariant code motion.
+     * @param package package to do optimization.
+     * @param builder CHIR builder for creating the preheaders.
+     * @param isDebug flag whether print debug log.
+     */
+    static void RunOnPackage(const Package& package, CHIRBuilder& builder, bool isDebug);
+
+private:
+    static void RunOnBlockGroup(BlockGroup& blockGroup, CHIRBuilder& builder, bool isDebug);
+    /// return true if the CFG is changed, which invalidates the loop info.
+    static bool RunOnLoop(const NaturalLoop& loop, const LoopInfo& loopInfo, CHIRBuilder& builder, bool isDebug);
+};
+} // namespace Cangjie::CHIR
+
+#endif
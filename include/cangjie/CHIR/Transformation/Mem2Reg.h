@@ -0,0 +1,35 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#ifndef CANGJIE_CHIR_TRANSFORMATION_MEM2REG_H
+#define CANGJIE_CHIR_TRANSFORMATION_MEM2REG_H
+
+#include "cangjie/CHIR/Package.h"
+
+namespace Cangjie::CHIR {
+/**
+ * CHIR Opt Pass: promote local variables to SSA values.
+ * A local variable whose address is only used by `Load` and `Store` in its own block group is promoted:
+ * 1. if it's stored only once, the loads dominated by the store are replaced with the stored value;
+ * 2. otherwise, the loads preceded by a store in the same block are replaced with the value of that store.
+ * The variable is removed once all its loads are replaced.
+ * Blocks of CHIR have no parameters, so a load reached by different stores on different paths is kept.
+ */
+class Mem2Reg {
+public:
+    /**
+     * @brief Main process to promote local variables.
+     * @param package package to do optimization.
+     * @param isDebug flag whether print debug log.
+     */
+    static void RunOnPackage(const Package& package, bool isDebug);
+
+private:
+    static void RunOnBlockGroup(BlockGroup& blockGroup, bool isDebug);
+};
+} // namespace Cangjie::CHIR
+
+#endif
@@ -97,7 +97,24 @@ private:
 
     void RecordEffectMap(const Expression* expr, const Func* func) const;
 
-    void CheckVarrayIndex(const Ptr<Intrinsic>& intrin, const RangeDomain& state) const;
+    /**
+     * Report the indexes of a varray access that are out of bounds, return true if all the indexes are proven
+     * to be in bounds.
+     */
+    bool CheckVarrayIndex(const Ptr<Intrinsic>& intrin, const RangeDomain& state) const;
+
+    /**
+     * This function will rewrite an ARRAY_GET or ARRAY_SET intrinsic whose index is proven to be in bounds
+     * to its unchecked version.
+     */
+    void RemoveArrayBoundsCheck(Intrinsic& intrinsic, bool isDebug) const;
+
+    /**
+     * This function will mark a THROWING integer `+`, `-` or `*`, either a binary expression or an
+     * IntOpWithException, with `NeverOverflowInfo` if the ranges of its operands prove that it never overflows,
+     * so that it is lowered without the overflow check.
+     */
+    void MarkNeverOverflow(Expression& expr, OverflowStrategy ov, const RangeDomain& state, bool isDebug) const;
 
     CHIRBuilder& builder;
     RangeAnalysisWrapper* analysisWrapper;
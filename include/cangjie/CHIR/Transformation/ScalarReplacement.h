@@ -0,0 +1,44 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#ifndef CANGJIE_CHIR_TRANSFORMATION_SCALAR_REPLACEMENT_H
+#define CANGJIE_CHIR_TRANSFORMATION_SCALAR_REPLACEMENT_H
+
+#include "cangjie/CHIR/Analysis/EscapeAnalysis.h"
+#include "cangjie/CHIR/CHIRBuilder.h"
+#include "cangjie/CHIR/Package.h"
+
+namespace Cangjie::CHIR {
+/**
+ * CHIR Opt Pass: replace objects that do not escape with local variables.
+ * 1. A class object that does not escape, and whose fields are only read and written directly, is replaced by one
+ *    local variable per field, so it is no longer allocated on the heap.
+ * 2. A boxed value which is only unboxed back to its original type is replaced by the original value.
+ */
+class ScalarReplacement {
+public:
+    /**
+     * @brief Main process to do scalar replacement.
+     * @param package package to do optimization.
+     * @param builder CHIR builder for creating the local variables.
+     * @param isDebug flag whether print debug log.
+     */
+    static void RunOnPackage(const Package& package, CHIRBuilder& builder, bool isDebug);
+
+    /**
+     * @brief Mark the parameters of reference type proven not to escape with `NO_ESCAPE`, so codegen can tell
+     * the backend that the callee does not capture them.
+     * @param package package to mark.
+     */
+    static void MarkNoEscapeParams(const Package& package);
+
+private:
+    static void RunOnBlockGroup(
+        BlockGroup& blockGroup, const EscapeAnalysis& escapeAnalysis, CHIRBuilder& builder, bool isDebug);
+};
+} // namespace Cangjie::CHIR
+
+#endif
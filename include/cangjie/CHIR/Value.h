@@ -10,6 +10,7 @@
 #include "cangjie/CHIR/AnnoInfo.h"
 #include "cangjie/CHIR/AttributeInfo.h"
 #include "cangjie/CHIR/Base.h"
+#include "cangjie/CHIR/InternedString.h"
 #include "cangjie/CHIR/Type/Type.h"
 #include "cangjie/CHIR/UserDefinedType.h"
 #include "cangjie/Utils/SafePointer.h"
@@ -121,6 +122,10 @@ public:
     virtual std::string GetSrcCodeIdentifier() const;
     const std::string& GetIdentifier() const;
     std::string GetIdentifierWithoutPrefix() const;
+    /**
+     * @brief Get the interned identifier, which can be compared and hashed in O(1).
+     */
+    InternedString GetInternedIdentifier() const;
 
     std::vector<Expression*> GetUsers() const;
 
@@ -163,7 +168,7 @@ protected:
 
 protected:
     Type* ty;                       // variable type
-    std::string identifier;         // variable identifier
+    InternedString identifier;      // variable identifier
     AttributeInfo attributes;       // variable attribute
     std::vector<Expression*> users; // variable users
     std::mutex userMutex;           // mutex for AddUserOnly and RemoveUserOnly
@@ -291,9 +296,9 @@ public:
     void DestroySelf();
 
 protected:
-    std::string packageName; // package where this globalVar defined by user
-    std::string srcCodeIdentifier;                // the name of global variable
-    std::string rawMangledName;                   // rawMangledName, generated by Parser, used by Incremental Compile
+    InternedString packageName;         // package where this globalVar defined by user
+    InternedString srcCodeIdentifier;   // the name of global variable
+    InternedString rawMangledName;      // rawMangledName, generated by Parser, used by Incremental Compile
     CustomTypeDef* declaredParent = nullptr; // e.g. class A { static var x = 1 }
                                                   // `A` is declaredParent of `x`
 
@@ -723,9 +728,9 @@ public:
     virtual void DestroySelf();
 
 protected:
-    std::string srcCodeIdentifier; // origin name
-    std::string rawMangledName;
-    std::string packageName;
+    InternedString srcCodeIdentifier; // origin name
+    InternedString rawMangledName;
+    InternedString packageName;
     CustomTypeDef* declaredParent{nullptr};       // e.g. class A { func foo() {} }
                                                   //      `class A` is declaredParent of `foo`
                                                   // e.g. extend A { func goo() {} }
@@ -59,6 +59,8 @@ private:
 
     std::string optPath;
     std::string llcPath;
+    // the cached objects of this build, either reused or stored
+    std::vector<std::string> usedCachedObjs;
 
     /**
      * @brief Create an instance of a cjnative base tool.
@@ -78,6 +80,8 @@ private:
     std::vector<TempFileInfo> GeneratePreprocessTools(const std::vector<TempFileInfo>& bitCodeFiles);
 
     void PreprocessOfNewPassManager(Tool& tool);
+    void AppendPreprocessOptions(Tool& tool);
+    void AppendCompileOptions(Tool& tool);
     bool ProcessGenerationOfNormalCompile(const std::vector<TempFileInfo>& bitCodeFiles);
     bool ProcessGenerationOfIncrementalNoChangeCompile(const std::vector<TempFileInfo>& bitCodeFiles);
 
@@ -87,6 +91,22 @@ private:
      */
     std::vector<TempFileInfo> GenerateCompileTool(
         const std::vector<TempFileInfo>& bitCodeFiles, bool emitAssembly = false);
+
+    /**
+     * @brief Whether objects of unchanged bitcode files are reused from the content-addressed object cache.
+     */
+    bool IsObjectCacheEnabled() const;
+    std::string GetBackendOptionsFingerprint();
+    std::string GetObjectCachePrefix() const;
+    /**
+     * @brief Generate the tool that removes the least recently used cached objects, after the build succeeds.
+     */
+    void GenerateObjectCacheEvictTool();
+    /**
+     * @brief Like 'opt' + 'llc', but bitcode files whose objects are cached are copied from the cache instead of
+     * being compiled again. The returned object files keep the order of the input bitcode files.
+     */
+    std::vector<TempFileInfo> GenerateCompileToolsWithObjectCache(const std::vector<TempFileInfo>& bitCodeFiles);
 };
 } // namespace Cangjie
 
@@ -0,0 +1,57 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+/**
+ * @file
+ *
+ * This file declares the content-addressed object cache of incremental compilation.
+ */
+
+#ifndef CANGJIE_DRIVER_OBJECT_CACHE_H
+#define CANGJIE_DRIVER_OBJECT_CACHE_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_set>
+
+namespace Cangjie::ObjectCache {
+/**
+ * @brief Limits of the objects kept in the cache. The objects used by the last build are always kept.
+ */
+struct EvictionPolicy {
+    /** @brief objects not used for longer than this many seconds are removed */
+    int64_t maxAge{7 * 24 * 60 * 60};
+    /** @brief the least recently used objects are removed until the cache is below this many bytes */
+    uint64_t maxSize{uint64_t{1} << 30};
+};
+
+/**
+ * @brief Hash the backend options, so that a bitcode file has a different key for every configuration.
+ * @param optionsFingerprint the compiler version and the options of 'opt' and 'llc'.
+ */
+uint64_t HashOptions(const std::string& optionsFingerprint);
+
+/**
+ * @brief Get the cache key of the object compiled from the bitcode file @p bitCodeFile.
+ * The file is read and hashed once.
+ * @return the key, or nullopt if the file can't be read.
+ */
+std::optional<std::string> GetKey(const std::string& bitCodeFile, uint64_t optionsHash);
+
+/**
+ * @brief Remove the cached objects beyond @p policy, least recently used first.
+ * Should run after a successful build, since @p usedObjs are marked as used now.
+ * @param cacheDir directory of the cache.
+ * @param prefix path prefix of the cached objects, the other files of @p cacheDir are left untouched.
+ * @param usedObjs paths of the cached objects used by the build.
+ * @param now current time, in seconds since the epoch.
+ */
+void Evict(const std::string& cacheDir, const std::string& prefix, const std::unordered_set<std::string>& usedObjs,
+    const EvictionPolicy& policy, int64_t now);
+} // namespace Cangjie::ObjectCache
+
+#endif // CANGJIE_DRIVER_OBJECT_CACHE_H
@@ -403,6 +403,8 @@ public:
     // enable incremental compilation
     bool enIncrementalCompilation = false;
     bool printIncrementalInfo = false;
+    // reuse the objects of unchanged sub-modules from a content-addressed cache
+    bool enIncrementalObjectCache = false;
     std::string compilationCachedPath;
 
     // cached path generated with full package name
@@ -560,6 +562,10 @@ public:
 
     bool discardEhFrame = false;
 
+    // Lay out the exhaustive enums mixing reference and value associated values inline. Only takes effect when
+    // reflection is disabled, since the runtime can't read such enums through reflection.
+    bool enableEnumInlineLayout = false;
+
     // Control link mode of std module.
     // The 'linkStaticStd' is 'true' when cjc uses '--static-std' link option.
     // The 'linkStaticStd' is 'false' when cjc uses '--dy-std' link option.
@@ -703,6 +709,8 @@ public:
     bool interpMainNoLinkage = false;
     bool interpCHIR = false;
     bool constEvalDebug = false;
+    size_t constEvalMemoryLimit = 1024; /**< Memory limit of const evaluation in MiB. */
+    size_t constEvalStepLimit = 100000000; /**< Limit on the number of jumps and calls run by const evaluation. */
 #ifdef CANGJIE_CODEGEN_CJNATIVE_BACKEND
     bool computeAnnotationsDebug{false}; // --debug-annotations
 #endif
@@ -710,6 +718,7 @@ public:
     bool disableDeserializer = false;
 
     bool chirDebugOptimizer = false;
+    std::string chirInlineRemarksFile; /**< Write inline decisions of CHIR to this file if it's not empty. */
 
     enum class CHIRMode : uint8_t { NA, STANDARD, WITH_ID, ALL };
 
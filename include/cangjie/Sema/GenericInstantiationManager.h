@@ -52,6 +52,11 @@ public:
      */
     void ResetGenericInstantiationStage() const;
     std::unordered_map<Ptr<const AST::Decl>, std::unordered_set<Ptr<AST::Decl>>> GetAllGenericToInsDecls() const;
+    /**
+     * Get the instantiations of imported packages which are referenced by current package instead of being
+     * instantiated again, in the order they are first used.
+     */
+    const std::vector<Ptr<AST::FuncDecl>>& GetReusedInstantiations() const;
 
     friend class MockUtils;
 
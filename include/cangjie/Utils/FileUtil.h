@@ -210,6 +210,21 @@ bool ReadBinaryFileToBuffer(const std::string& filePath, std::vector<uint8_t>& b
  */
 size_t GetFileSize(const std::string& filePath);
 
+/**
+ * Get the last modification time of a file.
+ * @param filePath Path to the file.
+ * @return seconds since the epoch, or nullopt if the file can't be accessed.
+ */
+std::optional<int64_t> GetFileModifiedTime(const std::string& filePath);
+
+/**
+ * Set the last access and modification time of a file.
+ * @param filePath Path to the file.
+ * @param time seconds since the epoch.
+ * @return whether func invoked successfully.
+ */
+bool SetFileModifiedTime(const std::string& filePath, int64_t time);
+
 /**
  * Read file and return its content.
  * @param[in] filePath String like "path/file.extension".
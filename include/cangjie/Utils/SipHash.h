@@ -10,6 +10,8 @@
 #include "cangjie/Utils/CheckUtils.h"
 #include <bitset>
 #include <climits>
+#include <string>
+#include <vector>
 
 namespace Cangjie::Utils {
 
@@ -39,6 +41,10 @@ public:
     {
         return GetHashValue(std::string{data});
     }
+    static uint64_t GetHashValue(const std::vector<uint8_t>& data)
+    {
+        return SipHash_2_4(data.data(), data.size());
+    }
 
 private:
     static const uint64_t k0_ = 0xdeadbeef;
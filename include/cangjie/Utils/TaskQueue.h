@@ -13,12 +13,16 @@
 #ifndef CANGJIE_UTILS_TASKQUEUE_H
 #define CANGJIE_UTILS_TASKQUEUE_H
 
-#include <functional>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <future>
+#include <memory>
 #include <mutex>
-#include <queue>
-#include <thread>
+#include <type_traits>
+#include <vector>
 #include "cangjie/Utils/CheckUtils.h"
+#include "cangjie/Utils/ThreadPool.h"
 
 namespace Cangjie::Utils {
 
@@ -26,13 +30,16 @@ template <typename TRes> using TaskResult = std::future<TRes>;
 
 struct Task {
 public:
-    template <typename F> explicit Task(F&& fn, uint64_t priority) : fn(std::forward<F>(fn)), priority(priority)
+    template <typename TRes, typename F> static Task Create(F&& fn, uint64_t priority, TaskResult<TRes>& res)
     {
+        auto impl = std::make_unique<TaskImpl<TRes, std::decay_t<F>>>(std::forward<F>(fn));
+        res = impl->promise.get_future();
+        return Task(std::move(impl), priority);
     }
 
     void operator()() const
     {
-        fn();
+        impl->Run();
     }
 
     bool operator<(const Task& other) const
@@ -41,7 +48,43 @@ public:
     }
 
 private:
-    std::function<void()> fn;
+    struct TaskBase {
+        virtual ~TaskBase() = default;
+        virtual void Run() = 0;
+    };
+
+    // The function and the promise of its result live in one allocation.
+    template <typename TRes, typename F> struct TaskImpl final : public TaskBase {
+        explicit TaskImpl(F&& fn) : fn(std::move(fn))
+        {
+        }
+        explicit TaskImpl(const F& fn) : fn(fn)
+        {
+        }
+
+        void Run() override
+        {
+            try {
+                if constexpr (std::is_void_v<TRes>) {
+                    fn();
+                    promise.set_value();
+                } else {
+                    promise.set_value(fn());
+                }
+            } catch (...) {
+                promise.set_exception(std::current_exception());
+            }
+        }
+
+        F fn;
+        std::promise<TRes> promise;
+    };
+
+    Task(std::unique_ptr<TaskBase>&& impl, uint64_t priority) : impl(std::move(impl)), priority(priority)
+    {
+    }
+
+    std::unique_ptr<TaskBase> impl;
     uint64_t priority; /**< A larger value indicates a higher priority. **/
 };
 
@@ -51,10 +94,11 @@ private:
  * of the queue from the task queue to execute. This means tasks with
  * higher weights can always be executed with higher priority.
  *
- * Note that **adding tasks** and **executing tasks** are phased and it
- * is not allowed to add tasks again after TaskQueue starts to execute.
- * Therefore, make sure all tasks have been added before TaskQueue is
- * executed. Otherwise, unintended behavior may occur.
+ * The queue does not own threads. Running it submits at most `threadsNum`
+ * drainers to the process-wide ThreadPool, and the thread waiting for the
+ * queue takes part in draining it, so a TaskQueue can be created and run
+ * inside a task of another TaskQueue. Tasks may also be added while the
+ * queue is running, e.g. a task can spawn subtasks into its own queue.
  *
  * @tparam TRes The type of task result
  */
@@ -70,94 +114,127 @@ public:
 
     ~TaskQueue()
     {
-        threads.clear();
+        WaitForAllTasksCompleted();
     }
 
     /**
-     * Add a task into the queue. This is not a concurrency-safe method.
+     * Add a task into the queue. This is a concurrency-safe method and can
+     * be called while the queue is running.
      * @tparam TRes The result type of the task.
      * @param fn Function to be executed by the task.
      * @param priority Priority of the task.
      * @return A place where stores the result of the task.
      */
-    template <typename TRes> TaskResult<TRes> AddTask(const std::function<TRes()>& fn, uint64_t priority = 0U)
+    template <typename TRes, typename F> TaskResult<TRes> AddTask(F&& fn, uint64_t priority = 0U)
     {
-        CJC_ASSERT(!isStarted && "Do not add new tasks while executing.");
-        auto task = std::make_shared<std::packaged_task<TRes()>>(fn);
-        TaskResult<TRes> res = task->get_future();
-        tasks.emplace([task]() mutable { (*task)(); }, priority);
+        TaskResult<TRes> res;
+        std::unique_lock<std::mutex> lock(mutex);
+        tasks.emplace_back(Task::Create<TRes>(std::forward<F>(fn), priority, res));
+        std::push_heap(tasks.begin(), tasks.end());
+        if (isStarted) {
+            ScheduleDrainers(lock, threadsNum);
+        }
         return res;
     }
 
     /**
-     * Create threads and start executing tasks in the queue asynchronously
-     * in the background.
+     * Start executing tasks in the queue asynchronously in the background.
      */
     void RunInBackground()
     {
+        std::unique_lock<std::mutex> lock(mutex);
         if (tasks.empty()) {
             return;
         }
-        CreateThreads();
+        isStarted = true;
+        ThreadPool::Get().Reserve(threadsNum);
+        ScheduleDrainers(lock, threadsNum);
     }
 
     /**
-     * Waiting for all threads to complete the tasks.
+     * Waiting for all tasks to complete. The calling thread executes tasks
+     * of this queue while it waits, and a pool worker also executes other
+     * pending jobs of the pool.
      */
     void WaitForAllTasksCompleted()
     {
-        for (auto& thread : threads) {
-            if (thread.joinable()) {
-                thread.join();
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!isStarted) {
+            return;
+        }
+        while (!tasks.empty() || drainers > 0) {
+            if (!tasks.empty() && drainers < threadsNum) {
+                ++drainers;
+                lock.unlock();
+                Drain();
+                lock.lock();
+            } else if (!ThreadPool::IsWorkerThread()) {
+                allDone.wait(lock, [this] { return drainers == 0; });
+            } else {
+                // A pool worker must not block here: the drainers we are waiting for may be queued behind us.
+                lock.unlock();
+                bool helped = ThreadPool::Get().RunPendingJob();
+                lock.lock();
+                if (!helped && drainers > 0) {
+                    constexpr auto pollInterval = std::chrono::milliseconds(1);
+                    (void)allDone.wait_for(lock, pollInterval);
+                }
             }
         }
-        threads.clear();
     }
 
     /**
-     * Create threads to start asynchronously executing tasks in the queue and
-     * waiting for all threads to complete the tasks.
-     * Note: it will block the main thread.
+     * Start executing tasks in the queue and wait for all of them to complete.
+     * Note: it will block the calling thread, which executes tasks as well.
      */
     void RunAndWaitForAllTasksCompleted()
     {
-        if (tasks.empty()) {
-            return;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (tasks.empty()) {
+                return;
+            }
+            isStarted = true;
+            // The calling thread is one of the drainers, see `WaitForAllTasksCompleted`.
+            ThreadPool::Get().Reserve(threadsNum - 1);
+            ScheduleDrainers(lock, threadsNum - 1);
         }
-        CreateThreads();
         WaitForAllTasksCompleted();
     }
 
 private:
-    void CreateThreads()
+    // Submit drainers to the pool until there are `limit` of them or one per pending task.
+    void ScheduleDrainers(const std::unique_lock<std::mutex>&, size_t limit)
     {
-        isStarted = true;
-        auto fixedThreadsNum = std::min(tasks.size(), threadsNum);
-        for (size_t threadIdx = 0; threadIdx < fixedThreadsNum; ++threadIdx) {
-            (void)threads.emplace_back([this] { DoTask(); });
+        auto expected = std::min(tasks.size(), limit);
+        for (; drainers < expected; ++drainers) {
+            ThreadPool::Get().Submit([this] { Drain(); });
         }
     }
 
-    void DoTask()
+    void Drain()
     {
-        // Once the thread is idle, it selects the task at the head of the queue to execute.
-        while (true) {
-            std::unique_lock<std::mutex> lock(mutex);
-            // No remaining tasks. Thread exits polling.
-            if (tasks.empty()) {
-                return;
-            }
-            Task task = tasks.top();
-            tasks.pop();
+        // The drainer selects the task at the head of the queue to execute until the queue is empty.
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!tasks.empty()) {
+            std::pop_heap(tasks.begin(), tasks.end());
+            Task task = std::move(tasks.back());
+            tasks.pop_back();
             lock.unlock();
             task();
+            lock.lock();
+        }
+        CJC_ASSERT(drainers > 0);
+        if (--drainers == 0) {
+            allDone.notify_all();
         }
     }
 
-    std::priority_queue<Task> tasks;
+    std::vector<Task> tasks; /**< A max-heap ordered by task priority. **/
     std::mutex mutex;
+    std::condition_variable allDone;
     size_t threadsNum;
-    std::vector<std::thread> threads;
+    size_t drainers{0}; /**< Number of drainers scheduled or running. **/
     bool isStarted = false;
 };
 } // namespace Cangjie::Utils
@@ -0,0 +1,104 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+/**
+ * @file
+ *
+ * This file declares the process-wide work-stealing ThreadPool shared by all TaskQueues.
+ */
+
+#ifndef CANGJIE_UTILS_THREADPOOL_H
+#define CANGJIE_UTILS_THREADPOOL_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Cangjie::Utils {
+/**
+ * A persistent pool of worker threads. Threads are created lazily the first time a caller asks for
+ * them and then live until the process exits, so phases running one TaskQueue after another reuse
+ * the same threads instead of spawning new ones.
+ *
+ * Every worker owns a deque: jobs submitted from a worker are pushed to the back of its own deque
+ * and popped LIFO by that worker, idle workers steal from the front of the others' deques, and jobs
+ * submitted from outside the pool go to a shared injection queue. A thread that has to wait for
+ * other jobs should call `RunPendingJob` instead of blocking, which is what makes nested parallelism
+ * (a job that itself runs a TaskQueue) safe.
+ */
+class ThreadPool {
+public:
+    using Job = std::function<void()>;
+
+    static ThreadPool& Get();
+
+    /**
+     * Make sure the pool has at least @p threadsNum workers (capped by `MAX_WORKERS`).
+     */
+    void Reserve(size_t threadsNum);
+
+    /**
+     * Schedule @p job to be executed by some worker.
+     */
+    void Submit(Job&& job);
+
+    /**
+     * Execute one pending job on the calling thread, if any.
+     * @return false if there was no job to execute.
+     */
+    bool RunPendingJob();
+
+    /**
+     * Whether the calling thread is one of the pool workers.
+     */
+    static bool IsWorkerThread();
+
+    size_t GetWorkersNum() const
+    {
+        return workersNum.load(std::memory_order_acquire);
+    }
+
+    static constexpr size_t MAX_WORKERS = 256;
+
+private:
+    struct Worker {
+        std::mutex mtx;
+        std::deque<Job> jobs;
+    };
+
+    ThreadPool() = default;
+    ~ThreadPool();
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    void WorkerLoop(size_t index);
+    bool TakeJob(size_t selfIndex, Job& job);
+    void NotifyOne();
+
+    std::array<std::unique_ptr<Worker>, MAX_WORKERS> workers;
+    std::atomic<size_t> workersNum{0};
+    std::vector<std::thread> threads;
+    std::mutex growMtx;
+
+    std::mutex injectMtx;
+    std::deque<Job> injected;
+
+    // Workers with nothing to do sleep on `wakeUp` until `pendingJobs` becomes positive.
+    std::mutex sleepMtx;
+    std::condition_variable wakeUp;
+    std::atomic<size_t> pendingJobs{0};
+    bool stopping{false};
+};
+} // namespace Cangjie::Utils
+#endif
@@ -246,14 +246,13 @@ void InvertedIndex::Reset()
     scopeGateMap.clear();
     scopeLevelIndexes.clear();
     astKindIndexes.clear();
-    nameTrie->Reset();
-    scopeNameTrie->Reset(TOPLEVEL_SCOPE_NAME);
-    astKindTrie->Reset();
+    sortedNames.Reset();
+    sortedScopeNames.Reset(TOPLEVEL_SCOPE_NAME);
+    sortedASTKinds.Reset();
     for (auto& kindString : AST::ASTKIND_TO_STRING_MAP) {
-        astKindTrie->Insert(kindString.second);
+        sortedASTKinds.Insert(kindString.second);
     }
-    posBeginTrie->Reset();
-    posEndTrie->Reset();
+    posIndex.Reset();
 }
 
 void InvertedIndex::Index(AST::Symbol* symbol, bool withTrie)
@@ -270,9 +269,8 @@ void InvertedIndex::Index(AST::Symbol* symbol, bool withTrie)
     scopeLevelIndexes[symbol->scopeLevel].insert(symbol->id);
     astKindIndexes[AST::ASTKIND_TO_STRING_MAP[symbol->astKind]].insert(symbol->id);
     if (withTrie) {
-        nameTrie->Insert(symbol->name, *symbol->id);
-        posBeginTrie->Insert(PosSearchApi::PosToStr(symbol->node->begin), *symbol->id);
-        posEndTrie->Insert(PosSearchApi::PosToStr(symbol->node->end), *symbol->id);
+        sortedNames.Insert(symbol->name);
+        posIndex.Insert(*symbol->id);
     }
 }
 
@@ -292,9 +290,7 @@ void InvertedIndex::Delete(AST::Symbol* symbol)
     }
     scopeLevelIndexes[symbol->scopeLevel].erase(symbol);
     astKindIndexes[AST::ASTKIND_TO_STRING_MAP[symbol->astKind]].erase(symbol);
-    nameTrie->Delete(symbol->name, *symbol);
-    posBeginTrie->Delete(PosSearchApi::PosToStr(symbol->node->begin), *symbol);
-    posEndTrie->Delete(PosSearchApi::PosToStr(symbol->node->end), *symbol);
+    posIndex.Delete(*symbol);
     symbol->invertedIndexBeenDeleted = true;
 }
 
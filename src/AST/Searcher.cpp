@@ -12,6 +12,7 @@
 
 #include "cangjie/AST/Searcher.h"
 
+#include <limits>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -48,206 +49,179 @@ std::string NormalizeQuery(const Query& query, const Order& order)
 }
 } // namespace
 
-void Trie::Insert(const std::string& value)
+void StringIndex::Insert(const std::string& value)
 {
-    TrieNode* n = root.get();
-    for (unsigned i = 0; i < value.size(); ++i) {
-        if (n->next.find(value[i]) == n->next.end()) {
-            n->next.emplace(value[i], std::make_unique<TrieNode>(value[i]));
-        }
-        n = n->next[value[i]].get();
-        n->prefix = value.substr(0, i + 1);
-        n->suffixes.insert(value.substr(i + 1));
+    if (!value.empty()) {
+        values.emplace(value);
     }
-    n->value = value;
 }
 
-void Trie::Insert(const std::string& value, Symbol& id)
+std::vector<std::string> StringIndex::PrefixMatch(const std::string& prefix) const
 {
-    TrieNode* n = root.get();
-    for (unsigned i = 0; i < value.size(); ++i) {
-        if (n->next.find(value[i]) == n->next.end()) {
-            n->next.emplace(value[i], std::make_unique<TrieNode>(value[i]));
-        }
-        auto next = n->next[value[i]].get();
-        next->depth = n->depth + 1;
-        next->parent = n;
-        next->ids.insert(&id);
-        n = next;
-        n->prefix = value.substr(0, i + 1);
-        n->suffixes.insert(value.substr(i + 1));
+    std::vector<std::string> matches;
+    for (auto it = values.lower_bound(prefix); it != values.end() && it->compare(0, prefix.size(), prefix) == 0;
+         ++it) {
+        matches.push_back(*it);
     }
-    n->value = value;
+    return matches;
 }
 
-void Trie::Delete(const std::string& value, Symbol& id)
+std::vector<std::string> StringIndex::SuffixMatch(const std::string& suffix) const
 {
-    TrieNode* n = root.get();
-    for (char i : value) {
-        if (n->next.empty()) {
-            return;
+    std::vector<std::string> matches;
+    for (auto& value : values) {
+        if (value.size() > suffix.size() &&
+            value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0) {
+            matches.push_back(value);
         }
-        auto next = n->next[i].get();
-        next->ids.erase(&id);
-        n = next;
     }
+    return matches;
 }
 
-TrieNode* Trie::GetPrefixRootNode(const std::string& prefix) const
+namespace {
+template <typename Key> Key ToKey(const Position& pos)
 {
-    TrieNode* n = root.get();
-    for (auto c : prefix) {
-        TrieNode::Next::const_iterator found = n->next.find(c);
-        if (found == n->next.end()) {
-            return nullptr;
-        }
-        n = found->second.get();
-    }
-    return n;
+    return Key{pos.fileID, pos.line, pos.column};
 }
 
-std::vector<std::string> Trie::PrefixMatch(const std::string& prefix) const
+template <typename Key> Key FileBegin(const Position& pos)
 {
-    std::vector<std::string> matches;
-    auto prefixRoot = GetPrefixRootNode(prefix);
-    std::function<void(TrieNode*)> walk = [&matches, &walk](TrieNode* n) {
-        if (!n) {
-            return;
-        }
-        if (!n->value.empty()) {
-            matches.push_back(n->value);
-        }
-        for (auto& i : std::as_const(n->next)) {
-            walk(i.second.get());
-        }
-    };
-    walk(prefixRoot);
-    return matches;
+    return Key{pos.fileID, std::numeric_limits<int>::min(), std::numeric_limits<int>::min()};
 }
 
-std::vector<std::string> Trie::SuffixMatch(const std::string& suffix) const
+template <typename Key> Key FileEnd(const Position& pos)
 {
-    std::vector<std::string> matches;
-    std::function<void(TrieNode*)> walk = [&suffix, &matches, &walk](TrieNode* n) {
-        if (!n) {
-            return;
-        }
-        if (n->suffixes.find(suffix) != n->suffixes.cend()) {
-            matches.push_back(n->prefix + suffix);
-        }
-        for (auto& i : std::as_const(n->next)) {
-            walk(i.second.get());
-        }
-    };
-    walk(root.get());
-    return matches;
+    return Key{pos.fileID, std::numeric_limits<int>::max(), std::numeric_limits<int>::max()};
 }
 
-std::string PosSearchApi::PosToStr(const Position& pos)
+Symbol* GetID(const std::pair<std::tuple<unsigned int, int, int>, Symbol*>& value)
 {
-    std::string ret = FillZero(static_cast<int>(pos.fileID), MAX_DIGITS_FILE);
-    ret += FillZero(pos.line, MAX_DIGITS_LINE);
-    ret += FillZero(pos.column, MAX_DIGITS_COLUMN);
-    return ret;
+    return value.second;
 }
 
-TrieNode* PosSearchApi::FindCommonRootInPosTrie(const Trie& posTrie, const Position& pos)
+Symbol* GetID(Symbol* value)
 {
-    std::string posStr = PosToStr(pos);
-    TrieNode* n = posTrie.root.get();
-    for (auto c : posStr) {
-        TrieNode::Next::const_iterator found = n->next.find(c);
-        if (found == n->next.cend()) {
-            return n;
-        }
-        n = found->second.get();
-    }
-    return n;
+    return value;
 }
 
-TrieNode* PosSearchApi::FindCommonRootInPosTrie(const Trie& posTrie, const std::string& pos)
+// Get the IDs of the entries of @p index in the file of @p pos which are after it, or at it if @p isClose.
+template <typename Index>
+std::set<Symbol*> GetIDsAfter(const Index& index, const Position& pos, bool isClose)
 {
-    TrieNode* n = posTrie.root.get();
-    for (auto c : pos) {
-        TrieNode::Next::const_iterator found = n->next.find(c);
-        if (found == n->next.cend()) {
-            return n;
-        }
-        n = found->second.get();
+    using Key = typename Index::key_type;
+    auto first = isClose ? index.lower_bound(ToKey<Key>(pos)) : index.upper_bound(ToKey<Key>(pos));
+    auto last = index.upper_bound(FileEnd<Key>(pos));
+    std::set<Symbol*> ids;
+    for (auto it = first; it != last; ++it) {
+        ids.emplace(GetID(it->second));
     }
-    return n;
+    return ids;
 }
 
-std::set<Symbol*> PosSearchApi::GetIDsGreaterThanPos(const Trie& posTrie, const Position& pos, bool isClose)
+// Get the IDs of the entries of @p index in the file of @p pos which are before it, or at it if @p isClose.
+template <typename Index>
+std::set<Symbol*> GetIDsBefore(const Index& index, const Position& pos, bool isClose)
 {
-    std::string posStr = PosToStr(pos);
-    TrieNode* n = FindCommonRootInPosTrie(posTrie, posStr);
-    TrieNode::Next::const_iterator startIter;
+    using Key = typename Index::key_type;
+    auto first = index.lower_bound(FileBegin<Key>(pos));
+    auto last = isClose ? index.upper_bound(ToKey<Key>(pos)) : index.lower_bound(ToKey<Key>(pos));
     std::set<Symbol*> ids;
-    while (n->depth > MAX_DIGITS_FILE) {
-        if (n->depth == MAX_DIGITS_POSITION) {
-            n = n->parent;
-            continue;
-        }
-        if (isClose) {
-            startIter = n->next.lower_bound(posStr[n->depth]);
-            isClose = false;
-        } else {
-            startIter = n->next.upper_bound(posStr[n->depth]);
-        }
-        for (auto it = startIter; it != n->next.end(); ++it) {
-            ids = Searcher::Union(ids, it->second->ids);
-        }
-        n = n->parent;
+    for (auto it = first; it != last; ++it) {
+        ids.emplace(GetID(it->second));
     }
     return ids;
 }
 
-void PosSearchApi::GetIDsLessThanPosOfDepth(
-    TrieNode& n, const std::string& posStr, std::set<Symbol*>& ids, bool& isClose)
+template <typename Index> void EraseID(Index& index, const typename Index::key_type& key, const Symbol& id)
 {
-    auto endIter = n.next.lower_bound(posStr[n.depth]);
-    if (endIter != n.next.cend()) {
-        if (isClose) {
-            if (endIter->first == posStr[n.depth]) {
-                ++endIter;
-            }
-            isClose = false;
+    auto [first, last] = index.equal_range(key);
+    for (auto it = first; it != last; ++it) {
+        if (GetID(it->second) == &id) {
+            index.erase(it);
+            return;
         }
     }
-    for (auto it = n.next.cbegin(); it != endIter; ++it) {
-        ids = Searcher::Union(ids, it->second->ids);
-    }
+}
+} // namespace
+
+void PosIndex::Reset()
+{
+    byBegin.clear();
+    byEnd.clear();
+}
+
+void PosIndex::Insert(Symbol& id)
+{
+    auto end = ToKey<Key>(id.node->end);
+    byBegin.emplace(ToKey<Key>(id.node->begin), std::make_pair(end, &id));
+    byEnd.emplace(end, &id);
+}
+
+void PosIndex::Delete(Symbol& id)
+{
+    EraseID(byBegin, ToKey<Key>(id.node->begin), id);
+    EraseID(byEnd, ToKey<Key>(id.node->end), id);
+}
+
+std::set<Symbol*> PosIndex::GetIDsBeginAfter(const Position& pos, bool isClose) const
+{
+    return GetIDsAfter(byBegin, pos, isClose);
 }
 
-std::set<Symbol*> PosSearchApi::GetIDsLessThanPos(const Trie& posTrie, const Position& pos, bool isClose)
+std::set<Symbol*> PosIndex::GetIDsBeginBefore(const Position& pos, bool isClose) const
+{
+    return GetIDsBefore(byBegin, pos, isClose);
+}
+
+std::set<Symbol*> PosIndex::GetIDsBeginWithin(
+    const Position& startPos, const Position& endPos, bool isLeftClose, bool isRightClose) const
 {
-    std::string posStr = PosToStr(pos);
-    TrieNode* n = FindCommonRootInPosTrie(posTrie, posStr);
     std::set<Symbol*> ids;
-    while (n->depth > MAX_DIGITS_FILE) {
-        if (n->depth == MAX_DIGITS_POSITION) {
-            n = n->parent;
-            continue;
-        }
-        GetIDsLessThanPosOfDepth(*n, posStr, ids, isClose);
-        n = n->parent;
+    if (endPos.fileID != startPos.fileID || endPos <= startPos) {
+        return ids;
+    }
+    auto first = isLeftClose ? byBegin.lower_bound(ToKey<Key>(startPos)) : byBegin.upper_bound(ToKey<Key>(startPos));
+    auto last = isRightClose ? byBegin.upper_bound(ToKey<Key>(endPos)) : byBegin.lower_bound(ToKey<Key>(endPos));
+    for (auto it = first; it != last; ++it) {
+        ids.emplace(it->second.second);
     }
     return ids;
 }
 
-std::set<Symbol*> PosSearchApi::GetIDsWithinPosXByRange(
-    const Trie& posTrie, const Position& startPos, const Position& endPos, bool isLeftClose, bool isRightClose)
+std::set<Symbol*> PosIndex::GetIDsEndBefore(const Position& pos, bool isClose) const
+{
+    return GetIDsBefore(byEnd, pos, isClose);
+}
+
+bool PosIndex::HasIDsEndAfter(const Position& pos, bool isClose) const
 {
+    auto first = isClose ? byEnd.lower_bound(ToKey<Key>(pos)) : byEnd.upper_bound(ToKey<Key>(pos));
+    return first != byEnd.upper_bound(FileEnd<Key>(pos));
+}
+
+std::set<Symbol*> PosIndex::GetIDsContaining(const Position& pos, bool isLeftClose, bool isRightClose) const
+{
+    auto key = ToKey<Key>(pos);
+    auto first = byBegin.lower_bound(FileBegin<Key>(pos));
+    auto last = isLeftClose ? byBegin.upper_bound(key) : byBegin.lower_bound(key);
     std::set<Symbol*> ids;
-    if (endPos <= startPos) {
-        return ids;
+    for (auto it = first; it != last; ++it) {
+        auto& end = it->second.first;
+        if (key < end || (isRightClose && key == end)) {
+            ids.emplace(it->second.second);
+        }
     }
-    ids = GetIDsGreaterThanPos(posTrie, startPos, isLeftClose);
-    ids = Searcher::Intersection(ids, GetIDsLessThanPos(posTrie, endPos, isRightClose));
     return ids;
 }
 
+std::string PosSearchApi::PosToStr(const Position& pos)
+{
+    std::string ret = FillZero(static_cast<int>(pos.fileID), MAX_DIGITS_FILE);
+    ret += FillZero(pos.line, MAX_DIGITS_LINE);
+    ret += FillZero(pos.column, MAX_DIGITS_COLUMN);
+    return ret;
+}
+
 // Used for sort function, caller guarantees symbol inputs are not nullptr.
 Order Sort::posAsc = [](const Symbol* a, const Symbol* b) noexcept {
     CJC_ASSERT(a && b);
@@ -351,7 +325,7 @@ std::set<Symbol*> Searcher::GetIDsByName(const ASTContext& ctx, const std::strin
 std::set<Symbol*> Searcher::GetIDsByNamePrefix(const ASTContext& ctx, const std::string& prefix) const
 {
     std::set<Symbol*> ids;
-    std::vector<std::string> names = ctx.invertedIndex.nameTrie->PrefixMatch(prefix);
+    std::vector<std::string> names = ctx.invertedIndex.sortedNames.PrefixMatch(prefix);
     for (std::string& name : names) {
         ids = Union(ids, GetIDsByName(ctx, name));
     }
@@ -361,7 +335,7 @@ std::set<Symbol*> Searcher::GetIDsByNamePrefix(const ASTContext& ctx, const std:
 std::set<Symbol*> Searcher::GetIDsByNameSuffix(const ASTContext& ctx, const std::string& suffix) const
 {
     std::set<Symbol*> ids;
-    std::vector<std::string> names = ctx.invertedIndex.nameTrie->SuffixMatch(suffix);
+    std::vector<std::string> names = ctx.invertedIndex.sortedNames.SuffixMatch(suffix);
     for (std::string& name : names) {
         ids = Union(ids, GetIDsByName(ctx, name));
     }
@@ -391,7 +365,7 @@ void Searcher::InvalidateCacheBut(const std::string& query)
 
 std::vector<std::string> Searcher::GetScopeNamesByPrefix(const ASTContext& ctx, const std::string& prefix) const
 {
-    return ctx.invertedIndex.scopeNameTrie->PrefixMatch(prefix);
+    return ctx.invertedIndex.sortedScopeNames.PrefixMatch(prefix);
 }
 
 std::set<Symbol*> Searcher::GetIDsByScopeLevel(const ASTContext& ctx, uint32_t scopeLevel) const
@@ -416,25 +390,19 @@ std::set<Symbol*> Searcher::GetIDsByASTKind(const ASTContext& ctx, const std::st
 
 std::vector<std::string> Searcher::GetAstKindsBySuffix(const ASTContext& ctx, const std::string& suffix) const
 {
-    return ctx.invertedIndex.astKindTrie->SuffixMatch(suffix);
+    return ctx.invertedIndex.sortedASTKinds.SuffixMatch(suffix);
 }
 
 std::set<Symbol*> Searcher::GetIDsByPosEQ(
     const ASTContext& ctx, const Position& pos, bool isLeftClose, bool isRightClose) const
 {
     // Equivalent to finding symbol n whose position meets n->node->begin <= pos && pos < n->node->end.
-    std::set<Symbol*> ids;
-    if (ctx.invertedIndex.posBeginTrie != nullptr) {
-        ids = PosSearchApi::GetIDsLessThanPos(*ctx.invertedIndex.posBeginTrie, pos, isLeftClose);
-    }
-    std::set<Symbol*> ids1;
-    if (ctx.invertedIndex.posEndTrie != nullptr) {
-        ids1 = PosSearchApi::GetIDsGreaterThanPos(*ctx.invertedIndex.posEndTrie, pos, isRightClose);
-    }
-    if (!ids1.empty()) {
-        return Intersection(ids, ids1);
+    auto& posIndex = ctx.invertedIndex.posIndex;
+    if (posIndex.HasIDsEndAfter(pos, isRightClose)) {
+        return posIndex.GetIDsContaining(pos, isLeftClose, isRightClose);
     }
     // We use scope_level to filter the node contain the pos.
+    std::set<Symbol*> ids = posIndex.GetIDsBeginBefore(pos, isLeftClose);
     if (ids.empty()) {
         return {};
     }
@@ -454,10 +422,7 @@ std::set<Symbol*> Searcher::GetIDsByPosEQ(
 std::set<Symbol*> Searcher::GetIDsByPosLT(const ASTContext& ctx, const Position& pos, bool contain) const
 {
     // Equivalent to finding symbol n whose position meets n->node->begin <= pos && pos < n->node->end.
-    std::set<Symbol*> ids;
-    if (ctx.invertedIndex.posEndTrie != nullptr) {
-        ids = PosSearchApi::GetIDsLessThanPos(*ctx.invertedIndex.posEndTrie, pos, false);
-    }
+    std::set<Symbol*> ids = ctx.invertedIndex.posIndex.GetIDsEndBefore(pos, false);
     if (contain) {
         ids = Union(ids, GetIDsByPosEQ(ctx, pos));
     }
@@ -467,10 +432,7 @@ std::set<Symbol*> Searcher::GetIDsByPosLT(const ASTContext& ctx, const Position&
 std::set<Symbol*> Searcher::GetIDsByPosGT(const ASTContext& ctx, const Position& pos, bool contain) const
 {
     // Equivalent to finding symbol n whose position meets n->node->begin > pos && pos <= n->node->end.
-    std::set<Symbol*> ids;
-    if (ctx.invertedIndex.posBeginTrie != nullptr) {
-        ids = PosSearchApi::GetIDsGreaterThanPos(*ctx.invertedIndex.posBeginTrie, pos, false);
-    }
+    std::set<Symbol*> ids = ctx.invertedIndex.posIndex.GetIDsBeginAfter(pos, false);
     if (contain) {
         ids = Union(ids, GetIDsByPosEQ(ctx, pos));
     }
@@ -275,6 +275,28 @@ bool IsInDeclWithAttribute(const Decl& decl, AST::Attribute attr)
     return false;
 }
 
+bool IsReusableInstantiatedFunc(const FuncDecl& fd)
+{
+    if (!fd.TestAttr(Attribute::GENERIC_INSTANTIATED, Attribute::GLOBAL) || fd.TestAttr(Attribute::GENERIC) ||
+        fd.outerDecl != nullptr || fd.isConst || fd.isInline || fd.isFrozen) {
+        return false;
+    }
+    auto genericDecl = DynamicCast<const FuncDecl*>(fd.genericDecl);
+    if (genericDecl == nullptr || !genericDecl->IsExportedDecl() || !genericDecl->funcBody ||
+        genericDecl->funcBody->paramLists.empty()) {
+        return false;
+    }
+    // Only the package of the generic function shares its instantiations, so that the packages don't export again the
+    // instantiations of the imported generic functions, and each one is kept by a single package.
+    if (fd.fullPackageName != genericDecl->fullPackageName) {
+        return false;
+    }
+    // The default parameter functions are instantiated along with the function and can't be referenced alone.
+    auto& params = genericDecl->funcBody->paramLists[0]->params;
+    return std::none_of(
+        params.begin(), params.end(), [](auto& param) { return param->assignment || param->desugarDecl; });
+}
+
 std::vector<Ptr<AST::Pattern>> FlattenVarWithPatternDecl(const AST::VarWithPatternDecl& vwpDecl)
 {
     std::vector<Ptr<AST::Pattern>> result;
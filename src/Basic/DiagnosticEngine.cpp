@@ -11,6 +11,7 @@
  */
 #include "DiagnosticEngineImpl.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <set>
 #include <sstream>
@@ -192,9 +193,7 @@ DiagnosticBuilder::~DiagnosticBuilder()
     try {
 #endif
         if (!diag.GetEnableDiagnose()) {
-            auto storedDiags = diag.ConsumeStoredDiags();
-            storedDiags.emplace_back(diagnostic);
-            diag.SetStoredDiags(std::move(storedDiags));
+            diag.StoreDiag(std::move(diagnostic));
             return;
         }
         if (!diagnostic.isRefactor) {
@@ -589,7 +588,7 @@ DiagnosticEngine::~DiagnosticEngine() noexcept
     delete impl;
 }
 
-std::vector<Diagnostic> DiagnosticEngineImpl::DisableDiagnose()
+size_t DiagnosticEngineImpl::DisableDiagnose()
 {
     disableDiagDeep = disableDiagDeep + 1;
     if (disableDiagDeep > 0) {
@@ -597,7 +596,9 @@ std::vector<Diagnostic> DiagnosticEngineImpl::DisableDiagnose()
             enableDiagnose = false;
         }
     }
-    return ConsumeStoredDiags();
+    auto outerBegin = storedDiagsBegin;
+    storedDiagsBegin = storedDiags.size();
+    return outerBegin;
 }
 
 void DiagnosticEngineImpl::EnableDiagnose()
@@ -608,24 +609,47 @@ void DiagnosticEngineImpl::EnableDiagnose()
     if (disableDiagDeep == 0) {
         if (!enableDiagnose) {
             enableDiagnose = true;
-            storedDiags.clear();
+            storedDiags.erase(storedDiags.begin() + static_cast<long>(storedDiagsBegin), storedDiags.end());
         }
     }
 }
 
-void DiagnosticEngineImpl::EnableDiagnose(const std::vector<Diagnostic>& diags)
+void DiagnosticEngineImpl::EnableDiagnose(size_t outerBegin)
 {
-    EnableDiagnose();
-    storedDiags = diags;
+    CJC_ASSERT(outerBegin <= storedDiagsBegin && storedDiagsBegin <= storedDiags.size());
+    storedDiags.erase(storedDiags.begin() + static_cast<long>(storedDiagsBegin), storedDiags.end());
+    storedDiagsBegin = outerBegin;
+    if (disableDiagDeep > 0) {
+        disableDiagDeep = disableDiagDeep - 1;
+    }
+    if (disableDiagDeep == 0) {
+        enableDiagnose = true;
+    }
 }
 
 std::vector<Diagnostic> DiagnosticEngineImpl::ConsumeStoredDiags()
 {
-    std::vector<Diagnostic> stored = storedDiags;
-    storedDiags.clear();
+    auto begin = storedDiags.begin() + static_cast<long>(storedDiagsBegin);
+    std::vector<Diagnostic> stored(std::make_move_iterator(begin), std::make_move_iterator(storedDiags.end()));
+    storedDiags.erase(begin, storedDiags.end());
     return stored;
 }
 
+bool DiagnosticEngineImpl::HasStoredError() const
+{
+    return std::any_of(storedDiags.begin() + static_cast<long>(storedDiagsBegin), storedDiags.end(),
+        [](const Diagnostic& d) { return d.diagSeverity == DiagSeverity::DS_ERROR; });
+}
+
+std::vector<Diagnostic> DiagnosticEngineImpl::GetStoredDiags(size_t from) const
+{
+    auto begin = storedDiagsBegin + from;
+    if (begin >= storedDiags.size()) {
+        return {};
+    }
+    return std::vector<Diagnostic>(storedDiags.begin() + static_cast<long>(begin), storedDiags.end());
+}
+
 Range DiagnosticEngineImpl::MakeRealRange(
     const AST::Node& node, const Position begin, const Position end, bool begLowBound) const
 {
@@ -936,24 +960,18 @@ DiagnosticCache::DiagCacheKey DiagnosticCache::ExtractKey(const DiagnosticEngine
 
 void DiagnosticCache::ToExclude(const DiagnosticEngine& diagBefore)
 {
-    cachedDiags = diagBefore.GetStoredDiags();
+    excludedCount = diagBefore.GetStoredDiagsCount();
 }
 
 void DiagnosticCache::BackUp(const DiagnosticEngine& diagAfter)
 {
-    auto& storedDiags = diagAfter.GetStoredDiags();
-    if (storedDiags.size() > cachedDiags.size()) {
-        cachedDiags = std::vector<Diagnostic>(
-            storedDiags.begin() + static_cast<long>(cachedDiags.size()), storedDiags.end());
-    } else {
-        cachedDiags.clear();
-    }
+    cachedDiags = diagAfter.GetStoredDiags(excludedCount);
 }
 
 void DiagnosticCache::Restore(DiagnosticEngine& dst)
 {
-    auto old = dst.ConsumeStoredDiags();
-    old.insert(old.end(), cachedDiags.begin(), cachedDiags.end());
-    dst.SetStoredDiags(std::move(old));
+    for (auto& diag : cachedDiags) {
+        dst.StoreDiag(Diagnostic(diag));
+    }
 }
 }; // namespace Cangjie
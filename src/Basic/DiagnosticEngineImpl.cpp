@@ -17,32 +17,35 @@ DiagnosticEngine::StashDisableDiagnoseStatus::StashDisableDiagnoseStatus(Diagnos
     : engine(e),
       enableDiagnose(e->impl->enableDiagnose),
       disableDiagDeep(e->impl->disableDiagDeep),
-      storedDiags(e->impl->storedDiags),
+      storedDiagsBegin(e->impl->storedDiagsBegin),
+      storedDiagsEnd(e->impl->storedDiags.size()),
       hasTargetType(hasTargetType)
 {
     if (!hasTargetType) {
         e->impl->enableDiagnose = true;
         e->impl->disableDiagDeep = 0;
-        e->impl->storedDiags.clear();
+        e->impl->storedDiagsBegin = storedDiagsEnd;
     }
 }
 
 DiagnosticEngine::StashDisableDiagnoseStatus::~StashDisableDiagnoseStatus() noexcept
 {
+    auto& impl = *engine->impl;
     if (hasTargetType) {
-        engine->impl->enableDiagnose = true;
-        engine->impl->disableDiagDeep = 0;
-        engine->impl->storedDiags.erase(
-            std::remove_if(engine->impl->storedDiags.begin(), engine->impl->storedDiags.end(),
-                [](const Diagnostic& diag) { return diag.diagSeverity == DiagSeverity::DS_ERROR; }),
-            engine->impl->storedDiags.end());
-        for (auto& diag : engine->impl->storedDiags) {
-            engine->Diagnose(diag);
+        auto diags = impl.GetStoredDiags(0);
+        impl.enableDiagnose = true;
+        impl.disableDiagDeep = 0;
+        for (auto& diag : diags) {
+            if (diag.diagSeverity != DiagSeverity::DS_ERROR) {
+                engine->Diagnose(diag);
+            }
         }
     }
-    std::swap(engine->impl->enableDiagnose, enableDiagnose);
-    std::swap(engine->impl->disableDiagDeep, disableDiagDeep);
-    std::swap(engine->impl->storedDiags, storedDiags);
+    // the diagnoses stored before are kept, the ones stored since are dropped
+    impl.storedDiags.erase(impl.storedDiags.begin() + static_cast<long>(storedDiagsEnd), impl.storedDiags.end());
+    impl.storedDiagsBegin = storedDiagsBegin;
+    impl.enableDiagnose = enableDiagnose;
+    impl.disableDiagDeep = disableDiagDeep;
 }
 
 bool DiagnosticEngine::HasSourceManager()
@@ -132,13 +135,17 @@ int32_t DiagnosticEngine::GetDisableDiagDeep() const
 {
     return impl->GetDisableDiagDeep();
 }
-const std::vector<Diagnostic>& DiagnosticEngine::GetStoredDiags() const
+size_t DiagnosticEngine::GetStoredDiagsCount() const
 {
-    return impl->GetStoredDiags();
+    return impl->GetStoredDiagsCount();
 }
-void DiagnosticEngine::SetStoredDiags(std::vector<Diagnostic>&& value)
+bool DiagnosticEngine::HasStoredError() const
 {
-    return impl->SetStoredDiags(std::move(value));
+    return impl->HasStoredError();
+}
+std::vector<Diagnostic> DiagnosticEngine::GetStoredDiags(size_t from) const
+{
+    return impl->GetStoredDiags(from);
 }
 bool DiagnosticEngine::GetEnableDiagnose() const
 {
@@ -260,7 +267,7 @@ void DiagnosticEngine::ReportErrorAndWarningCount()
 {
     impl->ReportErrorAndWarningCount();
 }
-std::vector<Diagnostic> DiagnosticEngine::DisableDiagnose()
+size_t DiagnosticEngine::DisableDiagnose()
 {
     return impl->DisableDiagnose();
 }
@@ -269,9 +276,13 @@ void DiagnosticEngine::EnableDiagnose()
 {
     impl->EnableDiagnose();
 }
-void DiagnosticEngine::EnableDiagnose(const std::vector<Diagnostic>& diags)
+void DiagnosticEngine::EnableDiagnose(size_t outerBegin)
+{
+    impl->EnableDiagnose(outerBegin);
+}
+void DiagnosticEngine::StoreDiag(Diagnostic&& diagnostic)
 {
-    impl->EnableDiagnose(diags);
+    impl->StoreDiag(std::move(diagnostic));
 }
 std::vector<Diagnostic> DiagnosticEngine::ConsumeStoredDiags()
 {
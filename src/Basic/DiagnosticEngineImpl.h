@@ -66,17 +66,15 @@ public:
     {
         return disableDiagDeep;
     }
-    const std::vector<Diagnostic>& GetStoredDiags() const&
+    size_t GetStoredDiagsCount() const
     {
-        return storedDiags;
+        return storedDiags.size() - storedDiagsBegin;
     }
-    std::vector<Diagnostic> GetStoredDiags() &&
+    bool HasStoredError() const;
+    std::vector<Diagnostic> GetStoredDiags(size_t from) const;
+    void StoreDiag(Diagnostic&& diagnostic)
     {
-        return std::move(storedDiags);
-    }
-    void SetStoredDiags(std::vector<Diagnostic>&& value)
-    {
-        storedDiags = std::move(value);
+        storedDiags.emplace_back(std::move(diagnostic));
     }
     bool GetEnableDiagnose() const
     {
@@ -229,19 +227,22 @@ public:
     bool DiagFilter(Diagnostic& diagnostic) noexcept;
 
     /**
-     * Disable diagnose, and take out current stored diagnoses.
-     * return current stored diagnoses in diagnose engine.
+     * Disable diagnose, and start a new scope of stored diagnoses on top of the current one.
+     * return the beginning of the current scope, to be passed to \ref EnableDiagnose when the new scope ends.
      */
-    std::vector<Diagnostic> DisableDiagnose();
+    size_t DisableDiagnose();
 
     void EnableDiagnose();
 
     /**
-     * Set stored diagnoses to given contents, can be used to suppress cached diagnoses.
-     * @param diags given diagnoses to be restored in diagnose engine
+     * Drop the diagnoses stored by the innermost scope, and go back to the scope beginning at @p outerBegin.
+     * @param outerBegin the value returned by the matching \ref DisableDiagnose.
      */
-    void EnableDiagnose(const std::vector<Diagnostic>& diags);
+    void EnableDiagnose(size_t outerBegin);
 
+    /**
+     * Take out the diagnoses stored by the innermost scope.
+     */
     std::vector<Diagnostic> ConsumeStoredDiags();
 
     bool HardDisable() const { return hardDisable; }
@@ -269,7 +270,10 @@ private:
 
     std::optional<unsigned int> maxNumOfDiags = DEFAULT_DIAG_NUM;
     std::vector<std::function<bool(Diagnostic& diag)>> diagFilters;
+    /* The diagnoses stored while diagnose is disabled. The nested suppressions are a stack of scopes in it, the
+     * innermost one starts at `storedDiagsBegin`, so entering and leaving a scope doesn't copy the diagnoses. */
     std::vector<Diagnostic> storedDiags;
+    size_t storedDiagsBegin{0};
     
     // IsEmitter is used to some tools like CJLint which don't want to output error to terminal.
     bool isEmitter{true};
@@ -553,6 +553,12 @@ void AST2CHIR::CollectImportedDecls(const AST::Package& node)
     std::unordered_set<std::string> mangledNameSet;
     // 1. imported generic instantiated declarations, for which we should collect their instantiated versions
     CollectImportedGenericInstantiatedDecl(node, mangledNameSet);
+    // and the instantiations of imported packages which are reused instead of being instantiated again
+    if (gim) {
+        for (auto funcDecl : gim->GetReusedInstantiations()) {
+            CollectImportedFuncDeclAndDesugarParams(*funcDecl);
+        }
+    }
 
     // 2. all imported decls, only including used decls in current package
     for (auto& importPkg : importManager.GetAllImportedPackages()) {
@@ -51,9 +51,8 @@ void DevirtualizationInfo::CollectInfo()
             if (IsCoreObject(*parentDef)) {
                 continue;
             }
-            if (CheckCustomTypeInternal(*parentDef)) {
+            if (CheckCustomTypeClosed(*parentDef)) {
                 subtypeMap[parentDef].emplace_back(InheritanceInfo{parentTy, thisType});
- 
             }
         }
     }
@@ -167,6 +166,16 @@ bool DevirtualizationInfo::CheckCustomTypeInternal(const CustomTypeDef& def) con
     return false;
 }
 
+bool DevirtualizationInfo::CheckCustomTypeClosed(const CustomTypeDef& def) const
+{
+    if (CheckCustomTypeInternal(def)) {
+        return true;
+    }
+    // a sealed type can only be inherited in the package where it's defined
+    return def.TestAttr(Attribute::SEALED) && !def.TestAttr(Attribute::IMPORTED) &&
+        def.GetPackageName() == package->GetName();
+}
+
 void DevirtualizationInfo::CollectConstMemberVarType()
 {
     ConstMemberVarCollector{package, constMemberTypeMap}.CollectConstMemberVarType();
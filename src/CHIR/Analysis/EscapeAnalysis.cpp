@@ -0,0 +1,232 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#include "cangjie/CHIR/Analysis/EscapeAnalysis.h"
+
+#include <unordered_set>
+
+#include "cangjie/CHIR/CHIRCasting.h"
+#include "cangjie/CHIR/Expression/Terminator.h"
+
+namespace Cangjie::CHIR {
+namespace {
+const BlockGroup* GetOwnerBlockGroup(const Value& value)
+{
+    if (value.IsLocalVar()) {
+        return StaticCast<const LocalVar&>(value).GetOwnerBlockGroup();
+    }
+    if (value.IsParameter()) {
+        auto& param = StaticCast<const Parameter&>(value);
+        if (auto func = param.GetOwnerFunc(); func != nullptr) {
+            return func->GetBody();
+        }
+        if (auto lambda = param.GetOwnerLambda(); lambda != nullptr) {
+            return lambda->GetBody();
+        }
+    }
+    return nullptr;
+}
+
+/// Get the loads of @p location if it's a local variable only loaded and stored in @p blockGroup, so a reference
+/// stored to it is only reachable through these loads.
+std::optional<std::vector<Value*>> GetLoadsOfLocalVar(const Value& location, const BlockGroup& blockGroup)
+{
+    if (!location.IsLocalVar() || StaticCast<const LocalVar&>(location).IsRetValue()) {
+        return std::nullopt;
+    }
+    if (StaticCast<const LocalVar&>(location).GetExpr()->GetExprKind() != ExprKind::ALLOCATE) {
+        return std::nullopt;
+    }
+    std::vector<Value*> loads;
+    for (auto user : location.GetUsers()) {
+        if (user->GetParentBlockGroup() != &blockGroup) {
+            return std::nullopt;
+        }
+        if (user->GetExprKind() == ExprKind::LOAD) {
+            loads.emplace_back(user->GetResult());
+        } else if (user->GetExprKind() == ExprKind::STORE) {
+            if (StaticCast<Store*>(user)->GetLocation() != &location) {
+                return std::nullopt;
+            }
+        } else if (user->GetExprKind() != ExprKind::DEBUGEXPR) {
+            return std::nullopt;
+        }
+    }
+    return loads;
+}
+
+std::vector<Value*> GetCallArgs(const Expression& call)
+{
+    if (call.GetExprKind() == ExprKind::APPLY) {
+        return StaticCast<const Apply&>(call).GetArgs();
+    }
+    CJC_ASSERT(call.GetExprKind() == ExprKind::APPLY_WITH_EXCEPTION);
+    return StaticCast<const ApplyWithException&>(call).GetArgs();
+}
+
+Value* GetCallee(const Expression& call)
+{
+    if (call.GetExprKind() == ExprKind::APPLY) {
+        return StaticCast<const Apply&>(call).GetCallee();
+    }
+    CJC_ASSERT(call.GetExprKind() == ExprKind::APPLY_WITH_EXCEPTION);
+    return StaticCast<const ApplyWithException&>(call).GetCallee();
+}
+} // namespace
+
+EscapeAnalysis::EscapeAnalysis(const Package& package)
+{
+    std::vector<const Func*> funcs;
+    for (auto func : package.GetGlobalFuncs()) {
+        if (func->GetBody() != nullptr) {
+            funcs.emplace_back(func);
+            paramEscapes.emplace(func, std::vector<bool>(func->GetParams().size(), false));
+        }
+    }
+    // start from the optimistic summaries and make parameters escape until nothing changes, the summaries only
+    // grow, so this terminates
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (auto func : funcs) {
+            auto& escapes = paramEscapes.at(func);
+            for (size_t i = 0; i < escapes.size(); ++i) {
+                if (!escapes[i] && GetEscapeState(*func->GetParam(i)) == EscapeState::GLOBAL_ESCAPE) {
+                    escapes[i] = true;
+                    changed = true;
+                }
+            }
+        }
+    }
+}
+
+bool EscapeAnalysis::IsParamNoEscape(const Func& func, size_t index) const
+{
+    auto it = paramEscapes.find(&func);
+    return it != paramEscapes.end() && index < it->second.size() && !it->second[index];
+}
+
+EscapeState EscapeAnalysis::GetArgEscapeState(const Expression& call, const Value& arg) const
+{
+    auto callee = GetCallee(call);
+    if (callee == &arg || !callee->IsFuncWithBody()) {
+        return EscapeState::GLOBAL_ESCAPE;
+    }
+    auto& func = *VirtualCast<Func*>(callee);
+    auto args = GetCallArgs(call);
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == &arg && !IsParamNoEscape(func, i)) {
+            return EscapeState::GLOBAL_ESCAPE;
+        }
+    }
+    return EscapeState::ARG_ESCAPE;
+}
+
+bool EscapeAnalysis::DoesFieldAddrEscape(const Value& addr) const
+{
+    auto blockGroup = GetOwnerBlockGroup(addr);
+    for (auto user : addr.GetUsers()) {
+        // captured by a lambda
+        if (user->GetParentBlockGroup() != blockGroup) {
+            return true;
+        }
+        switch (user->GetExprKind()) {
+            case ExprKind::LOAD:
+            case ExprKind::DEBUGEXPR:
+                break;
+            case ExprKind::STORE:
+                if (StaticCast<Store*>(user)->GetValue() == &addr) {
+                    return true;
+                }
+                break;
+            case ExprKind::STORE_ELEMENT_REF:
+                if (StaticCast<StoreElementRef*>(user)->GetValue() == &addr) {
+                    return true;
+                }
+                break;
+            case ExprKind::GET_ELEMENT_REF:
+                if (DoesFieldAddrEscape(*user->GetResult())) {
+                    return true;
+                }
+                break;
+            default:
+                return true;
+        }
+    }
+    return false;
+}
+
+EscapeState EscapeAnalysis::GetEscapeState(const Value& obj) const
+{
+    auto blockGroup = GetOwnerBlockGroup(obj);
+    if (blockGroup == nullptr) {
+        return EscapeState::GLOBAL_ESCAPE;
+    }
+    auto res = EscapeState::NO_ESCAPE;
+    // the values referring to the same object as `obj`
+    std::vector<const Value*> worklist{&obj};
+    std::unordered_set<const Value*> aliases{&obj};
+    const auto addAlias = [&worklist, &aliases](const Value* alias) {
+        if (aliases.emplace(alias).second) {
+            worklist.emplace_back(alias);
+        }
+    };
+    while (!worklist.empty()) {
+        auto value = worklist.back();
+        worklist.pop_back();
+        for (auto user : value->GetUsers()) {
+            // captured by a lambda
+            if (user->GetParentBlockGroup() != blockGroup) {
+                return EscapeState::GLOBAL_ESCAPE;
+            }
+            switch (user->GetExprKind()) {
+                case ExprKind::DEBUGEXPR:
+                case ExprKind::INSTANCEOF:
+                case ExprKind::EQUAL:
+                case ExprKind::NOTEQUAL:
+                    break;
+                case ExprKind::TYPECAST:
+                    addAlias(user->GetResult());
+                    break;
+                case ExprKind::GET_ELEMENT_REF:
+                    if (DoesFieldAddrEscape(*user->GetResult())) {
+                        return EscapeState::GLOBAL_ESCAPE;
+                    }
+                    break;
+                case ExprKind::STORE_ELEMENT_REF:
+                    if (StaticCast<StoreElementRef*>(user)->GetValue() == value) {
+                        return EscapeState::GLOBAL_ESCAPE;
+                    }
+                    break;
+                case ExprKind::STORE: {
+                    auto store = StaticCast<Store*>(user);
+                    if (store->GetValue() != value) {
+                        return EscapeState::GLOBAL_ESCAPE;
+                    }
+                    auto loads = GetLoadsOfLocalVar(*store->GetLocation(), *blockGroup);
+                    if (!loads.has_value()) {
+                        return EscapeState::GLOBAL_ESCAPE;
+                    }
+                    for (auto load : *loads) {
+                        addAlias(load);
+                    }
+                    break;
+                }
+                case ExprKind::APPLY:
+                case ExprKind::APPLY_WITH_EXCEPTION:
+                    if (GetArgEscapeState(*user, *value) == EscapeState::GLOBAL_ESCAPE) {
+                        return EscapeState::GLOBAL_ESCAPE;
+                    }
+                    res = EscapeState::ARG_ESCAPE;
+                    break;
+                default:
+                    return EscapeState::GLOBAL_ESCAPE;
+            }
+        }
+    }
+    return res;
+}
+} // namespace Cangjie::CHIR
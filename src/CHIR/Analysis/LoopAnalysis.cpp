@@ -0,0 +1,295 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#include "cangjie/CHIR/Analysis/LoopAnalysis.h"
+
+#include <algorithm>
+
+#include "cangjie/CHIR/Expression/Expression.h"
+#include "cangjie/Utils/CheckUtils.h"
+
+namespace Cangjie::CHIR {
+Block* NaturalLoop::GetHeader() const
+{
+    return header;
+}
+
+NaturalLoop* NaturalLoop::GetParentLoop() const
+{
+    return parent;
+}
+
+const std::vector<NaturalLoop*>& NaturalLoop::GetSubLoops() const
+{
+    return subLoops;
+}
+
+const std::vector<Block*>& NaturalLoop::GetBlocks() const
+{
+    return blocks;
+}
+
+const std::vector<Block*>& NaturalLoop::GetLatches() const
+{
+    return latches;
+}
+
+std::vector<Block*> NaturalLoop::GetExitingBlocks() const
+{
+    std::vector<Block*> res;
+    for (auto block : blocks) {
+        auto succs = block->GetSuccessors();
+        if (std::any_of(succs.begin(), succs.end(), [this](auto succ) { return !Contains(succ); })) {
+            res.emplace_back(block);
+        }
+    }
+    return res;
+}
+
+std::vector<Block*> NaturalLoop::GetExitBlocks() const
+{
+    std::vector<Block*> res;
+    std::unordered_set<Block*> visited;
+    for (auto block : blocks) {
+        for (auto succ : block->GetSuccessors()) {
+            if (!Contains(succ) && visited.emplace(succ).second) {
+                res.emplace_back(succ);
+            }
+        }
+    }
+    return res;
+}
+
+Block* NaturalLoop::GetPreheader() const
+{
+    Block* res = nullptr;
+    for (auto pred : header->GetPredecessors()) {
+        if (Contains(pred)) {
+            continue;
+        }
+        if (res != nullptr && res != pred) {
+            return nullptr;
+        }
+        res = pred;
+    }
+    if (res == nullptr || res->GetSuccessors().size() != 1) {
+        return nullptr;
+    }
+    return res;
+}
+
+size_t NaturalLoop::GetDepth() const
+{
+    return depth;
+}
+
+bool NaturalLoop::Contains(const Block* block) const
+{
+    return blockSet.count(block) != 0;
+}
+
+bool NaturalLoop::Contains(const NaturalLoop* loop) const
+{
+    for (; loop != nullptr; loop = loop->parent) {
+        if (loop == this) {
+            return true;
+        }
+    }
+    return false;
+}
+
+LoopInfo::LoopInfo(const BlockGroup& blockGroup)
+{
+    ComputeDominators(blockGroup);
+    ComputeLoops();
+}
+
+void LoopInfo::ComputeDominators(const BlockGroup& blockGroup)
+{
+    auto entry = blockGroup.GetEntryBlock();
+    if (entry == nullptr) {
+        return;
+    }
+    // post order by an iterative DFS
+    std::vector<Block*> postOrder;
+    std::unordered_set<const Block*> visited{entry};
+    std::vector<std::pair<Block*, std::vector<Block*>>> stack;
+    stack.emplace_back(entry, entry->GetSuccessors());
+    while (!stack.empty()) {
+        auto& [block, succs] = stack.back();
+        if (succs.empty()) {
+            postOrder.emplace_back(block);
+            stack.pop_back();
+            continue;
+        }
+        auto succ = succs.back();
+        succs.pop_back();
+        if (visited.emplace(succ).second) {
+            stack.emplace_back(succ, succ->GetSuccessors());
+        }
+    }
+    rpo.assign(postOrder.rbegin(), postOrder.rend());
+    for (size_t i = 0; i < rpo.size(); ++i) {
+        rpoIndex.emplace(rpo[i], i);
+    }
+
+    // "A Simple, Fast Dominance Algorithm", Cooper, Harvey and Kennedy.
+    const auto intersect = [this](Block* a, Block* b) {
+        while (a != b) {
+            while (rpoIndex.at(a) > rpoIndex.at(b)) {
+                a = idom.at(a);
+            }
+            while (rpoIndex.at(b) > rpoIndex.at(a)) {
+                b = idom.at(b);
+            }
+        }
+        return a;
+    };
+    idom.emplace(entry, entry);
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (size_t i = 1; i < rpo.size(); ++i) {
+            auto block = rpo[i];
+            Block* newIDom = nullptr;
+            for (auto pred : block->GetPredecessors()) {
+                if (idom.count(pred) == 0) {
+                    continue;
+                }
+                newIDom = newIDom == nullptr ? pred : intersect(pred, newIDom);
+            }
+            CJC_NULLPTR_CHECK(newIDom);
+            if (auto it = idom.find(block); it == idom.end()) {
+                idom.emplace(block, newIDom);
+                changed = true;
+            } else if (it->second != newIDom) {
+                it->second = newIDom;
+                changed = true;
+            }
+        }
+    }
+}
+
+void LoopInfo::ComputeLoops()
+{
+    for (auto header : rpo) {
+        std::vector<Block*> latches;
+        for (auto pred : header->GetPredecessors()) {
+            if (Dominates(header, pred)) {
+                latches.emplace_back(pred);
+            }
+        }
+        if (latches.empty()) {
+            continue;
+        }
+        auto loop = std::make_unique<NaturalLoop>(header);
+        loop->latches = latches;
+        loop->blockSet.emplace(header);
+        // the blocks of a natural loop are the blocks reaching a latch without going through the header
+        std::vector<Block*> worklist;
+        for (auto latch : latches) {
+            if (loop->blockSet.emplace(latch).second) {
+                worklist.emplace_back(latch);
+            }
+        }
+        while (!worklist.empty()) {
+            auto block = worklist.back();
+            worklist.pop_back();
+            for (auto pred : block->GetPredecessors()) {
+                if (rpoIndex.count(pred) != 0 && loop->blockSet.emplace(pred).second) {
+                    worklist.emplace_back(pred);
+                }
+            }
+        }
+        for (auto block : rpo) {
+            if (loop->blockSet.count(block) != 0) {
+                loop->blocks.emplace_back(block);
+            }
+        }
+        // the headers are visited in reverse post order, so the loops containing this one are already created
+        for (auto it = loops.rbegin(); it != loops.rend(); ++it) {
+            if ((*it)->Contains(header) && (loop->parent == nullptr || (*it)->depth > loop->parent->depth)) {
+                loop->parent = it->get();
+            }
+        }
+        if (loop->parent != nullptr) {
+            loop->depth = loop->parent->depth + 1;
+            loop->parent->subLoops.emplace_back(loop.get());
+        } else {
+            topLevelLoops.emplace_back(loop.get());
+        }
+        loops.emplace_back(std::move(loop));
+    }
+    for (auto& loop : loops) {
+        for (auto block : loop->blocks) {
+            auto& innermost = innermostLoop[block];
+            if (innermost == nullptr || innermost->depth < loop->depth) {
+                innermost = loop.get();
+            }
+        }
+    }
+}
+
+const std::vector<NaturalLoop*>& LoopInfo::GetTopLevelLoops() const
+{
+    return topLevelLoops;
+}
+
+std::vector<NaturalLoop*> LoopInfo::GetLoopsInnermostFirst() const
+{
+    std::vector<NaturalLoop*> res;
+    for (auto& loop : loops) {
+        res.emplace_back(loop.get());
+    }
+    std::stable_sort(res.begin(), res.end(), [](auto a, auto b) { return a->GetDepth() > b->GetDepth(); });
+    return res;
+}
+
+NaturalLoop* LoopInfo::GetLoopFor(const Block* block) const
+{
+    auto it = innermostLoop.find(block);
+    return it == innermostLoop.end() ? nullptr : it->second;
+}
+
+size_t LoopInfo::GetLoopDepth(const Block* block) const
+{
+    auto loop = GetLoopFor(block);
+    return loop == nullptr ? 0 : loop->GetDepth();
+}
+
+bool LoopInfo::Dominates(const Block* a, const Block* b) const
+{
+    if (rpoIndex.count(a) == 0 || rpoIndex.count(b) == 0) {
+        return false;
+    }
+    auto cur = b;
+    while (true) {
+        if (cur == a) {
+            return true;
+        }
+        auto next = idom.at(cur);
+        if (next == cur) {
+            return false;
+        }
+        cur = next;
+    }
+}
+
+Block* LoopInfo::GetIDom(const Block* block) const
+{
+    auto it = idom.find(block);
+    if (it == idom.end() || it->second == block) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+size_t GetLoopDepth(const Expression& expr)
+{
+    LoopInfo loopInfo(*expr.GetParentBlockGroup());
+    return loopInfo.GetLoopDepth(expr.GetParentBlock());
+}
+} // namespace Cangjie::CHIR
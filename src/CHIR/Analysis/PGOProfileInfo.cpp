@@ -0,0 +1,158 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#include "cangjie/CHIR/Analysis/PGOProfileInfo.h"
+
+#include <algorithm>
+#include <cctype>
+#include <optional>
+#include <sstream>
+#include <vector>
+
+#include "cangjie/Utils/FileUtil.h"
+
+using namespace Cangjie::CHIR;
+
+namespace {
+// same as the default `-profile-summary-cutoff-hot` of LLVM: counters covering 99% of the total count are hot
+constexpr uint64_t HOT_COUNT_CUTOFF_PERCENT = 99;
+constexpr uint64_t PERCENT = 100;
+
+std::optional<uint64_t> ParseCount(const std::string& line)
+{
+    if (line.empty() || !std::all_of(line.begin(), line.end(), [](char c) { return std::isdigit(c) != 0; })) {
+        return std::nullopt;
+    }
+    uint64_t res = 0;
+    std::istringstream(line) >> res;
+    return res;
+}
+
+/// Names of functions with local linkage are prefixed with their file name in the profile.
+std::string StripFileNamePrefix(const std::string& name)
+{
+    auto pos = name.rfind(';');
+    return pos == std::string::npos ? name : name.substr(pos + 1);
+}
+} // namespace
+
+std::unique_ptr<PGOProfileInfo> PGOProfileInfo::Load(const std::string& path)
+{
+    std::string failedReason;
+    auto content = Cangjie::FileUtil::ReadFileContent(path, failedReason);
+    // indexed profiles start with the magic "\xfflprofi"
+    if (!content.has_value() || content->empty() || static_cast<unsigned char>(content->front()) == 0xff) {
+        return nullptr;
+    }
+    auto res = std::make_unique<PGOProfileInfo>();
+    if (!res->Parse(*content)) {
+        return nullptr;
+    }
+    res->ComputeHotThreshold();
+    return res;
+}
+
+bool PGOProfileInfo::Parse(const std::string& content)
+{
+    // A text profile consists of records separated by empty lines, each record is:
+    //   <function name>
+    //   <function hash>
+    //   <number of counters N>
+    //   <N counter values>
+    //   [value profile data]
+    // Lines starting with '#' are comments, and lines starting with ':' before the records are header flags.
+    std::vector<std::string> record;
+    const auto flushRecord = [this, &record]() {
+        const size_t countersBegin = 3;
+        if (record.empty()) {
+            return true;
+        }
+        if (record.size() < countersBegin) {
+            return false;
+        }
+        auto num = ParseCount(record[2]);
+        if (!num.has_value() || !ParseCount(record[1]).has_value() || record.size() < countersBegin + *num) {
+            return false;
+        }
+        uint64_t maxCount = 0;
+        for (size_t i = countersBegin; i < countersBegin + *num; ++i) {
+            auto count = ParseCount(record[i]);
+            if (!count.has_value()) {
+                return false;
+            }
+            maxCount = std::max(maxCount, *count);
+        }
+        auto& funcCount = funcMaxCount[StripFileNamePrefix(record[0])];
+        funcCount = std::max(funcCount, maxCount);
+        record.clear();
+        return true;
+    };
+    std::istringstream input(content);
+    std::string line;
+    while (std::getline(input, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (!line.empty() && (line[0] == '#' || (line[0] == ':' && record.empty()))) {
+            continue;
+        }
+        if (!line.empty()) {
+            record.emplace_back(line);
+        } else if (!flushRecord()) {
+            return false;
+        }
+    }
+    return flushRecord() && !funcMaxCount.empty();
+}
+
+void PGOProfileInfo::ComputeHotThreshold()
+{
+    std::vector<uint64_t> counts;
+    uint64_t total = 0;
+    for (auto& [_, count] : funcMaxCount) {
+        if (count != 0) {
+            counts.emplace_back(count);
+            total += count;
+        }
+    }
+    std::sort(counts.begin(), counts.end(), std::greater<uint64_t>());
+    const uint64_t target =
+        total / PERCENT * HOT_COUNT_CUTOFF_PERCENT + total % PERCENT * HOT_COUNT_CUTOFF_PERCENT / PERCENT;
+    uint64_t covered = 0;
+    for (auto count : counts) {
+        covered += count;
+        hotThreshold = count;
+        if (covered >= target) {
+            break;
+        }
+    }
+}
+
+PGOProfileInfo::Hotness PGOProfileInfo::GetFuncHotness(const std::string& mangledName) const
+{
+    auto it = funcMaxCount.find(mangledName);
+    if (it == funcMaxCount.end()) {
+        return Hotness::UNKNOWN;
+    }
+    if (it->second == 0) {
+        return Hotness::COLD;
+    }
+    return it->second >= hotThreshold ? Hotness::HOT : Hotness::NORMAL;
+}
+
+std::string Cangjie::CHIR::HotnessToString(PGOProfileInfo::Hotness hotness)
+{
+    switch (hotness) {
+        case PGOProfileInfo::Hotness::COLD:
+            return "cold";
+        case PGOProfileInfo::Hotness::NORMAL:
+            return "normal";
+        case PGOProfileInfo::Hotness::HOT:
+            return "hot";
+        default:
+            return "unknown";
+    }
+}
@@ -232,6 +232,13 @@ inline bool IsSaturating(Cangjie::OverflowStrategy ov)
     return ov == OverflowStrategy::SATURATING;
 }
 
+// A THROWING operation only produces a result if it does not overflow, so the saturated range is a sound bound of
+// its result, and unlike the wrapped range it keeps induction variables bounded below.
+inline bool IsNonWrapping(Cangjie::OverflowStrategy ov)
+{
+    return ov == OverflowStrategy::SATURATING || ov == OverflowStrategy::THROWING;
+}
+
 ConstantRange NumericConversionU2SSameWidth(const ConstantRange& src);
 // Convert the numeric bound from an SIntDomain value to signed to be stored as symbolic bound
 // as symbolic bounds are always stored as signed range.
@@ -257,7 +264,7 @@ SIntDomain ComputeAdd(const CHIRArithmeticBinopArgs& args)
     auto& ln = lhs.NumericBound();
     auto& rn = rhs.NumericBound();
     bool isUnsigned = args.uns;
-    ConstantRange numeric = !IsSaturating(args.ov) ? ln.Add(rn) : (isUnsigned ? ln.UAddSat(rn) : ln.SAddSat(rn));
+    ConstantRange numeric = !IsNonWrapping(args.ov) ? ln.Add(rn) : (isUnsigned ? ln.UAddSat(rn) : ln.SAddSat(rn));
     // combine numeric range with arithmetic range is only safe in THROWING strategy
     if (numeric.IsEmptySet() || args.ov != OverflowStrategy::THROWING) {
         return {numeric, isUnsigned};
@@ -282,7 +289,7 @@ SIntDomain ComputeSub(const CHIRArithmeticBinopArgs& args)
     auto& rhs = args.rd;
     auto& ln = lhs.NumericBound();
     auto& rn = rhs.NumericBound();
-    ConstantRange numeric = !IsSaturating(args.ov) ? ln.Sub(rn) : (args.uns ? ln.USubSat(rn) : ln.SSubSat(rn));
+    ConstantRange numeric = !IsNonWrapping(args.ov) ? ln.Sub(rn) : (args.uns ? ln.USubSat(rn) : ln.SSubSat(rn));
     if (numeric.IsEmptySet() || args.ov != OverflowStrategy::THROWING) {
         return {numeric, args.uns};
     }
@@ -19,7 +19,7 @@ AbstractObject::AbstractObject(std::string identifier) : Value(nullptr, identifi
 
 std::string AbstractObject::ToString() const
 {
-    return identifier;
+    return identifier.Str();
 }
 
 AbstractObject* AbstractObject::GetTopObjInstance()
@@ -7,6 +7,7 @@
 #include "cangjie/CHIR/Analysis/ValueRangeAnalysis.h"
 
 #include <climits>
+#include <unordered_set>
 #include "cangjie/CHIR/OverflowChecking.h"
 #include "cangjie/CHIR/Analysis/Arithmetic.h"
 
@@ -24,7 +25,8 @@ ValueRange::RangeKind ValueRange::GetRangeKind() const
     return kind;
 }
 
-BoolRange::BoolRange(BoolDomain domain) : ValueRange(RangeKind::BOOL), domain(std::move(domain))
+BoolRange::BoolRange(BoolDomain domain, const BinaryExpression* predicate)
+    : ValueRange(RangeKind::BOOL), domain(std::move(domain)), predicate(predicate)
 {
 }
 
@@ -32,10 +34,11 @@ std::optional<std::unique_ptr<ValueRange>> BoolRange::Join(const ValueRange& rhs
 {
     CJC_ASSERT(rhs.GetRangeKind() == RangeKind::BOOL);
     auto rhsRange = StaticCast<const BoolRange&>(rhs);
-    if (domain.IsSame(rhsRange.domain)) {
+    auto joinedPredicate = predicate == rhsRange.predicate ? predicate : nullptr;
+    if (domain.IsSame(rhsRange.domain) && joinedPredicate == predicate) {
         return std::nullopt;
     }
-    return std::make_unique<BoolRange>(BoolRange{BoolDomain::Union(domain, rhsRange.domain)});
+    return std::make_unique<BoolRange>(BoolRange{BoolDomain::Union(domain, rhsRange.domain), joinedPredicate});
 }
 
 std::string BoolRange::ToString() const
@@ -47,7 +50,14 @@ std::string BoolRange::ToString() const
 
 std::unique_ptr<ValueRange> BoolRange::Clone() const
 {
-    return std::make_unique<BoolRange>(domain);
+    return std::make_unique<BoolRange>(domain, predicate);
+}
+
+std::unique_ptr<ValueRange> BoolRange::Widen(const ValueRange& prev) const
+{
+    // the bool domain is finite, no need to widen
+    (void)prev;
+    return nullptr;
 }
 
 const BoolDomain& BoolRange::GetVal() const
@@ -55,19 +65,42 @@ const BoolDomain& BoolRange::GetVal() const
     return domain;
 }
 
+const BinaryExpression* BoolRange::GetPredicate() const
+{
+    return predicate;
+}
+
 SIntRange::SIntRange(SIntDomain domain) : ValueRange(RangeKind::SINT), domain(std::move(domain))
 {
 }
 
+namespace {
+bool HasSameSymbolicBounds(const SIntDomain& lhs, const SIntDomain& rhs)
+{
+    auto l = lhs.SymbolicBounds();
+    auto r = rhs.SymbolicBounds();
+    auto il = l.Begin();
+    auto ir = r.Begin();
+    for (; il != l.End() && ir != r.End(); ++il, ++ir) {
+        if (il->first != ir->first || il->second != ir->second) {
+            return false;
+        }
+    }
+    return il == l.End() && ir == r.End();
+}
+} // namespace
+
 std::optional<std::unique_ptr<ValueRange>> SIntRange::Join(const ValueRange& rhs) const
 {
     CJC_ASSERT(rhs.GetRangeKind() == RangeKind::SINT);
-    auto rhsRange = StaticCast<const SIntRange&>(rhs);
-    if (!domain.IsSame(rhsRange.domain) ||
-        (domain.NumericBound().IsFullSet() && !domain.SymbolicBounds().Empty())) {
-        return std::make_unique<SIntRange>(SIntRange{SIntDomain::Unions(domain, rhsRange.domain)});
-        }
-    return std::nullopt;
+    const auto& rhsRange = StaticCast<const SIntRange&>(rhs);
+    // the symbolic bounds must be compared as well, otherwise a bound that only holds on one of the incoming
+    // paths would survive the join
+    auto res = SIntDomain::Unions(domain, rhsRange.domain);
+    if (res.IsSame(domain) && HasSameSymbolicBounds(res, domain)) {
+        return std::nullopt;
+    }
+    return std::make_unique<SIntRange>(std::move(res));
 }
 
 std::string SIntRange::ToString() const
@@ -82,6 +115,44 @@ std::unique_ptr<ValueRange> SIntRange::Clone() const
     return std::make_unique<SIntRange>(domain);
 }
 
+std::unique_ptr<ValueRange> SIntRange::Widen(const ValueRange& prev) const
+{
+    CJC_ASSERT(prev.GetRangeKind() == RangeKind::SINT);
+    const auto& prevDomain = StaticCast<const SIntRange&>(prev).domain;
+    if (domain.IsBottom() || prevDomain.IsBottom()) {
+        return nullptr;
+    }
+    auto isUnsigned = domain.IsUnsigned();
+    auto width = domain.Width();
+    const auto& cur = domain.NumericBound();
+    const auto& old = prevDomain.NumericBound();
+    auto lower = cur.MinValue(isUnsigned);
+    auto upper = cur.MaxValue(isUnsigned);
+    bool widened = false;
+    if (isUnsigned ? lower.Ult(old.MinValue(true)) : lower.Slt(old.MinValue(false))) {
+        lower = isUnsigned ? SInt::UMinValue(width) : SInt::SMinValue(width);
+        widened = true;
+    }
+    if (isUnsigned ? upper.Ugt(old.MaxValue(true)) : upper.Sgt(old.MaxValue(false))) {
+        upper = isUnsigned ? SInt::UMaxValue(width) : SInt::SMaxValue(width);
+        widened = true;
+    }
+    SIntDomain::SymbolicBoundsMap symbolics{};
+    auto bounds = domain.SymbolicBounds();
+    for (auto it = bounds.Begin(); it != bounds.End(); ++it) {
+        if (auto prevBound = prevDomain.FindSymbolicBound(it->first); prevBound && *prevBound == it->second) {
+            symbolics.emplace(it->first, it->second);
+        } else {
+            widened = true;
+        }
+    }
+    if (!widened) {
+        return nullptr;
+    }
+    auto numeric = ConstantRange::NonEmpty(lower, upper + uint64_t{1});
+    return std::make_unique<SIntRange>(SIntDomain{numeric, std::move(symbolics), isUnsigned});
+}
+
 const SIntDomain& SIntRange::GetVal() const
 {
     return domain;
@@ -115,7 +186,9 @@ RangeAnalysis::~RangeAnalysis()
 {
 }
 
-const int MAX_INQUEUE_TIMES = 4;
+const int MAX_INQUEUE_TIMES = 8;
+/// The number of joins into the entry state of a block in a loop before widening is applied.
+const uint32_t WIDENING_DELAY = 1;
 
 bool CanAnalyse(const Ptr<Type>& type)
 {
@@ -194,6 +267,11 @@ void RangeAnalysis::HandleNormalExpressionEffect(RangeDomain& state, const Expre
 {
     switch (expression->GetExprMajorKind()) {
         case ExprMajorKind::MEMORY_EXPR:
+            if (expression->GetExprKind() == ExprKind::LOAD) {
+                HandleLoadExpr(state, StaticCast<const Load*>(expression));
+            } else if (expression->GetExprKind() == ExprKind::STORE) {
+                HandleStoreExpr(state, StaticCast<const Store*>(expression));
+            }
             return;
         case ExprMajorKind::UNARY_EXPR:
             HandleUnaryExpr(state, StaticCast<const UnaryExpression*>(expression));
@@ -387,8 +465,10 @@ void RangeAnalysis::HandleBinaryExpr(RangeDomain& state, const BinaryExpression*
     }
     if (dest->GetType()->IsBoolean()) {
         auto res = GenerateBoolRangeFromBinaryOp(state, binaryExpr);
-        if (res.IsNonTrivial()) {
-            return state.Update(dest, std::make_unique<BoolRange>(res));
+        // an unknown comparison is still recorded, so that the branches on it can refine its operands
+        auto predicate = IsRefinablePredicate(*binaryExpr) ? binaryExpr : nullptr;
+        if (res.IsNonTrivial() || predicate != nullptr) {
+            return state.Update(dest, std::make_unique<BoolRange>(res, predicate));
         }
     }
     state.SetToBound(binaryExpr->GetResult(), true);
@@ -429,9 +509,12 @@ void RangeAnalysis::HandleOthersExpr(RangeDomain& state, const Expression* expre
             HandleTypeCast(state, StaticCast<const TypeCast*>(expression));
             break;
         }
+        case ExprKind::FIELD:
+            return HandleFieldExpr(state, StaticCast<const Field*>(expression));
+        case ExprKind::INTRINSIC:
+            return HandleIntrinsicExpr(state, StaticCast<const Intrinsic*>(expression));
         case ExprKind::CONSTANT:
         case ExprKind::APPLY:
-        case ExprKind::FIELD:
             return;
         case ExprKind::TUPLE:
         default: {
@@ -441,6 +524,115 @@ void RangeAnalysis::HandleOthersExpr(RangeDomain& state, const Expression* expre
     }
 }
 
+namespace {
+bool IsLocalAllocation(const Value* location)
+{
+    return location->IsLocalVar() &&
+        StaticCast<const LocalVar*>(location)->GetExpr()->GetExprKind() == ExprKind::ALLOCATE;
+}
+} // namespace
+
+void RangeAnalysis::HandleLoadExpr(RangeDomain& state, const Load* load)
+{
+    auto dest = load->GetResult();
+    auto loc = load->GetLocation();
+    if (!dest->GetType()->IsInteger() || loc->IsGlobal() || loc->TestAttr(Attribute::STATIC)) {
+        return;
+    }
+    auto obj = state.CheckAbstractObjectRefBy(loc);
+    if (obj == nullptr || obj->IsTopObjInstance()) {
+        return;
+    }
+    const auto& loaded = GetSIntDomainFromState(state, dest);
+    SIntDomain::SymbolicBoundsMap symbolics{};
+    auto bounds = loaded.SymbolicBounds();
+    bool isInCycle = IsInCycle(load->GetParentBlock());
+    for (auto it = bounds.Begin(); it != bounds.End(); ++it) {
+        // The result of a load in a loop lives across iterations, drop the relations against values that
+        // may be redefined by a later iteration.
+        if (!isInCycle || IsStableSymbol(it->first)) {
+            symbolics.emplace(it->first, it->second);
+        }
+    }
+    SIntDomain destDomain{loaded.NumericBound(), std::move(symbolics), loaded.IsUnsigned()};
+    // The variable equals to the loaded value until it is stored again, bind them so that the relations
+    // proven against the loaded value later (e.g. on a branch) also apply to the variable.
+    auto width = SIntDomain::ToWidth(dest->GetType());
+    auto objDomain = SIntDomain::Intersects(
+        destDomain, SIntDomain{destDomain.NumericBound(), dest, ConstantRange{SInt::Zero(width)}});
+    state.Update(dest, std::make_unique<SIntRange>(std::move(destDomain)));
+    state.Update(obj, std::make_unique<SIntRange>(std::move(objDomain)));
+}
+
+void RangeAnalysis::HandleStoreExpr(RangeDomain& state, const Store* store) const
+{
+    auto value = store->GetValue();
+    auto location = store->GetLocation();
+    if (!value->GetType()->IsBoolean() || location->IsGlobal() || location->TestAttr(Attribute::STATIC)) {
+        return;
+    }
+    auto absVal = state.CheckAbstractValue(value);
+    if (absVal == nullptr || absVal->GetRangeKind() != ValueRange::RangeKind::BOOL) {
+        return;
+    }
+    auto range = StaticCast<const BoolRange*>(absVal);
+    auto predicate = range->GetPredicate();
+    if (predicate == nullptr) {
+        return;
+    }
+    // The predicate only stays with a local variable if it is stored right after being computed. Otherwise the
+    // operands of the comparison may be redefined before the variable is read.
+    if (predicate->GetResult() == value && predicate->GetParentBlock() == store->GetParentBlock() &&
+        IsLocalAllocation(location)) {
+        return;
+    }
+    if (auto obj = state.CheckAbstractObjectRefBy(location); obj && !obj->IsTopObjInstance()) {
+        state.Update(obj, std::make_unique<BoolRange>(range->GetVal()));
+    }
+}
+
+void RangeAnalysis::HandleFieldExpr(RangeDomain& state, const Field* field)
+{
+    auto dest = field->GetResult();
+    if (!dest->GetType()->IsInteger()) {
+        return;
+    }
+    BindToCanonicalSymbol(state, dest, canonicalFields[{field->GetBase(), field->GetPath()}]);
+}
+
+void RangeAnalysis::HandleIntrinsicExpr(RangeDomain& state, const Intrinsic* intrinsic)
+{
+    auto dest = intrinsic->GetResult();
+    if (intrinsic->GetIntrinsicKind() != CHIR::IntrinsicKind::ARRAY_SIZE || !dest->GetType()->IsInteger()) {
+        return state.SetToTopOrTopRef(dest, dest->GetType()->IsRef());
+    }
+    // the size of a raw array is never negative
+    auto width = SIntDomain::ToWidth(dest->GetType());
+    state.Update(dest,
+        std::make_unique<SIntRange>(SIntDomain::FromNumeric(RelationalOperation::GE, SInt::Zero(width), false)));
+    BindToCanonicalSymbol(state, dest, canonicalArraySizes[intrinsic->GetOperand(0)]);
+}
+
+void RangeAnalysis::BindToCanonicalSymbol(RangeDomain& state, Value* value, Value*& canonical)
+{
+    if (canonical == nullptr) {
+        if (IsStableSymbol(value)) {
+            canonical = value;
+        }
+        return;
+    }
+    if (canonical == value) {
+        return;
+    }
+    auto width = SIntDomain::ToWidth(value->GetType());
+    const auto& canonicalDomain = GetSIntDomainFromState(state, canonical);
+    auto res = SIntDomain::Intersects(GetSIntDomainFromState(state, value),
+        SIntDomain{canonicalDomain.NumericBound(), canonical, ConstantRange{SInt::Zero(width)}});
+    if (!res.IsBottom()) {
+        state.Update(value, std::make_unique<SIntRange>(std::move(res)));
+    }
+}
+
 std::optional<Block*> RangeAnalysis::HandleTerminatorEffect(RangeDomain& state, const Terminator* terminator)
 {
     RangeAnalysis::ExceptionKind res = ExceptionKind::NA;
@@ -511,4 +703,251 @@ std::optional<Block*> RangeAnalysis::HandleMultiBranchTerminator(
     }
     return multi->GetDefaultBlock();
 }
-} // namespace Cangjie::CHIR
\ No newline at end of file
+
+bool RangeAnalysis::IsInCycle(const Block* block)
+{
+    if (auto it = inCycleCache.find(block); it != inCycleCache.end()) {
+        return it->second;
+    }
+    bool res = false;
+    std::unordered_set<const Block*> visited{};
+    std::vector<const Block*> worklist{block};
+    while (!worklist.empty() && !res) {
+        auto cur = worklist.back();
+        worklist.pop_back();
+        for (auto succ : cur->GetSuccessors()) {
+            if (succ == block) {
+                res = true;
+                break;
+            }
+            if (visited.emplace(succ).second) {
+                worklist.emplace_back(succ);
+            }
+        }
+    }
+    inCycleCache.emplace(block, res);
+    return res;
+}
+
+bool RangeAnalysis::IsStableSymbol(const Value* value)
+{
+    if (!value->IsLocalVar()) {
+        return true;
+    }
+    return !IsInCycle(StaticCast<const LocalVar*>(value)->GetExpr()->GetParentBlock());
+}
+
+bool RangeAnalysis::IsRefinablePredicate(const BinaryExpression& binary)
+{
+    auto kind = binary.GetExprKind();
+    if (kind < ExprKind::LT || kind > ExprKind::NOTEQUAL || !binary.GetLHSOperand()->GetType()->IsInteger()) {
+        return false;
+    }
+    // An operand defined in another block of a loop may be redefined without the comparison being evaluated
+    // again, after which the result of the comparison says nothing about it.
+    for (auto operand : {binary.GetLHSOperand(), binary.GetRHSOperand()}) {
+        if (operand->IsLocalVar() &&
+            StaticCast<LocalVar*>(operand)->GetExpr()->GetParentBlock() != binary.GetParentBlock() &&
+            !IsStableSymbol(operand)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const BinaryExpression* RangeAnalysis::GetBranchPredicate(const RangeDomain& state, const Branch& branch) const
+{
+    auto cond = branch.GetCondition();
+    if (!cond->IsLocalVar()) {
+        return nullptr;
+    }
+    auto condExpr = StaticCast<LocalVar*>(cond)->GetExpr();
+    if (condExpr->GetExprKind() == ExprKind::LOAD) {
+        // e.g. the condition variable of a flattened for-in loop, `HandleStoreExpr` drops the predicate of the
+        // variable if it may be stale.
+        if (condExpr->GetParentBlock() != branch.GetParentBlock() ||
+            !IsLocalAllocation(StaticCast<const Load*>(condExpr)->GetLocation())) {
+            return nullptr;
+        }
+    } else if (condExpr->GetExprMajorKind() != ExprMajorKind::BINARY_EXPR) {
+        return nullptr;
+    }
+    auto absVal = state.CheckAbstractValue(cond);
+    if (absVal == nullptr || absVal->GetRangeKind() != ValueRange::RangeKind::BOOL) {
+        return nullptr;
+    }
+    return StaticCast<const BoolRange*>(absVal)->GetPredicate();
+}
+
+namespace {
+RelationalOperation ToRelationalOperation(ExprKind kind)
+{
+    switch (kind) {
+        case ExprKind::LT:
+            return RelationalOperation::LT;
+        case ExprKind::LE:
+            return RelationalOperation::LE;
+        case ExprKind::GT:
+            return RelationalOperation::GT;
+        case ExprKind::GE:
+            return RelationalOperation::GE;
+        case ExprKind::EQUAL:
+            return RelationalOperation::EQ;
+        case ExprKind::NOTEQUAL:
+            return RelationalOperation::NE;
+        default:
+            CJC_ABORT();
+            return RelationalOperation::NE;
+    }
+}
+
+/// `!(a rel b)` is `a Negate(rel) b`
+RelationalOperation Negate(RelationalOperation rel)
+{
+    switch (rel) {
+        case RelationalOperation::LT:
+            return RelationalOperation::GE;
+        case RelationalOperation::LE:
+            return RelationalOperation::GT;
+        case RelationalOperation::GT:
+            return RelationalOperation::LE;
+        case RelationalOperation::GE:
+            return RelationalOperation::LT;
+        case RelationalOperation::EQ:
+            return RelationalOperation::NE;
+        default:
+            return RelationalOperation::EQ;
+    }
+}
+
+/// `a rel b` is `b Swap(rel) a`
+RelationalOperation Swap(RelationalOperation rel)
+{
+    switch (rel) {
+        case RelationalOperation::LT:
+            return RelationalOperation::GT;
+        case RelationalOperation::LE:
+            return RelationalOperation::GE;
+        case RelationalOperation::GT:
+            return RelationalOperation::LT;
+        case RelationalOperation::GE:
+            return RelationalOperation::LE;
+        default:
+            return rel;
+    }
+}
+
+/// The numeric bound of `a` implied by `a rel b`, where @p other is the numeric bound of `b`.
+SIntDomain NumericConstraint(RelationalOperation rel, const ConstantRange& other, bool isUnsigned)
+{
+    switch (rel) {
+        case RelationalOperation::LT:
+        case RelationalOperation::LE:
+            return SIntDomain::FromNumeric(rel, other.MaxValue(isUnsigned), isUnsigned);
+        case RelationalOperation::GT:
+        case RelationalOperation::GE:
+            return SIntDomain::FromNumeric(rel, other.MinValue(isUnsigned), isUnsigned);
+        case RelationalOperation::EQ:
+            return SIntDomain{other, isUnsigned};
+        default:
+            if (other.IsSingleElement()) {
+                return SIntDomain::FromNumeric(rel, other.GetSingleElement(), isUnsigned);
+            }
+            return SIntDomain::Top(other.Width(), isUnsigned);
+    }
+}
+} // namespace
+
+void RangeAnalysis::RefineOperand(
+    RangeDomain& state, Value* value, RelationalOperation rel, Value* other, bool isUnsigned)
+{
+    if (!value->IsLocalVar() && !value->IsParameter()) {
+        return;
+    }
+    const auto& otherBound = GetSIntDomainFromState(state, other).NumericBound();
+    if (otherBound.IsEmptySet()) {
+        return;
+    }
+    auto constraint = NumericConstraint(rel, otherBound, isUnsigned);
+    // symbolic bounds are signed differences, and are only recorded against values that are never redefined
+    if (!isUnsigned && rel != RelationalOperation::NE && other != value && IsStableSymbol(other)) {
+        constraint = SIntDomain::Intersects(
+            constraint, SIntDomain::FromSymbolic(rel, other, SIntDomain::ToWidth(value->GetType()), isUnsigned));
+    }
+    auto refined = SIntDomain::Intersects(GetSIntDomainFromState(state, value), constraint);
+    if (refined.IsBottom()) {
+        return;
+    }
+    if (value->IsLocalVar()) {
+        if (auto load = DynamicCast<Load*>(StaticCast<LocalVar*>(value)->GetExpr()); load) {
+            // the variable that still holds the loaded value satisfies the condition as well
+            auto loc = load->GetLocation();
+            AbstractObject* obj =
+                loc->IsGlobal() || loc->TestAttr(Attribute::STATIC) ? nullptr : state.CheckAbstractObjectRefBy(loc);
+            // abstract objects have no type, the kind of their abstract value tells whether they hold an integer
+            auto absVal = obj == nullptr || obj->IsTopObjInstance() ? nullptr : state.CheckAbstractValue(obj);
+            if (absVal != nullptr && absVal->GetRangeKind() == ValueRange::RangeKind::SINT) {
+                const auto& objDomain = StaticCast<const SIntRange*>(absVal)->GetVal();
+                auto bound = objDomain.FindSymbolicBound(value);
+                if (bound && bound->IsSingleElement() && bound->GetSingleElement().IsZero()) {
+                    auto refinedObj = SIntDomain::Intersects(objDomain, constraint);
+                    if (!refinedObj.IsBottom()) {
+                        state.Update(obj, std::make_unique<SIntRange>(std::move(refinedObj)));
+                    }
+                }
+            }
+        }
+    }
+    state.Update(value, std::make_unique<SIntRange>(std::move(refined)));
+}
+
+bool RangeAnalysis::HasEdgeEffect(const Terminator* terminator)
+{
+    if (terminator->GetExprKind() != ExprKind::BRANCH) {
+        return false;
+    }
+    auto branch = StaticCast<const Branch*>(terminator);
+    auto cond = branch->GetCondition();
+    if (branch->GetTrueBlock() == branch->GetFalseBlock() || !cond->IsLocalVar()) {
+        return false;
+    }
+    auto condExpr = StaticCast<LocalVar*>(cond)->GetExpr();
+    return condExpr->GetExprKind() == ExprKind::LOAD || condExpr->GetExprMajorKind() == ExprMajorKind::BINARY_EXPR;
+}
+
+void RangeAnalysis::PropagateEdgeEffect(RangeDomain& state, const Terminator* terminator, const Block* succ)
+{
+    auto branch = StaticCast<const Branch*>(terminator);
+    auto predicate = GetBranchPredicate(state, *branch);
+    if (predicate == nullptr) {
+        return;
+    }
+    auto rel = ToRelationalOperation(predicate->GetExprKind());
+    if (succ == branch->GetFalseBlock()) {
+        rel = Negate(rel);
+    }
+    auto lhs = predicate->GetLHSOperand();
+    auto rhs = predicate->GetRHSOperand();
+    auto isUnsigned = IsUnsignedArithmetic(*predicate);
+    RefineOperand(state, lhs, rel, rhs, isUnsigned);
+    RefineOperand(state, rhs, Swap(rel), lhs, isUnsigned);
+}
+
+bool RangeAnalysis::JoinEntryState(RangeDomain& entry, const RangeDomain& incoming, const Block* block)
+{
+    if (entry.IsBottom() || !IsInCycle(block) || joinTimes[block]++ < WIDENING_DELAY) {
+        return entry.Join(incoming);
+    }
+    RangeDomain prev = entry; // should be a copy
+    if (!entry.Join(incoming)) {
+        return false;
+    }
+    entry.Widen(prev);
+    return true;
+}
+
+bool RangeAnalysis::SupportsSparseMode() const
+{
+    return true;
+}
+} // namespace Cangjie::CHIR
@@ -8,6 +8,7 @@
 #include <iostream>
 #include <sstream>
 
+#include "cangjie/CHIR/GeneratedFromForIn.h"
 #include "cangjie/CHIR/Type/Type.h"
 #include "cangjie/CHIR/Value.h"
 
@@ -16,20 +17,20 @@ std::string AnnotationMap::ToString() const
 {
     std::stringstream ss;
     ss << loc.ToString();
-    for (auto& pair : annotations) {
-        auto str = pair.second->ToString();
+    ForEachAnnotation([&ss](const std::type_index&, const Annotation& anno) {
+        auto str = anno.ToString();
         if (str.empty()) {
-            continue;
+            return;
         }
         if (ss.str() != "") {
             ss << ", ";
         }
         ss << str;
-    }
+    });
     return ss.str();
 }
 
-std::string SkipCheck::ToString()
+std::string SkipCheck::ToString() const
 {
     switch (kind) {
         case SkipKind::SKIP_DCE_WARNING:
@@ -43,7 +44,7 @@ std::string SkipCheck::ToString()
     }
 }
 
-std::string WrappedRawMethod::ToString()
+std::string WrappedRawMethod::ToString() const
 {
     // WrappedRawMethod may be removed body when removeUnusedImported，do not form it.
     auto wrapMethod = dynamic_cast<Func*>(rawMethod);
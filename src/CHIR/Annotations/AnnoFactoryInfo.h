@@ -22,7 +22,7 @@ struct AnnoFactoryInfo final : public Annotation {
         return std::make_unique<AnnoFactoryInfo>(value);
     }
  
-    std::string ToString() override
+    std::string ToString() const override
     {
         std::stringstream gvs;
         gvs << "annoGVs:";
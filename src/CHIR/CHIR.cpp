@@ -26,8 +26,11 @@
 #include "cangjie/CHIR/Transformation/Devirtualization.h"
 #include "cangjie/CHIR/Transformation/FlatForInExpr.h"
 #include "cangjie/CHIR/Transformation/FunctionInline.h"
+#include "cangjie/CHIR/Transformation/GenericSpecialization.h"
 #include "cangjie/CHIR/Transformation/GetRefToArrayElem.h"
+#include "cangjie/CHIR/Transformation/LoopInvariantCodeMotion.h"
 #include "cangjie/CHIR/Transformation/MarkClassHasInited.h"
+#include "cangjie/CHIR/Transformation/Mem2Reg.h"
 #include "cangjie/CHIR/Transformation/MergeBlocks.h"
 #include "cangjie/CHIR/Transformation/NoSideEffectMarker.h"
 #include "cangjie/CHIR/Transformation/RangePropagation.h"
@@ -35,6 +38,7 @@
 #include "cangjie/CHIR/Transformation/RedundantGetOrThrowElimination.h"
 #include "cangjie/CHIR/Transformation/RedundantLoadElimination.h"
 #include "cangjie/CHIR/Transformation/SanitizerCoverage.h"
+#include "cangjie/CHIR/Transformation/ScalarReplacement.h"
 #include "cangjie/CHIR/Transformation/UnitUnify.h"
 #include "cangjie/CHIR/Transformation/UselessAllocateElimination.h"
 #include "cangjie/CHIR/Visitor/Visitor.h"
@@ -372,7 +376,11 @@ void ToCHIR::Devirtualization(DevirtualizationInfo& devirtInfo)
     AnalysisWrapper<TypeAnalysis, TypeDomain> typeAnalysisWrapper(builder);
     typeAnalysisWrapper.RunOnPackage(chirPkg, opts.chirDebugOptimizer, threadNum, devirtInfo);
     auto devirt = CHIR::Devirtualization(&typeAnalysisWrapper, devirtInfo);
+    devirt.SetProfile(GetPGOProfile());
+    devirt.AddInstFuncs(specializedFuncs);
     devirt.RunOnFuncs(funcs, builder, opts.chirDebugOptimizer);
+    // only the funcs of the first round, the frozen inst funcs are inlined below anyway
+    auto devirtualizedFuncs = devirt.GetDevirtualizedFuncs();
 
     // if get frozen inst funcs after first devirtualization, opt them in the second round
     if (!devirt.GetFrozenInstFuns().empty()) {
@@ -389,6 +397,20 @@ void ToCHIR::Devirtualization(DevirtualizationInfo& devirtInfo)
             pass.Run(*func);
         }
     }
+
+    // the direct calls created by devirtualization, including the guarded ones, may be inlined now
+    if (opts.IsOptimizationExisted(GlobalOptions::OptimizationFlag::FUNC_INLINING)) {
+        auto pass = FunctionInline(builder, opts.optimizationLevel, opts.chirDebugOptimizer);
+        pass.SetProfile(GetPGOProfile());
+        // a guarded invoke has one direct call per guard, bound their inlining like the main inline pass does
+        pass.SetCodeGrowthBudget(devirtualizedFuncs);
+        for (auto func : devirtualizedFuncs) {
+            if (func->GetSrcCodeIdentifier() == "$toAny" || func->GetFuncKind() == FuncKind::ANNOFACTORY_FUNC) {
+                continue;
+            }
+            pass.Run(*func);
+        }
+    }
     DumpCHIRDebug("Devirtualization");
 }
 
@@ -442,6 +464,27 @@ void ToCHIR::RunArrayListConstStartOpt()
     DumpCHIRDebug("RunArrayListConstStartOpt");
 }
 
+const PGOProfileInfo* ToCHIR::GetPGOProfile()
+{
+    if (opts.enablePgoInstrUse && pgoProfile == nullptr) {
+        pgoProfile = PGOProfileInfo::Load(opts.pgoProfileFile);
+    }
+    return pgoProfile.get();
+}
+
+void ToCHIR::RunGenericSpecialization()
+{
+    if (!opts.IsCHIROptimizationLevelOverO2() || opts.enIncrementalCompilation || opts.interpFullBchir) {
+        return;
+    }
+    Utils::ProfileRecorder recorder("CHIR Opt", "GenericSpecialization");
+    auto pass = GenericSpecialization(builder, opts.chirDebugOptimizer);
+    pass.SetProfile(GetPGOProfile());
+    pass.RunOnPackage(*chirPkg);
+    specializedFuncs = pass.GetSpecializedFuncs();
+    DumpCHIRDebug("GenericSpecialization");
+}
+
 void ToCHIR::RunFunctionInline(DevirtualizationInfo& devirtInfo)
 {
     if (!opts.IsOptimizationExisted(GlobalOptions::OptimizationFlag::FUNC_INLINING)) {
@@ -452,6 +495,11 @@ void ToCHIR::RunFunctionInline(DevirtualizationInfo& devirtInfo)
     // Collect all call graph information.
     callGraphAnalysis.DoCallGraphAnalysis(opts.chirDebugOptimizer);
     auto pass = FunctionInline(builder, opts.optimizationLevel, opts.chirDebugOptimizer);
+    pass.SetProfile(GetPGOProfile());
+    pass.SetCodeGrowthBudget(callGraphAnalysis.postOrderSCCFunctionlist);
+    if (!opts.chirInlineRemarksFile.empty()) {
+        pass.EnableRemarks();
+    }
     for (auto func : callGraphAnalysis.postOrderSCCFunctionlist) {
         if (!func) {
             continue;
@@ -465,6 +513,9 @@ void ToCHIR::RunFunctionInline(DevirtualizationInfo& devirtInfo)
         pass.Run(*func);
     }
     MergeEffectMap(pass.GetEffectMap(), effectMap);
+    if (!opts.chirInlineRemarksFile.empty() && !pass.WriteRemarks(opts.chirInlineRemarksFile)) {
+        Errorln("failed to write inline remarks to ", opts.chirInlineRemarksFile);
+    }
     Utils::ProfileRecorder::Stop("CHIR Opt", "FunctionInline");
     DumpCHIRDebug("FunctionInline");
 
@@ -625,6 +676,48 @@ void ToCHIR::RunNoSideEffectMarkerOpt()
     DumpCHIRDebug("No_Side_Effect_Marker");
 }
 
+void ToCHIR::RunLoopInvariantCodeMotion()
+{
+    if (!opts.chirLICM || opts.interpFullBchir) {
+        return;
+    }
+    Utils::ProfileRecorder recorder("CHIR Opt", "Loop Invariant Code Motion");
+    LoopInvariantCodeMotion::RunOnPackage(*chirPkg, builder, opts.chirDebugOptimizer);
+    DumpCHIRDebug("Loop_Invariant_Code_Motion");
+}
+
+void ToCHIR::RunScalarReplacement()
+{
+    if (!opts.chirEA || !opts.IsOptimizationExisted(GlobalOptions::OptimizationFlag::SROA_OPT) ||
+        opts.interpFullBchir) {
+        return;
+    }
+    Utils::ProfileRecorder recorder("CHIR Opt", "Scalar Replacement");
+    ScalarReplacement::RunOnPackage(*chirPkg, builder, opts.chirDebugOptimizer);
+    DumpCHIRDebug("Scalar_Replacement");
+}
+
+void ToCHIR::RunMem2Reg()
+{
+    // the debug info of a local variable is bound to its allocation, which must be kept when debugging
+    if (!opts.IsCHIROptimizationLevelOverO2() || opts.enableCompileDebug || opts.interpFullBchir) {
+        return;
+    }
+    Utils::ProfileRecorder recorder("CHIR Opt", "Mem2Reg");
+    Mem2Reg::RunOnPackage(*chirPkg, opts.chirDebugOptimizer);
+    DumpCHIRDebug("Mem2Reg");
+}
+
+void ToCHIR::RunNoEscapeMarker()
+{
+    if (!opts.chirEA || opts.interpFullBchir) {
+        return;
+    }
+    Utils::ProfileRecorder recorder("CHIR Opt", "No Escape Marker");
+    ScalarReplacement::MarkNoEscapeParams(*chirPkg);
+    DumpCHIRDebug("No_Escape_Marker");
+}
+
 void ToCHIR::RunUnitUnify()
 {
     if (!opts.IsCHIROptimizationLevelOverO2()) {
@@ -705,7 +798,10 @@ bool ToCHIR::RunOptimizationPassAndRulesChecking()
     MarkNoSideEffect();
     RunUnitUnify();
     auto devirtInfo = CollectDevirtualizationInfo();
+    RunGenericSpecialization();
     RunFunctionInline(devirtInfo);
+    RunScalarReplacement();
+    RunMem2Reg();
     RedundantLoadElimination();
     RedundantGetOrThrowElimination();
     RunRangePropagation();
@@ -715,7 +811,9 @@ bool ToCHIR::RunOptimizationPassAndRulesChecking()
     RunArrayLambdaOpt();
     RunRedundantFutureOpt();
     RunNoSideEffectMarkerOpt();
+    RunLoopInvariantCodeMotion();
     RunGetRefToArrayElemOpt();
+    RunNoEscapeMarker();
     return true;
 }
 
@@ -824,6 +922,9 @@ void ToCHIR::RecordCodeInfoAtTheEnd()
     Utils::ProfileRecorder recorder("CHIR", "RecordCodeInfo");
     Utils::ProfileRecorder::RecordCodeInfo("all CHIR node", static_cast<int64_t>(builder.GetAllNodesNum()));
     Utils::ProfileRecorder::RecordCodeInfo("all CHIR type", static_cast<int64_t>(builder.GetTypesNum()));
+    auto [internedStrNum, internedStrBytes] = InternedString::GetPoolUsage();
+    Utils::ProfileRecorder::RecordCodeInfo("interned CHIR string", static_cast<int64_t>(internedStrNum));
+    Utils::ProfileRecorder::RecordCodeInfo("interned CHIR string bytes", static_cast<int64_t>(internedStrBytes));
     Utils::ProfileRecorder::RecordCodeInfo(
         "global func after CHIR stage", static_cast<int64_t>(chirPkg->GetGlobalFuncs().size()));
     int64_t wrapperFuncNum = 0;
@@ -0,0 +1,165 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#include "cangjie/CHIR/InternedString.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "cangjie/Utils/CheckUtils.h"
+
+using namespace Cangjie::CHIR;
+
+namespace {
+/**
+ * The texts are stored in fixed-size chunks which are never moved, so a text can be read by its id without any lock,
+ * and the keys of `ids` can refer to the stored texts.
+ */
+class StringPool {
+public:
+    static StringPool& Instance()
+    {
+        static StringPool pool;
+        return pool;
+    }
+
+    uint32_t Intern(std::string_view str)
+    {
+        {
+            std::shared_lock<std::shared_mutex> lock(mtx);
+            if (auto it = ids.find(str); it != ids.end()) {
+                return it->second;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(mtx);
+        if (auto it = ids.find(str); it != ids.end()) {
+            return it->second;
+        }
+        return Append(str);
+    }
+
+    const std::string& Get(uint32_t id) const
+    {
+        auto chunk = chunks[id >> CHUNK_BITS].load(std::memory_order_acquire);
+        CJC_NULLPTR_CHECK(chunk);
+        return chunk[id & CHUNK_MASK];
+    }
+
+    std::pair<size_t, size_t> GetUsage()
+    {
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        return {size, textBytes};
+    }
+
+    void Acquire()
+    {
+        std::unique_lock<std::shared_mutex> lock(mtx);
+        ++leases;
+    }
+
+    void Release()
+    {
+        std::unique_lock<std::shared_mutex> lock(mtx);
+        CJC_ASSERT(leases > 0);
+        if (--leases == 0) {
+            Clear();
+        }
+    }
+
+private:
+    static constexpr uint32_t CHUNK_BITS = 16;
+    static constexpr uint32_t CHUNK_SIZE = 1U << CHUNK_BITS;
+    static constexpr uint32_t CHUNK_MASK = CHUNK_SIZE - 1;
+    static constexpr uint32_t MAX_CHUNKS = 1U << (32 - CHUNK_BITS);
+
+    StringPool() : chunks(std::make_unique<std::atomic<std::string*>[]>(MAX_CHUNKS))
+    {
+        (void)Append("");
+    }
+
+    ~StringPool()
+    {
+        for (uint32_t i = 0; i < MAX_CHUNKS; ++i) {
+            delete[] chunks[i].load();
+        }
+    }
+
+    /// Drop all the strings but the empty one, the first chunk is kept for the next compilation.
+    void Clear()
+    {
+        ids.clear();
+        for (uint32_t i = 1; i < MAX_CHUNKS && chunks[i].load(std::memory_order_relaxed) != nullptr; ++i) {
+            delete[] chunks[i].load(std::memory_order_relaxed);
+            chunks[i].store(nullptr, std::memory_order_relaxed);
+        }
+        auto first = chunks[0].load(std::memory_order_relaxed);
+        for (uint32_t i = 0; i < std::min(size, CHUNK_SIZE); ++i) {
+            std::string{}.swap(first[i]);
+        }
+        size = 0;
+        textBytes = 0;
+        (void)Append("");
+    }
+
+    uint32_t Append(std::string_view str)
+    {
+        auto id = size;
+        auto chunkIdx = id >> CHUNK_BITS;
+        CJC_ASSERT(chunkIdx < MAX_CHUNKS);
+        auto chunk = chunks[chunkIdx].load(std::memory_order_relaxed);
+        if (chunk == nullptr) {
+            chunk = new std::string[CHUNK_SIZE];
+            chunks[chunkIdx].store(chunk, std::memory_order_release);
+        }
+        auto& stored = chunk[id & CHUNK_MASK];
+        stored = str;
+        ids.emplace(std::string_view{stored}, id);
+        ++size;
+        textBytes += str.size();
+        return id;
+    }
+
+    std::shared_mutex mtx;
+    std::unordered_map<std::string_view, uint32_t> ids;
+    std::unique_ptr<std::atomic<std::string*>[]> chunks;
+    uint32_t size{0};
+    size_t textBytes{0};
+    size_t leases{0};
+};
+} // namespace
+
+InternedString::InternedString(std::string_view str) : id(str.empty() ? 0 : StringPool::Instance().Intern(str))
+{
+}
+
+const std::string& InternedString::Str() const
+{
+    return StringPool::Instance().Get(id);
+}
+
+InternedString::PoolLease::PoolLease()
+{
+    StringPool::Instance().Acquire();
+}
+
+InternedString::PoolLease::~PoolLease()
+{
+    StringPool::Instance().Release();
+}
+
+std::pair<size_t, size_t> InternedString::GetPoolUsage()
+{
+    return StringPool::Instance().GetUsage();
+}
+
+std::ostream& Cangjie::CHIR::operator<<(std::ostream& out, const InternedString& str)
+{
+    return out << str.Str();
+}
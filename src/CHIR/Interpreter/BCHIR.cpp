@@ -34,6 +34,12 @@ void Bchir::Definition::Push8bytes(uint64_t value)
     (void)bytecode.emplace_back(static_cast<ByteCodeContent>(value >> byteCodeContentWidth));
 }
 
+void Bchir::Definition::PushInlineCache()
+{
+    CJC_ASSERT(bytecode.size() + INLINE_CACHE_SIZE <= BYTECODE_CONTENT_MAX);
+    bytecode.insert(bytecode.end(), INLINE_CACHE_SIZE, BYTECODE_CONTENT_MAX);
+}
+
 
 void Bchir::Definition::Set(ByteCodeIndex index, Bchir::ByteCodeContent value)
 {
@@ -154,6 +160,35 @@ IVal* Bchir::StoreStringArray(IArray&& array)
     return stringArrays.emplace_back(std::make_unique<IVal>(std::move(array))).get();
 }
 
+Bchir Bchir::Clone() const
+{
+    Bchir copy;
+    copy.packageName = packageName;
+    copy.initFuncsForConsts = initFuncsForConsts;
+    copy.skippedConstEvalFuncs = skippedConstEvalFuncs;
+    copy.globalVars = globalVars;
+    copy.functions = functions;
+    copy.globalInitFunc = globalInitFunc;
+    copy.globalInitLiteralFunc = globalInitLiteralFunc;
+    copy.sClassTable = sClassTable;
+    copy.mangledNames = mangledNames;
+    copy.types = types;
+    copy.strings = strings;
+    copy.stringArrays.reserve(stringArrays.size());
+    for (auto& array : stringArrays) {
+        copy.stringArrays.emplace_back(std::make_unique<IVal>(*array));
+    }
+    copy.fileNames = fileNames;
+    copy.mainMangledName = mainMangledName;
+    copy.linkedByteCode = linkedByteCode;
+    copy.classTable = classTable;
+    copy.defaultFuncPtrs = defaultFuncPtrs;
+    copy.expectedNumberOfArgumentsByMain = expectedNumberOfArgumentsByMain;
+    copy.numGlobalVars = numGlobalVars;
+    copy.isCore = isCore;
+    return copy;
+}
+
 size_t Bchir::AddType(Cangjie::CHIR::Type& ty)
 {
     auto idx = types.size();
@@ -316,26 +351,27 @@ const Bchir::SClassTable& Bchir::GetSClassTable() const
 
 void Bchir::AddClass(ByteCodeContent id, ClassInfo&& classInfo)
 {
-    classTable.emplace(id, classInfo);
+    CJC_ASSERT(!classInfo.mangledName.empty());
+    if (id >= classTable.size()) {
+        classTable.resize(static_cast<size_t>(id) + 1);
+    }
+    classTable[id] = std::move(classInfo);
 }
 
 const Bchir::ClassInfo& Bchir::GetClass(ByteCodeContent id) const
 {
-    auto it = classTable.find(id);
-    CJC_ASSERT(it != classTable.end());
-    return it->second;
+    CJC_ASSERT(ClassExists(id));
+    return classTable[id];
 }
 
 bool Bchir::ClassExists(ByteCodeContent id) const
 {
-    return classTable.find(id) != classTable.end();
+    return id < classTable.size() && !classTable[id].mangledName.empty();
 }
 
 Bchir::ByteCodeIndex Bchir::GetClassFinalizer(ByteCodeContent classId)
 {
-    auto classIt = classTable.find(classId);
-    CJC_ASSERT(classIt != classTable.end());
-    return classIt->second.finalizerIdx;
+    return GetClass(classId).finalizerIdx;
 }
 
 const Bchir::ClassTable& Bchir::GetClassTable() const
@@ -11,10 +11,14 @@
  */
 
 #include "cangjie/CHIR/Interpreter/BCHIRInterpreter.h"
+#include "cangjie/Basic/Print.h"
+#include <algorithm>
 #include <securec.h>
 
 using namespace Cangjie::CHIR::Interpreter;
 
+std::mutex BCHIRInterpreter::sourceManagerMtx;
+
 const IVal& BCHIRInterpreter::PeekValueOfGlobal(Bchir::VarIdx id) const
 {
     return env.PeekGlobal(id);
@@ -32,9 +36,47 @@ const Bchir& BCHIRInterpreter::GetBchir() const
     return bchir;
 }
 
+// With GCC and clang, each operation jumps to the handler of the next one through a table of label addresses,
+// instead of going back to the `switch`. This saves the bounds check of the `switch`, and gives each handler its
+// own indirect jump, which is easier to predict.
+#if defined(__GNUC__)
+#define BCHIR_THREADED_DISPATCH
+#endif
+
+#ifdef BCHIR_THREADED_DISPATCH
+#define OPCODE_CASE(ID)                                                                                                \
+    case OpCode::ID:                                                                                                   \
+    HANDLER_##ID
+#ifndef NDEBUG
+#define PRINT_DEBUG_INFO() PrintDebugInfo(pc)
+#else
+#define PRINT_DEBUG_INFO()
+#endif
+#define NEXT_OP()                                                                                                      \
+    do {                                                                                                               \
+        if (interpreterError) {                                                                                        \
+            return;                                                                                                    \
+        }                                                                                                              \
+        current = static_cast<OpCode>(bchir.Get(pc));                                                                  \
+        PRINT_DEBUG_INFO();                                                                                            \
+        pcExcOffset = 0;                                                                                               \
+        goto *handlers[static_cast<size_t>(current)];                                                                  \
+    } while (false)
+#else
+#define OPCODE_CASE(ID) case OpCode::ID
+#define NEXT_OP() continue
+#endif
+
 void BCHIRInterpreter::Interpret()
 {
     CJC_ASSERT(pc == baseIndex);
+#ifdef BCHIR_THREADED_DISPATCH
+    static const void* const handlers[static_cast<size_t>(OpCode::INVALID) + 1]{
+#define OPCODE(ID, VALUE, SIZE, HAS_EXC_HANDLER) &&HANDLER_##ID,
+#include "cangjie/CHIR/Interpreter/OpCodes.inc"
+#undef OPCODE
+    };
+#endif
     // no bound variables in the top-level thunk
     while (!interpreterError) {
         auto current = static_cast<OpCode>(bchir.Get(pc));
@@ -53,28 +95,30 @@ void BCHIRInterpreter::Interpret()
         // pcExcOffset is going to 0 if entry point was X or 1 is entry point was X_EXC
         Bchir::ByteCodeIndex pcExcOffset{0};
         switch (current) {
-            case OpCode::ALLOCATE_RAW_ARRAY: {
+            OPCODE_CASE(ALLOCATE_RAW_ARRAY): {
                 InterpretAllocateRawArray<false, false>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::ALLOCATE_EXC:
+            OPCODE_CASE(ALLOCATE_EXC):
                 pcExcOffset = 1;
                 // intended missing break
                 // for the time being allocate never raises exception
-            case OpCode::ALLOCATE: {
+            OPCODE_CASE(ALLOCATE): {
+                CollectGarbageIfNeeded();
                 auto ptr = IPointer();
                 ptr.content = AllocateValue(INullptr());
                 interpStack.ArgsPush(ptr);
                 pc += 1 + pcExcOffset;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::ALLOCATE_STRUCT_EXC:
+            OPCODE_CASE(ALLOCATE_STRUCT_EXC):
                 pcExcOffset = 1;
                 // intended missing break
                 // for the time being allocate never raises exception
-            case OpCode::ALLOCATE_STRUCT: {
+            OPCODE_CASE(ALLOCATE_STRUCT): {
+                CollectGarbageIfNeeded();
                 auto numField = bchir.Get(pc + 1);
-                std::vector<IVal> content;
+                IValVector content;
                 for (size_t i = 0; i < numField; i++) {
                     content.emplace_back(INullptr());
                 }
@@ -82,16 +126,17 @@ void BCHIRInterpreter::Interpret()
                 ptr.content = AllocateValue(ITuple{std::move(content)});
                 interpStack.ArgsPush(ptr);
                 pc += Bchir::FLAG_TWO + pcExcOffset;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::ALLOCATE_CLASS_EXC:
+            OPCODE_CASE(ALLOCATE_CLASS_EXC):
                 pcExcOffset = 1;
                 // intended missing break
                 // for the time being allocate never raises exception
-            case OpCode::ALLOCATE_CLASS: {
+            OPCODE_CASE(ALLOCATE_CLASS): {
+                CollectGarbageIfNeeded();
                 auto classId = bchir.Get(pc + 1);
                 auto numField = bchir.Get(pc + Bchir::FLAG_TWO);
-                std::vector<IVal> content;
+                IValVector content;
                 for (size_t i = 0; i < numField; i++) {
                     content.emplace_back(INullptr());
                 }
@@ -99,73 +144,96 @@ void BCHIRInterpreter::Interpret()
                 ptr.content = AllocateValue(IObject{classId, std::move(content)});
                 interpStack.ArgsPush(ptr);
                 pc += Bchir::FLAG_THREE + pcExcOffset;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::FRAME: {
+            OPCODE_CASE(FRAME): {
                 auto num = bchir.Get(pc + 1);
                 env.AllocateLocalVarsForFrame(static_cast<size_t>(num));
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::LVAR: {
+            OPCODE_CASE(LVAR): {
                 auto varIdx = pc + 1;
                 auto var = bchir.Get(varIdx);
                 // update pc for next operation
                 pc += Bchir::FLAG_TWO;
 
                 interpStack.ArgsPushIValRef(env.GetLocal(var));
-                continue;
+                NEXT_OP();
             }
-            case OpCode::GVAR: {
+            OPCODE_CASE(GVAR): {
                 auto varId = bchir.Get(pc + 1);
                 auto& val = env.GetGlobal(varId);
                 interpStack.ArgsPush(IPointer{&val});
                 // update pc for next operation
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::GVAR_SET: {
+            OPCODE_CASE(GVAR_SET): {
                 auto varId = bchir.Get(pc + 1);
                 env.SetGlobal(varId, interpStack.ArgsPopIVal());
                 pc = pc + 1 + 1;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::LVAR_SET: {
+            OPCODE_CASE(LVAR_SET): {
                 auto varId = bchir.Get(pc + 1);
                 env.SetLocal(varId, interpStack.ArgsPopIVal());
                 pc = pc + 1 + 1;
-                continue;
+                NEXT_OP();
+            }
+            OPCODE_CASE(LVAR_LVAR): {
+                // LVAR :: a :: LVAR :: b
+                interpStack.ArgsPushIValRef(env.GetLocal(bchir.Get(pc + 1)));
+                interpStack.ArgsPushIValRef(env.GetLocal(bchir.Get(pc + Bchir::FLAG_THREE)));
+                pc += Bchir::FLAG_FOUR;
+                NEXT_OP();
+            }
+            OPCODE_CASE(LVAR_SET_LVAR): {
+                // LVAR_SET :: a :: LVAR :: b
+                env.SetLocal(bchir.Get(pc + 1), interpStack.ArgsPopIVal());
+                interpStack.ArgsPushIValRef(env.GetLocal(bchir.Get(pc + Bchir::FLAG_THREE)));
+                pc += Bchir::FLAG_FOUR;
+                NEXT_OP();
+            }
+            OPCODE_CASE(LVAR_SET_BRANCH): {
+                // LVAR_SET :: a :: LVAR :: a :: BRANCH :: t :: f
+                // charged like the BRANCH it replaces, the other fused operations don't transfer control
+                ChargeStep();
+                auto cond = interpStack.ArgsPop<IBool>();
+                env.SetLocal(bchir.Get(pc + 1), cond);
+                pc = cond.content ? bchir.Get(pc + Bchir::FLAG_FIVE) : bchir.Get(pc + Bchir::FLAG_SIX);
+                NEXT_OP();
             }
-            case OpCode::UINT8: {
+            OPCODE_CASE(UINT8): {
                 auto valIdx = pc + 1;
                 interpStack.ArgsPush(IValUtils::PrimitiveValue<IUInt8>(static_cast<uint8_t>(bchir.Get(valIdx))));
                 // update pc for next operation
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::UINT16: {
+            OPCODE_CASE(UINT16): {
                 auto valIdx = pc + 1;
                 interpStack.ArgsPush(IValUtils::PrimitiveValue<IUInt16>(static_cast<uint16_t>(bchir.Get(valIdx))));
                 // update pc for next operation
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::UINT32: {
+            OPCODE_CASE(UINT32): {
                 auto valIdx = pc + 1;
                 interpStack.ArgsPush(IValUtils::PrimitiveValue<IUInt32>(static_cast<uint32_t>(bchir.Get(valIdx))));
                 // update pc for next operation
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::UINT64: {
+            OPCODE_CASE(UINT64): {
                 auto valIdx = pc + 1;
                 interpStack.ArgsPush(
                     IValUtils::PrimitiveValue<IUInt64>(static_cast<uint64_t>(bchir.Get8bytes(valIdx))));
                 // update pc for next operation
                 pc += Bchir::FLAG_THREE;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::UINTNAT: {
+            OPCODE_CASE(UINTNAT): {
                 auto valIdx = pc + 1;
 #if (defined(__x86_64__) || defined(__aarch64__))
                 interpStack.ArgsPush(
@@ -176,37 +244,37 @@ void BCHIRInterpreter::Interpret()
 #endif
                 // update pc for next operation
                 pc += Bchir::FLAG_THREE;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::INT8: {
+            OPCODE_CASE(INT8): {
                 auto valIdx = pc + 1;
                 interpStack.ArgsPush(IValUtils::PrimitiveValue<IInt8>(static_cast<int8_t>(bchir.Get(valIdx))));
                 // update pc for next operation
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::INT16: {
+            OPCODE_CASE(INT16): {
                 auto valIdx = pc + 1;
                 interpStack.ArgsPush(IValUtils::PrimitiveValue<IInt16>(static_cast<int16_t>(bchir.Get(valIdx))));
                 // update pc for next operation
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::INT32: {
+            OPCODE_CASE(INT32): {
                 auto valIdx = pc + 1;
                 interpStack.ArgsPush(IValUtils::PrimitiveValue<IInt32>(static_cast<int32_t>(bchir.Get(valIdx))));
                 // update pc for next operation
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::INT64: {
+            OPCODE_CASE(INT64): {
                 auto valIdx = pc + 1;
                 interpStack.ArgsPush(IValUtils::PrimitiveValue<IInt64>(static_cast<int64_t>(bchir.Get8bytes(valIdx))));
                 // update pc for next operation
                 pc += Bchir::FLAG_THREE;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::INTNAT: {
+            OPCODE_CASE(INTNAT): {
                 auto valIdx = pc + 1;
 #if (defined(__x86_64__) || defined(__aarch64__))
                 interpStack.ArgsPush(IValUtils::PrimitiveValue<IIntNat>(static_cast<int64_t>(bchir.Get8bytes(valIdx))));
@@ -215,9 +283,9 @@ void BCHIRInterpreter::Interpret()
 #endif
                 // update pc for next operation
                 pc += Bchir::FLAG_THREE;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::FLOAT16: {
+            OPCODE_CASE(FLOAT16): {
                 auto valIdx = pc + 1;
                 auto tmp = bchir.Get(valIdx);
                 // Value for a FLOAT16 instruction is a 32-bit float.
@@ -228,9 +296,9 @@ void BCHIRInterpreter::Interpret()
                 }
                 interpStack.ArgsPush(IValUtils::PrimitiveValue<IFloat16>(static_cast<float>(f)));
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::FLOAT32: {
+            OPCODE_CASE(FLOAT32): {
                 auto valIdx = pc + 1;
                 auto tmp = bchir.Get(valIdx);
                 float f;
@@ -240,9 +308,9 @@ void BCHIRInterpreter::Interpret()
                 }
                 interpStack.ArgsPush(IValUtils::PrimitiveValue<IFloat32>(static_cast<float>(f)));
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::FLOAT64: {
+            OPCODE_CASE(FLOAT64): {
                 auto valIdx = pc + 1;
                 auto tmp = bchir.Get8bytes(valIdx);
                 double d;
@@ -252,40 +320,41 @@ void BCHIRInterpreter::Interpret()
                 }
                 interpStack.ArgsPush(IValUtils::PrimitiveValue<IFloat64>(d));
                 pc += Bchir::FLAG_THREE;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::RUNE: {
+            OPCODE_CASE(RUNE): {
                 auto valIdx = pc + 1;
                 interpStack.ArgsPush(IValUtils::PrimitiveValue<IRune>(bchir.Get(static_cast<char32_t>(valIdx))));
                 // update pc for next operation
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BOOL: {
+            OPCODE_CASE(BOOL): {
                 auto valIdx = pc + 1;
                 interpStack.ArgsPush(IValUtils::PrimitiveValue<IBool>(bchir.Get(valIdx)));
                 // update pc for next operation
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::UNIT: {
+            OPCODE_CASE(UNIT): {
                 interpStack.ArgsPush(IUnit());
                 // update pc for next operation
                 pc += 1;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::NULLPTR: {
+            OPCODE_CASE(NULLPTR): {
                 interpStack.ArgsPush(INullptr());
                 // update pc for next operation
                 pc += 1;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::STRING: {
+            OPCODE_CASE(STRING): {
+                CollectGarbageIfNeeded();
                 InterpretString();
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::TUPLE: {
+            OPCODE_CASE(TUPLE): {
                 auto sizeIdx = pc + 1;
                 auto size = bchir.Get(sizeIdx);
                 pc = sizeIdx + 1;
@@ -293,188 +362,190 @@ void BCHIRInterpreter::Interpret()
                 auto tuple = ITuple();
                 interpStack.ArgsPop(size, tuple.content);
                 interpStack.ArgsPush(std::move(tuple));
-                continue;
+                NEXT_OP();
             }
-            case OpCode::VARRAY: {
+            OPCODE_CASE(VARRAY): {
                 auto sizeIdx = pc + 1;
                 auto size = bchir.Get(sizeIdx);
                 auto array = IArray();
                 interpStack.ArgsPop(size, array.content);
                 interpStack.ArgsPush(std::move(array));
                 pc = sizeIdx + 1;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::VARRAY_GET: {
+            OPCODE_CASE(VARRAY_GET): {
                 InterpretVArrayGet();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::RAW_ARRAY_LITERAL_INIT: {
+            OPCODE_CASE(RAW_ARRAY_LITERAL_INIT): {
                 InterpretRawArrayLiteralInit();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::FUNC: {
+            OPCODE_CASE(FUNC): {
                 // FUNC :: THUNK_IDX :: NEXT_OP
                 auto thunkIdx = pc + 1;
                 auto func = IFunc{bchir.Get(thunkIdx)};
                 interpStack.ArgsPush(func);
                 pc = thunkIdx + 1;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::RETURN: {
+            OPCODE_CASE(RETURN): {
                 InterpretReturn();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::EXIT: {
+            OPCODE_CASE(EXIT): {
                 // we are done
                 return;
             }
-            case OpCode::DROP: {
+            OPCODE_CASE(DROP): {
                 interpStack.ArgsPopBack();
                 pc += 1;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::JUMP: {
+            OPCODE_CASE(JUMP): {
+                ChargeStep();
                 pc = bchir.Get(pc + 1);
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BRANCH: {
+            OPCODE_CASE(BRANCH): {
+                ChargeStep();
                 auto cond = interpStack.ArgsPop<IBool>();
                 if (cond.content) {
                     pc = bchir.Get(pc + 1);
                 } else {
                     pc = bchir.Get(pc + Bchir::FLAG_TWO);
                 }
-                continue;
+                NEXT_OP();
             }
-            case OpCode::UN_NEG_EXC: {
+            OPCODE_CASE(UN_NEG_EXC): {
                 BinOp<OpCode::UN_NEG_EXC>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_ADD_EXC: {
+            OPCODE_CASE(BIN_ADD_EXC): {
                 BinOp<OpCode::BIN_ADD_EXC>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_SUB_EXC: {
+            OPCODE_CASE(BIN_SUB_EXC): {
                 BinOp<OpCode::BIN_SUB_EXC>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_MUL_EXC: {
+            OPCODE_CASE(BIN_MUL_EXC): {
                 BinOp<OpCode::BIN_MUL_EXC>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_DIV_EXC: {
+            OPCODE_CASE(BIN_DIV_EXC): {
                 BinOp<OpCode::BIN_DIV_EXC>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_MOD_EXC: {
+            OPCODE_CASE(BIN_MOD_EXC): {
                 BinOp<OpCode::BIN_MOD_EXC>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_EXP_EXC: {
+            OPCODE_CASE(BIN_EXP_EXC): {
                 BinOp<OpCode::BIN_EXP_EXC>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_LSHIFT_EXC: {
+            OPCODE_CASE(BIN_LSHIFT_EXC): {
                 BinOp<OpCode::BIN_LSHIFT_EXC>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_RSHIFT_EXC: {
+            OPCODE_CASE(BIN_RSHIFT_EXC): {
                 BinOp<OpCode::BIN_RSHIFT_EXC>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::UN_NEG: {
+            OPCODE_CASE(UN_NEG): {
                 BinOp<OpCode::UN_NEG>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::UN_DEC: {
+            OPCODE_CASE(UN_DEC): {
                 BinOp<OpCode::UN_DEC>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::UN_INC: {
+            OPCODE_CASE(UN_INC): {
                 BinOp<OpCode::UN_INC>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::UN_NOT: {
+            OPCODE_CASE(UN_NOT): {
                 BinOpFixedBool<OpCode::UN_NOT>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::UN_BITNOT: {
+            OPCODE_CASE(UN_BITNOT): {
                 BinOp<OpCode::UN_BITNOT>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_ADD: {
+            OPCODE_CASE(BIN_ADD): {
                 BinOp<OpCode::BIN_ADD>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_SUB: {
+            OPCODE_CASE(BIN_SUB): {
                 BinOp<OpCode::BIN_SUB>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_MUL: {
+            OPCODE_CASE(BIN_MUL): {
                 BinOp<OpCode::BIN_MUL>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_DIV: {
+            OPCODE_CASE(BIN_DIV): {
                 BinOp<OpCode::BIN_DIV>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_MOD: {
+            OPCODE_CASE(BIN_MOD): {
                 BinOp<OpCode::BIN_MOD>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_EXP: {
+            OPCODE_CASE(BIN_EXP): {
                 BinOp<OpCode::BIN_EXP>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_LT: {
+            OPCODE_CASE(BIN_LT): {
                 BinOp<OpCode::BIN_LT>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_GT: {
+            OPCODE_CASE(BIN_GT): {
                 BinOp<OpCode::BIN_GT>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_LE: {
+            OPCODE_CASE(BIN_LE): {
                 BinOp<OpCode::BIN_LE>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_GE: {
+            OPCODE_CASE(BIN_GE): {
                 BinOp<OpCode::BIN_GE>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_NOTEQ: {
+            OPCODE_CASE(BIN_NOTEQ): {
                 BinOp<OpCode::BIN_NOTEQ>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_EQUAL: {
+            OPCODE_CASE(BIN_EQUAL): {
                 BinOp<OpCode::BIN_EQUAL>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_BITAND: {
+            OPCODE_CASE(BIN_BITAND): {
                 BinOp<OpCode::BIN_BITAND>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_BITOR: {
+            OPCODE_CASE(BIN_BITOR): {
                 BinOp<OpCode::BIN_BITOR>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_BITXOR: {
+            OPCODE_CASE(BIN_BITXOR): {
                 BinOp<OpCode::BIN_BITXOR>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_LSHIFT: {
+            OPCODE_CASE(BIN_LSHIFT): {
                 BinOp<OpCode::BIN_LSHIFT>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::BIN_RSHIFT: {
+            OPCODE_CASE(BIN_RSHIFT): {
                 BinOp<OpCode::BIN_RSHIFT>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::FIELD_TPL: {
+            OPCODE_CASE(FIELD_TPL): {
                 InterpretFieldTpl();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::FIELD: {
+            OPCODE_CASE(FIELD): {
                 auto fieldIdx = pc + 1;
                 auto field = bchir.Get(fieldIdx);
                 // OPTIMIZE
@@ -488,123 +559,143 @@ void BCHIRInterpreter::Interpret()
                     interpStack.ArgsPushIVal(std::move(object.content[field - 1]));
                 }
                 pc = fieldIdx + 1;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::INVOKE_EXC: {
+            OPCODE_CASE(INVOKE_EXC): {
                 InterpretInvoke<OpCode::INVOKE_EXC>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::INVOKE: {
+            OPCODE_CASE(INVOKE): {
                 InterpretInvoke<OpCode::INVOKE>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::TYPECAST: {
+            OPCODE_CASE(TYPECAST): {
                 InterpretTypeCast();
                 if (raiseExnToTopLevel) {
                     return;
                 }
-                continue;
+                NEXT_OP();
             }
-            case OpCode::INSTANCEOF: {
+            OPCODE_CASE(INSTANCEOF): {
                 auto ptr = interpStack.ArgsPop<IPointer>();
                 auto& obj = IValUtils::Get<IObject>(*ptr.content);
                 auto lhs = obj.classId;
                 auto rhs = bchir.Get(pc + 1);
-                interpStack.ArgsPush(IBool{IsSubclass(lhs, rhs)});
-                pc += Bchir::FLAG_TWO;
-                continue;
-            }
-            case OpCode::BOX: {
+                auto isSubclass = LookUpInlineCache(
+                    pc + Bchir::FLAG_TWO, lhs, [this, lhs, rhs]() { return IsSubclass(lhs, rhs) ? 1U : 0U; });
+                interpStack.ArgsPush(IBool{isSubclass != 0});
+                pc += Bchir::FLAG_TWO + Bchir::INLINE_CACHE_SIZE;
+                NEXT_OP();
+            }
+            OPCODE_CASE(BOX): {
+                CollectGarbageIfNeeded();
                 auto classId = bchir.Get(pc + 1);
-                std::vector<IVal> content;
+                IValVector content;
                 interpStack.ArgsPop(1, content);
                 auto ptr = IPointer();
                 ptr.content = AllocateValue(IObject{classId, std::move(content)});
                 interpStack.ArgsPush(std::move(ptr));
                 pc += Bchir::FLAG_TWO;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::UNBOX: {
+            OPCODE_CASE(UNBOX): {
                 auto ptr = interpStack.ArgsPop<IPointer>();
                 auto& obj = IValUtils::Get<IObject>(*ptr.content);
                 auto value = obj.content[0];
                 interpStack.ArgsPushIVal(std::move(value));
                 pc++;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::UNBOX_REF: {
+            OPCODE_CASE(UNBOX_REF): {
                 auto ptr = interpStack.ArgsPop<IPointer>();
                 auto& obj = IValUtils::Get<IObject>(*ptr.content);
                 ptr.content = &obj.content[0]; // reusing ptr
                 interpStack.ArgsPush(std::move(ptr));
                 pc++;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::APPLY: {
+            OPCODE_CASE(APPLY): {
                 InterpretApply<OpCode::APPLY>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::APPLY_EXC: {
+            OPCODE_CASE(APPLY_EXC): {
                 InterpretApply<OpCode::APPLY_EXC>();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::ASG: {
+            OPCODE_CASE(ASG): {
                 auto ptr = interpStack.ArgsPop<IPointer>();
                 auto value = interpStack.ArgsPopIVal();
                 *ptr.content = std::move(value);
                 interpStack.ArgsPush(IUnit());
                 pc += 1;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::STOREINREF: {
+            OPCODE_CASE(STOREINREF): {
                 InterpretStoreInRef();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::STORE: {
+            OPCODE_CASE(STORE): {
                 auto ptr = interpStack.ArgsPop<IPointer>();
                 auto value = interpStack.ArgsPopIVal();
                 *ptr.content = std::move(value);
                 pc += 1;
-                continue;
+                NEXT_OP();
             }
-            case OpCode::DEREF: {
+            OPCODE_CASE(DEREF): {
                 InterpretDeref();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::INTRINSIC0: {
+            OPCODE_CASE(INTRINSIC0): {
                 InterpretIntrinsic<OpCode::INTRINSIC0>();
                 if (raiseExnToTopLevel) {
                     return;
                 }
-                continue;
+                NEXT_OP();
             }
-            case OpCode::INTRINSIC1: {
+            OPCODE_CASE(INTRINSIC1): {
                 InterpretIntrinsic<OpCode::INTRINSIC1>();
                 if (raiseExnToTopLevel) {
                     return;
                 }
-                continue;
+                NEXT_OP();
             }
-            case OpCode::SWITCH: {
+            OPCODE_CASE(SWITCH): {
                 InterpretSwitch();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::GETREF: {
+            OPCODE_CASE(GETREF): {
                 InterpretGetRef();
-                continue;
+                NEXT_OP();
             }
-            case OpCode::SYSCALL:
-            case OpCode::CAPPLY:
-            case OpCode::ABORT: {
+            OPCODE_CASE(SYSCALL):
+            OPCODE_CASE(CAPPLY):
+            OPCODE_CASE(ABORT): {
                 if (!isConstEval) {
                     FailWith(pc, "operation not currently supported in const eval", DiagKind::const_eval_unsupported);
+                } else {
+                    CheckAbortedInSkippedConstEvalFunc(pc);
                 }
                 interpreterError = true;
                 return;
             }
-            case OpCode::SPAWN:
-            case OpCode::NOT_SUPPORTED:
-            case OpCode::INVALID:
+            OPCODE_CASE(SPAWN):
+            OPCODE_CASE(ALLOCATE_RAW_ARRAY_EXC):
+            OPCODE_CASE(ALLOCATE_RAW_ARRAY_LITERAL):
+            OPCODE_CASE(ALLOCATE_RAW_ARRAY_LITERAL_EXC):
+            OPCODE_CASE(RAW_ARRAY_INIT_BY_VALUE):
+            OPCODE_CASE(ARRAY):
+            OPCODE_CASE(VARRAY_BY_VALUE):
+            OPCODE_CASE(TYPECAST_EXC):
+            OPCODE_CASE(RAISE):
+            OPCODE_CASE(RAISE_EXC):
+            OPCODE_CASE(GET_EXCEPTION):
+            OPCODE_CASE(INTRINSIC2):
+            OPCODE_CASE(INTRINSIC0_EXC):
+            OPCODE_CASE(INTRINSIC1_EXC):
+            OPCODE_CASE(INTRINSIC2_EXC):
+            OPCODE_CASE(SPAWN_EXC):
+            OPCODE_CASE(NOT_SUPPORTED):
+            OPCODE_CASE(INVALID):
             default: {
                 FailWith(pc, "operation not currently supported in interpreter", DiagKind::interp_unsupported,
                     "Interpret", GetOpCodeLabel(current));
@@ -614,6 +705,13 @@ void BCHIRInterpreter::Interpret()
     }
 }
 
+#undef NEXT_OP
+#undef OPCODE_CASE
+#ifdef BCHIR_THREADED_DISPATCH
+#undef PRINT_DEBUG_INFO
+#undef BCHIR_THREADED_DISPATCH
+#endif
+
 void BCHIRInterpreter::InterpretString()
 {
     // String values in the interpreter must match the definition of strings in the core library
@@ -713,8 +811,8 @@ void BCHIRInterpreter::InterpretReturn()
             [[fallthrough]];
         }
         case OpCode::INVOKE: {
-            // ctrl.byteCodePtr + NUMBER_OF_ARGS + 1
-            pc = ctrl.byteCodePtr + 1 + 1 + 1;
+            // ctrl.byteCodePtr + NUMBER_OF_ARGS + METHOD_ID + INLINE_CACHE + 1
+            pc = ctrl.byteCodePtr + 1 + 1 + Bchir::INLINE_CACHE_SIZE + 1;
             break;
         }
         case OpCode::APPLY_EXC: {
@@ -740,6 +838,20 @@ void BCHIRInterpreter::RaiseError(Bchir::ByteCodeIndex, const std::string&)
     interpreterError = true;
 }
 
+void BCHIRInterpreter::CheckAbortedInSkippedConstEvalFunc(Bchir::ByteCodeIndex abortIdx) const
+{
+    // the abort functions are FRAME :: 0 :: ABORT, with the FRAME annotated with the missing function
+    if (abortIdx < Bchir::FLAG_TWO) {
+        return;
+    }
+    auto& mangledName = bchir.GetLinkedByteCode().GetMangledNameAnnotation(abortIdx - Bchir::FLAG_TWO);
+    if (bchir.skippedConstEvalFuncs.count(mangledName) != 0) {
+        // const evaluation would silently fall back to runtime initialization
+        Debugln("const evaluation called `", mangledName, "`, which wasn't translated as it was found unreachable");
+        CJC_ASSERT(false && "const evaluable function missed by CollectConstEvalFuncs");
+    }
+}
+
 void BCHIRInterpreter::RaiseArithmeticExceptionMsg(Bchir::ByteCodeIndex sourcePc, const std::string& str)
 {
     ReportConstEvalException(sourcePc, "ArithmeticException: " + str);
@@ -778,6 +890,7 @@ void BCHIRInterpreter::ReportConstEvalException(Bchir::ByteCodeIndex opIdx, std:
     Cangjie::Position errorPosition = DEFAULT_POSITION;
     auto applyPosition = bchir.GetLinkedByteCode().GetCodePositionAnnotation(opIdx);
     auto fileName = bchir.GetFileName(applyPosition.fileID);
+    std::lock_guard<std::mutex> lock(sourceManagerMtx);
     auto fileId = diag.GetSourceManager().GetFileID(fileName);
     if (fileId != -1 && !diag.GetSourceManager().GetSource(static_cast<unsigned int>(fileId)).buffer.empty()) {
         errorPosition = Cangjie::Position(static_cast<unsigned int>(fileId), static_cast<int>(applyPosition.line),
@@ -1020,6 +1133,7 @@ template <OpCode op> void BCHIRInterpreter::InterpretTypeCast()
 
 template <OpCode op> void BCHIRInterpreter::InterpretApply()
 {
+    ChargeStep();
     // APPLY :: NUMBER_OF_ARGS
     auto numberArgsIdx = pc + 1;
     size_t numberArgs = bchir.Get(numberArgsIdx);
@@ -1036,28 +1150,47 @@ template <OpCode op> void BCHIRInterpreter::InterpretApply()
 
 Bchir::ByteCodeIndex BCHIRInterpreter::FindMethod(Bchir::ByteCodeContent classId, Bchir::ByteCodeContent nameId)
 {
-    auto classInfoIt = bchir.GetClassTable().find(classId);
-    CJC_ASSERT(classInfoIt != bchir.GetClassTable().end());
-    auto& classInfo = classInfoIt->second;
-    auto methodIt = classInfo.vtable.find(nameId);
-    CJC_ASSERT(methodIt != classInfo.vtable.end());
+    auto& vtable = bchir.GetClass(classId).vtable;
+    auto methodIt = std::lower_bound(vtable.begin(), vtable.end(), nameId,
+        [](const auto& entry, Bchir::ByteCodeContent id) { return entry.first < id; });
+    CJC_ASSERT(methodIt != vtable.end() && methodIt->first == nameId);
     return methodIt->second;
 }
 
+template <typename LookUp>
+Bchir::ByteCodeContent BCHIRInterpreter::LookUpInlineCache(
+    Bchir::ByteCodeIndex cacheIdx, Bchir::ByteCodeContent classId, LookUp lookUp)
+{
+    for (Bchir::ByteCodeContent i = 0; i < Bchir::INLINE_CACHE_ENTRIES; ++i) {
+        auto entryIdx = cacheIdx + i * Bchir::FLAG_TWO;
+        auto cachedClassId = bchir.Get(entryIdx);
+        if (cachedClassId == classId) {
+            return bchir.Get(entryIdx + 1);
+        }
+        if (cachedClassId == Bchir::BYTECODE_CONTENT_MAX) {
+            auto value = lookUp();
+            bchir.Set(entryIdx, classId);
+            bchir.Set(entryIdx + 1, value);
+            return value;
+        }
+    }
+    // the operation has seen more classes than the inline cache can hold
+    return lookUp();
+}
+
 bool BCHIRInterpreter::IsSubclass(Bchir::ByteCodeContent lhs, Bchir::ByteCodeContent rhs)
 {
     if (lhs == rhs) {
         return true;
     }
-    auto& classTable = bchir.GetClassTable();
-    auto it = classTable.find(lhs);
-    CJC_ASSERT(it != classTable.end());
-    return it->second.superClasses.find(rhs) != it->second.superClasses.end();
+    auto& superClasses = bchir.GetClass(lhs).superClasses;
+    return std::binary_search(superClasses.begin(), superClasses.end(), rhs);
 }
 
 template <OpCode op> void BCHIRInterpreter::InterpretInvoke()
 {
-    // INVOKE :: NUMBER_OF_ARGS
+    ChargeStep();
+    // INVOKE :: NUMBER_OF_ARGS :: METHOD_ID :: INLINE_CACHE
     auto numberArgsIdx = pc + 1;
     size_t numberArgs = bchir.Get(numberArgsIdx);
     size_t nameId = bchir.Get(numberArgsIdx + 1);
@@ -1068,7 +1201,8 @@ template <OpCode op> void BCHIRInterpreter::InterpretInvoke()
     auto& object = IValUtils::Get<IObject>(*ptr.content);
     auto classId = object.classId;
 
-    auto funcThunkIdx = FindMethod(classId, static_cast<unsigned>(nameId));
+    auto funcThunkIdx = LookUpInlineCache(numberArgsIdx + Bchir::FLAG_TWO, classId,
+        [this, classId, nameId]() { return FindMethod(classId, static_cast<unsigned>(nameId)); });
 
     // add apply to opStack so that we know where to continue when we reach RETURN
     interpStack.CtrlPush({op, funcThunkIdx, pc, env.GetBP()});
@@ -1572,8 +1706,16 @@ const IResult& BCHIRInterpreter::GetLastResult() const
     return result;
 }
 
+void BCHIRInterpreter::SetLimits(size_t maxMemory, size_t maxSteps)
+{
+    memoryLimit = maxMemory;
+    stepsLeft = maxSteps;
+    arena.SetMemoryLimit(maxMemory);
+}
+
 void BCHIRInterpreter::InterpretSwitch()
 {
+    ChargeStep();
     pc += 1;
     switch (static_cast<CHIR::Type::TypeKind>(bchir.Get(pc))) {
         case CHIR::Type::TypeKind::TYPE_UINT8: {
@@ -1664,6 +1806,26 @@ IVal* BCHIRInterpreter::AllocateValue(IVal&& value)
     return ptr;
 }
 
+void BCHIRInterpreter::CollectGarbageIfNeeded()
+{
+    if (!arena.ShouldCollect()) {
+        return;
+    }
+    arena.BeginCollection();
+    auto markReachable = [this](const IVal& root) { arena.MarkReachable(root); };
+    env.ForEachVar(markReachable);
+    interpStack.ArgsForEach(markReachable);
+    if (exception.has_value()) {
+        markReachable(*exception);
+    }
+    if (auto lastResult = std::get_if<ISuccess>(&result)) {
+        markReachable(lastResult->val);
+    }
+    if (arena.FinishCollection() > memoryLimit) {
+        FailWith(pc, "memory limit exceeded", DiagKind::const_eval_limit_exceeded, "memory");
+    }
+}
+
 #ifndef NDEBUG
 std::string BCHIRInterpreter::DebugGetPosition(Bchir::ByteCodeIndex index)
 {
@@ -1712,6 +1874,7 @@ void BCHIRInterpreter::PrepareRuntimeDebug(const GlobalOptions& options)
 
 template <bool isLiteral, bool isExc> void BCHIRInterpreter::InterpretAllocateRawArray()
 {
+    CollectGarbageIfNeeded();
     auto initPc = pc++;
     auto array = IArray();
     if constexpr (isLiteral) {
@@ -1731,6 +1894,9 @@ template <bool isLiteral, bool isExc> void BCHIRInterpreter::InterpretAllocateRa
         if (static_cast<size_t>(size + 1) > array.content.max_size()) {
             return RaiseOutOfMemoryError(initPc);
         }
+        if (static_cast<size_t>(size + 1) * sizeof(IVal) > memoryLimit) {
+            return FailWith(initPc, "memory limit exceeded", DiagKind::const_eval_limit_exceeded, "memory");
+        }
 
         array.content.reserve(static_cast<size_t>(size) + 1);
         array.content.emplace_back(std::move(sizeIVal));
@@ -1760,7 +1926,7 @@ void BCHIRInterpreter::InterpretVArrayGet()
 {
     auto initPc = pc++;
     auto pathSize = bchir.Get(pc++);
-    std::vector<IVal> path;
+    IValVector path;
     interpStack.ArgsPop(pathSize, path);
     auto array = interpStack.ArgsPop<IArray>();
     for (size_t i = 0; i < pathSize - 1; ++i) {
@@ -1781,7 +1947,7 @@ void BCHIRInterpreter::InterpretRawArrayLiteralInit()
     pc++; // to array size
     auto size = bchir.Get(pc);
     pc++; // to next operation
-    std::vector<IVal> elems;
+    IValVector elems;
     interpStack.ArgsPop(size, elems);
     auto arrayPtr = interpStack.ArgsPop<IPointer>();
     auto& array = IValUtils::Get<IArray>(*arrayPtr.content);
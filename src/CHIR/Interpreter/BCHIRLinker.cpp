@@ -10,6 +10,7 @@
  * This file implements a linker for the BCHIR Interpreter.
  */
 
+#include <algorithm>
 #include <queue>
 
 #include "cangjie/CHIR/Interpreter/BCHIRPrinter.h"
@@ -41,6 +42,8 @@ std::unordered_map<Bchir::ByteCodeIndex, IVal> BCHIRLinker::Run(
         const auto& bchir = packages[i];
         if constexpr (ForConstEval) {
             LinkAndInitGlobalVars(bchir, gvarId2InitIVal, i == packages.size() - 1);
+            topBchir.skippedConstEvalFuncs.insert(
+                bchir.skippedConstEvalFuncs.begin(), bchir.skippedConstEvalFuncs.end());
         }
         if (bchir.GetMainMangledName() != "") {
             // always get the main from the most recent package
@@ -56,6 +59,7 @@ std::unordered_map<Bchir::ByteCodeIndex, IVal> BCHIRLinker::Run(
     topDef.Push(0); // 0 is just a dummy value. The real value will be set below with `targetJumpIdx`.
     // Second traversal to link functions
     LinkFunctions(packages);
+    GenerateAbortFunctionsForMissingFunctions();
 
     // Set the jump target. The interpretation of the top-level definitions should start at `topDef.NextIndex()`.
     topDef.Set(targetJumpIdx, topDef.NextIndex());
@@ -115,11 +119,45 @@ void BCHIRLinker::GenerateCallsToConstInitFunctions(const std::vector<std::strin
 
 void BCHIRLinker::GenerateDummyAbortFunction()
 {
-    dummyAbortFuncIdx = topDef.NextIndex();
+    dummyAbortFuncIdx = GenerateAbortFunction("linker_dummy_abort_function");
+}
+
+Bchir::ByteCodeIndex BCHIRLinker::GenerateAbortFunction(const std::string& mangledName)
+{
+    auto idx = topDef.NextIndex();
     topDef.Push(OpCode::FRAME);
-    topDef.AddMangledNameAnnotation(topDef.NextIndex() - 1, "linker_dummy_abort_function");
+    topDef.AddMangledNameAnnotation(idx, mangledName);
     topDef.Push(0);
     topDef.Push(OpCode::ABORT);
+    return idx;
+}
+
+Bchir::ByteCodeIndex BCHIRLinker::GetAbortFunction(const std::string& mangledName)
+{
+    auto it = mName2AbortFuncIdx.find(mangledName);
+    if (it != mName2AbortFuncIdx.end()) {
+        return it->second;
+    }
+    auto idx = GenerateAbortFunction(mangledName);
+    mName2AbortFuncIdx.emplace(mangledName, idx);
+    return idx;
+}
+
+void BCHIRLinker::GenerateAbortFunctionsForMissingFunctions()
+{
+    // sorted so that the linked bytecode is deterministic
+    std::vector<std::string> missing;
+    for (auto& it : mName2FuncBodyIdxPlaceHolder) {
+        missing.emplace_back(it.first);
+    }
+    std::sort(missing.begin(), missing.end());
+    for (auto& mangledName : missing) {
+        auto idx = GetAbortFunction(mangledName);
+        for (auto ph : mName2FuncBodyIdxPlaceHolder[mangledName]) {
+            topDef.Set(ph, idx);
+        }
+    }
+    mName2FuncBodyIdxPlaceHolder.clear();
 }
 
 Bchir::ByteCodeContent BCHIRLinker::GetClassId(const std::string& classMangledName)
@@ -195,27 +233,30 @@ void BCHIRLinker::LinkClass(const Bchir& bchir, const std::string& mangledName)
         auto superClassIt = mName2ClassId.find(superClass);
         CJC_ASSERT(superClassIt != mName2ClassId.end());
         auto superId = superClassIt->second;
-        classInfo.superClasses.emplace(superId);
+        classInfo.superClasses.emplace_back(superId);
         // all the super classes have been encoded before
         auto& superSuperClasses = topBchir.GetClass(superId).superClasses;
-        for (auto scit : superSuperClasses) {
-            (void)classInfo.superClasses.emplace(scit);
-        }
+        classInfo.superClasses.insert(classInfo.superClasses.end(), superSuperClasses.begin(), superSuperClasses.end());
     }
+    // sorted for binary search in the interpreter
+    std::sort(classInfo.superClasses.begin(), classInfo.superClasses.end());
+    classInfo.superClasses.erase(
+        std::unique(classInfo.superClasses.begin(), classInfo.superClasses.end()), classInfo.superClasses.end());
 
     for (const auto& [methodName, funcMangledName] : sClassInfo->vtable) {
         Bchir::ByteCodeIndex thisMethodId = GetMethodId(methodName);
         auto thisMethdIdxIt = mName2FuncBodyIdx.find(funcMangledName);
         if (thisMethdIdxIt != mName2FuncBodyIdx.end()) {
-            (void)classInfo.vtable.emplace(thisMethodId, thisMethdIdxIt->second);
+            (void)classInfo.vtable.emplace_back(thisMethodId, thisMethdIdxIt->second);
         } else {
             // This can happen because we only load packages that are required for const-eval - see
             // requiredConstEvalDependencies in the RunConstantEvaluation function; However, a class type might appear
             // as an import CHIR type, but the package containing the definition is never loaded - we are currently
             // assuming that those methods won't be used in const contexts.
-            (void)classInfo.vtable.emplace(thisMethodId, dummyAbortFuncIdx);
+            (void)classInfo.vtable.emplace_back(thisMethodId, GetAbortFunction(funcMangledName));
         }
     }
+    std::sort(classInfo.vtable.begin(), classInfo.vtable.end());
 
     auto finalizerIdxIt = mName2FuncBodyIdx.find(sClassInfo->finalizer);
     if (sClassInfo->finalizer != "" && finalizerIdxIt != mName2FuncBodyIdx.end()) {
@@ -342,9 +383,11 @@ void BCHIRLinker::TraverseAndLink(const Bchir& bchir, const Bchir::Definition& c
     Bchir::ByteCodeIndex curr{0};
     auto& positions = currentDef.GetCodePositionsAnnotations();
     auto& mangledNames = currentDef.GetMangledNamesAnnotations();
+    std::vector<Bchir::ByteCodeIndex> linkedOps;
     while (curr < currentDef.NextIndex()) {
         auto op = static_cast<OpCode>(currentDef.Get(curr));
         CJC_ASSERT(op <= OpCode::INVALID);
+        linkedOps.emplace_back(topDef.NextIndex());
         // pushing the opcode
         topDef.Push(op);
         // propagate code positions for call stack printing purposes
@@ -378,7 +421,7 @@ void BCHIRLinker::TraverseAndLink(const Bchir& bchir, const Bchir::Definition& c
                 } else {
                     AddToMName2FuncBodyIdxPlaceHolder(mgl, topDef.NextIndex());
                     // Most of the time `dummyAbortFuncIdx` will be modified when function is visited, otherwise
-                    // something went wrong and the interpretation will abort.
+                    // it's set to the abort function of `mgl` by `GenerateAbortFunctionsForMissingFunctions`.
                     topDef.Push(dummyAbortFuncIdx);
                 }
                 break;
@@ -423,19 +466,25 @@ void BCHIRLinker::TraverseAndLink(const Bchir& bchir, const Bchir::Definition& c
                     LinkClass(bchir, mgl);
                 }
                 topDef.Push(thisClassId);
+                if (op == OpCode::INSTANCEOF) {
+                    topDef.PushInlineCache();
+                }
                 break;
             }
             case OpCode::INVOKE_EXC: {
                 topDef.Push(currentDef.Get(curr + 1)); // number of arguments
                 auto& mgl = currentDef.GetMangledNameAnnotation(curr);
-                topDef.Push(GetMethodId(mgl));                                  // method ID
-                topDef.Push(currentDef.Get(curr + Bchir::FLAG_THREE) + offset); // jump target for when exception
+                topDef.Push(GetMethodId(mgl)); // method ID
+                topDef.PushInlineCache();
+                // jump target for when exception
+                topDef.Push(currentDef.Get(curr + Bchir::FLAG_THREE + Bchir::INLINE_CACHE_SIZE) + offset);
                 break;
             }
             case OpCode::INVOKE: {
                 topDef.Push(currentDef.Get(curr + 1));
                 auto& mgl = currentDef.GetMangledNameAnnotation(curr);
                 topDef.Push(GetMethodId(mgl));
+                topDef.PushInlineCache();
                 break;
             }
             case OpCode::JUMP: {
@@ -555,6 +604,29 @@ void BCHIRLinker::TraverseAndLink(const Bchir& bchir, const Bchir::Definition& c
         }
         curr = next;
     }
+    FuseSuperInstructions(linkedOps);
+}
+
+void BCHIRLinker::FuseSuperInstructions(const std::vector<Bchir::ByteCodeIndex>& ops)
+{
+    auto opAt = [this, &ops](size_t i) {
+        return i < ops.size() ? static_cast<OpCode>(topDef.Get(ops[i])) : OpCode::INVALID;
+    };
+    // only the op code of the first operation is replaced, so the jumps to the following operations are still valid
+    for (size_t i = 0; i + 1 < ops.size(); ++i) {
+        auto op = opAt(i);
+        auto nextOp = opAt(i + 1);
+        if (op == OpCode::LVAR_SET && nextOp == OpCode::LVAR) {
+            // the result of an expression is usually loaded by the next one, e.g. the condition of a branch
+            auto isSameVar = topDef.Get(ops[i] + 1) == topDef.Get(ops[i + 1] + 1);
+            topDef.SetOp(ops[i],
+                isSameVar && opAt(i + Bchir::FLAG_TWO) == OpCode::BRANCH ? OpCode::LVAR_SET_BRANCH
+                                                                          : OpCode::LVAR_SET_LVAR);
+        } else if (op == OpCode::LVAR && nextOp == OpCode::LVAR) {
+            // the operands of binary operations and calls
+            topDef.SetOp(ops[i], OpCode::LVAR_LVAR);
+        }
+    }
 }
 
 Bchir::ByteCodeContent BCHIRLinker::FreshGVarId()
@@ -593,3 +665,12 @@ int BCHIRLinker::GetGVARId(const std::string& name) const
     }
     return -1;
 }
+
+int BCHIRLinker::GetFuncBodyIdx(const std::string& name) const
+{
+    auto it = mName2FuncBodyIdx.find(name);
+    if (it != mName2FuncBodyIdx.end()) {
+        return static_cast<int>(it->second);
+    }
+    return -1;
+}
@@ -149,6 +149,13 @@ void BCHIRPrinter::DefinitionPrinter::PrintAtIndex()
     index++;
 }
 
+void BCHIRPrinter::DefinitionPrinter::PrintInlineCache()
+{
+    for (Bchir::ByteCodeContent i = 0; i < Bchir::INLINE_CACHE_SIZE; ++i) {
+        PrintAtIndex();
+    }
+}
+
 void BCHIRPrinter::DefinitionPrinter::PrintAtIndex8bytes()
 {
     auto val = *reinterpret_cast<const uint64_t*>(&bytecode[index]);
@@ -330,7 +337,10 @@ void BCHIRPrinter::DefinitionPrinter::PrintOP()
         case OpCode::GVAR_SET:
         case OpCode::LVAR_SET:
         case OpCode::GVAR:
-        case OpCode::LVAR: {
+        case OpCode::LVAR:
+        case OpCode::LVAR_LVAR:
+        case OpCode::LVAR_SET_LVAR:
+        case OpCode::LVAR_SET_BRANCH: {
             PrintAtIndex();
             return;
         }
@@ -549,6 +559,7 @@ void BCHIRPrinter::DefinitionPrinter::PrintOP()
             PrintAtIndex();
             // name id
             PrintAtIndex();
+            PrintInlineCache();
             return;
         }
         case OpCode::INVOKE_EXC: {
@@ -556,6 +567,7 @@ void BCHIRPrinter::DefinitionPrinter::PrintOP()
             PrintAtIndex();
             // name id
             PrintAtIndex();
+            PrintInlineCache();
             // jump target for when exception is raised
             PrintAtIndex();
             return;
@@ -572,6 +584,7 @@ void BCHIRPrinter::DefinitionPrinter::PrintOP()
         case OpCode::INSTANCEOF: {
             // class id
             PrintAtIndex();
+            PrintInlineCache();
             return;
         }
         case OpCode::APPLY: {
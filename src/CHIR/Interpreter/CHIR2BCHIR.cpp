@@ -16,6 +16,7 @@
 #include "cangjie/CHIR/Type/StructDef.h"
 #include "cangjie/CHIR/Utils.h"
 #include "cangjie/CHIR/Value.h"
+#include "cangjie/CHIR/Visitor/Visitor.h"
 
 using namespace Cangjie::CHIR;
 using namespace Interpreter;
@@ -45,6 +46,9 @@ template <bool ForConstEval> void CHIR2BCHIR::TranslatePackage(
     }
     TranslateClassesLike<ForConstEval>(chirPkg);
     TranslateGlobalVars<ForConstEval>(chirPkg);
+    if constexpr (ForConstEval) {
+        CollectConstEvalFuncs(chirPkg, initFuncsForConstVar);
+    }
     TranslateFunctions<ForConstEval>(chirPkg);
     bchir.SetGlobalInitFunc(chirPkg.GetPackageInitFunc()->GetIdentifierWithoutPrefix());
     if constexpr (ForConstEval) {
@@ -106,6 +110,85 @@ bool CHIR2BCHIR::IsConstClass(const CustomTypeDef& def) const
     }
 };
 
+/** @brief Whether `func` is one of the functions the interpreter relies on. */
+static bool IsDefaultFunction(const Bchir& bchir, const Func& func)
+{
+    auto& defaultFuncs = Bchir::defaultFunctionsManledNames;
+    return bchir.IsCore() &&
+        std::find(defaultFuncs.begin(), defaultFuncs.end(), func.GetIdentifierWithoutPrefix()) != defaultFuncs.end();
+}
+
+bool CHIR2BCHIR::IsConstEvalFunc(const Func& func) const
+{
+    if (func.TestAttr(Attribute::SKIP_ANALYSIS) && !func.GetBody()) {
+        // missing body
+        return false;
+    }
+    return
+        // it is a const function
+        func.IsCompileTimeValue() ||
+        // function that can be executed during const-eval
+        CONST_FUNCTIONS.count(func.GetIdentifier()) > 0 ||
+        // interpreter relies on this set of functions
+        IsDefaultFunction(bchir, func) ||
+        // it is a finalizer -- at the moment there is no easy way to find out if a class is const.
+        // The right way to do this would be to mark the finalizer as const, when there is a const init.
+        func.IsFinalizer();
+}
+
+void CHIR2BCHIR::CollectConstEvalFuncs(
+    const Package& chirPkg, const std::vector<CHIR::FuncBase*>& initFuncsForConstVar)
+{
+    // the methods of the types translated by `TranslateClassesLike`, by name
+    MethodsByName methods;
+    for (auto def : chirPkg.GetAllClassDef()) {
+        if (def->IsInterface() || IsConstClass(*def)) {
+            CollectMethodsByName(*def, methods);
+        }
+    }
+    for (auto def : chirPkg.GetAllStructDef()) {
+        if (IsConstClass(*def)) {
+            CollectMethodsByName(*def, methods);
+        }
+    }
+    for (auto def : chirPkg.GetAllEnumDef()) {
+        CollectMethodsByName(*def, methods);
+    }
+    for (auto def : chirPkg.GetAllExtendDef()) {
+        auto extendedDef = def->GetExtendedCustomTypeDef();
+        if (extendedDef == nullptr || IsConstClass(*extendedDef)) {
+            CollectMethodsByName(*def, methods);
+        }
+    }
+
+    std::vector<const Func*> worklist;
+    auto addFunc = [this, &worklist](const Func& func) {
+        if (IsConstEvalFunc(func) && constEvalFuncs.emplace(&func).second) {
+            worklist.emplace_back(&func);
+        }
+    };
+    for (auto func : initFuncsForConstVar) {
+        if (auto initFunc = DynamicCast<const Func*>(func)) {
+            addFunc(*initFunc);
+        }
+    }
+    for (auto func : chirPkg.GetGlobalFuncs()) {
+        // the default functions are called by the interpreter, the finalizers are linked with their classes
+        if (func->IsFinalizer() || IsDefaultFunction(bchir, *func)) {
+            addFunc(*func);
+        }
+    }
+    std::unordered_set<std::string> invokedMethods;
+    while (!worklist.empty()) {
+        auto func = worklist.back();
+        worklist.pop_back();
+        Visitor::Visit(*func, [&addFunc, &invokedMethods, &methods](Expression& expr) {
+            ForEachCallee(expr, methods, invokedMethods, addFunc);
+            return VisitResult::CONTINUE;
+        });
+    }
+}
+
 template <bool ForConstEval> void CHIR2BCHIR::TranslateClassesLike(const Package& chirPkg)
 {
     TranslateClasses<ForConstEval>(chirPkg);
@@ -229,28 +312,18 @@ template <bool ForConstEval> void CHIR2BCHIR::TranslateFunctions(const Package&
         }
 
         if constexpr (ForConstEval) {
-            bool missingBody = f->TestAttr(Attribute::SKIP_ANALYSIS) && !f->GetBody();
-            if (missingBody) {
-                continue;
-            }
-            // If ForConstEval we only need to translate the IsCompileTimeValue expressions.
-            if (
-                // it is a const function
-                f->IsCompileTimeValue() ||
-                // function that can be executed during const-eval
-                CONST_FUNCTIONS.count(f->GetIdentifier()) > 0 ||
-                // interpreter relies on this set of functions
-                (bchir.IsCore() &&
-                    std::find(Bchir::defaultFunctionsManledNames.begin(), Bchir::defaultFunctionsManledNames.end(),
-                        fIdent) != Bchir::defaultFunctionsManledNames.end()) ||
-                // it is a finalizer -- at the moment there is no easy way to find out if a class is const.
-                // The right way to do this would be to mark the finalizer as const, when there is a const init.
-                f->IsFinalizer()) {
-                // need to translate function for const eval
-            } else {
-                // no need to translate function for const eval
-                continue;
+            // If ForConstEval we only need to translate the functions that can be run by the const initializers.
+            if (constEvalFuncs.count(f) == 0) {
+                if (!IsConstEvalFunc(*f)) {
+                    continue;
+                }
+                if (!translateUnreachable) {
+                    // so that the interpreter can tell if a call to it is reached anyway
+                    bchir.skippedConstEvalFuncs.emplace(fIdent);
+                    continue;
+                }
             }
+            bchir.skippedConstEvalFuncs.erase(fIdent);
         }
         CJC_ASSERT(f->GetBody());
 
@@ -149,6 +149,7 @@ void CHIR2BCHIR::TranslateInvoke(Context& ctx, const Expression& expr)
     // we dont store mangled name here
     PushOpCodeWithAnnotations<false, true>(
         ctx, OpCode::INVOKE, expr, static_cast<unsigned>(expr.GetNumOfOperands()), 0);
+    ctx.def.PushInlineCache();
     auto methodName = MangleMethodName<true>(invokeExpr->GetMethodName(), *invokeExpr->GetMethodType());
     ctx.def.AddMangledNameAnnotation(idx, methodName);
 }
@@ -176,6 +177,7 @@ void CHIR2BCHIR::TranslateInstanceOf(Context& ctx, const InstanceOf& expr)
     CJC_ASSERT(opIdx <= static_cast<size_t>(Bchir::BYTECODE_CONTENT_MAX));
     PushOpCodeWithAnnotations<false>(ctx, OpCode::INSTANCEOF, expr);
     ctx.def.Push(0); // dummy value, this will be resolved during linking
+    ctx.def.PushInlineCache();
     if (expr.GetType()->IsRef()) {
         auto refTy = StaticCast<const RefType*>(expr.GetType());
         auto classTy = StaticCast<const ClassType*>(refTy->GetBaseType());
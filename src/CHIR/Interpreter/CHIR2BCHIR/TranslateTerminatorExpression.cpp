@@ -83,8 +83,8 @@ void CHIR2BCHIR::TranslateTerminatorExpression(Context& ctx, const Expression& e
             break;
         }
         case ExprKind::INVOKE_WITH_EXCEPTION: {
-            // :: INVOKE_EXC :: number_of_args :: method_name :: idx_when_exception :: LVAR_SET :: lvar_id
-            // :: JUMP :: idx_when_normal_return
+            // :: INVOKE_EXC :: number_of_args :: method_name :: inline_cache :: idx_when_exception :: LVAR_SET
+            // :: lvar_id :: JUMP :: idx_when_normal_return
             CJC_ASSERT(expr.GetNumOfOperands() > 0);
             CJC_ASSERT(expr.GetNumOfOperands() <= static_cast<size_t>(Bchir::BYTECODE_CONTENT_MAX));
             auto invoke = StaticCast<const InvokeWithException*>(&expr);
@@ -92,6 +92,7 @@ void CHIR2BCHIR::TranslateTerminatorExpression(Context& ctx, const Expression& e
             // we dont store mangled name here
             PushOpCodeWithAnnotations<false, true>(
                 ctx, OpCode::INVOKE_EXC, expr, static_cast<unsigned>(expr.GetNumOfOperands()), 0);
+            ctx.def.PushInlineCache();
             auto methodName = MangleMethodName<true>(invoke->GetMethodName(), *invoke->GetMethodType());
             ctx.def.AddMangledNameAnnotation(idx, methodName);
             TranslateTryTerminatorJumps(ctx, *invoke);
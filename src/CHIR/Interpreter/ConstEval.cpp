@@ -10,6 +10,7 @@
  * This file implements a translation from CHIR to BCHIR for atomic operations.
  */
 
+#include <deque>
 #include <numeric>
 
 #include <cangjie/CHIR/Interpreter/ConstEval.h>
@@ -18,14 +19,191 @@
 #include <cangjie/CHIR/Interpreter/BCHIRInterpreter.h>
 #include <cangjie/CHIR/Interpreter/BCHIRLinker.h>
 #include <cangjie/CHIR/Interpreter/CHIR2BCHIR.h>
+#include <cangjie/CHIR/Interpreter/Utils.h>
 #include <cangjie/CHIR/LiteralValue.h>
 #include <cangjie/CHIR/Type/ClassDef.h>
 #include <cangjie/CHIR/Type/EnumDef.h>
+#include <cangjie/CHIR/Visitor/Visitor.h>
 #include <cangjie/Utils/ProfileRecorder.h>
+#include <cangjie/Utils/TaskQueue.h>
 
 using Cangjie::CHIR::Interpreter::ConstEvalPass;
 using Cangjie::CHIR::Interpreter::IVal2CHIR;
 
+namespace Cangjie::CHIR::Interpreter {
+namespace {
+// a batch with fewer initializers doesn't pay for the copy of the bytecode
+constexpr size_t MIN_INIT_FUNCS_PER_BATCH = 8;
+
+/** @brief The global vars of this package initialized by the const initializer `initFunc`. */
+std::vector<const GlobalVar*> GetInitializedGlobalVars(const Func& initFunc)
+{
+    std::vector<const GlobalVar*> globalVars;
+    for (auto block : initFunc.GetBody()->GetBlocks()) {
+        for (auto expr : block->GetExpressions()) {
+            if (expr->GetExprKind() != ExprKind::STORE) {
+                continue;
+            }
+            auto location = StaticCast<const Store*>(expr)->GetLocation();
+            if (location->IsGlobalVarInCurPackage()) {
+                globalVars.emplace_back(VirtualCast<const GlobalVar*>(location));
+            }
+        }
+    }
+    return globalVars;
+}
+
+size_t FindRoot(std::vector<size_t>& parents, size_t idx)
+{
+    while (parents[idx] != idx) {
+        parents[idx] = parents[parents[idx]];
+        idx = parents[idx];
+    }
+    return idx;
+}
+} // namespace
+
+std::vector<std::vector<const Func*>> SplitIndependentInitFuncs(
+    const Package& package, const std::vector<FuncBase*>& initFuncsForConstVar, size_t maxBatches)
+{
+    std::vector<const Func*> initFuncs;
+    for (auto func : initFuncsForConstVar) {
+        if (auto initFunc = DynamicCast<const Func*>(func); initFunc && initFunc->GetBody()) {
+            initFuncs.emplace_back(initFunc);
+        }
+    }
+    maxBatches = std::min(maxBatches, initFuncs.size() / MIN_INIT_FUNCS_PER_BATCH);
+    if (maxBatches <= 1) {
+        return {initFuncs};
+    }
+    std::unordered_map<const Value*, size_t> initializerOf;
+    for (size_t i = 0; i < initFuncs.size(); ++i) {
+        for (auto globalVar : GetInitializedGlobalVars(*initFuncs[i])) {
+            initializerOf.emplace(globalVar, i);
+        }
+    }
+    MethodsByName methods;
+    for (auto def : package.GetAllCustomTypeDef()) {
+        CollectMethodsByName(*def, methods);
+    }
+
+    // the initializers of the global vars accessed by a function and the functions it may call
+    struct Accesses {
+        std::vector<size_t> initializers;
+        std::vector<const Func*> callees;
+    };
+    std::unordered_map<const Func*, Accesses> accessesOf;
+    auto getAccesses = [&accessesOf, &initializerOf, &methods](const Func& func) -> const Accesses& {
+        auto [it, inserted] = accessesOf.emplace(&func, Accesses{});
+        if (!inserted) {
+            return it->second;
+        }
+        auto& accesses = it->second;
+        std::unordered_set<std::string> invokedMethods;
+        auto addCallee = [&accesses](const Func& callee) { accesses.callees.emplace_back(&callee); };
+        Visitor::Visit(func, [&accesses, &initializerOf, &methods, &invokedMethods, &addCallee](Expression& expr) {
+            for (auto operand : expr.GetOperands()) {
+                if (auto initializer = initializerOf.find(operand); initializer != initializerOf.end()) {
+                    accesses.initializers.emplace_back(initializer->second);
+                }
+            }
+            ForEachCallee(expr, methods, invokedMethods, addCallee);
+            return VisitResult::CONTINUE;
+        });
+        return accesses;
+    };
+
+    std::vector<size_t> parents(initFuncs.size());
+    std::iota(parents.begin(), parents.end(), 0);
+    for (size_t i = 0; i < initFuncs.size(); ++i) {
+        std::unordered_set<const Func*> visited{initFuncs[i]};
+        std::vector<const Func*> worklist{initFuncs[i]};
+        while (!worklist.empty()) {
+            auto& accesses = getAccesses(*worklist.back());
+            worklist.pop_back();
+            for (auto initializer : accesses.initializers) {
+                parents[FindRoot(parents, initializer)] = FindRoot(parents, i);
+            }
+            for (auto callee : accesses.callees) {
+                if (visited.emplace(callee).second) {
+                    worklist.emplace_back(callee);
+                }
+            }
+        }
+    }
+
+    std::vector<std::vector<const Func*>> groups;
+    std::unordered_map<size_t, size_t> groupOf;
+    for (size_t i = 0; i < initFuncs.size(); ++i) {
+        auto [it, inserted] = groupOf.emplace(FindRoot(parents, i), groups.size());
+        if (inserted) {
+            groups.emplace_back();
+        }
+        groups[it->second].emplace_back(initFuncs[i]);
+    }
+    if (groups.size() <= maxBatches) {
+        return groups;
+    }
+    // each group goes to the batch with the fewest initializers so far
+    std::vector<std::vector<const Func*>> batches(maxBatches);
+    for (auto& group : groups) {
+        auto batch = std::min_element(
+            batches.begin(), batches.end(), [](auto& lhs, auto& rhs) { return lhs.size() < rhs.size(); });
+        batch->insert(batch->end(), group.begin(), group.end());
+    }
+    return batches;
+}
+
+namespace {
+/** @brief Evaluate `initFuncs` in order, by calling each of them from the external playground of `interpreter`. */
+bool RunInitFuncs(BCHIRInterpreter& interpreter, Bchir& bchir, Bchir::ByteCodeIndex playground,
+    const BCHIRLinker& linker, const std::vector<const Func*>& initFuncs)
+{
+    for (auto initFunc : initFuncs) {
+        auto funcIdx = linker.GetFuncBodyIdx(initFunc->GetIdentifierWithoutPrefix());
+        if (funcIdx == -1) {
+            // not linked, as in `BCHIRLinker::GenerateCallsToConstInitFunctions`
+            continue;
+        }
+        // FUNC :: FUNC_IDX :: APPLY :: 1 :: DROP :: EXIT
+        auto idx = playground;
+        bchir.SetOp(idx++, OpCode::FUNC);
+        bchir.Set(idx++, static_cast<Bchir::ByteCodeContent>(funcIdx));
+        bchir.SetOp(idx++, OpCode::APPLY);
+        bchir.Set(idx++, 1);
+        bchir.SetOp(idx++, OpCode::DROP);
+        bchir.SetOp(idx, OpCode::EXIT);
+        if (!std::holds_alternative<INotRun>(interpreter.Run(playground, false))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/** @brief Evaluate each of `batches` with the worker of the same index, in parallel. */
+bool RunWorkers(std::deque<BCHIRInterpreter>& workers, std::deque<Bchir>& workerBchirs,
+    Bchir::ByteCodeIndex playground, const BCHIRLinker& linker,
+    const std::vector<std::vector<const Func*>>& batches)
+{
+    Utils::TaskQueue taskQueue(batches.size());
+    std::vector<Utils::TaskResult<bool>> results;
+    for (size_t i = 0; i < batches.size(); ++i) {
+        results.emplace_back(taskQueue.AddTask<bool>(
+            [&worker = workers[i], &workerBchir = workerBchirs[i], playground, &linker, &batch = batches[i]]() {
+                return RunInitFuncs(worker, workerBchir, playground, linker, batch);
+            },
+            batches[i].size()));
+    }
+    taskQueue.RunAndWaitForAllTasksCompleted();
+    bool success = true;
+    for (auto& result : results) {
+        success = result.get() && success;
+    }
+    return success;
+}
+} // namespace
+} // namespace Cangjie::CHIR::Interpreter
+
 Cangjie::CHIR::Constant* IVal2CHIR::TryConvertToConstant(Type& ty, const IVal& val, Block& parent)
 {
     switch (ty.GetTypeKind()) {
@@ -244,7 +422,7 @@ Cangjie::CHIR::Value* IVal2CHIR::ConvertRefToChir(
             // This is only partially implemeneted:
             // If a constant references another constant, then it should not create a deep copy of that constant.
             auto classType = StaticCast<ClassType*>(referencedType);
-            auto& valClassName = bchir.GetClassTable().find(obj->classId)->second.mangledName;
+            auto& valClassName = bchir.GetClass(obj->classId).mangledName;
             auto refType = &ty;
             auto needCast = false;
 
@@ -364,6 +542,25 @@ void ConstEvalPass::RunInterpreter(Package& package, std::vector<Bchir>& bchirPa
     linkedBchir.Resize(fePlayground + extraReqSpace);
 
     std::unordered_map<std::string, void*> dyHandles{};
+    constexpr size_t bytesPerMiB = 1024 * 1024;
+    auto memoryLimit = opts.constEvalMemoryLimit * bytesPerMiB;
+
+    // Independent initializers are evaluated in parallel, each batch by its own worker with its own copy of the
+    // bytecode, sharing the limits. The values of the global vars they initialize are copied to `interpreter`, and the
+    // workers keep the values these refer to alive until the end. Their diagnostics are discarded: on failure, all the
+    // initializers are evaluated again by `interpreter` alone, so that the errors don't depend on the number of jobs.
+    auto batches = SplitIndependentInitFuncs(package, initFuncsForConstVar, opts.GetJobs());
+    DiagnosticEngine workersDiag;
+    workersDiag.SetSourceManager(&sourceManager);
+    workersDiag.RegisterHandler(std::make_unique<DiagnosticHandler>(workersDiag, DiagHandlerKind::HANDLER));
+    std::deque<Bchir> workerBchirs;
+    std::deque<BCHIRInterpreter> workers;
+    for (size_t i = 0; batches.size() > 1 && i < batches.size(); ++i) {
+        auto& worker = workers.emplace_back(workerBchirs.emplace_back(linkedBchir.Clone()), workersDiag, dyHandles,
+            static_cast<unsigned>(fePlayground), static_cast<unsigned>(interpPlayground), true);
+        worker.SetGlobalVars(std::unordered_map<Bchir::ByteCodeIndex, IVal>(gVarInitIVals));
+        worker.SetLimits(memoryLimit / batches.size(), opts.constEvalStepLimit / batches.size());
+    }
 
     BCHIRInterpreter interpreter(linkedBchir, diag, dyHandles, static_cast<unsigned>(fePlayground),
         static_cast<unsigned>(interpPlayground), true);
@@ -372,14 +569,32 @@ void ConstEvalPass::RunInterpreter(Package& package, std::vector<Bchir>& bchirPa
 #endif
     interpreter.SetGlobalVars(std::move(gVarInitIVals));
     gVarInitIVals = {};
+    interpreter.SetLimits(memoryLimit, opts.constEvalStepLimit);
 
     Utils::ProfileRecorder::Start("Constant Evaluation", "Evaluate global vars");
-    auto res = interpreter.Run(0, false);
+    bool success = !workers.empty() &&
+        RunWorkers(workers, workerBchirs, static_cast<unsigned>(interpPlayground), linker, batches);
+    if (success) {
+        // as with a single interpreter, either all the initializers are replaced or none
+        std::unordered_map<Bchir::ByteCodeIndex, IVal> initializedGlobalVars;
+        for (size_t i = 0; i < batches.size(); ++i) {
+            for (auto initFunc : batches[i]) {
+                for (auto globalVar : GetInitializedGlobalVars(*initFunc)) {
+                    auto varId = linker.GetGVARId(globalVar->GetIdentifierWithoutPrefix());
+                    CJC_ASSERT(varId != -1);
+                    auto id = static_cast<Bchir::ByteCodeIndex>(varId);
+                    initializedGlobalVars.emplace(id, workers[i].PeekValueOfGlobal(id));
+                }
+            }
+        }
+        interpreter.SetGlobalVars(std::move(initializedGlobalVars));
+    } else {
+        // Suppress error on exception, no way to know whether exception is legitimate
+        success = std::holds_alternative<INotRun>(interpreter.Run(0, false));
+    }
     Utils::ProfileRecorder::Stop("Constant Evaluation", "Evaluate global vars");
-    if (std::holds_alternative<INotRun>(res)) {
+    if (success) {
         onSuccess(package, interpreter, linker);
-    } else if (std::holds_alternative<IException>(res)) {
-        // Suppress error, no way to know whether exception is legitimate
     }
 }
 
@@ -0,0 +1,146 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+/**
+ * @file
+ *
+ * This file implements the garbage collection of the interpreter arena.
+ */
+
+#include "cangjie/CHIR/Interpreter/InterpreterArena.h"
+
+using namespace Cangjie::CHIR::Interpreter;
+
+namespace {
+/** @brief The elements of `value` if it's a tuple, an array or an object, nullptr otherwise. */
+const IValVector* GetElements(const IVal& value)
+{
+    if (auto tuple = IValUtils::GetIf<ITuple>(&value)) {
+        return &tuple->content;
+    } else if (auto array = IValUtils::GetIf<IArray>(&value)) {
+        return &array->content;
+    } else if (auto object = IValUtils::GetIf<IObject>(&value)) {
+        return &object->content;
+    }
+    return nullptr;
+}
+} // namespace
+
+size_t Arena::GetElementsSize(const IVal& value)
+{
+    auto elems = GetElements(value);
+    if (elems == nullptr || elems->capacity() == 0) {
+        return 0;
+    }
+    size_t size = sizeof(IValVector::Storage) + elems->capacity() * sizeof(IVal);
+    for (auto& elem : *elems) {
+        size += GetElementsSize(elem);
+    }
+    return size;
+}
+
+void Arena::AddElementRegions(const IVal& value, size_t slot)
+{
+    auto elems = GetElements(value);
+    if (elems == nullptr || elems->empty()) {
+        return;
+    }
+    regions.emplace_back(Region{elems->begin(), elems->end(), slot, false});
+    for (auto& elem : *elems) {
+        AddElementRegions(elem, slot);
+    }
+}
+
+void Arena::BeginCollection()
+{
+    auto numberOfSlots = GetNumberOfSlots();
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        auto& bucket = *buckets[i];
+        regions.emplace_back(Region{bucket.data(), bucket.data() + bucket.size(), i * BUCKET_SIZE, true});
+    }
+    for (size_t slot = 0; slot < numberOfSlots; ++slot) {
+        if (!isFree[slot]) {
+            AddElementRegions(*GetSlot(slot), slot);
+        }
+    }
+    // the regions are disjoint, so a pointer is looked up by the last region starting before it
+    std::sort(regions.begin(), regions.end(), [](auto& lhs, auto& rhs) { return lhs.begin < rhs.begin; });
+    isMarked.assign(numberOfSlots, false);
+    for (auto object : finalizingObjects) {
+        MarkPointee(object);
+    }
+}
+
+void Arena::MarkPointee(const IVal* pointee)
+{
+    auto it = std::upper_bound(regions.begin(), regions.end(), pointee,
+        [](const IVal* ptr, const Region& region) { return ptr < region.begin; });
+    if (it == regions.begin()) {
+        // not in the arena, e.g. a global variable
+        return;
+    }
+    --it;
+    if (pointee >= it->end) {
+        return;
+    }
+    auto slot = it->isBucket ? it->slot + static_cast<size_t>(pointee - it->begin) : it->slot;
+    if (!isMarked[slot]) {
+        isMarked[slot] = true;
+        markStack.emplace_back(slot);
+    }
+}
+
+void Arena::MarkPointees(const IVal& value)
+{
+    if (auto ptr = IValUtils::GetIf<IPointer>(&value)) {
+        MarkPointee(ptr->content);
+    } else if (auto elems = GetElements(value)) {
+        for (auto& elem : *elems) {
+            MarkPointees(elem);
+        }
+    }
+}
+
+void Arena::TraceMarked()
+{
+    // an explicit stack, since a long linked list would overflow the native one
+    while (!markStack.empty()) {
+        auto slot = markStack.back();
+        markStack.pop_back();
+        MarkPointees(*GetSlot(slot));
+    }
+}
+
+void Arena::MarkReachable(const IVal& root)
+{
+    MarkPointees(root);
+    TraceMarked();
+}
+
+size_t Arena::FinishCollection()
+{
+    TraceMarked();
+    size_t liveBytes = 0;
+    for (size_t slot = 0; slot < isMarked.size(); ++slot) {
+        if (isFree[slot]) {
+            continue;
+        }
+        auto value = GetSlot(slot);
+        if (isMarked[slot]) {
+            liveBytes += sizeof(IVal) + GetElementsSize(*value);
+        } else {
+            *value = IInvalid();
+            isFree[slot] = true;
+            freeSlots.emplace_back(slot);
+        }
+    }
+    regions.clear();
+    isMarked.clear();
+    bytesSinceCollection = 0;
+    // collect again once the heap has doubled
+    collectionThreshold = std::max(liveBytes, minCollectionThreshold);
+    return liveBytes;
+}
@@ -13,6 +13,7 @@
 #include "cangjie/CHIR/Interpreter/Utils.h"
 
 #include <securec.h>
+#include "cangjie/CHIR/CHIRCasting.h"
 #include "cangjie/CHIR/Interpreter/InterpreterValueUtils.h"
 
 using namespace Cangjie::CHIR;
@@ -236,3 +237,38 @@ IVal Interpreter::ByteCodeToIval(const Bchir::Definition& def, const Bchir& bchi
             return {INullptr()};
     }
 }
+
+void Interpreter::CollectMethodsByName(const CustomTypeDef& def, MethodsByName& methods)
+{
+    for (const auto& it : def.GetVTable()) {
+        for (const auto& funcInfo : it.second) {
+            if (auto method = DynamicCast<const Func*>(funcInfo.instance); method && method->GetBody()) {
+                methods[funcInfo.srcCodeIdentifier].emplace_back(method);
+            }
+        }
+    }
+}
+
+void Interpreter::ForEachCallee(const Expression& expr, const MethodsByName& methods,
+    std::unordered_set<std::string>& invokedMethods, const std::function<void(const Func&)>& onCallee)
+{
+    for (auto operand : expr.GetOperands()) {
+        if (operand->IsFuncWithBody()) {
+            onCallee(*VirtualCast<const Func*>(operand));
+        }
+    }
+    std::string methodName;
+    if (expr.GetExprKind() == ExprKind::INVOKE) {
+        methodName = StaticCast<const Invoke&>(expr).GetMethodName();
+    } else if (expr.GetExprKind() == ExprKind::INVOKE_WITH_EXCEPTION) {
+        methodName = StaticCast<const InvokeWithException&>(expr).GetMethodName();
+    }
+    if (methodName.empty() || !invokedMethods.emplace(methodName).second) {
+        return;
+    }
+    if (auto it = methods.find(methodName); it != methods.end()) {
+        for (auto method : it->second) {
+            onCallee(*method);
+        }
+    }
+}
@@ -153,7 +153,7 @@ flatbuffers::Offset<PackageFormat::AnnoInfo> CHIRSerializer::CHIRSerializerImpl:
     return PackageFormat::CreateAnnoInfoDirect(builder, obj.mangledName.data());
 }
 
-[[maybe_unused]] static void Empty(Annotation*)
+[[maybe_unused]] static void Empty(const Annotation*)
 {
 }
 
@@ -161,10 +161,10 @@ template <> flatbuffers::Offset<PackageFormat::Base> CHIRSerializer::CHIRSeriali
 {
     auto annoTypes = std::vector<uint8_t>();
     auto annos = std::vector<flatbuffers::Offset<void>>();
-    std::unordered_map<std::type_index, std::function<void(Annotation*)>> annoHandler;
+    std::unordered_map<std::type_index, std::function<void(const Annotation*)>> annoHandler;
 
     // NeedCheckArrayBound
-    annoHandler[typeid(CHIR::NeedCheckArrayBound)] = [this, &annos, &annoTypes](Annotation* anno) {
+    annoHandler[typeid(CHIR::NeedCheckArrayBound)] = [this, &annos, &annoTypes](const Annotation* anno) {
         annoTypes.push_back(PackageFormat::Annotation::Annotation_needCheckArrayBound);
         annos.emplace_back(PackageFormat::CreateNeedCheckArrayBound(
             builder, NeedCheckArrayBound::Extract(StaticCast<NeedCheckArrayBound*>(anno)))
@@ -172,7 +172,7 @@ template <> flatbuffers::Offset<PackageFormat::Base> CHIRSerializer::CHIRSeriali
     };
 
     // NeedCheckCast
-    annoHandler[typeid(CHIR::NeedCheckCast)] = [this, &annos, &annoTypes](Annotation* anno) {
+    annoHandler[typeid(CHIR::NeedCheckCast)] = [this, &annos, &annoTypes](const Annotation* anno) {
         annoTypes.push_back(PackageFormat::Annotation::Annotation_needCheckCast);
         annos.emplace_back(
             PackageFormat::CreateNeedCheckCast(builder, NeedCheckCast::Extract(StaticCast<NeedCheckCast*>(anno)))
@@ -184,7 +184,7 @@ template <> flatbuffers::Offset<PackageFormat::Base> CHIRSerializer::CHIRSeriali
     annos.emplace_back(Serialize<PackageFormat::DebugLocation>(obj.Base::GetDebugLocation()).Union());
 
     // DebugLocationInfoForWarning
-    annoHandler[typeid(CHIR::DebugLocationInfoForWarning)] = [this, &annos, &annoTypes](Annotation* anno) {
+    annoHandler[typeid(CHIR::DebugLocationInfoForWarning)] = [this, &annos, &annoTypes](const Annotation* anno) {
         annoTypes.push_back(PackageFormat::Annotation::Annotation_debugLocationInfoForWarning);
         annos.emplace_back(Serialize<PackageFormat::DebugLocation>(
             DebugLocationInfoForWarning::Extract(StaticCast<DebugLocationInfoForWarning*>(anno)))
@@ -192,7 +192,7 @@ template <> flatbuffers::Offset<PackageFormat::Base> CHIRSerializer::CHIRSeriali
     };
 
     // LinkTypeInfo
-    annoHandler[typeid(CHIR::LinkTypeInfo)] = [this, &annos, &annoTypes](Annotation* anno) {
+    annoHandler[typeid(CHIR::LinkTypeInfo)] = [this, &annos, &annoTypes](const Annotation* anno) {
         annoTypes.push_back(PackageFormat::Annotation::Annotation_linkTypeInfo);
         annos.emplace_back(PackageFormat::CreateLinkTypeInfo(
             builder, PackageFormat::Linkage(LinkTypeInfo::Extract(StaticCast<CHIR::LinkTypeInfo*>(anno))))
@@ -200,7 +200,7 @@ template <> flatbuffers::Offset<PackageFormat::Base> CHIRSerializer::CHIRSeriali
     };
 
     // SkipCheck
-    annoHandler[typeid(CHIR::SkipCheck)] = [this, &annos, &annoTypes](Annotation* anno) {
+    annoHandler[typeid(CHIR::SkipCheck)] = [this, &annos, &annoTypes](const Annotation* anno) {
         annoTypes.push_back(PackageFormat::Annotation::Annotation_skipCheck);
         annos.emplace_back(PackageFormat::CreateSkipCheck(
             builder, PackageFormat::SkipKind(SkipCheck::Extract(StaticCast<CHIR::SkipCheck*>(anno))))
@@ -212,7 +212,7 @@ template <> flatbuffers::Offset<PackageFormat::Base> CHIRSerializer::CHIRSeriali
     if (wrapMethod != nullptr && !wrapMethod->GetBody()) {
         annoHandler[typeid(CHIR::WrappedRawMethod)] = Empty;
     } else {
-        annoHandler[typeid(CHIR::WrappedRawMethod)] = [this, &annos, &annoTypes](Annotation* anno) {
+        annoHandler[typeid(CHIR::WrappedRawMethod)] = [this, &annos, &annoTypes](const Annotation* anno) {
             annoTypes.push_back(PackageFormat::Annotation::Annotation_wrappedRawMethod);
             auto rawMethod =
                 GetId<Value>(StaticCast<Value*>(WrappedRawMethod::Extract(StaticCast<CHIR::WrappedRawMethod*>(anno))));
@@ -220,7 +220,7 @@ template <> flatbuffers::Offset<PackageFormat::Base> CHIRSerializer::CHIRSeriali
         };
     }
     // NeverOverflowInfo
-    annoHandler[typeid(CHIR::NeverOverflowInfo)] = [this, &annos, &annoTypes](Annotation* anno) {
+    annoHandler[typeid(CHIR::NeverOverflowInfo)] = [this, &annos, &annoTypes](const Annotation* anno) {
         annoTypes.push_back(PackageFormat::Annotation::Annotation_neverOverflowInfo);
         annos.emplace_back(PackageFormat::CreateNeverOverflowInfo(
             builder, NeverOverflowInfo::Extract(StaticCast<CHIR::NeverOverflowInfo*>(anno)))
@@ -228,7 +228,7 @@ template <> flatbuffers::Offset<PackageFormat::Base> CHIRSerializer::CHIRSeriali
     };
 
     // GeneratedFromForIn
-    annoHandler[typeid(CHIR::GeneratedFromForIn)] = [this, &annos, &annoTypes](Annotation* anno) {
+    annoHandler[typeid(CHIR::GeneratedFromForIn)] = [this, &annos, &annoTypes](const Annotation* anno) {
         annoTypes.push_back(PackageFormat::Annotation::Annotation_generatedFromForIn);
         annos.emplace_back(PackageFormat::CreateGeneratedFromForIn(
             builder, GeneratedFromForIn::Extract(StaticCast<CHIR::GeneratedFromForIn*>(anno)))
@@ -236,7 +236,7 @@ template <> flatbuffers::Offset<PackageFormat::Base> CHIRSerializer::CHIRSeriali
     };
 
     // IsAutoEnvClass
-    annoHandler[typeid(CHIR::IsAutoEnvClass)] = [this, &annos, &annoTypes](Annotation* anno) {
+    annoHandler[typeid(CHIR::IsAutoEnvClass)] = [this, &annos, &annoTypes](const Annotation* anno) {
         annoTypes.push_back(PackageFormat::Annotation::Annotation_isAutoEnvClass);
         annos.emplace_back(PackageFormat::CreateIsAutoEnvClass(
             builder, IsAutoEnvClass::Extract(StaticCast<CHIR::IsAutoEnvClass*>(anno)))
@@ -244,7 +244,7 @@ template <> flatbuffers::Offset<PackageFormat::Base> CHIRSerializer::CHIRSeriali
     };
 
     // IsCapturedClassInCC
-    annoHandler[typeid(CHIR::IsCapturedClassInCC)] = [this, &annos, &annoTypes](Annotation* anno) {
+    annoHandler[typeid(CHIR::IsCapturedClassInCC)] = [this, &annos, &annoTypes](const Annotation* anno) {
         annoTypes.push_back(PackageFormat::Annotation::Annotation_isCapturedClassInCC);
         annos.emplace_back(PackageFormat::CreateIsCapturedClassInCC(
             builder, IsCapturedClassInCC::Extract(StaticCast<CHIR::IsCapturedClassInCC*>(anno)))
@@ -252,7 +252,7 @@ template <> flatbuffers::Offset<PackageFormat::Base> CHIRSerializer::CHIRSeriali
     };
 
     // EnumCaseIndex
-    annoHandler[typeid(CHIR::EnumCaseIndex)] = [this, &annos, &annoTypes](Annotation* anno) {
+    annoHandler[typeid(CHIR::EnumCaseIndex)] = [this, &annos, &annoTypes](const Annotation* anno) {
         annoTypes.push_back(PackageFormat::Annotation::Annotation_enumCaseIndex);
         auto index = EnumCaseIndex::Extract(StaticCast<CHIR::EnumCaseIndex*>(anno));
         int64_t indexNum = -1;
@@ -263,7 +263,7 @@ template <> flatbuffers::Offset<PackageFormat::Base> CHIRSerializer::CHIRSeriali
     };
 
     // VirMethodOffset
-    annoHandler[typeid(CHIR::VirMethodOffset)] = [this, &annos, &annoTypes](Annotation* anno) {
+    annoHandler[typeid(CHIR::VirMethodOffset)] = [this, &annos, &annoTypes](const Annotation* anno) {
         annoTypes.push_back(PackageFormat::Annotation::Annotation_virMethodOffset);
         auto offset = VirMethodOffset::Extract(StaticCast<CHIR::VirMethodOffset*>(anno));
         int64_t offsetNum = -1;
@@ -275,13 +275,13 @@ template <> flatbuffers::Offset<PackageFormat::Base> CHIRSerializer::CHIRSeriali
 
     annoHandler[typeid(CHIR::AnnoFactoryInfo)] = Empty;
 
-    for (auto& entry : obj.GetAnno().GetAnnos()) {
-        if (annoHandler.count(entry.first) != 0) {
-            annoHandler.at(entry.first)(entry.second.get());
+    obj.GetAnno().ForEachAnnotation([&annoHandler](const std::type_index& index, const Annotation& anno) {
+        if (annoHandler.count(index) != 0) {
+            annoHandler.at(index)(&anno);
         } else {
             CJC_ABORT();
         }
-    }
+    });
     return PackageFormat::CreateBaseDirect(builder, &annoTypes, &annos);
 }
 
@@ -18,6 +18,7 @@
 #include "cangjie/CHIR/Visitor/Visitor.h"
 #include "cangjie/CHIR/Type/ExtendDef.h"
 #include "cangjie/CHIR/Type/PrivateTypeConverter.h"
+#include "cangjie/Mangle/CHIRManglingUtils.h"
 
 namespace Cangjie::CHIR {
 std::pair<BlockGroup*, LocalVar*> BlockGroupCopyHelper::CloneBlockGroup(
@@ -290,4 +291,62 @@ void FixCastProblemAfterInst(Ptr<BlockGroup> group, CHIRBuilder& builder)
     };
     Visitor::Visit(*group, [](Expression&) { return VisitResult::CONTINUE; }, postVisit);
 }
+
+std::string GetInstFuncMangleName(const Apply& apply, CHIRBuilder& builder)
+{
+    // 1. get type args
+    std::vector<Type*> genericTypes;
+    auto func = VirtualCast<FuncBase*>(apply.GetCallee());
+    if (auto customDef = func->GetParentCustomTypeDef(); customDef != nullptr && customDef->IsGenericDef()) {
+        auto funcInCustomType = apply.GetInstParentCustomTyOfCallee(builder);
+        while (funcInCustomType->IsRef()) {
+            funcInCustomType = StaticCast<RefType*>(funcInCustomType)->GetBaseType();
+        }
+        genericTypes = funcInCustomType->GetTypeArgs();
+    }
+    auto funcArgs = apply.GetInstantiatedTypeArgs();
+    if (!funcArgs.empty()) {
+        genericTypes.insert(genericTypes.end(), funcArgs.begin(), funcArgs.end());
+    }
+    // 2. get mangle
+    return CHIRMangling::GenerateInstantiateFuncMangleName(func->GetIdentifierWithoutPrefix(), genericTypes);
+}
+
+Func* CreateInstFunc(const Apply& apply, const std::string& mangledName, CHIRBuilder& builder)
+{
+    auto callee = VirtualCast<Func*>(apply.GetCallee());
+    std::vector<Type*> parameterType;
+    for (auto param : apply.GetArgs()) {
+        parameterType.emplace_back(param->GetType());
+    }
+    auto instFuncType = builder.GetType<FuncType>(parameterType, apply.GetResultType());
+    auto newFunc = builder.CreateFunc(callee->GetDebugLocation(), instFuncType, mangledName,
+        callee->GetSrcCodeIdentifier(), callee->GetRawMangledName(), callee->GetPackageName());
+
+    newFunc->AppendAttributeInfo(callee->GetAttributeInfo());
+    newFunc->DisableAttr(Attribute::GENERIC);
+    if (!apply.GetInstantiatedTypeArgs().empty()) {
+        newFunc->EnableAttr(Attribute::GENERIC_INSTANTIATED);
+    }
+    newFunc->Set<LinkTypeInfo>(Linkage::INTERNAL);
+
+    auto oriBlockGroup = callee->GetBody();
+    BlockGroupCopyHelper helper(builder);
+    helper.GetInstMapFromApply(apply);
+    auto [newGroup, newBlockGroupRetValue] = helper.CloneBlockGroup(*oriBlockGroup, *newFunc);
+    newFunc->InitBody(*newGroup);
+    newFunc->SetReturnValue(*newBlockGroupRetValue);
+
+    CJC_ASSERT(parameterType.size() == callee->GetParams().size());
+    std::unordered_map<Value*, Value*> paramMap;
+    for (size_t i = 0; i < parameterType.size(); i++) {
+        auto arg = builder.CreateParameter(parameterType[i], callee->GetParam(i)->GetDebugLocation(), *newFunc);
+        paramMap.emplace(callee->GetParam(i), arg);
+    }
+    helper.SubstituteValue(newGroup, paramMap);
+
+    FixCastProblemAfterInst(newGroup, builder);
+    newFunc->SetReturnValue(*newBlockGroupRetValue);
+    return newFunc;
+}
 }  // namespace Cangjie::CHIR
@@ -129,13 +129,12 @@ void SetAutoEnvBaseDefAttr(ClassDef& def)
     def.EnableAttr(Attribute::ABSTRACT);
 }
 
-void SetLiftedLambdaAttr(Func& func, Lambda& lambda)
+void SetLiftedFuncAttr(Func& func, Lambda& lambda)
 {
     func.EnableAttr(Attribute::COMPILER_ADD);
     func.EnableAttr(Attribute::NO_REFLECT_INFO);
     func.EnableAttr(Attribute::INTERNAL);
     func.Set<LinkTypeInfo>(Linkage::INTERNAL);
-    func.SetFuncKind(FuncKind::LAMBDA);
     if (!lambda.GetGenericTypeParams().empty()) {
         func.EnableAttr(Attribute::GENERIC);
     }
@@ -147,6 +146,12 @@ void SetLiftedLambdaAttr(Func& func, Lambda& lambda)
     }
 }
 
+void SetLiftedLambdaAttr(Func& func, Lambda& lambda)
+{
+    SetLiftedFuncAttr(func, lambda);
+    func.SetFuncKind(FuncKind::LAMBDA);
+}
+
 void SetMemberMethodAttr(Func& func, bool isConst)
 {
     func.EnableAttr(Attribute::COMPILER_ADD);
@@ -1040,6 +1045,28 @@ void ReplaceOperandWithAutoEnvWrapperClass(
         user->ReplaceOperand(&op, &autoEnvWrapperClass);
     }
 }
+
+/// Check whether @p lambda is only called directly, i.e. it never escapes as a value, so its captured variables can
+/// be passed to the lifted function as arguments instead of being stored in an env object.
+bool IsOnlyCalledDirectly(const Lambda& lambda)
+{
+    auto result = lambda.GetResult();
+    for (auto user : result->GetUsers()) {
+        if (user->GetExprKind() == CHIR::ExprKind::DEBUGEXPR) {
+            continue;
+        }
+        if (user->GetExprKind() != CHIR::ExprKind::APPLY &&
+            user->GetExprKind() != CHIR::ExprKind::APPLY_WITH_EXCEPTION) {
+            return false;
+        }
+        auto operands = user->GetOperands();
+        // it mustn't be passed as an argument to itself either
+        if (!IsCalleeOfApply(*user, *result) || std::count(operands.begin(), operands.end(), result) != 1) {
+            return false;
+        }
+    }
+    return true;
+}
 } // namespace
 
 ClosureConversion::ClosureConversion(Package& package, CHIRBuilder& builder, const GlobalOptions& opts,
@@ -1331,6 +1358,88 @@ void ClosureConversion::LiftNestedFunctionWithCFuncType(Lambda& nestedFunc)
     nestedFunc.RemoveSelfFromBlock();
 }
 
+bool ClosureConversion::CanElideAutoEnv(const Lambda& func) const
+{
+    // the env object is kept in debug mode, the captured variables are shown by it in debugger
+    if (opts.enableCompileDebug || !opts.IsCHIROptimizationLevelOverO2()) {
+        return false;
+    }
+    if (NeedAddThisType(*func.GetResult()) || !GetVisiableGenericTypes(*func.GetResult()).empty() ||
+        srcCodeImportedFuncs.count(func.GetTopLevelFunc()) != 0) {
+        return false;
+    }
+    return IsOnlyCalledDirectly(func);
+}
+
+void ClosureConversion::LiftNonEscapingLambda(Lambda& nestedFunc, const std::vector<Value*>& boxedEnvs)
+{
+    // the captured variables are passed as the leading parameters of the lifted function
+    const auto& loc = nestedFunc.GetResult()->GetDebugLocation();
+    std::vector<Type*> envTypes;
+    for (auto env : boxedEnvs) {
+        envTypes.emplace_back(env->GetType());
+    }
+    auto paramTypes = nestedFunc.GetFuncType()->GetParamTypes();
+    paramTypes.insert(paramTypes.begin(), envTypes.begin(), envTypes.end());
+    auto funcTy = builder.GetType<FuncType>(paramTypes, nestedFunc.GetFuncType()->GetReturnType());
+    auto globalFunc = builder.CreateFunc(loc, funcTy, GenerateGlobalFuncIdentifier(nestedFunc),
+        nestedFunc.GetSrcCodeIdentifier(), "", package.GetName());
+    CJC_NULLPTR_CHECK(nestedFunc.GetBody()->GetTopLevelFunc());
+    globalFunc->InheritIDFromFunc(*nestedFunc.GetBody()->GetTopLevelFunc());
+    std::vector<Value*> envParams;
+    for (auto ty : envTypes) {
+        envParams.emplace_back(builder.CreateParameter(ty, INVALID_LOCATION, *globalFunc));
+    }
+    for (auto param : nestedFunc.GetParams()) {
+        globalFunc->AddParam(*param);
+    }
+    globalFunc->InitBody(*nestedFunc.GetBody());
+    // not a `LAMBDA` kind function: its first parameter isn't an env object and it's never wrapped by a closure
+    SetLiftedFuncAttr(*globalFunc, nestedFunc);
+    globalFunc->SetReturnValue(*nestedFunc.GetReturnValue());
+    for (size_t i = 0; i < boxedEnvs.size(); ++i) {
+        for (auto user : boxedEnvs[i]->GetUsers()) {
+            if (user->GetTopLevelFunc() == globalFunc) {
+                user->ReplaceOperand(boxedEnvs[i], envParams[i]);
+            }
+        }
+    }
+    if (nestedFunc.GetParamDftValHostFunc()) {
+        if (auto it = convertedCache.find(nestedFunc.GetParamDftValHostFunc()); it != convertedCache.cend()) {
+            globalFunc->SetParamDftValHostFunc(*it->second);
+        } else {
+            InternalError("never come here in ConvertNestedFunctions");
+        }
+    }
+    convertedCache.emplace(&nestedFunc, globalFunc);
+
+    // the recursive calls in the lifted function pass its own parameters on
+    auto users = nestedFunc.GetResult()->GetUsers();
+    for (auto user : users) {
+        if (user->GetExprKind() == CHIR::ExprKind::DEBUGEXPR) {
+            user->RemoveSelfFromBlock();
+            continue;
+        }
+        const auto& envArgs = user->GetTopLevelFunc() == globalFunc ? envParams : boxedEnvs;
+        if (auto apply = DynamicCast<Apply*>(user); apply) {
+            auto newArgs = apply->GetArgs();
+            newArgs.insert(newArgs.begin(), envArgs.begin(), envArgs.end());
+            auto newApply = builder.CreateExpression<Apply>(apply->GetDebugLocation(), apply->GetResult()->GetType(),
+                globalFunc, FuncCallContext{.args = newArgs}, apply->GetParentBlock());
+            apply->ReplaceWith(*newApply);
+        } else {
+            auto awe = StaticCast<ApplyWithException*>(user);
+            auto newArgs = awe->GetArgs();
+            newArgs.insert(newArgs.begin(), envArgs.begin(), envArgs.end());
+            auto newApply = builder.CreateExpression<ApplyWithException>(awe->GetDebugLocation(),
+                awe->GetResult()->GetType(), globalFunc, FuncCallContext{.args = newArgs}, awe->GetSuccessBlock(),
+                awe->GetErrorBlock(), awe->GetParentBlock());
+            awe->ReplaceWith(*newApply);
+        }
+    }
+    nestedFunc.RemoveSelfFromBlock();
+}
+
 void ClosureConversion::RecordDuplicateLambdaName(const Lambda& func)
 {
     auto it = duplicateLambdaName.find(func.GetIdentifier());
@@ -1416,6 +1525,13 @@ void ClosureConversion::ConvertNestedFunctions(const std::vector<Lambda*>& funcs
         }
         auto rawEnvs = func->GetCapturedVariables();
         auto boxedEnvs = BoxAllMutableVars(rawEnvs);
+        if (CanElideAutoEnv(*func)) {
+            if (opts.chirDebugOptimizer) {
+                PrintNestedFuncInfo(func->GetDebugLocation().GetBeginPos());
+            }
+            LiftNonEscapingLambda(*func, boxedEnvs);
+            continue;
+        }
         auto autoEnvBaseDef = GetOrCreateAutoEnvBaseDef(*func->GetFuncType());
         auto autoEnvImplDef = GetOrCreateAutoEnvImplDef(*func, *autoEnvBaseDef, boxedEnvs);
         // `users` may be refreshed after the above processes.
@@ -901,6 +901,11 @@ bool DeadCodeElimination::CheckUselessFunc(const Func& func, const GlobalOptions
     if (IsExternalDecl(func)) {
         return false;
     }
+    // The instantiation may be reused by the downstream packages of a library, see 'AST::IsReusableInstantiatedFunc'.
+    if (func.TestAttr(Attribute::GENERIC_INSTANTIATED) && func.Get<LinkTypeInfo>() == Linkage::WEAK_ODR &&
+        opts.outputMode != GlobalOptions::OutputMode::EXECUTABLE) {
+        return false;
+    }
     // The func is in vtable.
     if (func.IsVirtualFunc()) {
         return false;
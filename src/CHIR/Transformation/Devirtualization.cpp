@@ -14,7 +14,6 @@
 #include "cangjie/CHIR/UserDefinedType.h"
 #include "cangjie/CHIR/Utils.h"
 #include "cangjie/CHIR/Transformation/BlockGroupCopyHelper.h"
-#include "cangjie/Mangle/CHIRManglingUtils.h"
 namespace Cangjie::CHIR {
 
 Devirtualization::Devirtualization(
@@ -26,11 +25,35 @@ Devirtualization::Devirtualization(
 void Devirtualization::RunOnFuncs(const std::vector<Func*>& funcs, CHIRBuilder& builder, bool isDebug)
 {
     rewriteInfos.clear();
+    guardedRewriteInfos.clear();
     for (auto func : funcs) {
+        auto rewriteNum = rewriteInfos.size() + guardedRewriteInfos.size();
         RunOnFunc(func, builder);
+        if (rewriteInfos.size() + guardedRewriteInfos.size() != rewriteNum) {
+            devirtualizedFuncs.emplace_back(func);
+        }
     }
     RewriteToApply(builder, rewriteInfos, isDebug);
     InstantiateFuncIfPossible(builder, rewriteInfos);
+    RewriteToGuardedApplies(builder, guardedRewriteInfos, isDebug);
+}
+
+void Devirtualization::SetProfile(const PGOProfileInfo* pgoProfile)
+{
+    profile = pgoProfile;
+}
+
+const std::vector<Func*>& Devirtualization::GetDevirtualizedFuncs() const
+{
+    return devirtualizedFuncs;
+}
+
+void Devirtualization::AddInstFuncs(const std::vector<Func*>& instFuncs)
+{
+    for (auto func : instFuncs) {
+        // they aren't frozen, they are in the package and analysed like the other functions
+        frozenInstFuncMap.emplace(func->GetIdentifierWithoutPrefix(), func);
+    }
 }
 
 void Devirtualization::RunOnFunc(const Func* func, CHIRBuilder& builder)
@@ -41,7 +64,7 @@ void Devirtualization::RunOnFunc(const Func* func, CHIRBuilder& builder)
     }
     CJC_ASSERT(result);
 
-    const auto actionBeforeVisitExpr = [this, &builder](const TypeDomain& state, Expression* expr, size_t) {
+    const auto actionBeforeVisitExpr = [this, &builder, func](const TypeDomain& state, Expression* expr, size_t) {
         if (expr->GetExprKind() != ExprKind::INVOKE) {
             return;
         }
@@ -57,13 +80,17 @@ void Devirtualization::RunOnFunc(const Func* func, CHIRBuilder& builder)
         for (auto param : invoke->GetOperands()) {
             paramTys.emplace_back(param->GetType());
         }
+        FuncSig method{invoke->GetMethodName(), std::move(paramTys), invoke->GetInstantiatedTypeArgs()};
         // Grab the function from the classMap.
-        auto [realCallee, thisType] = FindRealCallee(builder, resVal,
-            {invoke->GetMethodName(), std::move(paramTys), invoke->GetInstantiatedTypeArgs()});
-        if (!realCallee) {
+        auto [realCallee, thisType] = FindRealCallee(builder, resVal, method);
+        if (realCallee) {
+            rewriteInfos.emplace_back(RewriteInfo{invoke, realCallee, thisType, invoke->GetInstantiatedTypeArgs()});
             return;
         }
-        rewriteInfos.emplace_back(RewriteInfo{invoke, realCallee, thisType, invoke->GetInstantiatedTypeArgs()});
+        // More than one callee is possible, test the receiver against the classes implementing them.
+        if (auto guards = FindGuardedCallees(builder, resVal, method, *func); !guards.empty()) {
+            guardedRewriteInfos.emplace_back(GuardedRewriteInfo{invoke, std::move(guards)});
+        }
     };
 
     const auto actionAfterVisitExpr = [](const TypeDomain&, Expression*, size_t) {};
@@ -232,34 +259,100 @@ void Devirtualization::RewriteToApply(CHIRBuilder& builder, std::vector<RewriteI
     }
 }
 
-const std::vector<Func*>& Devirtualization::GetFrozenInstFuns() const
+namespace {
+Apply* CreateGuardedApply(
+    CHIRBuilder& builder, const Invoke& invoke, ClassType& receiverTy, FuncBase& callee, Block& parent)
 {
-    return frozenInstFuns;
+    auto& loc = invoke.GetDebugLocation();
+    auto thisType = builder.GetType<RefType>(&receiverTy);
+    auto instThisType = builder.GetType<RefType>(
+        GetInstParentType(receiverTy, *callee.GetFuncType()->GetParamTypes()[0]->StripAllRefs(), builder));
+    auto args = invoke.GetOperands();
+    // the receiver is known to be an instance of `receiverTy` here
+    args[0] = TypeCastOrBoxIfNeeded(*args[0], *instThisType, builder, parent, loc);
+    auto apply = builder.CreateExpression<Apply>(loc, invoke.GetResultType(), &callee, FuncCallContext{
+        .args = args,
+        .instTypeArgs = invoke.GetInstantiatedTypeArgs(),
+        .thisType = thisType}, &parent);
+    parent.AppendExpression(apply);
+    return apply;
 }
 
-void Devirtualization::AppendFrozenFuncState(const Func* func, std::unique_ptr<Results<TypeDomain>> analysisRes)
+void StoreResultIfNeeded(CHIRBuilder& builder, Value& result, LocalVar* resultVar, Block& parent)
 {
-    frozenStates.emplace(func, std::move(analysisRes));
+    if (resultVar != nullptr) {
+        parent.AppendExpression(builder.CreateExpression<Store>(
+            resultVar->GetDebugLocation(), builder.GetUnitTy(), &result, resultVar, &parent));
+    }
 }
+} // namespace
 
-static std::string CreateInstFuncMangleName(const std::string& oriIdentifer, const Apply& apply, CHIRBuilder& builder)
+void Devirtualization::RewriteToGuardedApplies(
+    CHIRBuilder& builder, std::vector<GuardedRewriteInfo>& guardedRewriteInfos, bool isDebug)
 {
-    // 1. get type args
-    std::vector<Type*> genericTypes;
-    auto func = VirtualCast<FuncBase*>(apply.GetCallee());
-    if (auto customDef = func->GetParentCustomTypeDef(); customDef != nullptr && customDef->IsGenericDef()) {
-        auto funcInCustomType = apply.GetInstParentCustomTyOfCallee(builder);
-        while (funcInCustomType->IsRef()) {
-            funcInCustomType = StaticCast<RefType*>(funcInCustomType)->GetBaseType();
+    for (auto& info : guardedRewriteInfos) {
+        auto invoke = info.invoke;
+        auto block = invoke->GetParentBlock();
+        auto blockGroup = block->GetParentBlockGroup();
+        auto& loc = invoke->GetDebugLocation();
+        auto resultTy = invoke->GetResultType();
+        // 1. the paths join in a new block holding the expressions after the invoke, the result of the call is
+        // passed to it through a local variable
+        auto joinBlock = builder.CreateBlock(blockGroup);
+        LocalVar* resultVar = nullptr;
+        if (!invoke->GetResult()->GetUsers().empty()) {
+            auto alloc = builder.CreateExpression<Allocate>(loc, builder.GetType<RefType>(resultTy), resultTy, block);
+            alloc->MoveBefore(invoke);
+            resultVar = alloc->GetResult();
+            auto load = builder.CreateExpression<Load>(loc, resultTy, resultVar, joinBlock);
+            joinBlock->AppendExpression(load);
+            invoke->GetResult()->ReplaceWith(*load->GetResult(), blockGroup);
+        }
+        bool afterInvoke = false;
+        for (auto expr : block->GetExpressions()) {
+            if (afterInvoke) {
+                expr->MoveTo(*joinBlock);
+            }
+            afterInvoke = afterInvoke || expr == invoke;
+        }
+        // 2. the receivers of other classes still go through the virtual call
+        auto fallbackBlock = builder.CreateBlock(blockGroup);
+        invoke->MoveTo(*fallbackBlock);
+        StoreResultIfNeeded(builder, *invoke->GetResult(), resultVar, *fallbackBlock);
+        fallbackBlock->AppendExpression(builder.CreateTerminator<GoTo>(joinBlock, fallbackBlock));
+        // 3. test the receiver against the guarded classes in order, each of them has a direct call
+        auto testBlock = block;
+        for (size_t i = 0; i < info.guards.size(); ++i) {
+            auto [receiverTy, callee] = info.guards[i];
+            auto fastBlock = builder.CreateBlock(blockGroup);
+            auto nextBlock = i + 1 == info.guards.size() ? fallbackBlock : builder.CreateBlock(blockGroup);
+            auto cond =
+                builder.CreateExpression<InstanceOf>(loc, builder.GetBoolTy(), invoke->GetObject(), receiverTy, testBlock);
+            testBlock->AppendExpression(cond);
+            testBlock->AppendExpression(
+                builder.CreateTerminator<Branch>(cond->GetResult(), fastBlock, nextBlock, testBlock));
+            auto apply = CreateGuardedApply(builder, *invoke, *receiverTy, *callee, *fastBlock);
+            StoreResultIfNeeded(builder, *apply->GetResult(), resultVar, *fastBlock);
+            fastBlock->AppendExpression(builder.CreateTerminator<GoTo>(joinBlock, fastBlock));
+            testBlock = nextBlock;
+        }
+        if (isDebug) {
+            std::string message = "[Devirtualization] The function call to " + invoke->GetMethodName() +
+                ToPosInfo(invoke->GetDebugLocation()) + " was optimized with " + std::to_string(info.guards.size()) +
+                " guarded fast path(s).";
+            std::cout << message << std::endl;
         }
-        genericTypes = funcInCustomType->GetTypeArgs();
-    }
-    auto funcArgs = apply.GetInstantiatedTypeArgs();
-    if (!funcArgs.empty()) {
-        genericTypes.insert(genericTypes.end(), funcArgs.begin(), funcArgs.end());
     }
-    // 2. get mangle
-    return CHIRMangling::GenerateInstantiateFuncMangleName(oriIdentifer, genericTypes);
+}
+
+const std::vector<Func*>& Devirtualization::GetFrozenInstFuns() const
+{
+    return frozenInstFuns;
+}
+
+void Devirtualization::AppendFrozenFuncState(const Func* func, std::unique_ptr<Results<TypeDomain>> analysisRes)
+{
+    frozenStates.emplace(func, std::move(analysisRes));
 }
 
 void Devirtualization::InstantiateFuncIfPossible(CHIRBuilder& builder, std::vector<RewriteInfo>& rewriteInfoList)
@@ -281,40 +374,12 @@ void Devirtualization::InstantiateFuncIfPossible(CHIRBuilder& builder, std::vect
             continue;
         }
         // 2. create new inst func if needed
-        auto newId = CreateInstFuncMangleName(callee->GetIdentifierWithoutPrefix(), *apply, builder);
+        auto newId = GetInstFuncMangleName(*apply, builder);
         Func* newFunc;
         if (frozenInstFuncMap.count(newId) != 0) {
             newFunc = frozenInstFuncMap.at(newId);
         } else {
-            newFunc = builder.CreateFunc(callee->GetDebugLocation(), instFuncType, newId,
-                callee->GetSrcCodeIdentifier(), callee->GetRawMangledName(), callee->GetPackageName());
-            
-            newFunc->AppendAttributeInfo(callee->GetAttributeInfo());
-            newFunc->DisableAttr(Attribute::GENERIC);
-            if (!apply->GetInstantiatedTypeArgs().empty()) {
-                newFunc->EnableAttr(Attribute::GENERIC_INSTANTIATED);
-            }
-            newFunc->Set<LinkTypeInfo>(Linkage::INTERNAL);
-
-            auto oriBlockGroup = callee->GetBody();
-            BlockGroupCopyHelper helper(builder);
-            helper.GetInstMapFromApply(*apply);
-            auto [newGroup, newBlockGroupRetValue] = helper.CloneBlockGroup(*oriBlockGroup, *newFunc);
-            newFunc->InitBody(*newGroup);
-            newFunc->SetReturnValue(*newBlockGroupRetValue);
-
-            std::vector<Value*> args;
-            CJC_ASSERT(parameterType.size() == callee->GetParams().size());
-            std::unordered_map<Value*, Value*> paramMap;
-            for (size_t i = 0; i < parameterType.size(); i++) {
-                auto arg = builder.CreateParameter(parameterType[i], callee->GetParam(i)->GetDebugLocation(), *newFunc);
-                args.push_back(arg);
-                paramMap.emplace(callee->GetParam(i), arg);
-            }
-            helper.SubstituteValue(newGroup, paramMap);
-
-            FixCastProblemAfterInst(newGroup, builder);
-            newFunc->SetReturnValue(*newBlockGroupRetValue);
+            newFunc = CreateInstFunc(*apply, newId, builder);
             frozenInstFuns.push_back(newFunc);
             frozenInstFuncMap[newId] = newFunc;
         }
@@ -499,6 +564,73 @@ static bool IsOpenClass(const ClassDef& def)
     return def.TestAttr(Attribute::VIRTUAL);
 }
 
+namespace {
+/// Limits of a call rewritten with guarded fast paths: the number of implementations looked into, and the number of
+/// guards generated.
+constexpr size_t MAX_GUARDED_IMPLEMENTATIONS = 16;
+constexpr size_t MAX_GUARDS = 3;
+
+using Guards = std::vector<std::pair<ClassType*, FuncBase*>>;
+
+size_t GetInheritanceDepth(const ClassType& classTy)
+{
+    size_t depth = 0;
+    for (auto def = classTy.GetClassDef()->GetSuperClassDef(); def != nullptr; def = def->GetSuperClassDef()) {
+        ++depth;
+    }
+    return depth;
+}
+
+/// Get the index of the first guard in @p guards passed by @p receiverTy except @p skipped, or the size of @p guards
+/// if it goes to the virtual call.
+size_t FindGuard(const Guards& guards, const Type& receiverTy, CHIRBuilder& builder, size_t skipped = SIZE_MAX)
+{
+    for (size_t i = 0; i < guards.size(); ++i) {
+        if (i != skipped && receiverTy.IsEqualOrSubTypeOf(*guards[i].first, builder)) {
+            return i;
+        }
+    }
+    return guards.size();
+}
+
+/// Remove the guards which dispatch some receiver to a wrong callee, e.g. a superclass tested without its subclasses
+/// overriding the method.
+void RemoveWrongGuards(Guards& guards, const std::vector<std::pair<Type*, FuncBase*>>& impls, CHIRBuilder& builder)
+{
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (auto [receiverTy, callee] : impls) {
+            if (auto i = FindGuard(guards, *receiverTy, builder); i < guards.size() && guards[i].second != callee) {
+                guards.erase(guards.begin() + static_cast<std::ptrdiff_t>(i));
+                changed = true;
+                break;
+            }
+        }
+    }
+}
+
+/// Remove the guards whose receivers would be dispatched to the same callee by a later guard.
+void RemoveRedundantGuards(
+    Guards& guards, const std::vector<std::pair<Type*, FuncBase*>>& impls, CHIRBuilder& builder)
+{
+    for (size_t i = 0; i < guards.size();) {
+        bool isRedundant = std::all_of(impls.begin(), impls.end(), [&guards, &builder, i](auto& impl) {
+            if (FindGuard(guards, *impl.first, builder) != i) {
+                return true;
+            }
+            auto next = FindGuard(guards, *impl.first, builder, i);
+            return next < guards.size() && guards[next].second == impl.second;
+        });
+        if (isRedundant) {
+            guards.erase(guards.begin() + static_cast<std::ptrdiff_t>(i));
+        } else {
+            ++i;
+        }
+    }
+}
+} // namespace
+
 FuncBase* Devirtualization::GetCandidateFromSpecificType(
     CHIRBuilder& builder, ClassType& specific, const FuncSig& method) const
 {
@@ -519,13 +651,14 @@ FuncBase* Devirtualization::GetCandidateFromSpecificType(
     return nullptr;
 }
 
-void Devirtualization::CollectCandidates(
+bool Devirtualization::CollectCandidates(
     CHIRBuilder& builder, ClassType* specific, std::pair<FuncBase*, Type*>& res, const FuncSig& method) const
 {
     auto specificDef = specific->GetClassDef();
-    if (IsOpenClass(*specificDef) && !devirtFuncInfo.CheckCustomTypeInternal(*specificDef)) {
-        // skip open classes with external linkage
-        return;
+    if (IsOpenClass(*specificDef) && !devirtFuncInfo.CheckCustomTypeClosed(*specificDef)) {
+        // open classes with external linkage may have subtypes unknown here
+        res = {nullptr, nullptr};
+        return false;
     }
     // 1. Get candidate from this type
     auto targetFromSpecificType = GetCandidateFromSpecificType(builder, *specific, method);
@@ -534,13 +667,13 @@ void Devirtualization::CollectCandidates(
     }
     if (!IsOpenClass(*specificDef)) {
         // non-open class do not need try its subtype
-        return;
+        return true;
     }
     auto& subtypeMap = devirtFuncInfo.GetSubtypeMap();
     auto it = subtypeMap.find(specificDef);
     if (it == subtypeMap.end()) {
         // return if has no subtype
-        return;
+        return true;
     }
     // 2. Get candidate from subtypes
     for (auto& inheritInfo : it->second) {
@@ -554,7 +687,9 @@ void Devirtualization::CollectCandidates(
         if (!subtypeClass ||
             (!subtypeClass->GetClassDef()->IsInterface() &&
                 !subtypeClass->GetClassDef()->TestAttr(Attribute::ABSTRACT))) {
-            auto extendsOrImplements = devirtFuncInfo.defsMap[subtypeClass];
+            // the defs of a non-class subtype are keyed by the type in its subtype info
+            auto extendsOrImplements =
+                devirtFuncInfo.defsMap[subtypeClass != nullptr ? subtype : inheritInfo.subInstType];
             for (auto oriDef : extendsOrImplements) {
                 auto def = oriDef->GetGenericDecl() != nullptr ? oriDef->GetGenericDecl() : oriDef;
                 for (auto [parentTy, infos] : def->GetVTable()) {
@@ -566,16 +701,141 @@ void Devirtualization::CollectCandidates(
                             res = {target, subtypeClass};
                         } else if (res.first != target) {
                             res = {nullptr, nullptr};
-                            return;
+                            return false;
                         }
                     }
                 }
             }
         }
-        if (subtypeClass) {
-            CollectCandidates(builder, subtypeClass, res, method);
+        if (subtypeClass && !CollectCandidates(builder, subtypeClass, res, method)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Devirtualization::CollectImplementations(CHIRBuilder& builder, ClassType& specific, const FuncSig& method,
+    std::vector<std::pair<Type*, FuncBase*>>& impls) const
+{
+    auto specificDef = specific.GetClassDef();
+    if (impls.size() > MAX_GUARDED_IMPLEMENTATIONS ||
+        (IsOpenClass(*specificDef) && !devirtFuncInfo.CheckCustomTypeClosed(*specificDef))) {
+        return false;
+    }
+    if (!specificDef->IsAbstract() && !specificDef->IsInterface()) {
+        // every instance of a concrete class must be dispatched somewhere, give up if it's unknown
+        auto target = GetCandidateFromSpecificType(builder, specific, method);
+        if (target == nullptr) {
+            return false;
+        }
+        impls.emplace_back(&specific, target);
+    }
+    if (!IsOpenClass(*specificDef)) {
+        return true;
+    }
+    auto& subtypeMap = devirtFuncInfo.GetSubtypeMap();
+    auto it = subtypeMap.find(specificDef);
+    if (it == subtypeMap.end()) {
+        return true;
+    }
+    for (auto& inheritInfo : it->second) {
+        auto expected = inheritInfo.parentInstType;
+        std::unordered_map<const GenericType*, Type*> replaceTable;
+        if (!IsValidSubType(builder, expected, &specific, replaceTable)) {
+            continue;
+        }
+        auto subtype = ReplaceRawGenericArgType(*(inheritInfo.subInstType), replaceTable, builder);
+        if (auto subtypeClass = DynamicCast<ClassType*>(subtype)) {
+            if (!CollectImplementations(builder, *subtypeClass, method, impls)) {
+                return false;
+            }
+            continue;
+        }
+        // a struct, enum or builtin type implementing the interface
+        FuncBase* target = nullptr;
+        for (auto oriDef : devirtFuncInfo.defsMap[inheritInfo.subInstType]) {
+            auto def = oriDef->GetGenericDecl() != nullptr ? oriDef->GetGenericDecl() : oriDef;
+            for (auto [parentTy, infos] : def->GetVTable()) {
+                if (target == nullptr && expected->IsEqualOrSubTypeOf(*parentTy->StripAllRefs(), builder)) {
+                    target = FindFunctionInVtable(parentTy, infos, method, builder);
+                }
+            }
+        }
+        if (target == nullptr) {
+            return false;
+        }
+        impls.emplace_back(subtype, target);
+    }
+    return true;
+}
+
+std::vector<std::pair<ClassType*, FuncBase*>> Devirtualization::SelectGuards(
+    const std::vector<std::pair<Type*, FuncBase*>>& impls, CHIRBuilder& builder) const
+{
+    Guards guards;
+    std::unordered_set<FuncBase*> callees;
+    for (auto [receiverTy, callee] : impls) {
+        callees.emplace(callee);
+        // receivers of other types, or of generic classes, are left to the virtual call
+        if (!receiverTy->IsClass() || receiverTy->IsGenericRelated()) {
+            continue;
         }
+        auto classTy = StaticCast<ClassType*>(receiverTy);
+        if (std::find_if(guards.begin(), guards.end(), [classTy](auto& guard) { return guard.first == classTy; }) ==
+            guards.end()) {
+            guards.emplace_back(classTy, callee);
+        }
+    }
+    if (callees.size() < 2) {
+        return {};
+    }
+    // a subclass is tested before its superclasses
+    std::stable_sort(guards.begin(), guards.end(),
+        [](auto& lhs, auto& rhs) { return GetInheritanceDepth(*lhs.first) > GetInheritanceDepth(*rhs.first); });
+    RemoveWrongGuards(guards, impls, builder);
+    RemoveRedundantGuards(guards, impls, builder);
+    if (profile != nullptr) {
+        auto hotness = [this](const FuncBase* callee) {
+            return profile->GetFuncHotness(callee->GetIdentifierWithoutPrefix());
+        };
+        // cold callees are not worth a fast path, and the hot ones are kept first if there are too many guards
+        guards.erase(std::remove_if(guards.begin(), guards.end(),
+            [&hotness](auto& guard) { return hotness(guard.second) == PGOProfileInfo::Hotness::COLD; }),
+            guards.end());
+        if (guards.size() > MAX_GUARDS) {
+            auto byHotness = guards;
+            std::stable_sort(byHotness.begin(), byHotness.end(),
+                [&hotness](auto& lhs, auto& rhs) { return hotness(lhs.second) > hotness(rhs.second); });
+            byHotness.resize(MAX_GUARDS);
+            guards.erase(std::remove_if(guards.begin(), guards.end(), [&byHotness](auto& guard) {
+                return std::find(byHotness.begin(), byHotness.end(), guard) == byHotness.end();
+            }), guards.end());
+        }
+        RemoveWrongGuards(guards, impls, builder);
+    }
+    if (guards.size() > MAX_GUARDS) {
+        return {};
+    }
+    return guards;
+}
+
+std::vector<std::pair<ClassType*, FuncBase*>> Devirtualization::FindGuardedCallees(
+    CHIRBuilder& builder, const TypeValue* typeState, const FuncSig& method, const Func& caller) const
+{
+    auto specificType = typeState->GetSpecificType();
+    if (typeState->GetTypeKind() != DevirtualTyKind::SUBTYPE_OF || !specificType->IsClass()) {
+        return {};
+    }
+    // the fast paths only pay off where the call is executed
+    if (profile != nullptr &&
+        profile->GetFuncHotness(caller.GetIdentifierWithoutPrefix()) == PGOProfileInfo::Hotness::COLD) {
+        return {};
+    }
+    std::vector<std::pair<Type*, FuncBase*>> impls;
+    if (!CollectImplementations(builder, *StaticCast<ClassType*>(specificType), method, impls)) {
+        return {};
     }
+    return SelectGuards(impls, builder);
 }
 
 bool Devirtualization::CheckFuncHasInvoke(const BlockGroup& bg)
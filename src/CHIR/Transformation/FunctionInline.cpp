@@ -14,6 +14,7 @@
 
 #include <list>
 
+#include "cangjie/CHIR/Analysis/LoopAnalysis.h"
 #include "cangjie/CHIR/CHIRCasting.h"
 #include "cangjie/CHIR/Expression/Terminator.h"
 #include "cangjie/CHIR/Type/PrivateTypeConverter.h"
@@ -21,6 +22,7 @@
 #include "cangjie/CHIR/Utils.h"
 #include "cangjie/CHIR/Visitor/Visitor.h"
 #include "cangjie/CHIR/Transformation/BlockGroupCopyHelper.h"
+#include "cangjie/Utils/FileUtil.h"
 
 using namespace Cangjie::CHIR;
 
@@ -28,9 +30,11 @@ using namespace Cangjie::CHIR;
 constexpr static size_t INIT_INLINE_THRESHOLD = 20;
 // Set the threshold value of inlined call in one function to avoid code expandsion
 constexpr static size_t INLINED_COUNT_THRESHOLD = 20;
+// The threshold of a call site never exceeds 3 times of the initial threshold
+constexpr static size_t MAX_INLINE_THRESHOLD = INIT_INLINE_THRESHOLD * 3;
 // This is for efficiency and avoid overflowing on `size`, we will
-// terminate the counting if the size is already 3 times of the threshold
-constexpr static size_t SEARCH_THRESHOLD = INIT_INLINE_THRESHOLD * 3;
+// terminate the counting once the size exceeds the max threshold
+constexpr static size_t SEARCH_THRESHOLD = MAX_INLINE_THRESHOLD + 1;
 
 // Increase the threshold value by 20%
 constexpr static size_t INCREASE_THRESHOLD = 5;
@@ -38,6 +42,20 @@ constexpr static size_t INCREASE_THRESHOLD = 5;
 // Step when the callee is with lambda parameter
 constexpr static size_t INCREASE_WHEN_CALLEE_WITH_LAMBDA_ARG = 2;
 
+// Nested loops beyond this depth don't increase the threshold any more
+constexpr static size_t MAX_LOOP_DEPTH_BONUS = 3;
+
+// Step when the profile marks the call site hot
+constexpr static size_t INCREASE_WHEN_HOT_CALL_SITE = 2;
+
+// Only tiny functions like getters are inlined into cold paths such as exception handlers
+constexpr static size_t COLD_INLINE_THRESHOLD = INIT_INLINE_THRESHOLD / 4;
+
+// The total size of inlined functions is limited to 40% of the size of the package
+constexpr static size_t CODE_GROWTH_PERCENT = 40;
+constexpr static size_t PERCENT = 100;
+constexpr static size_t MIN_CODE_GROWTH_BUDGET = INIT_INLINE_THRESHOLD * INLINED_COUNT_THRESHOLD;
+
 // Set the threshold of CHIR in one block for inline
 constexpr static size_t INLINED_BLOCKSIZE_THRESHOLD = 10000;
 
@@ -71,8 +89,31 @@ static const std::vector<FuncInfo> functionInlineBlackList = {
     FuncInfo("wrappingShr", NOT_CARE, {NOT_CARE}, ANY_TYPE, "std.overflow"),
 };
 
+static bool IsInExceptionHandler(const LoopInfo& loopInfo, const Block& block)
+{
+    for (auto cur = &block; cur != nullptr; cur = loopInfo.GetIDom(cur)) {
+        if (cur->IsLandingPadBlock()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void FunctionInline::InlineImpl(BlockGroup& bg)
 {
+    // call site info is computed before inlining any call, since inlining changes the CFG
+    LoopInfo loopInfo(bg);
+    for (auto block : bg.GetBlocks()) {
+        CallSiteInfo info{loopInfo.GetLoopDepth(block), IsInExceptionHandler(loopInfo, *block)};
+        if (info.loopDepth == 0 && !info.inExceptionHandler) {
+            continue;
+        }
+        for (auto expr : block->GetExpressions()) {
+            if (expr->GetExprKind() == ExprKind::APPLY) {
+                callSiteInfo.emplace(StaticCast<Apply*>(expr), info);
+            }
+        }
+    }
     auto postVisit = [this](Expression& e) {
         if (e.GetExprKind() == ExprKind::LAMBDA) {
             auto lambda = StaticCast<Lambda*>(&e);
@@ -85,6 +126,8 @@ void FunctionInline::InlineImpl(BlockGroup& bg)
         auto& apply = StaticCast<Apply&>(e);
         if (CheckCanRewrite(apply)) {
             DoFunctionInline(apply, optName);
+            // the size of the current function is changed
+            funcSizeMap.erase(globalFunc);
         }
 
         return VisitResult::CONTINUE;
@@ -95,9 +138,29 @@ void FunctionInline::InlineImpl(BlockGroup& bg)
 void FunctionInline::Run(Func& func)
 {
     globalFunc = &func;
+    callSiteInfo.clear();
     InlineImpl(*func.GetBody());
 }
 
+void FunctionInline::SetProfile(const PGOProfileInfo* pgoProfile)
+{
+    profile = pgoProfile;
+}
+
+void FunctionInline::EnableRemarks()
+{
+    remarksEnabled = true;
+}
+
+bool FunctionInline::WriteRemarks(const std::string& path) const
+{
+    std::string content;
+    for (auto& remark : remarks) {
+        content += remark + "\n";
+    }
+    return FileUtil::WriteToFile(path, content);
+}
+
 const OptEffectCHIRMap& FunctionInline::GetEffectMap() const
 {
     return effectMap;
@@ -149,15 +212,14 @@ static bool OnlyCalledOnce(const Func& func)
     return true;
 }
 
-static bool IsHotSpotCall(const Func& callee)
+static bool IsHotSpotCall(const Func& callee, size_t loopDepth)
 {
     // Case A: the callee is operator overloading function like `[]`, `+`, `-`
     if (callee.TestAttr(Attribute::OPERATOR)) {
         return true;
     }
     // Case B: the call site is located in a loop
-    // note: currently unsupported
-    return false;
+    return loopDepth > 0;
 }
 
 static bool FunctionWithLambdaArg(const Func& func)
@@ -170,25 +232,35 @@ static bool FunctionWithLambdaArg(const Func& func)
     return false;
 }
 
-static size_t CalculateThreshold(const Value& callee, const Cangjie::GlobalOptions::OptimizationLevel& optLevel)
+static size_t CalculateThreshold(const Func& func, const Cangjie::GlobalOptions::OptimizationLevel& optLevel,
+    size_t loopDepth, PGOProfileInfo::Hotness hotness)
 {
     size_t realThreshold = INIT_INLINE_THRESHOLD;
-    auto func = Cangjie::DynamicCast<const Func*>(&callee);
-    CJC_NULLPTR_CHECK(func);
-    if (OnlyCalledOnce(*func)) {
+    if (OnlyCalledOnce(func)) {
         // Increase the threshold value by 20%
         realThreshold += realThreshold / INCREASE_THRESHOLD;
     }
     if (optLevel < Cangjie::GlobalOptions::OptimizationLevel::Os) {
-        if (IsHotSpotCall(*func)) {
+        if (IsHotSpotCall(func, loopDepth)) {
             // Increase the threshold value by 20%
             realThreshold = INIT_INLINE_THRESHOLD + INIT_INLINE_THRESHOLD / INCREASE_THRESHOLD;
         }
-        if (FunctionWithLambdaArg(*func)) {
+        if (FunctionWithLambdaArg(func)) {
             realThreshold = INIT_INLINE_THRESHOLD * INCREASE_WHEN_CALLEE_WITH_LAMBDA_ARG;
         }
+        if (loopDepth > 1) {
+            // Increase the threshold value by another 20% for each level of nested loop
+            size_t extraDepth = std::min(loopDepth, MAX_LOOP_DEPTH_BONUS) - 1;
+            realThreshold += INIT_INLINE_THRESHOLD / INCREASE_THRESHOLD * extraDepth;
+        }
+        if (hotness == PGOProfileInfo::Hotness::HOT) {
+            realThreshold *= INCREASE_WHEN_HOT_CALL_SITE;
+        }
+    }
+    if (hotness == PGOProfileInfo::Hotness::COLD) {
+        realThreshold = std::min(realThreshold, COLD_INLINE_THRESHOLD);
     }
-    return realThreshold;
+    return std::min(realThreshold, MAX_INLINE_THRESHOLD);
 }
 
 static size_t GetExprSize(const Expression& expr)
@@ -205,20 +277,110 @@ static size_t GetExprSize(const Expression& expr)
     return exprSize;
 }
 
-static size_t CountFuncSize(const Func& func)
+static size_t CountFuncSize(const Func& func, size_t limit)
 {
     size_t funcSize = 0;
     for (auto block : func.GetBody()->GetBlocks()) {
         for (auto e : block->GetExpressions()) {
             funcSize += GetExprSize(*e);
-            if (funcSize >= SEARCH_THRESHOLD) {
-                break;
+            if (funcSize >= limit) {
+                return funcSize;
             }
         }
     }
     return funcSize;
 }
 
+void FunctionInline::SetCodeGrowthBudget(const std::vector<Func*>& funcs)
+{
+    size_t packageSize = 0;
+    for (auto func : funcs) {
+        if (func != nullptr && func->GetBody() != nullptr) {
+            packageSize += CountFuncSize(*func, SIZE_MAX);
+        }
+    }
+    codeGrowthBudget = std::max(packageSize / PERCENT * CODE_GROWTH_PERCENT, MIN_CODE_GROWTH_BUDGET);
+}
+
+size_t FunctionInline::GetFuncSize(Func& func)
+{
+    // `res` is std::pair<iterator, bool>, so
+    // `res.second == true` means `callee` is emplaced successfully, then we must set correct function size
+    // `res.second == false` means `callee` has already been emplaced before, we can use its size directly
+    auto res = funcSizeMap.emplace(&func, 0);
+    if (res.second) {
+        res.first->second = CountFuncSize(func, SEARCH_THRESHOLD);
+    }
+    return res.first->second;
+}
+
+PGOProfileInfo::Hotness FunctionInline::GetCallSiteHotness(const Func& callee) const
+{
+    if (profile == nullptr) {
+        return PGOProfileInfo::Hotness::UNKNOWN;
+    }
+    // call sites are not profiled, a call site is cold if its caller is never executed, and hot if both the caller
+    // and the callee are hot
+    auto callerHotness = profile->GetFuncHotness(globalFunc->GetIdentifierWithoutPrefix());
+    if (callerHotness == PGOProfileInfo::Hotness::COLD) {
+        return PGOProfileInfo::Hotness::COLD;
+    }
+    if (callerHotness == PGOProfileInfo::Hotness::HOT &&
+        profile->GetFuncHotness(callee.GetIdentifierWithoutPrefix()) == PGOProfileInfo::Hotness::HOT) {
+        return PGOProfileInfo::Hotness::HOT;
+    }
+    return PGOProfileInfo::Hotness::NORMAL;
+}
+
+static std::string EscapeJsonString(const std::string& str)
+{
+    std::string res;
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            res += '\\';
+            res += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            // control characters must be escaped in a JSON string, e.g. "\u000a" for a new line
+            constexpr char hexDigits[] = "0123456789abcdef";
+            constexpr unsigned hexBits = 4;
+            auto code = static_cast<unsigned char>(c);
+            res += "\\u00";
+            res += hexDigits[code >> hexBits];
+            res += hexDigits[code & 0xFU];
+        } else {
+            res += c;
+        }
+    }
+    return res;
+}
+
+bool FunctionInline::Decide(
+    const Apply& apply, bool inlined, const std::string& reason, size_t size, size_t threshold)
+{
+    if (!remarksEnabled) {
+        return inlined;
+    }
+    auto& loc = apply.GetDebugLocation();
+    auto it = callSiteInfo.find(&apply);
+    auto info = it == callSiteInfo.end() ? CallSiteInfo{} : it->second;
+    auto callee = VirtualCast<Func*>(apply.GetCallee());
+    std::string remark = "{\"pass\":\"" + optName + "\"" +
+        ",\"caller\":\"" + EscapeJsonString(globalFunc->GetIdentifierWithoutPrefix()) + "\"" +
+        ",\"callee\":\"" + EscapeJsonString(callee->GetIdentifierWithoutPrefix()) + "\"" +
+        ",\"file\":\"" + EscapeJsonString(loc.GetAbsPath()) + "\"" +
+        ",\"line\":" + std::to_string(loc.GetBeginPos().line) +
+        ",\"column\":" + std::to_string(loc.GetBeginPos().column) +
+        ",\"inlined\":" + (inlined ? "true" : "false") +
+        ",\"reason\":\"" + reason + "\"" +
+        ",\"size\":" + std::to_string(size) +
+        ",\"threshold\":" + std::to_string(threshold) +
+        ",\"loopDepth\":" + std::to_string(info.loopDepth) +
+        ",\"inExceptionHandler\":" + (info.inExceptionHandler ? "true" : "false") +
+        ",\"hotness\":\"" + HotnessToString(GetCallSiteHotness(*callee)) + "\"}";
+    remarks.emplace_back(std::move(remark));
+    return inlined;
+}
+
 bool FunctionInline::CheckCanRewrite(const Apply& apply)
 {
     auto callee = apply.GetCallee();
@@ -231,47 +393,50 @@ bool FunctionInline::CheckCanRewrite(const Apply& apply)
 
     // when the terminator of this block is RaiseException, do not inline this apply because it rarely happens
     if (auto block = apply.GetParentBlock(); Is<RaiseException>(block->GetTerminator())) {
-        return false;
+        return Decide(apply, false, "raise-exception-block");
     }
 
     // Omit the function inline in block that exceed the Blocksize
     // threshold to avoid the huge time consume.
     auto block = apply.GetParentBlock();
     if (block->GetExpressions().size() >= INLINED_BLOCKSIZE_THRESHOLD) {
-        return false;
+        return Decide(apply, false, "caller-block-too-large");
     }
 
     // recursive function doesn't need to inline
     // if you really want to inline it, yes, you can, it won't cause a problem
     if (callee == globalFunc) {
-        return false;
+        return Decide(apply, false, "recursive");
     }
     if (InBlackList(*func)) {
-        return false;
+        return Decide(apply, false, "blacklist");
     }
     if (InWhiteList(*func)) {
-        return true;
+        codeGrowth += GetFuncSize(*func);
+        return Decide(apply, true, "whitelist", GetFuncSize(*func));
     }
     if (func->GetFuncKind() == FuncKind::INSTANCEVAR_INIT) {
-        return true;
+        codeGrowth += GetFuncSize(*func);
+        return Decide(apply, true, "instance-var-init", GetFuncSize(*func));
     }
     // Determine if we can inline by checking the size of callee exceed the threshold
     if (inlinedCountMap[globalFunc] >= INLINED_COUNT_THRESHOLD) {
-        return false;
-    }
-    size_t realThreshold = CalculateThreshold(*callee, optLevel);
-    // `res` is std::pair<iterator, bool>, so
-    // `res.second == true` means `callee` is emplaced successfully, then we must set correct function size
-    // `res.second == false` means `callee` has already been emplaced before, we can use its size directly
-    auto res = funcSizeMap.emplace(func, 0);
-    if (res.second) {
-        res.first->second = CountFuncSize(*func);
-    }
-    if (res.first->second <= realThreshold) {
-        inlinedCountMap[globalFunc]++;
-        return true;
-    }
-    return false;
+        return Decide(apply, false, "caller-inline-count-limit");
+    }
+    auto it = callSiteInfo.find(&apply);
+    auto info = it == callSiteInfo.end() ? CallSiteInfo{} : it->second;
+    auto hotness = info.inExceptionHandler ? PGOProfileInfo::Hotness::COLD : GetCallSiteHotness(*func);
+    size_t realThreshold = CalculateThreshold(*func, optLevel, info.loopDepth, hotness);
+    size_t funcSize = GetFuncSize(*func);
+    if (funcSize > realThreshold) {
+        return Decide(apply, false, "callee-too-large", funcSize, realThreshold);
+    }
+    if (codeGrowth + funcSize > codeGrowthBudget) {
+        return Decide(apply, false, "code-growth-budget", funcSize, realThreshold);
+    }
+    inlinedCountMap[globalFunc]++;
+    codeGrowth += funcSize;
+    return Decide(apply, true, "within-threshold", funcSize, realThreshold);
 }
 
 static std::vector<Block*> GetExitBlocks(const BlockGroup& blockGroup)
@@ -0,0 +1,193 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#include "cangjie/CHIR/Transformation/GenericSpecialization.h"
+
+#include "cangjie/CHIR/Analysis/LoopAnalysis.h"
+#include "cangjie/CHIR/Analysis/Utils.h"
+#include "cangjie/CHIR/CHIRCasting.h"
+#include "cangjie/CHIR/Transformation/BlockGroupCopyHelper.h"
+#include "cangjie/CHIR/Visitor/Visitor.h"
+
+using namespace Cangjie::CHIR;
+
+namespace Cangjie::CHIR {
+namespace {
+// a call site in a loop counts as 8 call sites per loop level
+constexpr size_t LOOP_WEIGHT_SHIFT = 3;
+constexpr size_t MAX_LOOP_DEPTH = 3;
+constexpr size_t HOT_CALLER_WEIGHT = 8;
+// a single call site out of loops doesn't pay for the copy
+constexpr size_t MIN_CANDIDATE_WEIGHT = 2;
+constexpr size_t MAX_SPECIALIZED_FUNC_SIZE = 500;
+constexpr size_t CODE_GROWTH_PERCENT = 20;
+constexpr size_t PERCENT = 100;
+constexpr size_t MIN_CODE_GROWTH_BUDGET = 2000;
+
+size_t CountFuncSize(const Func& func)
+{
+    size_t size = 0;
+    Visitor::Visit(*func.GetBody(), [&size](Expression&) {
+        ++size;
+        return VisitResult::CONTINUE;
+    });
+    return size;
+}
+
+/// Check whether a value of @p instTy is boxed when passed to or returned from a function where it's of @p genericTy.
+bool IsBoxedByGenericCall(const Type& genericTy, const Type& instTy)
+{
+    return genericTy.IsGenericRelated() && instTy.IsValueType();
+}
+
+/// Get the generic function with a body called by @p apply, if calling it with the types at @p apply would box some
+/// arguments or the result.
+Func* GetSpecializableCallee(const Apply& apply)
+{
+    auto callee = DynamicCast<Func*>(apply.GetCallee());
+    if (callee == nullptr || callee->GetBody() == nullptr || !callee->IsInGenericContext() ||
+        callee->Get<WrappedRawMethod>() != nullptr) {
+        return nullptr;
+    }
+    auto args = apply.GetArgs();
+    auto paramTys = callee->GetFuncType()->GetParamTypes();
+    if (args.size() != paramTys.size() || apply.GetResultType()->IsGenericRelated()) {
+        return nullptr;
+    }
+    bool isBoxed = IsBoxedByGenericCall(*callee->GetFuncType()->GetReturnType(), *apply.GetResultType());
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i]->GetType()->IsGenericRelated()) {
+            return nullptr;
+        }
+        isBoxed = isBoxed || IsBoxedByGenericCall(*paramTys[i], *args[i]->GetType());
+    }
+    return isBoxed ? callee : nullptr;
+}
+} // namespace
+} // namespace Cangjie::CHIR
+
+void GenericSpecialization::SetProfile(const PGOProfileInfo* pgoProfile)
+{
+    profile = pgoProfile;
+}
+
+const std::vector<Func*>& GenericSpecialization::GetSpecializedFuncs() const
+{
+    return specializedFuncs;
+}
+
+size_t GenericSpecialization::GetCallerWeight(const Func& caller) const
+{
+    if (profile == nullptr) {
+        return 1;
+    }
+    switch (profile->GetFuncHotness(caller.GetIdentifierWithoutPrefix())) {
+        case PGOProfileInfo::Hotness::COLD:
+            return 0;
+        case PGOProfileInfo::Hotness::HOT:
+            return HOT_CALLER_WEIGHT;
+        default:
+            return 1;
+    }
+}
+
+void GenericSpecialization::CollectCandidates(const Func& caller, const BlockGroup& blockGroup, size_t outerLoopDepth)
+{
+    auto callerWeight = GetCallerWeight(caller);
+    if (callerWeight == 0) {
+        return;
+    }
+    LoopInfo loopInfo(blockGroup);
+    for (auto block : blockGroup.GetBlocks()) {
+        auto loopDepth = std::min(outerLoopDepth + loopInfo.GetLoopDepth(block), MAX_LOOP_DEPTH);
+        for (auto expr : block->GetExpressions()) {
+            if (expr->GetExprKind() == ExprKind::LAMBDA) {
+                CollectCandidates(caller, *StaticCast<Lambda*>(expr)->GetBody(), loopDepth);
+                continue;
+            }
+            if (expr->GetExprKind() != ExprKind::APPLY) {
+                continue;
+            }
+            auto apply = StaticCast<Apply*>(expr);
+            if (GetSpecializableCallee(*apply) == nullptr) {
+                continue;
+            }
+            auto mangledName = GetInstFuncMangleName(*apply, builder);
+            auto [it, inserted] = candidates.emplace(mangledName, Candidate{});
+            if (inserted) {
+                candidateOrder.emplace_back(mangledName);
+            }
+            it->second.applies.emplace_back(apply);
+            it->second.weight += callerWeight << (loopDepth * LOOP_WEIGHT_SHIFT);
+        }
+    }
+}
+
+void GenericSpecialization::Specialize(const std::string& mangledName, const Candidate& candidate)
+{
+    auto& firstApply = *candidate.applies.front();
+    auto callee = VirtualCast<Func*>(firstApply.GetCallee());
+    Func* specializedFunc = nullptr;
+    if (auto it = specializedFuncMap.find(mangledName); it != specializedFuncMap.end()) {
+        specializedFunc = it->second;
+    } else {
+        auto size = CountFuncSize(*callee);
+        if (size > MAX_SPECIALIZED_FUNC_SIZE || size > budget) {
+            return;
+        }
+        budget -= size;
+        specializedFunc = CreateInstFunc(firstApply, mangledName, builder);
+        specializedFuncMap.emplace(mangledName, specializedFunc);
+        specializedFuncs.emplace_back(specializedFunc);
+    }
+    for (auto apply : candidate.applies) {
+        auto instApply = builder.CreateExpression<Apply>(apply->GetDebugLocation(), apply->GetResultType(),
+            specializedFunc, FuncCallContext{.args = apply->GetArgs()}, apply->GetParentBlock());
+        apply->ReplaceWith(*instApply);
+        if (isDebug) {
+            std::string message = "[GenericSpecialization] The function call to " + callee->GetSrcCodeIdentifier() +
+                ToPosInfo(instApply->GetDebugLocation()) + " was specialized.";
+            std::cout << message << std::endl;
+        }
+    }
+}
+
+void GenericSpecialization::RunOnPackage(const Package& package)
+{
+    std::vector<Func*> funcs;
+    size_t packageSize = 0;
+    for (auto func : package.GetGlobalFuncs()) {
+        if (func->GetBody() == nullptr) {
+            continue;
+        }
+        packageSize += CountFuncSize(*func);
+        // the functions used by runtime and annotations mustn't be optimized
+        if (func->GetSrcCodeIdentifier() != "$toAny" && func->GetFuncKind() != FuncKind::ANNOFACTORY_FUNC) {
+            funcs.emplace_back(func);
+        }
+    }
+    budget = std::max(packageSize / PERCENT * CODE_GROWTH_PERCENT, MIN_CODE_GROWTH_BUDGET);
+    // the calls in the specialized functions become concrete, so they are scanned in the next round
+    while (!funcs.empty() && budget > 0) {
+        candidates.clear();
+        candidateOrder.clear();
+        for (auto func : funcs) {
+            CollectCandidates(*func, *func->GetBody(), 0);
+        }
+        std::stable_sort(candidateOrder.begin(), candidateOrder.end(), [this](auto& lhs, auto& rhs) {
+            return candidates.at(lhs).weight > candidates.at(rhs).weight;
+        });
+        auto specializedCount = specializedFuncs.size();
+        for (auto& mangledName : candidateOrder) {
+            auto& candidate = candidates.at(mangledName);
+            // the call sites of an existing copy are rewritten regardless of their weight
+            if (candidate.weight >= MIN_CANDIDATE_WEIGHT || specializedFuncMap.count(mangledName) != 0) {
+                Specialize(mangledName, candidate);
+            }
+        }
+        funcs.assign(specializedFuncs.begin() + static_cast<std::ptrdiff_t>(specializedCount), specializedFuncs.end());
+    }
+}
@@ -0,0 +1,291 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#include "cangjie/CHIR/Transformation/LoopInvariantCodeMotion.h"
+
+#include "cangjie/CHIR/Analysis/Utils.h"
+#include "cangjie/CHIR/CHIRCasting.h"
+#include "cangjie/CHIR/Expression/Terminator.h"
+
+using namespace Cangjie::CHIR;
+
+namespace Cangjie::CHIR {
+namespace {
+bool IsNoSideEffectApply(const Expression& expr)
+{
+    Value* callee = nullptr;
+    if (expr.GetExprKind() == ExprKind::APPLY) {
+        callee = StaticCast<const Apply&>(expr).GetCallee();
+    } else if (expr.GetExprKind() == ExprKind::APPLY_WITH_EXCEPTION) {
+        callee = StaticCast<const ApplyWithException&>(expr).GetCallee();
+    }
+    return callee != nullptr && callee->TestAttr(Attribute::NO_SIDE_EFFECT);
+}
+
+/// Whether @p expr may write memory visible outside the current function.
+bool MayWriteMemory(const Expression& expr)
+{
+    switch (expr.GetExprKind()) {
+        case ExprKind::STORE:
+        case ExprKind::STORE_ELEMENT_REF:
+        case ExprKind::STORE_ELEMENT_BY_NAME:
+        case ExprKind::RAW_ARRAY_LITERAL_INIT:
+        case ExprKind::RAW_ARRAY_INIT_BY_VALUE:
+        case ExprKind::INTRINSIC:
+        case ExprKind::INTRINSIC_WITH_EXCEPTION:
+        case ExprKind::SPAWN:
+        case ExprKind::SPAWN_WITH_EXCEPTION:
+        case ExprKind::INVOKE:
+        case ExprKind::INVOKE_WITH_EXCEPTION:
+        case ExprKind::INVOKESTATIC:
+        case ExprKind::INVOKESTATIC_WITH_EXCEPTION:
+            return true;
+        case ExprKind::APPLY:
+        case ExprKind::APPLY_WITH_EXCEPTION:
+            return !IsNoSideEffectApply(expr);
+        default:
+            return false;
+    }
+}
+
+bool IsThrowingArithmetic(OverflowStrategy ofs)
+{
+    return ofs == OverflowStrategy::THROWING;
+}
+
+/// Whether @p expr can be executed speculatively, i.e. it neither writes memory nor throws.
+bool IsSpeculatable(const Expression& expr)
+{
+    switch (expr.GetExprKind()) {
+        case ExprKind::CONSTANT:
+        case ExprKind::TUPLE:
+        case ExprKind::FIELD:
+        case ExprKind::GET_ELEMENT_REF:
+        case ExprKind::INSTANCEOF:
+        case ExprKind::NOT:
+        case ExprKind::BITNOT:
+        case ExprKind::BITAND:
+        case ExprKind::BITOR:
+        case ExprKind::BITXOR:
+        case ExprKind::LT:
+        case ExprKind::GT:
+        case ExprKind::LE:
+        case ExprKind::GE:
+        case ExprKind::EQUAL:
+        case ExprKind::NOTEQUAL:
+        case ExprKind::AND:
+        case ExprKind::OR:
+            return true;
+        case ExprKind::NEG:
+            return !IsThrowingArithmetic(StaticCast<const UnaryExpression&>(expr).GetOverflowStrategy());
+        case ExprKind::ADD:
+        case ExprKind::SUB:
+        case ExprKind::MUL:
+            // `div`, `mod`, `exp` and shifts may throw whatever the overflow strategy is
+            return !IsThrowingArithmetic(StaticCast<const BinaryExpression&>(expr).GetOverflowStrategy());
+        case ExprKind::TYPECAST:
+            return !IsThrowingArithmetic(StaticCast<const TypeCast&>(expr).GetOverflowStrategy());
+        default:
+            return false;
+    }
+}
+
+/// Whether @p location is a local variable whose address never leaves its block group, so only the stores in
+/// this block group can modify it.
+bool IsNonEscapingLocalVar(const Value& location, const BlockGroup& blockGroup)
+{
+    if (!location.IsLocalVar()) {
+        return false;
+    }
+    auto def = StaticCast<const LocalVar&>(location).GetExpr();
+    if (def->GetExprKind() != ExprKind::ALLOCATE) {
+        return false;
+    }
+    for (auto user : location.GetUsers()) {
+        if (user->GetParentBlockGroup() != &blockGroup) {
+            // captured by a lambda
+            return false;
+        }
+        if (user->GetExprKind() == ExprKind::LOAD || user->GetExprKind() == ExprKind::DEBUGEXPR) {
+            continue;
+        }
+        if (user->GetExprKind() == ExprKind::STORE && StaticCast<Store*>(user)->GetLocation() == &location &&
+            StaticCast<Store*>(user)->GetValue() != &location) {
+            continue;
+        }
+        return false;
+    }
+    return true;
+}
+
+class LoopHoister {
+public:
+    LoopHoister(const NaturalLoop& loop, const LoopInfo& loopInfo) : loop(loop), loopInfo(loopInfo)
+    {
+        for (auto block : loop.GetBlocks()) {
+            for (auto expr : block->GetExpressions()) {
+                writesMemory = writesMemory || MayWriteMemory(*expr);
+                if (expr->GetExprKind() == ExprKind::STORE) {
+                    storedLocations.emplace(StaticCast<Store*>(expr)->GetLocation());
+                }
+            }
+        }
+        exitingBlocks = loop.GetExitingBlocks();
+    }
+
+    /// Collect the invariant expressions in the order they should be hoisted.
+    std::vector<Expression*> CollectInvariants()
+    {
+        std::vector<Expression*> res;
+        for (auto block : loop.GetBlocks()) {
+            // expressions of inner loops are hoisted to the preheaders of inner loops first
+            if (loopInfo.GetLoopFor(block) != &loop) {
+                continue;
+            }
+            for (auto expr : block->GetExpressions()) {
+                if (expr->IsTerminator() || !IsInvariant(*expr) || !IsHoistable(*expr)) {
+                    continue;
+                }
+                invariants.emplace(expr);
+                res.emplace_back(expr);
+            }
+        }
+        return res;
+    }
+
+private:
+    bool IsInvariant(const Expression& expr) const
+    {
+        for (auto op : expr.GetOperands()) {
+            if (!op->IsLocalVar()) {
+                continue;
+            }
+            auto def = StaticCast<LocalVar*>(op)->GetExpr();
+            if (loop.Contains(def->GetParentBlock()) && invariants.count(def) == 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool IsHoistable(const Expression& expr) const
+    {
+        if (IsSpeculatable(expr)) {
+            return true;
+        }
+        if (expr.GetExprKind() == ExprKind::LOAD) {
+            auto location = StaticCast<const Load&>(expr).GetLocation();
+            return storedLocations.count(location) == 0 &&
+                IsNonEscapingLocalVar(*location, *loop.GetHeader()->GetParentBlockGroup());
+        }
+        if (expr.GetExprKind() == ExprKind::APPLY && IsNoSideEffectApply(expr)) {
+            // the result must not be a fresh object which may be modified in each iteration, and the call may
+            // throw, so it must be executed in every iteration before leaving the loop
+            if (writesMemory || !expr.GetResult()->GetType()->IsPrimitive()) {
+                return false;
+            }
+            // a loop without exits may run forever without reaching the call, and a block that does not
+            // dominate every latch may be skipped by some iterations
+            if (exitingBlocks.empty()) {
+                return false;
+            }
+            auto block = expr.GetParentBlock();
+            auto dominatedByBlock = [this, block](auto other) { return loopInfo.Dominates(block, other); };
+            return std::all_of(exitingBlocks.begin(), exitingBlocks.end(), dominatedByBlock) &&
+                std::all_of(loop.GetLatches().begin(), loop.GetLatches().end(), dominatedByBlock);
+        }
+        return false;
+    }
+
+    const NaturalLoop& loop;
+    const LoopInfo& loopInfo;
+    bool writesMemory{false};
+    std::unordered_set<const Value*> storedLocations;
+    std::vector<Block*> exitingBlocks;
+    std::unordered_set<const Expression*> invariants;
+};
+
+Block* CreatePreheader(const NaturalLoop& loop, CHIRBuilder& builder)
+{
+    auto header = loop.GetHeader();
+    auto preheader = builder.CreateBlock(header->GetParentBlockGroup());
+    std::unordered_set<Block*> redirected;
+    for (auto pred : header->GetPredecessors()) {
+        if (!loop.Contains(pred) && redirected.emplace(pred).second) {
+            pred->GetTerminator()->ReplaceSuccessor(*header, *preheader);
+        }
+    }
+    preheader->AppendExpression(builder.CreateTerminator<GoTo>(header, preheader));
+    return preheader;
+}
+} // namespace
+} // namespace Cangjie::CHIR
+
+void LoopInvariantCodeMotion::RunOnPackage(const Package& package, CHIRBuilder& builder, bool isDebug)
+{
+    for (auto func : package.GetGlobalFuncs()) {
+        if (auto body = func->GetBody(); body != nullptr) {
+            RunOnBlockGroup(*body, builder, isDebug);
+        }
+    }
+}
+
+void LoopInvariantCodeMotion::RunOnBlockGroup(BlockGroup& blockGroup, CHIRBuilder& builder, bool isDebug)
+{
+    for (auto block : blockGroup.GetBlocks()) {
+        for (auto expr : block->GetExpressions()) {
+            if (expr->GetExprKind() == ExprKind::LAMBDA) {
+                RunOnBlockGroup(*StaticCast<Lambda*>(expr)->GetBody(), builder, isDebug);
+            }
+        }
+    }
+    // creating a preheader changes the blocks of the enclosing loops, so the loop info is recomputed then and
+    // the loops already processed are skipped
+    std::unordered_set<const Block*> processedHeaders;
+    bool cfgChanged = true;
+    while (cfgChanged) {
+        cfgChanged = false;
+        LoopInfo loopInfo(blockGroup);
+        for (auto loop : loopInfo.GetLoopsInnermostFirst()) {
+            if (!processedHeaders.emplace(loop->GetHeader()).second) {
+                continue;
+            }
+            if (RunOnLoop(*loop, loopInfo, builder, isDebug)) {
+                cfgChanged = true;
+                break;
+            }
+        }
+    }
+}
+
+bool LoopInvariantCodeMotion::RunOnLoop(
+    const NaturalLoop& loop, const LoopInfo& loopInfo, CHIRBuilder& builder, bool isDebug)
+{
+    auto header = loop.GetHeader();
+    if (header->IsLandingPadBlock() || header == header->GetParentBlockGroup()->GetEntryBlock()) {
+        return false;
+    }
+    auto invariants = LoopHoister(loop, loopInfo).CollectInvariants();
+    if (invariants.empty()) {
+        return false;
+    }
+    bool cfgChanged = false;
+    auto preheader = loop.GetPreheader();
+    if (preheader == nullptr) {
+        preheader = CreatePreheader(loop, builder);
+        cfgChanged = true;
+    }
+    auto terminator = preheader->GetTerminator();
+    for (auto expr : invariants) {
+        expr->MoveBefore(terminator);
+        if (isDebug && !expr->GetDebugLocation().GetBeginPos().IsZero()) {
+            std::string message = "[LICM] " + expr->GetExprKindName() + ToPosInfo(expr->GetDebugLocation()) +
+                " has been hoisted out of the loop\n";
+            std::cout << message;
+        }
+    }
+    return cfgChanged;
+}
@@ -0,0 +1,174 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#include "cangjie/CHIR/Transformation/Mem2Reg.h"
+
+#include "cangjie/CHIR/Analysis/LoopAnalysis.h"
+#include "cangjie/CHIR/Analysis/Utils.h"
+#include "cangjie/CHIR/CHIRCasting.h"
+
+using namespace Cangjie::CHIR;
+
+namespace Cangjie::CHIR {
+namespace {
+struct PromotableVar {
+    Allocate* allocate;
+    std::vector<Store*> stores;
+    std::vector<Expression*> debugExprs;
+};
+
+/// Check whether the variable allocated by @p allocate can be promoted, i.e. its address is only used to load and
+/// store it in @p blockGroup.
+std::optional<PromotableVar> GetPromotableVar(Allocate& allocate, const BlockGroup& blockGroup)
+{
+    auto var = allocate.GetResult();
+    if (var->IsRetValue()) {
+        return std::nullopt;
+    }
+    PromotableVar res{&allocate, {}, {}};
+    for (auto user : var->GetUsers()) {
+        if (user->GetParentBlockGroup() != &blockGroup) {
+            // captured by a lambda
+            return std::nullopt;
+        }
+        switch (user->GetExprKind()) {
+            case ExprKind::LOAD:
+                break;
+            case ExprKind::STORE: {
+                auto store = StaticCast<Store*>(user);
+                auto value = store->GetValue();
+                // the callee info of applies to a loaded static member function needs to be adjusted when the load
+                // is replaced, which is left to `RedundantLoadElimination`
+                if (store->GetLocation() != var || value == var || value->IsFunc() ||
+                    value->GetType() != allocate.GetType()) {
+                    return std::nullopt;
+                }
+                res.stores.emplace_back(store);
+                break;
+            }
+            case ExprKind::DEBUGEXPR:
+                res.debugExprs.emplace_back(user);
+                break;
+            default:
+                return std::nullopt;
+        }
+    }
+    return res;
+}
+
+void ReplaceLoad(Load& load, Value& value)
+{
+    load.GetResult()->ReplaceWith(value);
+    load.RemoveSelfFromBlock();
+}
+
+/// Replace the loads preceded by a store to the same variable in the same block.
+void ForwardStoresInBlock(Block& block, const std::unordered_map<const Value*, PromotableVar>& vars)
+{
+    std::unordered_map<const Value*, Value*> curValues;
+    for (auto expr : block.GetExpressions()) {
+        if (expr->GetExprKind() == ExprKind::STORE) {
+            auto store = StaticCast<Store*>(expr);
+            if (vars.count(store->GetLocation()) != 0) {
+                curValues[store->GetLocation()] = store->GetValue();
+            }
+        } else if (expr->GetExprKind() == ExprKind::LOAD) {
+            auto load = StaticCast<Load*>(expr);
+            if (auto it = curValues.find(load->GetLocation()); it != curValues.end()) {
+                ReplaceLoad(*load, *it->second);
+            }
+        }
+    }
+}
+
+/// Replace the loads dominated by the only store to the variable.
+void ForwardSingleStore(const PromotableVar& var, const LoopInfo& domInfo)
+{
+    auto store = var.stores.front();
+    auto storeBlock = store->GetParentBlock();
+    for (auto user : var.allocate->GetResult()->GetUsers()) {
+        if (user->GetExprKind() != ExprKind::LOAD) {
+            continue;
+        }
+        // loads in the same block as the store are either forwarded already or executed before the store
+        auto loadBlock = user->GetParentBlock();
+        if (loadBlock != storeBlock && domInfo.Dominates(storeBlock, loadBlock)) {
+            ReplaceLoad(*StaticCast<Load*>(user), *store->GetValue());
+        }
+    }
+}
+
+bool HasLoad(const PromotableVar& var)
+{
+    auto users = var.allocate->GetResult()->GetUsers();
+    return std::any_of(users.begin(), users.end(), [](auto user) { return user->GetExprKind() == ExprKind::LOAD; });
+}
+
+void RemoveVar(const PromotableVar& var, bool isDebug)
+{
+    for (auto store : var.stores) {
+        store->RemoveSelfFromBlock();
+    }
+    for (auto debugExpr : var.debugExprs) {
+        debugExpr->RemoveSelfFromBlock();
+    }
+    var.allocate->RemoveSelfFromBlock();
+    if (isDebug && !var.allocate->GetDebugLocation().GetBeginPos().IsZero()) {
+        std::string message = "[Mem2Reg] The local variable" + ToPosInfo(var.allocate->GetDebugLocation()) +
+            " has been promoted\n";
+        std::cout << message;
+    }
+}
+} // namespace
+} // namespace Cangjie::CHIR
+
+void Mem2Reg::RunOnPackage(const Package& package, bool isDebug)
+{
+    for (auto func : package.GetGlobalFuncs()) {
+        if (auto body = func->GetBody(); body != nullptr) {
+            RunOnBlockGroup(*body, isDebug);
+        }
+    }
+}
+
+void Mem2Reg::RunOnBlockGroup(BlockGroup& blockGroup, bool isDebug)
+{
+    std::unordered_map<const Value*, PromotableVar> vars;
+    // keep the order of the variables for a stable output
+    std::vector<const Value*> varOrder;
+    for (auto block : blockGroup.GetBlocks()) {
+        for (auto expr : block->GetExpressions()) {
+            if (expr->GetExprKind() == ExprKind::LAMBDA) {
+                RunOnBlockGroup(*StaticCast<Lambda*>(expr)->GetBody(), isDebug);
+            } else if (expr->GetExprKind() == ExprKind::ALLOCATE) {
+                if (auto var = GetPromotableVar(*StaticCast<Allocate*>(expr), blockGroup); var.has_value()) {
+                    varOrder.emplace_back(expr->GetResult());
+                    vars.emplace(expr->GetResult(), std::move(*var));
+                }
+            }
+        }
+    }
+    if (vars.empty()) {
+        return;
+    }
+    for (auto block : blockGroup.GetBlocks()) {
+        ForwardStoresInBlock(*block, vars);
+    }
+    // the dominator tree is only needed for the variables stored once and loaded in other blocks
+    std::unique_ptr<LoopInfo> domInfo;
+    for (auto value : varOrder) {
+        auto& var = vars.at(value);
+        if (var.stores.size() == 1 && HasLoad(var)) {
+            if (domInfo == nullptr) {
+                domInfo = std::make_unique<LoopInfo>(blockGroup);
+            }
+            ForwardSingleStore(var, *domInfo);
+        }
+        if (!HasLoad(var)) {
+            RemoveVar(var, isDebug);
+        }
+    }
+}
@@ -23,6 +23,47 @@ std::optional<bool> CheckSingleBool(const ValueRange& vr)
     return std::nullopt;
 }
 
+void PrintBoundsCheckMessage(const Intrinsic& intrinsic, bool isDebug)
+{
+    if (isDebug) {
+        std::string message = "[RangePropagation] The bounds check of " +
+            ExprKindMgr::Instance()->GetKindName(static_cast<size_t>(intrinsic.GetExprKind())) +
+            ToPosInfo(intrinsic.GetDebugLocation()) + " has been eliminated\n";
+        std::cout << message;
+    }
+}
+
+/**
+ * The index of an array access is in bounds if it is non-negative and less than the size of the same array,
+ * i.e. it has a negative symbolic bound against an `ARRAY_SIZE` of the array, e.g. a loop variable compared
+ * against the size in the loop condition.
+ */
+bool IsArrayIndexInBounds(const Intrinsic& intrinsic, const RangeDomain& state)
+{
+    auto array = intrinsic.GetOperand(0);
+    auto index = intrinsic.GetOperand(1);
+    if (!index->GetType()->IsInteger()) {
+        return false;
+    }
+    const auto& indexRange = RangeAnalysis::GetSIntDomainFromState(state, index);
+    if (indexRange.IsBottom() || indexRange.NumericBound().SMinValue().IsNeg()) {
+        return false;
+    }
+    auto bounds = indexRange.SymbolicBounds();
+    for (auto it = bounds.Begin(); it != bounds.End(); ++it) {
+        if (!it->second.SMaxValue().IsNeg() || !it->first->IsLocalVar()) {
+            continue;
+        }
+        auto sizeExpr = StaticCast<LocalVar*>(it->first.get())->GetExpr();
+        if (sizeExpr->GetExprKind() == ExprKind::INTRINSIC &&
+            StaticCast<Intrinsic*>(sizeExpr)->GetIntrinsicKind() == CHIR::IntrinsicKind::ARRAY_SIZE &&
+            sizeExpr->GetOperand(0) == array) {
+            return true;
+        }
+    }
+    return false;
+}
+
 std::optional<SInt> CheckSingleSInt(const ValueRange& vr)
 {
     if (vr.GetRangeKind() == ValueRange::RangeKind::SINT) {
@@ -34,6 +75,57 @@ std::optional<SInt> CheckSingleSInt(const ValueRange& vr)
     return std::nullopt;
 }
 
+/**
+ * Check whether an integer `+`, `-` or `*` of the operand ranges @p ld and @p rd may overflow. The result of these
+ * operations is monotonic in each operand, so only the bounds of the operand ranges need to be checked.
+ */
+bool MayOverflow(ExprKind kind, const SIntDomain& ld, const SIntDomain& rd, bool isUnsigned)
+{
+    auto& ln = ld.NumericBound();
+    auto& rn = rd.NumericBound();
+    if (ln.IsEmptySet() || rn.IsEmptySet()) {
+        return true;
+    }
+    bool ov1 = false;
+    bool ov2 = false;
+    if (isUnsigned) {
+        switch (kind) {
+            case ExprKind::ADD:
+                (void)ln.UMaxValue().UAddOvf(rn.UMaxValue(), ov1);
+                break;
+            case ExprKind::SUB:
+                (void)ln.UMinValue().USubOvf(rn.UMaxValue(), ov1);
+                break;
+            default:
+                (void)ln.UMaxValue().UMulOvf(rn.UMaxValue(), ov1);
+                break;
+        }
+        return ov1;
+    }
+    switch (kind) {
+        case ExprKind::ADD:
+            (void)ln.SMinValue().SAddOvf(rn.SMinValue(), ov1);
+            (void)ln.SMaxValue().SAddOvf(rn.SMaxValue(), ov2);
+            return ov1 || ov2;
+        case ExprKind::SUB:
+            (void)ln.SMinValue().SSubOvf(rn.SMaxValue(), ov1);
+            (void)ln.SMaxValue().SSubOvf(rn.SMinValue(), ov2);
+            return ov1 || ov2;
+        default: {
+            // the extremes of a product are reached at the corners
+            for (auto& l : {ln.SMinValue(), ln.SMaxValue()}) {
+                for (auto& r : {rn.SMinValue(), rn.SMaxValue()}) {
+                    (void)l.SMulOvf(r, ov1);
+                    if (ov1) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+    }
+}
+
 RangePropagation::RangePropagation(
     CHIRBuilder& builder, RangeAnalysisWrapper* rangeAnalysisWrapper, DiagAdapter* diag, bool enIncre)
     : builder(builder), analysisWrapper(rangeAnalysisWrapper), diag(diag), enIncre(enIncre)
@@ -64,14 +156,20 @@ void RangePropagation::RunOnFunc(const Ptr<const Func>& func, bool isDebug)
         return;
     }
     std::vector<RewriteInfo> toBeRewrited;
+    std::vector<Intrinsic*> toBeUnchecked;
     const auto actionBeforeVisitExpr = [](const RangeDomain&, Expression*, size_t) {};
-    const auto actionAfterVisitExpr = [this, &toBeRewrited, func](
+    const auto actionAfterVisitExpr = [this, &toBeRewrited, &toBeUnchecked, func, isDebug](
                                           const RangeDomain& state, Expression* expr, size_t index) {
         auto exprType = expr->GetResult()->GetType();
         if (expr->IsBinaryExpr()) {
+            // only the constant results are rewritten, a range may still prove the operation never overflows
             if (auto absVal = state.CheckAbstractValue(expr->GetResult()); absVal) {
-                return (void)toBeRewrited.emplace_back(expr, index, GenerateConstExpr(exprType, absVal));
+                if (auto literal = GenerateConstExpr(exprType, absVal); literal) {
+                    return (void)toBeRewrited.emplace_back(expr, index, literal);
+                }
             }
+            auto binary = StaticCast<BinaryExpression*>(expr);
+            MarkNeverOverflow(*expr, binary->GetOverflowStrategy(), state, isDebug);
         } else if (expr->IsUnaryExpr()) {
             if (auto absVal = state.CheckAbstractValue(expr->GetResult()); absVal) {
                 return (void)toBeRewrited.emplace_back(expr, index, GenerateConstExpr(exprType, absVal));
@@ -83,17 +181,27 @@ void RangePropagation::RunOnFunc(const Ptr<const Func>& func, bool isDebug)
                 RecordEffectMap(expr, func);
             }
         } else if (expr->GetExprKind() == ExprKind::INTRINSIC) {
-            if (auto intrinic = StaticCast<Intrinsic*>(expr);
-                intrinic->GetIntrinsicKind() == CHIR::IntrinsicKind::VARRAY_SET ||
-                intrinic->GetIntrinsicKind() == CHIR::IntrinsicKind::VARRAY_GET) {
-                CheckVarrayIndex(intrinic, state);
+            auto intrinic = StaticCast<Intrinsic*>(expr);
+            auto kind = intrinic->GetIntrinsicKind();
+            if (kind == CHIR::IntrinsicKind::VARRAY_SET || kind == CHIR::IntrinsicKind::VARRAY_GET) {
+                if (CheckVarrayIndex(intrinic, state) && intrinic->Get<NeedCheckArrayBound>()) {
+                    intrinic->Set<NeedCheckArrayBound>(false);
+                    PrintBoundsCheckMessage(*intrinic, isDebug);
+                }
+            } else if ((kind == CHIR::IntrinsicKind::ARRAY_GET || kind == CHIR::IntrinsicKind::ARRAY_SET) &&
+                IsArrayIndexInBounds(*intrinic, state)) {
+                toBeUnchecked.emplace_back(intrinic);
             }
         }
     };
     bool doBlockElimination = false;
-    const auto actionOnTerminator = [this, isDebug, &doBlockElimination](const RangeDomain&, Terminator* terminator,
-                                        std::optional<Block*> targetSucc) {
+    const auto actionOnTerminator = [this, isDebug, &doBlockElimination](const RangeDomain& state,
+                                        Terminator* terminator, std::optional<Block*> targetSucc) {
         switch (terminator->GetExprKind()) {
+            case ExprKind::INT_OP_WITH_EXCEPTION:
+                MarkNeverOverflow(
+                    *terminator, StaticCast<IntOpWithException*>(terminator)->GetOverflowStrategy(), state, isDebug);
+                break;
             case ExprKind::BRANCH:
             case ExprKind::MULTIBRANCH:
                 if (targetSucc.has_value()) {
@@ -109,6 +217,9 @@ void RangePropagation::RunOnFunc(const Ptr<const Func>& func, bool isDebug)
     for (auto& rewriteInfo : toBeRewrited) {
         RewriteToConstExpr(rewriteInfo, isDebug);
     }
+    for (auto intrinsic : toBeUnchecked) {
+        RemoveArrayBoundsCheck(*intrinsic, isDebug);
+    }
     if (doBlockElimination) {
         funcsNeedRemoveBlocks.push_back(func.get());
     }
@@ -241,7 +352,7 @@ std::vector<size_t> GetVArraySizeList(const Ptr<Type>& type)
     return size;
 }
 
-void RangePropagation::CheckVarrayIndex(const Ptr<Intrinsic>& intrin, const RangeDomain& state) const
+bool RangePropagation::CheckVarrayIndex(const Ptr<Intrinsic>& intrin, const RangeDomain& state) const
 {
     CJC_ASSERT(intrin->GetIntrinsicKind() == CHIR::IntrinsicKind::VARRAY_GET ||
         intrin->GetIntrinsicKind() == CHIR::IntrinsicKind::VARRAY_SET);
@@ -250,17 +361,19 @@ void RangePropagation::CheckVarrayIndex(const Ptr<Intrinsic>& intrin, const Rang
     size_t begin = intrin->GetIntrinsicKind() == CHIR::IntrinsicKind::VARRAY_GET ? 1U : 2U;
     auto sizes = GetVArraySizeList(args[0]->GetType());
     CJC_ASSERT(sizes.size() >= args.size() - begin);
+    bool inBounds = true;
     for (size_t i = begin; i < args.size(); ++i) {
         auto size = sizes[i - begin];
         auto index = args[i];
         auto indexRange = RangeAnalysis::GetSIntDomainFromState(state, index);
         if (indexRange.IsTop()) {
-            return;
+            return false;
         }
         SIntDomain varraySizeNode{ConstantRange{SInt{IntWidth::I64, static_cast<uint64_t>(size)}}, false};
         SIntDomain zeroNode{ConstantRange{SInt::Zero(IntWidth::I64)}, false};
         auto ltUpperBound{ComputeRelIntBinop({indexRange, varraySizeNode, index, nullptr, ExprKind::LT, false})};
         auto geLowerBound{ComputeRelIntBinop({indexRange, zeroNode, index, nullptr, ExprKind::GE, false})};
+        inBounds = inBounds && ltUpperBound.IsTrue() && geLowerBound.IsTrue();
         if (ltUpperBound.IsFalse() || geLowerBound.IsFalse()) {
             auto bd =
                 diag->DiagnoseRefactor(DiagKindRefactor::chir_idx_out_of_bounds, ToRange(intrin->GetDebugLocation()));
@@ -270,5 +383,49 @@ void RangePropagation::CheckVarrayIndex(const Ptr<Intrinsic>& intrin, const Rang
             bd.AddMainHintArguments(ss.str());
         }
     }
+    return inBounds;
+}
+
+void RangePropagation::MarkNeverOverflow(
+    Expression& expr, OverflowStrategy ov, const RangeDomain& state, bool isDebug) const
+{
+    auto kind = expr.GetExprKind() == ExprKind::INT_OP_WITH_EXCEPTION
+        ? StaticCast<IntOpWithException&>(expr).GetOpKind() : expr.GetExprKind();
+    if (ov != OverflowStrategy::THROWING || expr.GetNumOfOperands() != 2 || expr.Get<NeverOverflowInfo>() ||
+        (kind != ExprKind::ADD && kind != ExprKind::SUB && kind != ExprKind::MUL)) {
+        return;
+    }
+    auto lhs = expr.GetOperand(0);
+    auto rhs = expr.GetOperand(1);
+    auto ty = expr.GetResult()->GetType();
+    if (!ty->IsInteger() || lhs->GetType() != ty || rhs->GetType() != ty) {
+        return;
+    }
+    const auto& lRange = RangeAnalysis::GetSIntDomainFromState(state, lhs);
+    const auto& rRange = RangeAnalysis::GetSIntDomainFromState(state, rhs);
+    if (MayOverflow(kind, lRange, rRange, ty->IsUnsignedInteger())) {
+        return;
+    }
+    expr.Set<NeverOverflowInfo>(true);
+    if (isDebug) {
+        std::string message = "[RangePropagation] The overflow check of " + expr.GetExprKindName() +
+            ToPosInfo(expr.GetDebugLocation()) + " has been eliminated\n";
+        std::cout << message;
+    }
+}
+
+void RangePropagation::RemoveArrayBoundsCheck(Intrinsic& intrinsic, bool isDebug) const
+{
+    auto callContext = IntrisicCallContext {
+        .kind = intrinsic.GetIntrinsicKind() == CHIR::IntrinsicKind::ARRAY_GET
+            ? CHIR::IntrinsicKind::ARRAY_GET_UNCHECKED : CHIR::IntrinsicKind::ARRAY_SET_UNCHECKED,
+        .args = intrinsic.GetOperands(),
+        .instTypeArgs = intrinsic.GetInstantiatedTypeArgs()
+    };
+    auto newExpr = builder.CreateExpression<Intrinsic>(
+        intrinsic.GetResult()->GetType(), callContext, intrinsic.GetParentBlock());
+    newExpr->CopyAnnotationMapFrom(intrinsic);
+    intrinsic.ReplaceWith(*newExpr);
+    PrintBoundsCheckMessage(*newExpr, isDebug);
 }
 } // namespace Cangjie::CHIR
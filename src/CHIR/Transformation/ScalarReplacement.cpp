@@ -0,0 +1,211 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#include "cangjie/CHIR/Transformation/ScalarReplacement.h"
+
+#include "cangjie/CHIR/Analysis/Utils.h"
+#include "cangjie/CHIR/CHIRCasting.h"
+#include "cangjie/CHIR/Type/ClassDef.h"
+
+using namespace Cangjie::CHIR;
+
+namespace Cangjie::CHIR {
+namespace {
+bool HasFinalizer(const ClassType& classTy)
+{
+    for (auto def = classTy.GetClassDef(); def != nullptr; def = def->GetSuperClassDef()) {
+        if (def->GetFinalizer() != nullptr) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Get the field types of the object allocated by @p alloc if it can be replaced by its fields.
+std::optional<std::vector<Type*>> GetReplaceableFieldTys(
+    const Allocate& alloc, const EscapeAnalysis& escapeAnalysis, CHIRBuilder& builder)
+{
+    auto ty = alloc.GetType();
+    if (!ty->IsClass() || ty->IsGenericRelated()) {
+        return std::nullopt;
+    }
+    auto classTy = StaticCast<ClassType*>(ty);
+    // the closure objects are called through their vtable
+    if (classTy->IsAutoEnv() || HasFinalizer(*classTy)) {
+        return std::nullopt;
+    }
+    auto fieldTys = classTy->GetInstantiatedMemberTys(builder);
+    if (std::any_of(fieldTys.begin(), fieldTys.end(), [](auto fieldTy) { return fieldTy->IsGenericRelated(); })) {
+        return std::nullopt;
+    }
+    auto obj = alloc.GetResult();
+    if (escapeAnalysis.GetEscapeState(*obj) != EscapeState::NO_ESCAPE) {
+        return std::nullopt;
+    }
+    // only the fields are accessed, the object itself is never used as a value
+    for (auto user : obj->GetUsers()) {
+        const std::vector<uint64_t>* path = nullptr;
+        if (user->GetExprKind() == ExprKind::GET_ELEMENT_REF) {
+            path = &StaticCast<GetElementRef*>(user)->GetPath();
+        } else if (user->GetExprKind() == ExprKind::STORE_ELEMENT_REF &&
+            StaticCast<StoreElementRef*>(user)->GetLocation() == obj) {
+            path = &StaticCast<StoreElementRef*>(user)->GetPath();
+        } else if (user->GetExprKind() == ExprKind::DEBUGEXPR) {
+            continue;
+        } else {
+            return std::nullopt;
+        }
+        if (path->empty() || path->front() >= fieldTys.size()) {
+            return std::nullopt;
+        }
+        // a longer path goes into a field of value type, which is still addressable after being replaced
+        if (path->size() > 1 && !fieldTys[path->front()]->IsValueType()) {
+            return std::nullopt;
+        }
+    }
+    return fieldTys;
+}
+
+std::vector<uint64_t> GetSubPath(const std::vector<uint64_t>& path)
+{
+    return std::vector<uint64_t>(path.begin() + 1, path.end());
+}
+
+void ReplaceObjectWithFields(Allocate& alloc, const std::vector<Type*>& fieldTys, CHIRBuilder& builder)
+{
+    auto parent = alloc.GetParentBlock();
+    auto& loc = alloc.GetDebugLocation();
+    std::vector<LocalVar*> fields;
+    for (auto fieldTy : fieldTys) {
+        auto field = builder.CreateExpression<Allocate>(loc, builder.GetType<RefType>(fieldTy), fieldTy, parent);
+        field->MoveBefore(&alloc);
+        fields.emplace_back(field->GetResult());
+    }
+    for (auto user : alloc.GetResult()->GetUsers()) {
+        auto userParent = user->GetParentBlock();
+        auto& userLoc = user->GetDebugLocation();
+        if (user->GetExprKind() == ExprKind::GET_ELEMENT_REF) {
+            auto& path = StaticCast<GetElementRef*>(user)->GetPath();
+            auto field = fields[path.front()];
+            if (path.size() == 1) {
+                user->GetResult()->ReplaceWith(*field, alloc.GetParentBlockGroup());
+                user->RemoveSelfFromBlock();
+            } else {
+                auto newGetRef = builder.CreateExpression<GetElementRef>(
+                    userLoc, user->GetResult()->GetType(), field, GetSubPath(path), userParent);
+                user->ReplaceWith(*newGetRef);
+            }
+        } else if (user->GetExprKind() == ExprKind::STORE_ELEMENT_REF) {
+            auto storeRef = StaticCast<StoreElementRef*>(user);
+            auto& path = storeRef->GetPath();
+            auto field = fields[path.front()];
+            Expression* newStore = nullptr;
+            if (path.size() == 1) {
+                newStore = builder.CreateExpression<Store>(
+                    userLoc, builder.GetUnitTy(), storeRef->GetValue(), field, userParent);
+            } else {
+                newStore = builder.CreateExpression<StoreElementRef>(
+                    userLoc, builder.GetUnitTy(), storeRef->GetValue(), field, GetSubPath(path), userParent);
+            }
+            user->ReplaceWith(*newStore);
+        } else {
+            CJC_ASSERT(user->GetExprKind() == ExprKind::DEBUGEXPR);
+            user->RemoveSelfFromBlock();
+        }
+    }
+    alloc.RemoveSelfFromBlock();
+}
+
+/// Replace the results of unboxing @p box with the boxed value if it's only unboxed back to its original type.
+bool ForwardBoxedValue(Box& box)
+{
+    auto value = box.GetSourceValue();
+    auto users = box.GetResult()->GetUsers();
+    for (auto user : users) {
+        if (user->GetParentBlockGroup() != box.GetParentBlockGroup()) {
+            return false;
+        }
+        if (user->GetExprKind() == ExprKind::DEBUGEXPR) {
+            continue;
+        }
+        if (user->GetExprKind() != ExprKind::UNBOX || user->GetResult()->GetType() != value->GetType()) {
+            return false;
+        }
+    }
+    for (auto user : users) {
+        if (user->GetExprKind() == ExprKind::UNBOX) {
+            user->GetResult()->ReplaceWith(*value, box.GetParentBlockGroup());
+        }
+        user->RemoveSelfFromBlock();
+    }
+    box.RemoveSelfFromBlock();
+    return true;
+}
+} // namespace
+} // namespace Cangjie::CHIR
+
+void ScalarReplacement::RunOnPackage(const Package& package, CHIRBuilder& builder, bool isDebug)
+{
+    EscapeAnalysis escapeAnalysis(package);
+    for (auto func : package.GetGlobalFuncs()) {
+        if (auto body = func->GetBody(); body != nullptr) {
+            RunOnBlockGroup(*body, escapeAnalysis, builder, isDebug);
+        }
+    }
+}
+
+void ScalarReplacement::RunOnBlockGroup(
+    BlockGroup& blockGroup, const EscapeAnalysis& escapeAnalysis, CHIRBuilder& builder, bool isDebug)
+{
+    std::vector<Allocate*> allocs;
+    std::vector<Box*> boxes;
+    for (auto block : blockGroup.GetBlocks()) {
+        for (auto expr : block->GetExpressions()) {
+            if (expr->GetExprKind() == ExprKind::LAMBDA) {
+                RunOnBlockGroup(*StaticCast<Lambda*>(expr)->GetBody(), escapeAnalysis, builder, isDebug);
+            } else if (expr->GetExprKind() == ExprKind::ALLOCATE) {
+                allocs.emplace_back(StaticCast<Allocate*>(expr));
+            } else if (expr->GetExprKind() == ExprKind::BOX) {
+                boxes.emplace_back(StaticCast<Box*>(expr));
+            }
+        }
+    }
+    for (auto box : boxes) {
+        if (ForwardBoxedValue(*box) && isDebug && !box->GetDebugLocation().GetBeginPos().IsZero()) {
+            std::string message = "[ScalarReplacement] the box" + ToPosInfo(box->GetDebugLocation()) +
+                " has been replaced by the boxed value\n";
+            std::cout << message;
+        }
+    }
+    for (auto alloc : allocs) {
+        auto fieldTys = GetReplaceableFieldTys(*alloc, escapeAnalysis, builder);
+        if (!fieldTys.has_value()) {
+            continue;
+        }
+        ReplaceObjectWithFields(*alloc, *fieldTys, builder);
+        if (isDebug && !alloc->GetDebugLocation().GetBeginPos().IsZero()) {
+            std::string message = "[ScalarReplacement] the object allocated" + ToPosInfo(alloc->GetDebugLocation()) +
+                " has been replaced by its fields\n";
+            std::cout << message;
+        }
+    }
+}
+
+void ScalarReplacement::MarkNoEscapeParams(const Package& package)
+{
+    EscapeAnalysis escapeAnalysis(package);
+    for (auto func : package.GetGlobalFuncs()) {
+        if (func->GetBody() == nullptr) {
+            continue;
+        }
+        auto& params = func->GetParams();
+        for (size_t i = 0; i < params.size(); ++i) {
+            if (params[i]->GetType()->IsRef() && escapeAnalysis.IsParamNoEscape(*func, i)) {
+                params[i]->EnableAttr(Attribute::NO_ESCAPE);
+            }
+        }
+    }
+}
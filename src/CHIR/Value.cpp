@@ -106,14 +106,19 @@ std::string Value::GetSrcCodeIdentifier() const
 
 const std::string& Value::GetIdentifier() const
 {
-    return identifier;
+    return identifier.Str();
 }
 
 std::string Value::GetIdentifierWithoutPrefix() const
 {
-    if (identifier != "") {
-        return identifier.substr(1);
+    if (!identifier.Empty()) {
+        return identifier.Str().substr(1);
     }
+    return "";
+}
+
+InternedString Value::GetInternedIdentifier() const
+{
     return identifier;
 }
 
@@ -395,11 +400,11 @@ std::string GlobalVar::ToString() const
         AddCommaOrNot(comment);
         comment << "annoInfo: " + annoInfo.mangledName;
     }
-    if (!srcCodeIdentifier.empty()) {
+    if (!srcCodeIdentifier.Empty()) {
         AddCommaOrNot(comment);
-        comment << "srcCodeIdentifier: " + srcCodeIdentifier;
+        comment << "srcCodeIdentifier: " << srcCodeIdentifier;
     }
-    if (!rawMangledName.empty()) {
+    if (!rawMangledName.Empty()) {
         AddCommaOrNot(comment);
         comment << "rawMangledName: " << rawMangledName;
     }
@@ -423,7 +428,7 @@ Func* GlobalVar::GetInitFunc() const
 
 std::string GlobalVarBase::GetSrcCodeIdentifier() const
 {
-    return srcCodeIdentifier;
+    return srcCodeIdentifier.Str();
 }
 
 /**
@@ -436,7 +441,7 @@ CustomTypeDef* GlobalVarBase::GetParentCustomTypeDef() const
 
 const std::string& GlobalVarBase::GetPackageName() const
 {
-    return packageName;
+    return packageName.Str();
 }
 
 void GlobalVar::SetInitializer(LiteralValue& literalValue)
@@ -465,7 +470,7 @@ void GlobalVar::SetInitFunc(Func& func)
 
 const std::string& GlobalVarBase::GetRawMangledName() const
 {
-    return rawMangledName;
+    return rawMangledName.Str();
 }
 
 ImportedValue::ImportedValue()
@@ -997,7 +1002,7 @@ void FuncBase::SetFuncKind(FuncKind kind)
 
 const std::string& FuncBase::GetPackageName() const
 {
-    return packageName;
+    return packageName.Str();
 }
 
 FuncType* FuncBase::GetFuncType() const
@@ -1061,12 +1066,12 @@ CustomTypeDef* FuncBase::GetParentCustomTypeDef() const
 
 std::string FuncBase::GetSrcCodeIdentifier() const
 {
-    return srcCodeIdentifier;
+    return srcCodeIdentifier.Str();
 }
 
 const std::string& FuncBase::GetRawMangledName() const
 {
-    return rawMangledName;
+    return rawMangledName.Str();
 }
 
 void FuncBase::SetRawMangledName(const std::string& name)
@@ -1099,7 +1104,7 @@ bool FuncBase::IsGVInit() const
 bool FuncBase::IsStaticInit() const
 {
     return (funcKind == FuncKind::CLASS_CONSTRUCTOR || funcKind == FuncKind::STRUCT_CONSTRUCTOR) &&
-        srcCodeIdentifier == "static.init";
+        srcCodeIdentifier.Str() == "static.init";
 }
 
 bool FuncBase::IsPrimalConstructor() const
@@ -1407,7 +1412,7 @@ void ImportedFunc::SetParamInfo(std::vector<AbstractMethodParam>&& params)
 
 const std::string& ImportedFunc::GetSourcePackageName() const
 {
-    return packageName;
+    return packageName.Str();
 }
 
 ImportedVar::ImportedVar(Type* ty, std::string identifier, std::string srcCodeIdentifier, std::string rawMangledName,
@@ -1419,7 +1424,7 @@ ImportedVar::ImportedVar(Type* ty, std::string identifier, std::string srcCodeId
 
 const std::string& ImportedVar::GetSourcePackageName() const
 {
-    return packageName;
+    return packageName.Str();
 }
 
 namespace Cangjie::CHIR {
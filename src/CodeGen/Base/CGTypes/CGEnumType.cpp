@@ -67,7 +67,42 @@ std::tuple<bool, std::optional<std::size_t>> ObtainingAuxiliaryInformation(
 
     return std::make_tuple(hasRefTypeAssociatedValue, sizeOfConstructorUnion);
 }
+
+// The enums larger than this are cheaper to be passed around by a single reference than to be copied.
+constexpr std::size_t MAX_SIZE_OF_INLINE_ENUM = 64U;
+
+struct InlinePlacement {
+    // For each associated value: whether it takes a ref slot, and the index of the slot or its offset in the non-ref
+    // area.
+    std::vector<std::pair<bool, std::size_t>> positions;
+    std::size_t numOfRefSlots{0U};
+    std::size_t sizeOfNonRefArea{0U};
+};
+
+// Place the associated values of a constructor in the inline layout, or return `nullopt` if a value can't be placed,
+// i.e. it's neither a ref nor a sized value without refs.
+std::optional<InlinePlacement> PlaceAssociatedValuesInline(
+    CGModule& cgMod, const std::vector<CHIR::Type*>& associatedValueTypes)
+{
+    InlinePlacement placement;
+    for (auto associatedValueType : associatedValueTypes) {
+        auto cgType = CGType::GetOrCreate(cgMod, associatedValueType);
+        auto llvmType = cgType->GetLLVMType();
+        if (llvmType->isPointerTy() && llvmType->getPointerAddressSpace() == 1U) {
+            placement.positions.emplace_back(true, placement.numOfRefSlots++);
+            continue;
+        }
+        if (!cgType->GetSize().has_value() || IsTypeContainsRef(llvmType)) {
+            return std::nullopt;
+        }
+        std::size_t align = std::max(cgType->GetAlign().value_or(1U), 1U);
+        auto offset = (placement.sizeOfNonRefArea + align - 1U) / align * align;
+        placement.positions.emplace_back(false, offset);
+        placement.sizeOfNonRefArea = offset + cgType->GetSize().value();
+    }
+    return placement;
 }
+} // namespace
 
 CGEnumType::CGEnumType(CGModule& cgMod, CGContext& cgCtx, const CHIR::Type& chirType)
     : CGCustomType(cgMod, cgCtx, chirType, CGTypeKind::CG_ENUM),
@@ -123,9 +158,74 @@ CGEnumType::CGEnumTypeKind CGEnumType::CalculateCGEnumTypeKind()
         CJC_ASSERT(sizeOfConstructorUnion.has_value());
         return CGEnumTypeKind::EXHAUSTIVE_ASSOCIATED_NONREF;
     }
+    // Like EXHAUSTIVE_ASSOCIATED_NONREF, the generic enums keep the boxed layout, since their instantiations share the
+    // code accessing them. The runtime can only read the enums of the known kinds by reflection.
+    const auto& options = cgCtx.GetCGPkgContext().GetGlobalOptions();
+    if (options.enableEnumInlineLayout && options.disableReflection && chirEnumType.GetGenericArgs().empty() &&
+        CalculateInlineLayout()) {
+        return CGEnumTypeKind::EXHAUSTIVE_ASSOCIATED_INLINE;
+    }
     return CGEnumTypeKind::EXHAUSTIVE_OTHER;
 }
 
+bool CGEnumType::CalculateInlineLayout()
+{
+    std::size_t refSlots = 0U;
+    std::size_t nonRefAreaSize = 0U;
+    for (auto& ctor : chirEnumType.GetConstructorInfos(cgMod.GetCGContext().GetCHIRBuilder())) {
+        auto placement = PlaceAssociatedValuesInline(cgMod, ctor.funcType->GetParamTypes());
+        if (!placement.has_value()) {
+            return false;
+        }
+        refSlots = std::max(refSlots, placement->numOfRefSlots);
+        nonRefAreaSize = std::max(nonRefAreaSize, placement->sizeOfNonRefArea);
+    }
+    auto refSize = cgMod.GetLLVMModule()->getDataLayout().getPointerSize(1U);
+    // The ref slots are aligned after the tag.
+    if (refSize * (1U + refSlots) + nonRefAreaSize > MAX_SIZE_OF_INLINE_ENUM) {
+        return false;
+    }
+    numOfRefSlots = refSlots;
+    sizeOfNonRefArea = nonRefAreaSize;
+    return true;
+}
+
+std::vector<std::size_t> CGEnumType::GetInlineAssociatedValueOffsets(
+    const std::vector<CHIR::Type*>& associatedValueTypes) const
+{
+    CJC_ASSERT(IsInlineEnum() && layoutType);
+    auto placement = PlaceAssociatedValuesInline(cgMod, associatedValueTypes);
+    CJC_ASSERT(placement.has_value() && placement->numOfRefSlots <= numOfRefSlots &&
+        placement->sizeOfNonRefArea <= sizeOfNonRefArea);
+    // The elements of the layout are the tag, the ref slots and the non-ref area.
+    auto structLayout = cgMod.GetLLVMModule()->getDataLayout().getStructLayout(layoutType);
+    auto offsetOfNonRefArea = structLayout->getSizeInBytes();
+    if (sizeOfNonRefArea != 0U) {
+        offsetOfNonRefArea = structLayout->getElementOffset(static_cast<unsigned>(1U + numOfRefSlots));
+    }
+    std::vector<std::size_t> offsets;
+    for (auto [isInRefSlot, pos] : placement->positions) {
+        offsets.emplace_back(
+            isInRefSlot ? structLayout->getElementOffset(static_cast<unsigned>(1U + pos)) : offsetOfNonRefArea + pos);
+    }
+    return offsets;
+}
+
+std::vector<CHIR::Type*> CGEnumType::GetFieldTypesOfInlineLayout() const
+{
+    auto& chirBuilder = cgCtx.GetCHIRBuilder();
+    std::vector<CHIR::Type*> fieldTypes;
+    fieldTypes.emplace_back(const_cast<CHIR::Type*>(&CGType::GetInt32CGType(cgMod)->GetOriginal()));
+    for (std::size_t idx = 0U; idx < numOfRefSlots; ++idx) {
+        fieldTypes.emplace_back(CGType::GetRefTypeOf(chirBuilder, CGType::GetObjectCGType(cgMod)->GetOriginal()));
+    }
+    if (sizeOfNonRefArea != 0U) {
+        auto u8Type = const_cast<CHIR::Type*>(&CGType::GetUInt8CGType(cgMod)->GetOriginal());
+        fieldTypes.emplace_back(chirBuilder.GetType<CHIR::VArrayType>(u8Type, static_cast<int64_t>(sizeOfNonRefArea)));
+    }
+    return fieldTypes;
+}
+
 std::string CGEnumType::GetEnumTypeName() const
 {
     switch (cgEnumTypeKind) {
@@ -142,7 +242,8 @@ std::string CGEnumType::GetEnumTypeName() const
         case CGEnumTypeKind::EXHAUSTIVE_ASSOCIATED_OPTION_LIKE_NONREF: {
             return ENUM_TYPE_PREFIX + GetTypeQualifiedName(chirEnumType);
         }
-        case CGEnumTypeKind::EXHAUSTIVE_ASSOCIATED_NONREF: {
+        case CGEnumTypeKind::EXHAUSTIVE_ASSOCIATED_NONREF:
+        case CGEnumTypeKind::EXHAUSTIVE_ASSOCIATED_INLINE: {
             return ENUM_TYPE_PREFIX + GetTypeQualifiedName(chirEnumType);
         }
         case CGEnumTypeKind::NON_EXHAUSTIVE_ASSOCIATED:
@@ -172,6 +273,9 @@ llvm::Type* CGEnumType::GenLLVMType()
         case CGEnumTypeKind::EXHAUSTIVE_ASSOCIATED_NONREF: {
             return GenAssociatedNonRefEnumLLVMType();
         }
+        case CGEnumTypeKind::EXHAUSTIVE_ASSOCIATED_INLINE: {
+            return GenInlineEnumLLVMType();
+        }
         case CGEnumTypeKind::NON_EXHAUSTIVE_ASSOCIATED:
         case CGEnumTypeKind::EXHAUSTIVE_OTHER: {
             return GenCommonEnumLLVMType();
@@ -290,6 +394,31 @@ llvm::Type* CGEnumType::GenAssociatedNonRefEnumLLVMType()
     return llvmType;
 }
 
+llvm::Type* CGEnumType::GenInlineEnumLLVMType()
+{
+    auto& llvmCtx = cgCtx.GetLLVMContext();
+    const auto& enumTypeName = GetEnumTypeName();
+    layoutType = llvm::StructType::getTypeByName(llvmCtx, enumTypeName);
+    llvmType = layoutType;
+    if (llvmType && cgCtx.IsGeneratedStructType(enumTypeName)) {
+        return llvmType;
+    } else if (!llvmType) {
+        layoutType = llvm::StructType::create(llvmCtx, enumTypeName);
+        llvmType = layoutType;
+    }
+    cgCtx.AddGeneratedStructType(enumTypeName);
+
+    std::vector<llvm::Type*> elemTypes{llvm::Type::getInt32Ty(llvmCtx)};
+    for (std::size_t idx = 0U; idx < numOfRefSlots; ++idx) {
+        elemTypes.emplace_back(llvm::Type::getInt8PtrTy(llvmCtx, 1U));
+    }
+    if (sizeOfNonRefArea != 0U) {
+        elemTypes.emplace_back(llvm::ArrayType::get(llvm::Type::getInt8Ty(llvmCtx), sizeOfNonRefArea));
+    }
+    SetStructTypeBody(layoutType, elemTypes);
+    return llvmType;
+}
+
 void CGEnumType::GenContainedCGTypes()
 {
     switch (cgEnumTypeKind) {
@@ -301,6 +430,12 @@ void CGEnumType::GenContainedCGTypes()
         case CGEnumTypeKind::EXHAUSTIVE_ASSOCIATED_NONREF: {
             break;
         }
+        case CGEnumTypeKind::EXHAUSTIVE_ASSOCIATED_INLINE: {
+            for (auto fieldType : GetFieldTypesOfInlineLayout()) {
+                containedCGTypes.emplace_back(CGType::GetOrCreate(cgMod, fieldType));
+            }
+            break;
+        }
         case CGEnumTypeKind::EXHAUSTIVE_ASSOCIATED_OPTION_LIKE_T: {
             // Can't be determined at compile time.
             break;
@@ -335,7 +470,8 @@ void CGEnumType::CalculateSizeAndAlign()
         }
         case CGEnumTypeKind::NON_EXHAUSTIVE_ASSOCIATED:
         case CGEnumTypeKind::EXHAUSTIVE_OTHER:
-        case CGEnumTypeKind::EXHAUSTIVE_ASSOCIATED_OPTION_LIKE_REF: {
+        case CGEnumTypeKind::EXHAUSTIVE_ASSOCIATED_OPTION_LIKE_REF:
+        case CGEnumTypeKind::EXHAUSTIVE_ASSOCIATED_INLINE: {
             size = layOut.getTypeAllocSize(llvmType);
             align = layOut.getABITypeAlignment(llvmType);
             return;
@@ -392,6 +528,10 @@ llvm::Constant* CGEnumType::GenFieldsNumOfTypeInfo()
         case CGEnumTypeKind::EXHAUSTIVE_ZERO_SIZE: {
             return llvm::ConstantInt::get(llvm::Type::getInt16Ty(cgMod.GetLLVMContext()), 0U);
         }
+        case CGEnumTypeKind::EXHAUSTIVE_ASSOCIATED_INLINE: {
+            return llvm::ConstantInt::get(
+                llvm::Type::getInt16Ty(cgMod.GetLLVMContext()), GetFieldTypesOfInlineLayout().size());
+        }
         default:    // unexpected CGEnumTypeKind
             CJC_ASSERT(false && "Should not reach here: UNKNOWN enum kind");
             return nullptr;
@@ -425,6 +565,10 @@ llvm::Constant* CGEnumType::GenFieldsOfTypeInfo()
         case CGEnumTypeKind::EXHAUSTIVE_ZERO_SIZE: {
             break;
         }
+        case CGEnumTypeKind::EXHAUSTIVE_ASSOCIATED_INLINE: {
+            fieldTypes = GetFieldTypesOfInlineLayout();
+            break;
+        }
         case CGEnumTypeKind::EXHAUSTIVE_ASSOCIATED_OPTION_LIKE_T:
         default:
             CJC_ASSERT(false && "Should not reach here");
@@ -461,6 +605,7 @@ llvm::Constant* CGEnumType::GenFieldsNumOfTypeTemplate()
             return llvm::ConstantInt::get(llvm::Type::getInt16Ty(cgMod.GetLLVMContext()), 0U);
         }
         case CGEnumTypeKind::EXHAUSTIVE_ASSOCIATED_NONREF:
+        case CGEnumTypeKind::EXHAUSTIVE_ASSOCIATED_INLINE:
         default:
             CJC_ASSERT(false && "Should not reach here: UNKNOWN enum kind");
             return nullptr;
@@ -552,6 +697,7 @@ llvm::Constant* CGEnumType::GenFieldsFnsOfTypeTemplate()
             break;
         }
         case CGEnumTypeKind::EXHAUSTIVE_ASSOCIATED_NONREF:
+        case CGEnumTypeKind::EXHAUSTIVE_ASSOCIATED_INLINE:
         default:
             CJC_ASSERT(false && "Should not reach here: UNKNOWN enum kind");
             break;
@@ -33,6 +33,9 @@ public:
         EXHAUSTIVE_ASSOCIATED_OPTION_LIKE_NONREF, // has and only has two constructors, and only one constructor has
                                                   // only one associated value of non-ref-type.
         EXHAUSTIVE_ASSOCIATED_NONREF, // The associated values of all constructors are non-ref-type.
+        EXHAUSTIVE_ASSOCIATED_INLINE, // non-generic, and each associated value is either a ref or contains no ref,
+                                      // so the enum is laid out inline with a fixed set of ref slots. Only with
+                                      // `--fenum-inline-layout` and `--disable-reflection`.
         EXHAUSTIVE_OTHER,             // other cases.
 
         /* Unable to determine the category of T */
@@ -86,6 +89,10 @@ public:
     {
         return cgEnumTypeKind == CGEnumTypeKind::EXHAUSTIVE_ASSOCIATED_NONREF;
     }
+    bool IsInlineEnum() const
+    {
+        return cgEnumTypeKind == CGEnumTypeKind::EXHAUSTIVE_ASSOCIATED_INLINE;
+    }
     bool IsAntiOptionLike() const
     {
         CJC_ASSERT(optionLikeInfo != nullptr && "cgEnumType is not OptionLike");
@@ -98,7 +105,8 @@ public:
     }
     bool PassByReference() const
     {
-        return IsOptionLikeNonRef() || IsOptionLikeT() || IsZeroSizeEnum() || IsAllAssociatedValuesAreNonRef();
+        return IsOptionLikeNonRef() || IsOptionLikeT() || IsZeroSizeEnum() || IsAllAssociatedValuesAreNonRef() ||
+            IsInlineEnum();
     }
 
     llvm::StructType* GetLayoutType() const
@@ -119,6 +127,15 @@ public:
 
     std::string GetEnumTypeName() const;
 
+    /**
+     * Get the byte offsets of the associated values of a constructor in the inline layout, i.e. `{ i32 tag,
+     * ref slots, [N x i8] non-ref area }`. The ref-type values take the ref slots in order, and the others are
+     * placed in the non-ref area in order, each aligned to its own alignment. The offsets only depend on
+     * @p associatedValueTypes, so constructing an enum and reading its fields always agree.
+     */
+    std::vector<std::size_t> GetInlineAssociatedValueOffsets(
+        const std::vector<CHIR::Type*>& associatedValueTypes) const;
+
 protected:
     llvm::Type* GenLLVMType() override;
     void GenContainedCGTypes() override;
@@ -129,6 +146,8 @@ private:
     explicit CGEnumType(CGModule& cgMod, CGContext& cgCtx, const CHIR::Type& chirType);
 
     CGEnumTypeKind CalculateCGEnumTypeKind();
+    bool CalculateInlineLayout();
+    std::vector<CHIR::Type*> GetFieldTypesOfInlineLayout() const;
 
     void CalculateSizeAndAlign() override;
 
@@ -144,12 +163,15 @@ private:
     llvm::Type* GenOptionLikeRefLLVMType();
     llvm::Type* GenOptionLikeNonRefLLVMType();
     llvm::Type* GenAssociatedNonRefEnumLLVMType();
+    llvm::Type* GenInlineEnumLLVMType();
     llvm::Type* GenCommonEnumLLVMType();
 
 private:
     const CHIR::EnumType& chirEnumType;
     std::unique_ptr<OptionLikeInfo> optionLikeInfo;
     std::optional<std::size_t> sizeOfConstructorUnion;
+    std::size_t numOfRefSlots{0U};    // only for EXHAUSTIVE_ASSOCIATED_INLINE
+    std::size_t sizeOfNonRefArea{0U}; // only for EXHAUSTIVE_ASSOCIATED_INLINE
     CGEnumTypeKind cgEnumTypeKind;
 };
 } // namespace CodeGen
@@ -246,6 +246,7 @@ llvm::GlobalVariable* CGType::GetOrCreateTypeInfo()
     if (cgGenericKind == CGGenericKind::STATIC_GI) {
         if (!cgMod.GetLLVMModule()->getNamedGlobal(tiName)) {
             cgCtx.RegisterStaticGIName(tiName);
+            cgCtx.RecordStaticGIUser(tiName);
         }
         typeInfo = llvm::cast<llvm::GlobalVariable>(cgMod.GetLLVMModule()->getOrInsertGlobal(tiName, typeInfoType));
     } else if (cgGenericKind == CGGenericKind::CONCRETE) {
@@ -669,7 +670,10 @@ void CGType::GenTypeInfo()
 
     typeInfo->setInitializer(llvm::ConstantStruct::get(CGType::GetOrCreateTypeInfoType(llvmCtx), typeInfoVec));
     if (IsStaticGI()) {
-        typeInfo->setLinkage(llvm::GlobalValue::InternalLinkage);
+        // Other sub-packages may refer to this typeinfo, it is localized after all sub-packages are linked. The
+        // definition is dropped later if another sub-package owns it.
+        AddLinkageTypeMetadata(
+            *typeInfo, llvm::GlobalValue::InternalLinkage, cgCtx.GetCGPkgContext().IsTypeMetadataDedupEnabled());
     } else { // For Concrete type:
         // Note: The chirType that enters this branch is expected to be of CustomType.
         auto customType = dynamic_cast<const CHIR::CustomType*>(&chirType);
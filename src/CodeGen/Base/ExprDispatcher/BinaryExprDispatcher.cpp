@@ -58,6 +58,24 @@ llvm::Value* HandleNonOverflowBinaryExpression(IRBuilder2& irBuilder, const CHIR
     }
 }
 
+namespace {
+/// Generate an integer `+`, `-` or `*` that is proven never to overflow, LLVM is told so by the no-wrap flags.
+llvm::Value* GenerateNoWrapArithmetic(IRBuilder2& irBuilder, const CHIRBinaryExprWrapper& chirExpr, bool isSigned)
+{
+    auto& cgMod = irBuilder.GetCGModule();
+    auto valLeft = **(cgMod | chirExpr.GetLHSOperand());
+    auto valRight = **(cgMod | chirExpr.GetRHSOperand());
+    switch (chirExpr.GetBinaryExprKind()) {
+        case CHIR::ExprKind::ADD:
+            return irBuilder.CreateAdd(valLeft, valRight, "", !isSigned, isSigned);
+        case CHIR::ExprKind::SUB:
+            return irBuilder.CreateSub(valLeft, valRight, "", !isSigned, isSigned);
+        default:
+            return irBuilder.CreateMul(valLeft, valRight, "", !isSigned, isSigned);
+    }
+}
+} // namespace
+
 llvm::Value* HandleBinaryExpression(IRBuilder2& irBuilder, const CHIRBinaryExprWrapper& chirExpr)
 {
     const CHIR::Type* ty = chirExpr.GetResult()->GetType();
@@ -78,6 +96,11 @@ llvm::Value* HandleBinaryExpression(IRBuilder2& irBuilder, const CHIRBinaryExprW
         return HandleNonOverflowBinaryExpression(irBuilder, chirExpr);
     }
     const CHIR::IntType* intTy = StaticCast<const CHIR::IntType*>(ty);
+    // the overflow check is omitted if the range or const analysis proves that it never fails
+    if (chirExpr.Get<CHIR::NeverOverflowInfo>() &&
+        (kind == CHIR::ExprKind::ADD || kind == CHIR::ExprKind::SUB || kind == CHIR::ExprKind::MUL)) {
+        return GenerateNoWrapArithmetic(irBuilder, chirExpr, intTy->IsSigned());
+    }
     auto& cgMod = irBuilder.GetCGModule();
     CGValue* valLeft = cgMod | chirExpr.GetLHSOperand();
     CGValue* valRight = cgMod | chirExpr.GetRHSOperand();
@@ -123,6 +123,8 @@ llvm::Value* HandleGetElementRef(IRBuilder2& irBuilder, const CHIR::GetElementRe
             retValue = GetElementRefOfOptionLikeT(irBuilder, *enumType, cgEnumType->IsAntiOptionLike(), value);
         } else if (cgEnumType->IsAllAssociatedValuesAreNonRef()) {
             retValue = irBuilder.CreateBitCast(value, llvm::Type::getInt32PtrTy(cgMod.GetLLVMContext()));
+        } else if (cgEnumType->IsInlineEnum()) {
+            retValue = irBuilder.CreateStructGEP(layoutType, value, 0);
         } else if (cgEnumType->IsZeroSizeEnum()) {
             retValue = irBuilder.CreateEntryAlloca(irBuilder.getInt32Ty());
             irBuilder.CreateStore(llvm::ConstantInt::get(irBuilder.getInt32Ty(), 0U), retValue);
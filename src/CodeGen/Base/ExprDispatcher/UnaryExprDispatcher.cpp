@@ -55,7 +55,7 @@ llvm::Value* HandleUnaryExpression(IRBuilder2& irBuilder, const CHIRUnaryExprWra
 
     const CHIR::Type* ty = chirExpr.GetResult()->GetType();
     // There is a possibility of integer overflow when the result of an arithmetic expression is an integer type.(spec)
-    if (overflowStrategy == OverflowStrategy::WRAPPING || !ty->IsInteger()) {
+    if (overflowStrategy == OverflowStrategy::WRAPPING || !ty->IsInteger() || chirExpr.Get<CHIR::NeverOverflowInfo>()) {
         return HandleNonOverflowUnaryExpression(irBuilder, chirExpr);
     }
     const CHIR::IntType* intTy = StaticCast<const CHIR::IntType*>(ty);
@@ -151,7 +151,9 @@ llvm::Value* GenerateVarrayIntrinsics(IRBuilder2& irBuilder, const CHIRIntrinsic
             for (size_t i = 1; i < parameters.size(); i++) {
                 idxList.emplace_back(parameters[i]->GetRawValue());
             }
-            irBuilder.CallVArrayIntrinsicIndexCheck(varrPtr, idxList);
+            if (needIdxCheck) {
+                irBuilder.CallVArrayIntrinsicIndexCheck(varrPtr, idxList);
+            }
             auto elePtr = irBuilder.CreateVArrayGEP(varrPtr, idxList, "varr.idx.get.gep");
             // If element type is varray/struct in a varray, it should return element pointer.
             // only when it be used we need to load it.
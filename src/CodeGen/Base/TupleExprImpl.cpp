@@ -205,6 +205,35 @@ llvm::Value* GenerateAssociatedNonRefEnum(IRBuilder2& irBuilder, const CHIR::Tup
     return enumVal;
 }
 
+llvm::Value* GenerateInlineEnum(IRBuilder2& irBuilder, const CHIR::Tuple& tuple)
+{
+    auto& cgMod = irBuilder.GetCGModule();
+    auto i8Ty = irBuilder.getInt8Ty();
+    irBuilder.EmitLocation(CHIRExprWrapper(tuple));
+    // 1. allocate memory for the Enum's constructor, the ref slots not used by the constructor must be null.
+    auto chirEnumType = StaticCast<CHIR::EnumType*>(tuple.GetResult()->GetType());
+    auto cgEnumType = StaticCast<CGEnumType*>(CGType::GetOrCreate(cgMod, chirEnumType));
+    auto enumVal = irBuilder.CreateEntryAlloca(*cgEnumType, "enum.val");
+    (void)irBuilder.CreateCJMemSetStructWith0(llvm::cast<llvm::AllocaInst>(enumVal));
+    // 2. store the tag and associated values at their offsets in the inline layout.
+    std::vector<CHIR::Type*> associatedValueTypes;
+    for (unsigned idx = 1U; idx < tuple.GetNumOfOperands(); ++idx) {
+        associatedValueTypes.emplace_back(tuple.GetOperand(idx)->GetType());
+    }
+    auto offsets = cgEnumType->GetInlineAssociatedValueOffsets(associatedValueTypes);
+    auto casted = irBuilder.CreateBitCast(enumVal, i8Ty->getPointerTo());
+    for (unsigned idx = 0U; idx < tuple.GetNumOfOperands(); ++idx) {
+        auto field = tuple.GetOperand(idx);
+        auto fieldCGType = CGType::GetOrCreate(cgMod, field->GetType());
+        // the tag is always at the beginning
+        auto offset = idx == 0U ? 0U : offsets[idx - 1U];
+        auto destPtr = irBuilder.CreateConstGEP1_32(i8Ty, casted, static_cast<unsigned>(offset));
+        auto castedDestPtr = irBuilder.CreateBitCast(destPtr, fieldCGType->GetLLVMType()->getPointerTo());
+        (void)irBuilder.CreateStore(**(cgMod | field), castedDestPtr, field->GetType());
+    }
+    return enumVal;
+}
+
 llvm::Value* GenerateCommonEnum(IRBuilder2& irBuilder, const CHIR::Tuple& tuple)
 {
     auto& cgMod = irBuilder.GetCGModule();
@@ -289,6 +318,8 @@ llvm::Value* CodeGen::GenerateEnum(IRBuilder2& irBuilder, const CHIR::Tuple& tup
         return irBuilder.CreateEntryAlloca(*cgEnumType);
     } else if (cgEnumType->IsAllAssociatedValuesAreNonRef()) {
         return GenerateAssociatedNonRefEnum(irBuilder, tuple);
+    } else if (cgEnumType->IsInlineEnum()) {
+        return GenerateInlineEnum(irBuilder, tuple);
     }
     CJC_ASSERT(false && "Should not reach here: UNKNOWN enum kind");
     return nullptr;
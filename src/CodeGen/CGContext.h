@@ -190,6 +190,30 @@ public:
     {
         cgPkgContext.AddLocalizedSymbol(symName);
     }
+
+    /**
+     * @brief Record that this sub-package uses the static generic typeinfo `tiName`.
+     */
+    void RecordStaticGIUser(const std::string& tiName)
+    {
+        if (cgPkgContext.IsTypeMetadataDedupEnabled()) {
+            cgPkgContext.RecordTypeMetadataUser(tiName, subCHIRPackage.subCHIRPackageIdx);
+        }
+    }
+
+    /**
+     * @brief Whether the definition of the static generic typeinfo `tiName` is kept in this sub-package.
+     * Otherwise it is kept by another sub-package and only declared here.
+     * Only valid once all sub-packages have generated their typeinfos.
+     */
+    bool IsOwnerOfStaticGI(const std::string& tiName)
+    {
+        if (!cgPkgContext.IsTypeMetadataDedupEnabled()) {
+            return true;
+        }
+        auto owner = cgPkgContext.GetTypeMetadataOwner(tiName);
+        return !owner.has_value() || owner.value() == subCHIRPackage.subCHIRPackageIdx;
+    }
 #endif
 
     void AddCJString(const std::string& cjStringName, const std::string& cjStringContent)
@@ -352,6 +352,15 @@ CGFunction* CGModule::GetOrInsertCGFunction(const CHIR::Value* func, bool forWra
                 cgFunc->GetArgByIndexFromCHIR(idx)->addAttr(llvm::Attribute::NoCapture);
             }
         }
+        // parameters proven not to escape by CHIR, so the backend can allocate the arguments on the stack
+        if (func->IsFuncWithBody()) {
+            auto& params = VirtualCast<const CHIR::Func*>(func)->GetParams();
+            for (size_t idx = 0; idx < params.size(); ++idx) {
+                if (params[idx]->TestAttr(CHIR::Attribute::NO_ESCAPE)) {
+                    cgFunc->GetArgByIndexFromCHIR(idx)->addAttr(llvm::Attribute::NoCapture);
+                }
+            }
+        }
     }
     if (func->IsFuncWithBody()) {
         if (!VirtualCast<const CHIR::Func*>(func)->IsCFFIWrapper()) {
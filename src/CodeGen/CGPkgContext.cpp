@@ -86,6 +86,44 @@ const std::set<std::string>& CGPkgContext::GetLocalizedSymbols()
     return localizedSymbols.Do(
         [](const std::set<std::string>& object) -> const std::set<std::string>& { return object; });
 }
+
+void CGPkgContext::RecordTypeMetadataUser(const std::string& symName, std::size_t subCHIRPkgIdx)
+{
+    typeMetadataOwners.Do([&symName, subCHIRPkgIdx](std::unordered_map<std::string, std::size_t>& object) {
+        auto [it, inserted] = object.emplace(symName, subCHIRPkgIdx);
+        if (!inserted) {
+            it->second = std::min(it->second, subCHIRPkgIdx);
+        }
+    });
+}
+
+std::optional<std::size_t> CGPkgContext::GetTypeMetadataOwner(const std::string& symName)
+{
+    return typeMetadataOwners.Do(
+        [&symName](std::unordered_map<std::string, std::size_t>& object) -> std::optional<std::size_t> {
+            if (auto it = object.find(symName); it != object.end()) {
+                return it->second;
+            }
+            return std::nullopt;
+        });
+}
+
+void CGPkgContext::RecordDedupTypeMetadata(uint64_t savedBytes)
+{
+    ++dedupTypeMetadataNum;
+    dedupTypeMetadataBytes += savedBytes;
+}
+
+void CGPkgContext::ReportDedupTypeMetadata()
+{
+    if (!options.enableTimer && !options.enableMemoryCollect) {
+        return;
+    }
+    Utils::ProfileRecorder::RecordCodeInfo(
+        "deduplicated type metadata across sub-packages", static_cast<int64_t>(dedupTypeMetadataNum.load()));
+    Utils::ProfileRecorder::RecordCodeInfo(
+        "deduplicated type metadata bytes across sub-packages", static_cast<int64_t>(dedupTypeMetadataBytes.load()));
+}
 #endif
 
 CHIR::Value* CGPkgContext::FindCHIRGlobalValue(const std::string& mangledName)
@@ -7,7 +7,9 @@
 #ifndef CANGJIE_CODEGEN_PACKAGE_CONTEXT_H
 #define CANGJIE_CODEGEN_PACKAGE_CONTEXT_H
 
+#include <atomic>
 #include <mutex>
+#include <optional>
 
 #include "llvm/IR/Module.h"
 
@@ -83,6 +85,32 @@ public:
 #ifdef CANGJIE_CODEGEN_CJNATIVE_BACKEND
     void AddLocalizedSymbol(const std::string& symName);
     const std::set<std::string>& GetLocalizedSymbols();
+
+    /**
+     * @brief Whether type metadata shared by several sub-packages is emitted only once, by its owning sub-package.
+     * Incremental compilation caches every sub-package separately, so the ownership must not move between builds.
+     * Only the static generic typeinfos need it: the typeinfos, reflection metadata and extension tables of custom
+     * types are emitted by the sub-package of their def only, and `generatedStructType` and `enumInfoCache` of
+     * CGContext are caches of LLVM types and constants, which emit no symbols. The non-owners still generate the
+     * typeinfos they use before dropping them, since the owner is only known once all sub-packages are generated.
+     */
+    bool IsTypeMetadataDedupEnabled() const
+    {
+        return IsCGParallelEnabled() && !enableIncrement;
+    }
+    /**
+     * @brief Record that the sub-package `subCHIRPkgIdx` uses `symName`.
+     * The owner of a symbol is the lowest-indexed sub-package using it, so it doesn't depend on the order in which
+     * the sub-packages are generated, and the objects are reproducible.
+     */
+    void RecordTypeMetadataUser(const std::string& symName, std::size_t subCHIRPkgIdx);
+    /**
+     * @brief Return the index of the sub-package that owns the definition of `symName`, if any sub-package uses it.
+     * Only final once all sub-packages have recorded their uses.
+     */
+    std::optional<std::size_t> GetTypeMetadataOwner(const std::string& symName);
+    void RecordDedupTypeMetadata(uint64_t savedBytes);
+    void ReportDedupTypeMetadata();
 #endif
 
     CHIR::Value* FindCHIRGlobalValue(const std::string& mangledName);
@@ -101,6 +129,10 @@ private:
 #ifdef CANGJIE_CODEGEN_CJNATIVE_BACKEND
     // The symbols, which need to be changed linkageType after the link.
     ObjectLocker<std::set<std::string>> localizedSymbols;
+    // Key: the symbol name of the type metadata, Value: the index of the owning sub-package.
+    ObjectLocker<std::unordered_map<std::string, std::size_t>> typeMetadataOwners;
+    std::atomic<uint64_t> dedupTypeMetadataNum{0};
+    std::atomic<uint64_t> dedupTypeMetadataBytes{0};
 #endif
 };
 } // namespace CodeGen
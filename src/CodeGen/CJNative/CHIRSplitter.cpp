@@ -47,7 +47,16 @@ bool ChirTypeDefCmp::operator()(const CHIR::CustomTypeDef* lhs, const CHIR::Cust
 
 bool ChirValueCmp::operator()(const CHIR::Value* lhs, const CHIR::Value* rhs) const
 {
-    return lhs->GetIdentifierWithoutPrefix() < rhs->GetIdentifierWithoutPrefix();
+    // Equal identifiers are detected by their interned ids, and no string is copied to strip the prefix.
+    auto lhsId = lhs->GetInternedIdentifier();
+    auto rhsId = rhs->GetInternedIdentifier();
+    if (lhsId == rhsId) {
+        return false;
+    }
+    auto withoutPrefix = [](const std::string& identifier) {
+        return identifier.empty() ? std::string_view{} : std::string_view{identifier}.substr(1);
+    };
+    return withoutPrefix(lhsId.Str()) < withoutPrefix(rhsId.Str());
 }
 
 SubCHIRPackage::SubCHIRPackage(std::size_t splitNum)
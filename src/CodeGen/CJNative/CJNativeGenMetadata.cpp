@@ -594,6 +594,11 @@ void EnumMetadataInfo::GenerateAllEnumsMetadata()
             !typeDef->IsEnum()) {
             continue;
         }
+        // The runtime doesn't know the inline layout, so these enums are not described to it.
+        auto cgType = StaticCast<const CGEnumType*>(CGType::GetOrCreate(module, typeDef->GetType()));
+        if (cgType->IsInlineEnum()) {
+            continue;
+        }
         GenerateEnumMetadata(StaticCast<const CHIR::EnumDef&>(*typeDef));
     }
 }
@@ -1471,6 +1471,11 @@ llvm::Value* IRBuilder2::GetEnumTag(const CHIR::Field& field)
             auto tagType = CGType::GetOrCreate(cgMod, field.GetResult()->GetType())->GetLLVMType();
             return CreateLoad(tagType, CreateBitCast(enumVal, tagType->getPointerTo()));
         }
+        case CGEnumType::CGEnumTypeKind::EXHAUSTIVE_ASSOCIATED_INLINE: {
+            auto tagType = CGType::GetOrCreate(cgMod, field.GetResult()->GetType())->GetLLVMType();
+            return CreateLoad(
+                tagType, CreateBitCast(enumVal, tagType->getPointerTo(enumVal->getType()->getPointerAddressSpace())));
+        }
         case CGEnumType::CGEnumTypeKind::EXHAUSTIVE_ASSOCIATED_OPTION_LIKE_T: {
             auto i1Ty = getInt1Ty();
             auto payload = GetPayloadFromObject(enumVal);
@@ -1624,6 +1629,31 @@ llvm::Value* GetAssociatedNonRefEnumAssociatedValue(
     auto retLLVMType = CGType::GetOrCreate(cgMod, field.GetResult()->GetType())->GetLLVMType();
     return irBuilder.CreateLoad(retLLVMType, irBuilder.CreateBitCast(fieldPtr, retLLVMType->getPointerTo()));
 }
+
+llvm::Value* GetInlineEnumAssociatedValue(
+    IRBuilder2& irBuilder, const CHIR::Field& field, const CGValue& cgEnum, const CGEnumType& cgEnumType)
+{
+    auto& cgMod = irBuilder.GetCGModule();
+    auto i8Ty = irBuilder.getInt8Ty();
+
+    auto associatedValIdx = static_cast<unsigned int>(field.GetPath()[0]);
+    // 1. get the offset of the associated value, the first type argument is the type of the tag.
+    auto args = field.GetBase()->GetType()->GetTypeArgs();
+    CJC_ASSERT(associatedValIdx > 0U && associatedValIdx < args.size());
+    auto offsets = cgEnumType.GetInlineAssociatedValueOffsets(std::vector<CHIR::Type*>(args.begin() + 1, args.end()));
+    // 2. get the associated value, the enum may be stored in an object.
+    auto enumVal = cgEnum.GetRawValue();
+    auto addrSpace = enumVal->getType()->getPointerAddressSpace();
+    auto casted = irBuilder.CreateBitCast(enumVal, i8Ty->getPointerTo(addrSpace));
+    auto fieldPtr = irBuilder.CreateConstGEP1_32(
+        i8Ty, casted, static_cast<unsigned>(offsets[associatedValIdx - 1U]), "enum.field.ptr");
+    auto retLLVMType = CGType::GetOrCreate(cgMod, field.GetResult()->GetType())->GetLLVMType();
+    fieldPtr = irBuilder.CreateBitCast(fieldPtr, retLLVMType->getPointerTo(addrSpace));
+    if (addrSpace == 1U) {
+        irBuilder.GetCGContext().SetBasePtr(fieldPtr, enumVal);
+    }
+    return irBuilder.CreateLoad(retLLVMType, fieldPtr);
+}
 } // namespace
 
 llvm::Value* IRBuilder2::GetEnumAssociatedValue(const CHIR::Field& field)
@@ -1649,6 +1679,9 @@ llvm::Value* IRBuilder2::GetEnumAssociatedValue(const CHIR::Field& field)
         case CGEnumType::CGEnumTypeKind::EXHAUSTIVE_ASSOCIATED_NONREF: {
             return GetAssociatedNonRefEnumAssociatedValue(*this, field, *cgEnum);
         }
+        case CGEnumType::CGEnumTypeKind::EXHAUSTIVE_ASSOCIATED_INLINE: {
+            return GetInlineEnumAssociatedValue(*this, field, *cgEnum, *cgEnumType);
+        }
         case CGEnumType::CGEnumTypeKind::EXHAUSTIVE_ASSOCIATED_OPTION_LIKE_T: {
             CJC_ASSERT(index == 1);
             auto [refBB, nonRefBB, endBB] = Vec2Tuple<3>(CreateAndInsertBasicBlocks({"ref", "nonRef", "end"}));
@@ -1184,7 +1184,7 @@ llvm::DIType* DIBuilder::CreateEnumType(const CHIR::EnumType& enumTy, const CHIR
         fwdDecl = CreateTrivial(enumTy, enumMembers);
     } else if (isOption || cgType->IsOptionLike()) {
         fwdDecl = CreateEnumOptionType(enumTy, enumMembers, boxTy);
-    } else if (cgType->IsAllAssociatedValuesAreNonRef()) {
+    } else if (cgType->IsAllAssociatedValuesAreNonRef() || cgType->IsInlineEnum()) {
         fwdDecl = CreateEnumWithNonRefArgsType(enumTy, enumMembers);
     } else {
         fwdDecl = CreateEnumWithArgsType(enumTy, enumMembers, boxTy);
@@ -1261,6 +1261,7 @@ llvm::DICompositeType* DIBuilder::CreateEnumWithNonRefArgsType(
      *  The Enum is stored as
      *  32-bits // constructor
      *  X-bits // X is max size of union
+     *  The associated values of an inline enum are placed at the offsets given by its layout instead.
      */
     auto enumDef = enumTy.GetEnumDef();
     auto defPackage = createNameSpace(diCompileUnit, enumDef->GetPackageName(), false);
@@ -1268,9 +1269,10 @@ llvm::DICompositeType* DIBuilder::CreateEnumWithNonRefArgsType(
     auto diFile = GetOrCreateFile(position);
     auto typeName = RemoveCustomTypePrefix(GenerateTypeName(enumTy));
     auto cgType = StaticCast<const CGEnumType*>(CGType::GetOrCreate(cgMod, &enumTy));
-    auto fwdDecl = createStructType(defPackage, "E3$" + typeName, diFile, position.GetBeginPos().line,
-        cgType->GetsizeOfConstructorUnion() + 32, 0u, llvm::DINode::FlagZero, nullptr, {}, 0u, nullptr,
-        "$" + enumTy.ToString());
+    auto enumSize =
+        cgType->IsInlineEnum() ? cgType->GetSize().value() * 8u : cgType->GetsizeOfConstructorUnion() + 32;
+    auto fwdDecl = createStructType(defPackage, "E3$" + typeName, diFile, position.GetBeginPos().line, enumSize, 0u,
+        llvm::DINode::FlagZero, nullptr, {}, 0u, nullptr, "$" + enumTy.ToString());
     typeCache[&enumTy] = llvm::TrackingMDRef(fwdDecl);
     auto constructorType = GetOrCreateEnumCtorType(enumTy);
     uint32_t fieldIdx = 0;
@@ -1312,13 +1314,17 @@ llvm::DICompositeType* DIBuilder::CreateEnumWithNonRefArgsType(
         enumLayer.push_back(enumId);
         size_t offsetIndex = 1;
         size_t offset = 0;
+        std::vector<std::size_t> inlineOffsets;
+        if (cgType->IsInlineEnum()) {
+            inlineOffsets = cgType->GetInlineAssociatedValueOffsets(ctor.funcType->GetParamTypes());
+        }
         for (uint32_t argIndex = 0; argIndex < ctor.funcType->GetParamTypes().size(); ++argIndex) {
             auto arg = ctor.funcType->GetParamTypes()[argIndex];
             auto argTy = GetOrCreateType(*arg);
             if (IsReferenceType(*arg, cgMod) || arg->IsRawArray()) {
                 argTy = CreatePointerType(argTy, CreateRefType()->getSizeInBits());
             }
-            offset += sizeOfCtors[argIndex];
+            offset = inlineOffsets.empty() ? offset + sizeOfCtors[argIndex] : inlineOffsets[argIndex] * 8u;
             auto align = 0u;
             auto argType = createMemberType(subEnumType, "arg_" + std::to_string(offsetIndex), diFile, 0u,
                 GetSizeInBits(argTy), static_cast<uint32_t>(align), offset, llvm::DINode::FlagZero, argTy);
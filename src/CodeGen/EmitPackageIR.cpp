@@ -123,6 +123,10 @@ void GenerateStaticGIs(CGModule& cgMod)
 {
     std::vector<llvm::Constant*> content;
     for (auto staticGI : cgMod.GetAliveStaticGIs()) {
+        // Skip the typeinfo owned by another sub-package.
+        if (staticGI->isDeclaration()) {
+            continue;
+        }
         if (staticGI->getNumUses() > 0 || !staticGI->isLocalLinkage(staticGI->getLinkage())) {
             CJC_ASSERT(staticGI->hasInitializer());
             (void)content.emplace_back(staticGI);
@@ -130,8 +134,9 @@ void GenerateStaticGIs(CGModule& cgMod)
     }
 
     for (auto& staticGIName : cgMod.GetCGContext().GetReflectGeneratedStaticGINames()) {
-        if (auto staticGI = cgMod.GetLLVMModule()->getNamedGlobal(staticGIName)) {
-            CJC_ASSERT(staticGI->hasInitializer());
+        auto staticGI = cgMod.GetLLVMModule()->getNamedGlobal(staticGIName);
+        // Skip the typeinfo owned by another sub-package.
+        if (staticGI && !staticGI->isDeclaration()) {
             if (find(content.begin(), content.end(), staticGI) == content.end()) {
                 (void)content.emplace_back(staticGI);
             }
@@ -356,6 +361,37 @@ void GenSubCHIRPackage(CGModule& cgMod)
     InlineFunction(cgMod);
     CJNativeReflectionInfo(cgMod, subCHIRPkg).Gen();
     cgMod.GenTypeInfo(); // for reflect generated typeinfo
+}
+
+/*
+ * @brief Keep only the declaration of the static generic typeinfos owned by another sub-package.
+ * All sub-packages must have generated their typeinfos, so that the owners are final.
+ */
+void DropStaticGIsOfOtherSubPackages(CGModule& cgMod)
+{
+    auto& cgCtx = cgMod.GetCGContext();
+    if (!cgCtx.GetCGPkgContext().IsTypeMetadataDedupEnabled()) {
+        return;
+    }
+    auto& dataLayout = cgMod.GetLLVMModule()->getDataLayout();
+    for (auto& tiName : cgCtx.GetStaticGINames()) {
+        auto typeInfo = cgMod.GetLLVMModule()->getNamedGlobal(tiName);
+        if (!typeInfo || typeInfo->isDeclaration() || cgCtx.IsOwnerOfStaticGI(tiName)) {
+            continue;
+        }
+        cgCtx.GetCGPkgContext().RecordDedupTypeMetadata(
+            dataLayout.getTypeAllocSize(typeInfo->getValueType()).getFixedSize());
+        typeInfo->setInitializer(nullptr);
+        typeInfo->setMetadata("LinkageType", nullptr);
+        typeInfo->setLinkage(llvm::GlobalValue::ExternalLinkage);
+    }
+}
+
+void FinishSubCHIRPackage(CGModule& cgMod)
+{
+    auto& cgPkgCtx = cgMod.GetCGContext().GetCGPkgContext();
+    auto& globalOptions = cgPkgCtx.GetGlobalOptions();
+    DropStaticGIsOfOtherSubPackages(cgMod);
     cgMod.diBuilder->Finalize();
     TransformFFIs(cgMod);
     InitializeCjStringLiteral(cgMod);
@@ -447,20 +483,28 @@ private:
     void GenSubCHIRPackages()
     {
         Utils::ProfileRecorder::Start("EmitIR", "GenSubCHIRPackages");
+        // The owners of the shared typeinfos are known once every sub-package has generated its typeinfos, so the
+        // sub-packages are finished in a second round.
+        RunOnSubCHIRPackages(GenSubCHIRPackage);
+        RunOnSubCHIRPackages(FinishSubCHIRPackage);
+        Utils::ProfileRecorder::Stop("EmitIR", "GenSubCHIRPackages");
+    }
+
+    void RunOnSubCHIRPackages(void (*action)(CGModule&))
+    {
         auto& cgMods = cgPkgCtx.GetCGModules();
         size_t threadNum = cgPkgCtx.GetGlobalOptions().codegenDebugMode ? 1 : cgMods.size();
         if (threadNum == 1) {
             for (auto& cgMod : cgMods) {
-                GenSubCHIRPackage(*cgMod);
+                action(*cgMod);
             }
         } else {
             Utils::TaskQueue taskQueueCHIRIR2LLVMIR(threadNum);
             for (auto& cgMod : cgMods) {
-                taskQueueCHIRIR2LLVMIR.AddTask<void>([&cgMod]() { GenSubCHIRPackage(*cgMod); });
+                taskQueueCHIRIR2LLVMIR.AddTask<void>([&cgMod, action]() { action(*cgMod); });
             }
             taskQueueCHIRIR2LLVMIR.RunAndWaitForAllTasksCompleted();
         }
-        Utils::ProfileRecorder::Stop("EmitIR", "GenSubCHIRPackages");
     }
 #endif
 
@@ -552,6 +596,7 @@ void PackageGeneratorImpl::EmitIR()
 
     // Translate CHIR to LLVM IR
     GenSubCHIRPackages();
+    cgPkgCtx.ReportDedupTypeMetadata();
 
     auto localizedSymbols = cgPkgCtx.GetLocalizedSymbols();
     const_cast<GlobalOptions&>(cgPkgCtx.GetGlobalOptions()).symbolsNeedLocalized =
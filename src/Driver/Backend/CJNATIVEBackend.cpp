@@ -13,6 +13,8 @@
 #include "cangjie/Driver/Backend/CJNATIVEBackend.h"
 
 #include "Job.h"
+#include "cangjie/Basic/Version.h"
+#include "cangjie/Driver/ObjectCache.h"
 #include "cangjie/Driver/TempFileManager.h"
 #include "cangjie/Driver/ToolOptions.h"
 #include "Toolchains/CJNATIVE/Linux_CJNATIVE.h"
@@ -165,11 +167,16 @@ bool CJNATIVEBackend::ProcessGenerationOfNormalCompile(const std::vector<TempFil
         return TC->ProcessGeneration(preprocessedFiles);
     }
 
-    auto preprocessedFiles = GeneratePreprocessTools(bitCodeFiles);
-    if (driverOptions.saveTemps) {
-        (void)GenerateCompileTool(preprocessedFiles, true);
+    std::vector<TempFileInfo> objFiles;
+    if (IsObjectCacheEnabled()) {
+        objFiles = GenerateCompileToolsWithObjectCache(bitCodeFiles);
+    } else {
+        auto preprocessedFiles = GeneratePreprocessTools(bitCodeFiles);
+        if (driverOptions.saveTemps) {
+            (void)GenerateCompileTool(preprocessedFiles, true);
+        }
+        objFiles = GenerateCompileTool(preprocessedFiles);
     }
-    auto objFiles = GenerateCompileTool(preprocessedFiles);
     // copy each obj file from temporary directory to cache directory in normal compile case
     ToolBatch batch{};
     for (auto& objFile : objFiles) {
@@ -200,7 +207,13 @@ bool CJNATIVEBackend::ProcessGenerationOfNormalCompile(const std::vector<TempFil
         batch.emplace_back(std::move(tool));
     }
     backendCmds.emplace_back(std::move(batch));
-    return TC->ProcessGeneration(objFiles);
+    if (!TC->ProcessGeneration(objFiles)) {
+        return false;
+    }
+    if (IsObjectCacheEnabled()) {
+        GenerateObjectCacheEvictTool();
+    }
+    return true;
 }
 
 bool CJNATIVEBackend::ProcessGenerationOfIncrementalNoChangeCompile(const std::vector<TempFileInfo>& bitCodeFiles)
@@ -241,6 +254,98 @@ bool CJNATIVEBackend::ProcessGenerationOfIncrementalNoChangeCompile(const std::v
     return TC->ProcessGeneration(tempBitCodeFiles);
 }
 
+bool CJNATIVEBackend::IsObjectCacheEnabled() const
+{
+    // The assembly files of '--save-temps' are generated from the optimized bitcode, which is skipped on a cache hit.
+    return driverOptions.enIncrementalObjectCache && driverOptions.enIncrementalCompilation &&
+        !driverOptions.saveTemps && !driverOptions.compilationCachedDir.empty();
+}
+
+std::string CJNATIVEBackend::GetBackendOptionsFingerprint()
+{
+    auto optTool = GenerateCJNativeBaseTool(optPath);
+    AppendPreprocessOptions(*optTool);
+    auto llcTool = GenerateCJNativeBaseTool(llcPath);
+    AppendCompileOptions(*llcTool);
+    std::string fingerprint = CANGJIE_COMPILER_VERSION;
+    for (auto tool : {optTool.get(), llcTool.get()}) {
+        for (auto& arg : tool->GetFullArgs()) {
+            fingerprint += '\0' + arg;
+        }
+    }
+    return fingerprint;
+}
+
+std::string CJNATIVEBackend::GetObjectCachePrefix() const
+{
+    return driverOptions.GetHashedObjFileName("objcache") + ".";
+}
+
+void CJNATIVEBackend::GenerateObjectCacheEvictTool()
+{
+    // The cache is shared by all configurations of the package, so the objects unused by this build are only removed
+    // by age and size, after the build succeeds.
+    auto tool = std::make_unique<Tool>(
+        "ObjectCacheEvict", ToolType::INTERNAL_IMPLEMENTED, driverOptions.environment.allVariables);
+    tool->AppendArg(driverOptions.compilationCachedDir, GetObjectCachePrefix());
+    tool->AppendArg(usedCachedObjs);
+    backendCmds.emplace_back(MakeSingleToolBatch({std::move(tool)}));
+}
+
+std::vector<TempFileInfo> CJNATIVEBackend::GenerateCompileToolsWithObjectCache(
+    const std::vector<TempFileInfo>& bitCodeFiles)
+{
+    // Unchanged sub-modules produce the same bitcode as the previous build, so their objects are keyed by the hash
+    // of the bitcode content and the backend options, and only the changed sub-modules run through 'opt' and 'llc'.
+    auto optionsHash = ObjectCache::HashOptions(GetBackendOptionsFingerprint());
+    auto cachedObjPrefix = GetObjectCachePrefix();
+    std::vector<TempFileInfo> objFiles(bitCodeFiles.size());
+    std::vector<TempFileInfo> missedFiles;
+    std::vector<std::pair<size_t, std::optional<std::string>>> missedInfos;
+    ToolBatch hitBatch{};
+    for (size_t i = 0; i < bitCodeFiles.size(); ++i) {
+        auto key = bitCodeFiles[i].isForeignInput ? std::nullopt
+                                                  : ObjectCache::GetKey(bitCodeFiles[i].filePath, optionsHash);
+        auto cachedObj = key.has_value() ? std::make_optional(cachedObjPrefix + key.value() + ".o") : std::nullopt;
+        if (cachedObj.has_value()) {
+            usedCachedObjs.emplace_back(cachedObj.value());
+        }
+        if (!cachedObj.has_value() || !FileUtil::FileExist(cachedObj.value())) {
+            missedFiles.emplace_back(bitCodeFiles[i]);
+            missedInfos.emplace_back(i, cachedObj);
+            continue;
+        }
+        objFiles[i] = TempFileManager::Instance().CreateNewFileInfo(bitCodeFiles[i], TempFileKind::T_OBJ);
+        auto tool =
+            std::make_unique<Tool>("CacheCopy", ToolType::INTERNAL_IMPLEMENTED, driverOptions.environment.allVariables);
+        tool->AppendArg(cachedObj.value(), objFiles[i].filePath);
+        hitBatch.emplace_back(std::move(tool));
+    }
+    if (!hitBatch.empty()) {
+        backendCmds.emplace_back(std::move(hitBatch));
+    }
+    if (missedFiles.empty()) {
+        return objFiles;
+    }
+    auto missedObjFiles = GenerateCompileTool(GeneratePreprocessTools(missedFiles));
+    ToolBatch saveBatch{};
+    for (size_t i = 0; i < missedObjFiles.size(); ++i) {
+        auto& [idx, cachedObj] = missedInfos[i];
+        objFiles[idx] = missedObjFiles[i];
+        if (!cachedObj.has_value()) {
+            continue;
+        }
+        auto tool =
+            std::make_unique<Tool>("CacheCopy", ToolType::INTERNAL_IMPLEMENTED, driverOptions.environment.allVariables);
+        tool->AppendArg(missedObjFiles[i].filePath, cachedObj.value());
+        saveBatch.emplace_back(std::move(tool));
+    }
+    if (!saveBatch.empty()) {
+        backendCmds.emplace_back(std::move(saveBatch));
+    }
+    return objFiles;
+}
+
 void CJNATIVEBackend::PreprocessOfNewPassManager(Tool& tool)
 {
     std::string passesCollector = "-passes=";
@@ -265,6 +370,37 @@ void CJNATIVEBackend::PreprocessOfNewPassManager(Tool& tool)
     tool.AppendArg(passesCollector);
 }
 
+void CJNATIVEBackend::AppendPreprocessOptions(Tool& tool)
+{
+    // handle the new pass manager of 'opt'
+    PreprocessOfNewPassManager(tool);
+    using namespace ToolOptions;
+    SetFuncType setOptionHandler = [&tool](const std::string& option) { tool.AppendArg(option); };
+    std::vector<ToolOptionType> setOptionsPass = {
+        OPT::SetOptions,                // Comment ensure vector members are arranged vertically.
+        OPT::SetVerifyOptions,          //
+        OPT::SetTripleOptions,          //
+        OPT::SetCodeObfuscationOptions, //
+        OPT::SetLTOOptions,             //
+        OPT::SetPgoOptions,             //
+        OPT::SetTransparentOptions      // The transparent options must after other options.
+    };
+    SetOptions(setOptionHandler, driverOptions, setOptionsPass);
+}
+
+void CJNATIVEBackend::AppendCompileOptions(Tool& tool)
+{
+    using namespace ToolOptions;
+    SetFuncType setOptionHandler = [&tool](const std::string& option) { tool.AppendArg(option); };
+    std::vector<ToolOptionType> setOptionsPass = {
+        LLC::SetOptions,                  // Comment ensure vector members are arranged vertically.
+        LLC::SetTripleOptions,            //
+        LLC::SetOptimizationLevelOptions, //
+        LLC::SetTransparentOptions,       // The transparent options must after other options.
+    };
+    SetOptions(setOptionHandler, driverOptions, setOptionsPass);
+}
+
 std::vector<TempFileInfo> CJNATIVEBackend::GeneratePreprocessTools(const std::vector<TempFileInfo>& bitCodeFiles)
 {
     std::vector<TempFileInfo> outputFiles;
@@ -276,22 +412,7 @@ std::vector<TempFileInfo> CJNATIVEBackend::GeneratePreprocessTools(const std::ve
         tool->AppendArg(bitCodeFile.filePath);
 
         // set options
-        // handle the new pass manager of 'opt'
-        PreprocessOfNewPassManager(*tool);
-        {
-            using namespace ToolOptions;
-            SetFuncType setOptionHandler = [&tool](const std::string& option) { tool->AppendArg(option); };
-            std::vector<ToolOptionType> setOptionsPass = {
-                OPT::SetOptions,                // Comment ensure vector members are arranged vertically.
-                OPT::SetVerifyOptions,          //
-                OPT::SetTripleOptions,          //
-                OPT::SetCodeObfuscationOptions, //
-                OPT::SetLTOOptions,             //
-                OPT::SetPgoOptions,             //
-                OPT::SetTransparentOptions      // The transparent options must after other options.
-            };
-            SetOptions(setOptionHandler, driverOptions, setOptionsPass);
-        }
+        AppendPreprocessOptions(*tool);
 
         // set output
         // When compiling a static library in LTO mode
@@ -323,17 +444,7 @@ std::vector<TempFileInfo> CJNATIVEBackend::GenerateCompileTool(
         tool->AppendArg(bitCodeFile.filePath);
 
         // set options
-        {
-            using namespace ToolOptions;
-            SetFuncType setOptionHandler = [&tool](const std::string& option) { tool->AppendArg(option); };
-            std::vector<ToolOptionType> setOptionsPass = {
-                LLC::SetOptions,                  // Comment ensure vector members are arranged vertically.
-                LLC::SetTripleOptions,             //
-                LLC::SetOptimizationLevelOptions, //
-                LLC::SetTransparentOptions,       // The transparent options must after other options.
-            };
-            SetOptions(setOptionHandler, driverOptions, setOptionsPass);
-        }
+        AppendCompileOptions(*tool);
 
         // set output
         tool->AppendArg(emitAssembly ? "--filetype=asm" : "--filetype=obj");
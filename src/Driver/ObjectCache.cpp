@@ -0,0 +1,94 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+/**
+ * @file
+ *
+ * This file implements the content-addressed object cache of incremental compilation.
+ */
+
+#include "cangjie/Driver/ObjectCache.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include "cangjie/Utils/FileUtil.h"
+#include "cangjie/Utils/SipHash.h"
+
+using namespace Cangjie;
+
+namespace {
+struct CachedObj {
+    std::string path;
+    int64_t modifiedTime;
+    uint64_t size;
+};
+
+constexpr int HASH_HEX_WIDTH = 16;
+} // namespace
+
+uint64_t ObjectCache::HashOptions(const std::string& optionsFingerprint)
+{
+    return Utils::SipHash::GetHashValue(optionsFingerprint);
+}
+
+std::optional<std::string> ObjectCache::GetKey(const std::string& bitCodeFile, uint64_t optionsHash)
+{
+    std::vector<uint8_t> content;
+    std::string failedReason;
+    if (!FileUtil::ReadBinaryFileToBuffer(bitCodeFile, content, failedReason)) {
+        return std::nullopt;
+    }
+    // The options hash separates the configurations, and the content hash the sub-modules of one configuration.
+    std::stringstream ss;
+    ss << std::hex << std::setfill('0') << std::setw(HASH_HEX_WIDTH) << optionsHash << std::setw(HASH_HEX_WIDTH)
+       << Utils::SipHash::GetHashValue(content);
+    return ss.str();
+}
+
+void ObjectCache::Evict(const std::string& cacheDir, const std::string& prefix,
+    const std::unordered_set<std::string>& usedObjs, const EvictionPolicy& policy, int64_t now)
+{
+    std::vector<CachedObj> unusedObjs;
+    uint64_t totalSize = 0;
+    for (auto& fileName : FileUtil::GetAllFilesUnderCurrentPath(cacheDir, "o", false)) {
+        auto path = FileUtil::JoinPath(cacheDir, fileName);
+        if (path.rfind(prefix, 0) != 0) {
+            continue;
+        }
+        auto size = static_cast<uint64_t>(FileUtil::GetFileSize(path));
+        if (usedObjs.count(path) != 0) {
+            // the modification time records the last use, since the cached objects are never modified
+            (void)FileUtil::SetFileModifiedTime(path, now);
+            totalSize += size;
+            continue;
+        }
+        auto modifiedTime = FileUtil::GetFileModifiedTime(path);
+        if (!modifiedTime.has_value()) {
+            continue;
+        }
+        if (now - modifiedTime.value() > policy.maxAge) {
+            (void)FileUtil::Remove(path);
+            continue;
+        }
+        totalSize += size;
+        unusedObjs.emplace_back(CachedObj{path, modifiedTime.value(), size});
+    }
+    std::sort(unusedObjs.begin(), unusedObjs.end(),
+        [](const CachedObj& lhs, const CachedObj& rhs) {
+            return lhs.modifiedTime == rhs.modifiedTime ? lhs.path < rhs.path : lhs.modifiedTime < rhs.modifiedTime;
+        });
+    for (auto& obj : unusedObjs) {
+        if (totalSize <= policy.maxSize) {
+            break;
+        }
+        if (FileUtil::Remove(obj.path)) {
+            totalSize -= obj.size;
+        }
+    }
+}
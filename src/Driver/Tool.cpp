@@ -19,10 +19,12 @@
 #include <spawn.h>
 #include <sys/wait.h>
 #endif
+#include <ctime>
 #include <fstream>
 
 #include "cangjie/Utils/FileUtil.h"
 #include "cangjie/Utils/Semaphore.h"
+#include "cangjie/Driver/ObjectCache.h"
 #include "cangjie/Driver/TempFileManager.h"
 #include "cangjie/Driver/Utils.h"
 
@@ -93,6 +95,13 @@ bool Tool::InternalImplementedCommandExec() const
         FileUtil::HideFile(FileUtil::GetDirPath(arguments[2]));
 #endif
         res = true;
+    } else if (type == ToolType::INTERNAL_IMPLEMENTED && name == "ObjectCacheEvict") {
+        auto& arguments = GetFullArgs();
+        // arguments[1] - cache directory, arguments[2] - path prefix of the cached objects
+        // arguments[3...] - cached objects used by this build
+        std::unordered_set<std::string> usedObjs(arguments.begin() + 3, arguments.end());
+        ObjectCache::Evict(arguments[1], arguments[2], usedObjs, {}, static_cast<int64_t>(std::time(nullptr)));
+        res = true;
     }
     return res;
 }
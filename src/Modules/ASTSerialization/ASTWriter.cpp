@@ -699,6 +699,15 @@ void ASTWriter::ASTWriterImpl::ExportAST(const PackageDecl& package)
     for (auto decl : topLevelDeclsOrdered) {
         (void)GetDeclIndex(decl);
     }
+    if (config.exportContent) {
+        // The instantiations compiled with weak linkage are reused by the downstream packages.
+        // See 'IsReusableInstantiatedFunc'.
+        for (auto& decl : package.srcPackage->genericInstantiatedDecls) {
+            if (decl->astKind == ASTKind::FUNC_DECL && decl->linkage == Linkage::WEAK_ODR) {
+                (void)GetDeclIndex(decl.get());
+            }
+        }
+    }
 }
 
 void ASTWriter::SetSerializingCommon()
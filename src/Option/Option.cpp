@@ -1462,6 +1462,8 @@ std::vector<std::string> GlobalOptions::ToSerialized() const
     (void)result.emplace_back(VectorStrToSerializedString(interpreterArgs, "\\"));
     (void)result.emplace_back(BoolToSerializedString(interpreterPrintResult));
     (void)result.emplace_back(BoolToSerializedString(interpMainNoLinkage));
+    (void)result.emplace_back(std::to_string(constEvalMemoryLimit));
+    (void)result.emplace_back(std::to_string(constEvalStepLimit));
     (void)result.emplace_back(BoolToSerializedString(disableCodeGen));
     (void)result.emplace_back(BoolToSerializedString(disableDeserializer));
     return result;
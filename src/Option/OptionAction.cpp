@@ -400,6 +400,21 @@ bool ParseCHIRWFC(GlobalOptions& opts, const OptionArgInstance& arg)
     return true;
 }
 
+bool ParseConstEvalLimit(const OptionArgInstance& arg, std::size_t& limit)
+{
+    if (arg.value.empty() || arg.value.find_first_not_of("0123456789") != std::string::npos) {
+        Errorf("'%s' only accepts a positive integer number as value.\n", arg.name.c_str());
+        return false;
+    }
+    constexpr std::size_t maxLen = 12;
+    if (arg.value.length() > maxLen || std::stoull(arg.value) == 0) {
+        Errorf("'%s' gets an invalid number input.\n", arg.name.c_str());
+        return false;
+    }
+    limit = static_cast<std::size_t>(std::stoull(arg.value));
+    return true;
+}
+
 #ifdef CANGJIE_CODEGEN_CJNATIVE_BACKEND
 std::optional<std::size_t> ParseJobsValue(const OptionArgInstance& arg)
 {
@@ -631,6 +646,7 @@ std::unordered_map<Options::ID, std::function<bool(GlobalOptions&, OptionArgInst
     }},
     { Options::ID::INCRE_COMPILE, OPTION_TRUE_ACTION(opts.enIncrementalCompilation = true) },
     { Options::ID::INCRE_DEBUG, OPTION_TRUE_ACTION(opts.printIncrementalInfo = true) },
+    { Options::ID::INCRE_OBJECT_CACHE, OPTION_TRUE_ACTION(opts.enIncrementalObjectCache = true) },
     { Options::ID::DUMP_DEPENDENT_PACKAGE, OPTION_TRUE_ACTION(opts.scanDepPkg = true) },
     { Options::ID::NO_SUB_PACKAGE, OPTION_TRUE_ACTION(opts.noSubPkg = true) },
 
@@ -856,6 +872,10 @@ std::unordered_map<Options::ID, std::function<bool(GlobalOptions&, OptionArgInst
 
     // ---------- CHIR GENERAL OPTIONS ----------
     { Options::ID::CHIR_EA, ParseCHIREA },
+    { Options::ID::CHIR_INLINE_REMARKS, [](GlobalOptions& opts, const OptionArgInstance& arg) {
+        opts.chirInlineRemarksFile = arg.value;
+        return true;
+    }},
     { Options::ID::CHIR_WFC, ParseCHIRWFC },
     { Options::ID::ENABLE_CHIR_REDUNDANT_GETORTHROW_ELIMINATION,
         [](GlobalOptions& opts, [[maybe_unused]] const OptionArgInstance& arg) {
@@ -962,6 +982,12 @@ std::unordered_map<Options::ID, std::function<bool(GlobalOptions&, OptionArgInst
         return true;
     }},
     { Options::ID::INTERP_CONST_EVAL_DEBUG, OPTION_TRUE_ACTION(opts.constEvalDebug = true) },
+    { Options::ID::INTERP_CONST_EVAL_MEMORY_LIMIT, [](GlobalOptions& opts, const OptionArgInstance& arg) {
+        return ParseConstEvalLimit(arg, opts.constEvalMemoryLimit);
+    }},
+    { Options::ID::INTERP_CONST_EVAL_STEP_LIMIT, [](GlobalOptions& opts, const OptionArgInstance& arg) {
+        return ParseConstEvalLimit(arg, opts.constEvalStepLimit);
+    }},
     { Options::ID::DISABLE_CODEGEN, [](GlobalOptions& opts, [[maybe_unused]] OptionArgInstance& arg) {
         opts.disableCodeGen = true;
         return true;
@@ -993,6 +1019,8 @@ std::unordered_map<Options::ID, std::function<bool(GlobalOptions&, OptionArgInst
         return true;
     }},
     { Options::ID::DISCARD_EH_FRAME, OPTION_TRUE_ACTION(opts.discardEhFrame = true) },
+    { Options::ID::ENUM_INLINE_LAYOUT, OPTION_TRUE_ACTION(opts.enableEnumInlineLayout = true) },
+    { Options::ID::NO_ENUM_INLINE_LAYOUT, OPTION_TRUE_ACTION(opts.enableEnumInlineLayout = false) },
     {Options::ID::JOBS, ParseJobs},
     {Options::ID::AGGRESSIVE_PARALLEL_COMPILE, ParseAPCJobs},
 #ifndef DISABLE_EFFECT_HANDLERS
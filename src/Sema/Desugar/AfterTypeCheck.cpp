@@ -28,9 +28,9 @@
 #include "cangjie/AST/Clone.h"
 #include "cangjie/AST/Create.h"
 #include "cangjie/AST/Match.h"
+#include "cangjie/AST/StaticWalker.h"
 #include "cangjie/AST/Types.h"
 #include "cangjie/AST/Utils.h"
-#include "cangjie/AST/Walker.h"
 #include "cangjie/Driver/StdlibMap.h"
 #include "cangjie/Frontend/CompilerInstance.h"
 #include "cangjie/Modules/ImportManager.h"
@@ -379,7 +379,7 @@ void TypeChecker::TypeCheckerImpl::GenerateMainInvoke()
 // Perform desugar after typecheck before generic instantiation.
 void TypeChecker::TypeCheckerImpl::DesugarForPropDecl(Node& pkg)
 {
-    Walker(&pkg, [this](Ptr<Node> node) -> VisitAction {
+    StaticWalk(&pkg, [this](Ptr<Node> node) -> VisitAction {
         if (node->TestAnyAttr(Attribute::HAS_BROKEN, Attribute::IS_BROKEN)) {
             return VisitAction::SKIP_CHILDREN;
         }
@@ -396,7 +396,7 @@ void TypeChecker::TypeCheckerImpl::DesugarForPropDecl(Node& pkg)
                 break;
         }
         return VisitAction::WALK_CHILDREN;
-    }).Walk();
+    });
 }
 
 // Perform desugar after typecheck before generic instantiation.
@@ -416,7 +416,7 @@ void TypeChecker::TypeCheckerImpl::PerformDesugarAfterTypeCheck(ASTContext& ctx,
         ci->invocation.globalOptions.output));
 
     DesugarDeclsForPackage(pkg, ci->invocation.globalOptions.enableCoverage);
-    std::function<VisitAction(Ptr<Node>)> preVisit = [this, &ctx](Ptr<Node> node) -> VisitAction {
+    auto preVisit = [this, &ctx](Ptr<Node> node) -> VisitAction {
         switch (node->astKind) {
             case ASTKind::FOR_IN_EXPR: {
                 auto fie = StaticAs<ASTKind::FOR_IN_EXPR>(node);
@@ -477,7 +477,7 @@ void TypeChecker::TypeCheckerImpl::PerformDesugarAfterTypeCheck(ASTContext& ctx,
         }
         return VisitAction::WALK_CHILDREN;
     };
-    Walker(&pkg, preVisit).Walk();
+    StaticWalk(&pkg, preVisit);
 }
 
 Ptr<AST::Ty> TypeChecker::TypeCheckerImpl::SynthesizeWithoutRecover(ASTContext& ctx, Ptr<AST::Node> node)
@@ -27,9 +27,9 @@
 #include "cangjie/AST/Clone.h"
 #include "cangjie/AST/Create.h"
 #include "cangjie/AST/Match.h"
+#include "cangjie/AST/StaticWalker.h"
 #include "cangjie/AST/Types.h"
 #include "cangjie/AST/Utils.h"
-#include "cangjie/AST/Walker.h"
 #include "cangjie/Basic/Match.h"
 #include "cangjie/Modules/ImportManager.h"
 #include "cangjie/Sema/TypeManager.h"
@@ -51,7 +51,7 @@ void TypeChecker::PerformDesugarAfterInstantiation(ASTContext& ctx, Package& pkg
 namespace {
 void UpdateDeclAttributes(Package& pkg, bool exportForTest)
 {
-    Walker(&pkg, [&exportForTest](auto node) {
+    StaticWalk(&pkg, [&exportForTest](Ptr<Node> node) {
         if (auto vd = DynamicCast<VarDecl*>(node); vd && vd->initializer) {
             vd->EnableAttr(Attribute::DEFAULT);
         }
@@ -78,7 +78,7 @@ void UpdateDeclAttributes(Package& pkg, bool exportForTest)
             }
         }
         return VisitAction::WALK_CHILDREN;
-    }).Walk();
+    });
 }
 
 /**
@@ -88,14 +88,14 @@ void UpdateDeclAttributes(Package& pkg, bool exportForTest)
  */
 void ClearLineInfoAfterSema(Package& pkg)
 {
-    std::function<VisitAction(Ptr<Node>)> clearGenericInst = [](Ptr<Node> node) -> VisitAction {
+    auto clearGenericInst = [](Ptr<Node> node) -> VisitAction {
         node->begin.line = 0;
         node->begin.column = 0;
         node->begin.Mark(PositionStatus::IGNORE);
         return VisitAction::WALK_CHILDREN;
     };
     for (auto& decl : pkg.genericInstantiatedDecls) {
-        Walker(decl, clearGenericInst).Walk();
+        StaticWalk(decl, clearGenericInst);
     }
 }
 } // namespace
@@ -191,7 +191,7 @@ void AutoBoxing::TryOptionBox(EnumTy& target, Expr& expr)
  */
 void AutoBoxing::AddOptionBox(Package& pkg)
 {
-    std::function<VisitAction(Ptr<Node>)> preVisit = [this](Ptr<Node> node) -> VisitAction {
+    auto preVisit = [this](Ptr<Node> node) -> VisitAction {
         return match(*node)([this](const VarDecl& vd) { return AddOptionBoxHandleVarDecl(vd); },
             [this](const AssignExpr& ae) { return AddOptionBoxHandleAssignExpr(ae); },
             [this](CallExpr& ce) { return AddOptionBoxHandleCallExpr(ce); },
@@ -204,8 +204,7 @@ void AutoBoxing::AddOptionBox(Package& pkg)
             [this](ArrayExpr& ae) { return AddOptionBoxHandleArrayExpr(ae); },
             []() { return VisitAction::WALK_CHILDREN; });
     };
-    Walker walker(&pkg, preVisit);
-    walker.Walk();
+    StaticWalk(&pkg, preVisit);
 }
 
 VisitAction AutoBoxing::AddOptionBoxHandleTupleList(const TupleLit& tl)
@@ -20,9 +20,9 @@
 #include "cangjie/AST/Create.h"
 #include "cangjie/AST/Match.h"
 #include "cangjie/AST/Node.h"
+#include "cangjie/AST/StaticWalker.h"
 #include "cangjie/AST/Types.h"
 #include "cangjie/AST/Utils.h"
-#include "cangjie/AST/Walker.h"
 #include "cangjie/Utils/CheckUtils.h"
 #include "cangjie/Utils/Utils.h"
 
@@ -716,12 +716,11 @@ private:
 void PerformDesugarBeforeTypeCheck(Node& root, bool desugarMacrocall)
 {
     DiscardedHelper dHelper;
-    std::function<VisitAction(Ptr<Node>)> visitorPost = [&dHelper](Ptr<Node> node) -> VisitAction {
+    auto visitorPost = [&dHelper](Ptr<Node> node) -> VisitAction {
         dHelper.PopCtxt(node);
         return VisitAction::KEEP_DECISION;
     };
-    std::function<VisitAction(Ptr<Node>)> visitor =
-        [&visitor, &visitorPost, &dHelper, &desugarMacrocall](Ptr<Node> node) -> VisitAction {
+    auto visitor = [&visitorPost, &dHelper, &desugarMacrocall](auto& self, Ptr<Node> node) -> VisitAction {
         if (node->TestAttr(Attribute::IS_BROKEN)) {
             // must push before return to pair with visitorPost
             dHelper.PushCtxt(false, node);
@@ -733,7 +732,7 @@ void PerformDesugarBeforeTypeCheck(Node& root, bool desugarMacrocall)
             if (desugarMacrocall) {
                 // Walk nodes in macrocall to find references, for lsp.
                 for (auto& it : file->originalMacroCallNodes) {
-                    Walker(it.get(), visitor, visitorPost).Walk();
+                    StaticWalk(it.get(), [&self](Ptr<Node> child) { return self(self, child); }, visitorPost);
                 }
             }
             DesugarMacroDecl(*file);
@@ -764,6 +763,6 @@ void PerformDesugarBeforeTypeCheck(Node& root, bool desugarMacrocall)
         }
         return VisitAction::WALK_CHILDREN;
     };
-    Walker(&root, visitor, visitorPost).Walk();
+    StaticWalk(&root, [&visitor](Ptr<Node> node) { return visitor(visitor, node); }, visitorPost);
 }
 } // namespace Cangjie
@@ -23,15 +23,14 @@ std::vector<Diagnostic> DiagSuppressor::GetSuppressedDiag()
 void DiagSuppressor::ReportDiag()
 {
     auto diags = GetSuppressedDiag();
-    diag.EnableDiagnose(originDiagVec);
+    diag.EnableDiagnose(outerBegin);
     for (auto& d : diags) {
         diag.Diagnose(d);
     }
-    originDiagVec = diag.DisableDiagnose();
+    outerBegin = diag.DisableDiagnose();
 }
 
 bool DiagSuppressor::HasError() const
 {
-    return Utils::In(diag.GetStoredDiags(),
-        [](const Diagnostic& d) { return d.diagSeverity == DiagSeverity::DS_ERROR; });
+    return diag.HasStoredError();
 }
@@ -16,15 +16,19 @@
 #include "cangjie/Basic/DiagnosticEngine.h"
 
 namespace Cangjie {
+/**
+ * Store the diagnoses issued during its lifetime instead of reporting them. The suppressors nest as scopes of the
+ * stored diagnoses in DiagnosticEngine, entering and leaving one doesn't copy the diagnoses of the outer scopes.
+ */
 class DiagSuppressor {
 public:
     explicit DiagSuppressor(DiagnosticEngine& diag) : diag(diag)
     {
-        originDiagVec = diag.DisableDiagnose();
+        outerBegin = diag.DisableDiagnose();
     }
     ~DiagSuppressor()
     {
-        diag.EnableDiagnose(originDiagVec);
+        diag.EnableDiagnose(outerBegin);
     }
     std::vector<Diagnostic> GetSuppressedDiag();
     void ReportDiag();
@@ -32,7 +36,8 @@ public:
 
 private:
     DiagnosticEngine& diag;
-    std::vector<Diagnostic> originDiagVec;
+    /** The beginning of the stored diagnoses of the enclosing scope. */
+    size_t outerBegin;
 };
 } // namespace Cangjie
 
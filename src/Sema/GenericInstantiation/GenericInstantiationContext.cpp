@@ -39,6 +39,8 @@ void GIM::GenericInstantiationManagerImpl::ClearCache()
     declInstantiationByTypeMap.clear();
     instantiatedDeclsMap.clear();
     membersIndexMap.clear();
+    reusedInstantiations.clear();
+    reusedInstantiationSet.clear();
 }
 
 void GIM::GenericInstantiationManagerImpl::WalkImportedInstantiations(
@@ -81,6 +83,27 @@ void GIM::GenericInstantiationManagerImpl::RebuildGenericInstantiationManager()
             return backend == Triple::BackendType::CJNATIVE ||
                 importManager.IsMacroRelatedPackageName(pkg.fullPackageName);
         });
+    RecordReusableInstantiations();
+}
+
+void GIM::GenericInstantiationManagerImpl::RecordReusableInstantiations()
+{
+    if (!shareInstantiations) {
+        return;
+    }
+    WalkImportedInstantiations(
+        [this](Decl& decl) {
+            auto fd = DynamicCast<FuncDecl*>(&decl);
+            if (!fd || !fd->TestAttr(Attribute::IMPORTED) || !IsReusableInstantiatedFunc(*fd)) {
+                return;
+            }
+            // Several imported packages may have the same instantiation, the first one is used.
+            GenericInfo genericInfo(fd->genericDecl, BuildTypeMapping(*fd));
+            if (declInstantiationByTypeMap.count(genericInfo) == 0) {
+                declInstantiationByTypeMap.emplace(genericInfo, fd);
+            }
+        },
+        [](auto& pkg) { return !pkg.TestAttr(Attribute::IMPORTED); });
 }
 
 void GIM::GenericInstantiationManagerImpl::RestoreInstantiatedDeclTy() const
@@ -49,4 +49,9 @@ void GenericInstantiationManager::ResetGenericInstantiationStage() const
 Generic2InsMap GenericInstantiationManager::GetAllGenericToInsDecls() const
 {
     return impl->GetAllGenericToInsDecls();
+}
+
+const std::vector<Ptr<AST::FuncDecl>>& GenericInstantiationManager::GetReusedInstantiations() const
+{
+    return impl->GetReusedInstantiations();
 }
\ No newline at end of file
@@ -11,6 +11,8 @@
  * 1. Instantiate all referenced generic decls in non-generic/instantiated decls.
  *    - Copy generic decl and substitute generic types with instantiated types.
  *    - Imported inline functions' content should only be walked if the function is used in source package.
+ *    - For cjnative backend, the instantiations of public global generic functions exported by imported packages
+ *      are reused instead of being instantiated again.
  * 2. Rearrange generic references to instantiated decls.
  *   - Update reference decl pointer from original generic ast to instantiated decl's pointer.
  *     eg: func test<T>(a: T) { // xxx}
@@ -39,7 +41,7 @@
 #include "cangjie/AST/Match.h"
 #include "cangjie/AST/RecoverDesugar.h"
 #include "cangjie/AST/Utils.h"
-#include "cangjie/AST/Walker.h"
+#include "cangjie/AST/StaticWalker.h"
 #include "cangjie/Mangle/BaseMangler.h"
 #include "cangjie/Sema/Desugar.h"
 #include "cangjie/Sema/TypeManager.h"
@@ -58,26 +60,42 @@ GIM::GenericInstantiationManagerImpl::GenericInstantiationManagerImpl(CompilerIn
       promotion(*ci.typeManager),
       instantiationWalkerID(AST::Walker::GetNextWalkerID()),
       rearrangeWalkerID(AST::Walker::GetNextWalkerID()),
-      backend(ci.invocation.globalOptions.backend)
+      backend(ci.invocation.globalOptions.backend),
+      // MinGW has no weak definition merged across the libraries, so every package keeps its own instantiations.
+      shareInstantiations(backend == Triple::BackendType::CJNATIVE && !ci.invocation.globalOptions.target.IsMinGW())
 {
-    instantiator = [this](auto node) { return CheckNodeInstantiation(*node); };
-    rearranger = [this](auto node) { return RearrangeReferencePtr(*node); };
-    contextReset = [this](auto node) {
-        if (auto decl = DynamicCast<Decl*>(node); decl && !structContext.empty()) {
-            // Pop context if current is structure declaration or generic decl inside generic structure declaration.
-            if (NeedSwitchContext(*decl) && decl == structContext.back()) {
-                structContext.pop_back();
-            }
-        }
-        return VisitAction::WALK_CHILDREN;
-    };
     SetOptLevel(ci.invocation.globalOptions);
 }
 
+VisitAction GIM::GenericInstantiationManagerImpl::ResetContext(Ptr<Node> node)
+{
+    if (auto decl = DynamicCast<Decl*>(node); decl && !structContext.empty()) {
+        // Pop context if current is structure declaration or generic decl inside generic structure declaration.
+        if (NeedSwitchContext(*decl) && decl == structContext.back()) {
+            structContext.pop_back();
+        }
+    }
+    return VisitAction::WALK_CHILDREN;
+}
+
+void GIM::GenericInstantiationManagerImpl::WalkToInstantiate(Ptr<Node> node)
+{
+    StaticWalk(
+        node, [this](Ptr<Node> cur) { return CheckNodeInstantiation(*cur); },
+        [this](Ptr<Node> cur) { return ResetContext(cur); }, WalkerIDVisited(instantiationWalkerID));
+}
+
+void GIM::GenericInstantiationManagerImpl::WalkToRearrange(Ptr<Node> node)
+{
+    StaticWalk(
+        node, [this](Ptr<Node> cur) { return RearrangeReferencePtr(*cur); },
+        [this](Ptr<Node> cur) { return ResetContext(cur); }, WalkerIDVisited(rearrangeWalkerID));
+}
+
 namespace {
 std::unordered_map<Ptr<const Decl>, std::vector<size_t>> g_skippedMemberOffsets = {};
 
-void UpdateInstantiatedDeclsLinkage(const Package& pkg)
+void UpdateInstantiatedDeclsLinkage(const Package& pkg, bool shareInstantiations)
 {
     // All instantiated decls should be marked as internal for cjnative backend.
     // For other backend, only mark extend as internal since extend will be instantiated in used package.
@@ -88,6 +106,12 @@ void UpdateInstantiatedDeclsLinkage(const Package& pkg)
             }
             return VisitAction::WALK_CHILDREN;
         }).Walk();
+        // The instantiations reused by the downstream packages are exported instead, and the copies of the same
+        // instantiation in the packages linked together are merged by the linker.
+        auto fd = DynamicCast<FuncDecl*>(decl.get());
+        if (shareInstantiations && fd && IsReusableInstantiatedFunc(*fd)) {
+            fd->linkage = Linkage::WEAK_ODR;
+        }
     }
 }
 
@@ -293,7 +317,7 @@ void GIM::GenericInstantiationManagerImpl::GenericInstantiatePackage(Package& pk
         // When `GenericInstantiatePackage` is invoked for multiple times, ensure that global data is clean.
         PartialInstantiation::ResetGlobalMap();
         // Only walk non-generic or instantiated decl's to perform instantiation.
-        Walker(curPkg, instantiationWalkerID, instantiator, contextReset).Walk();
+        WalkToInstantiate(curPkg);
     }
     Utils::ProfileRecorder::Stop("GenericInstantiatePackage", "instantiate");
     Utils::ProfileRecorder::Start("GenericInstantiatePackage", "testManager");
@@ -311,7 +335,7 @@ void GIM::GenericInstantiationManagerImpl::GenericInstantiatePackage(Package& pk
     // After the instantiation finished and there are instantiatedDecls generated in current package,
     // rearrange the ptr of outer references' target to the instantiated decl.
     // NOTE: Walker will also walk 'genericInstantiatedDecls' in package node.
-    Walker(curPkg, rearrangeWalkerID, rearranger, contextReset).Walk();
+    WalkToRearrange(curPkg);
     RecoverDesugarForBuiltIn();
     Utils::ProfileRecorder::Stop("GenericInstantiatePackage", "rearrange");
     // Do not perform validation and deletion if errors generated.
@@ -320,7 +344,7 @@ void GIM::GenericInstantiationManagerImpl::GenericInstantiatePackage(Package& pk
     }
     Utils::ProfileRecorder recorder("GenericInstantiatePackage", "cleanup");
     UpdateInstantiatedExtendMap();
-    UpdateInstantiatedDeclsLinkage(pkg);
+    UpdateInstantiatedDeclsLinkage(pkg, shareInstantiations);
     ClearImportedUnusedInstantiatedDecls();
     ValidateUsedNodes(diag, pkg);
     UnsetBoxStatus(pkg);
@@ -340,7 +364,7 @@ void GIM::GenericInstantiationManagerImpl::InstantiateForIncrementalPackage()
             return;
         }
         if (decl->toBeCompiled) {
-            Walker(decl.get(), instantiationWalkerID, instantiator, contextReset).Walk();
+            WalkToInstantiate(decl.get());
             return;
         }
         unchanged.emplace_back(decl.get());
@@ -356,7 +380,7 @@ void GIM::GenericInstantiationManagerImpl::InstantiateForIncrementalPackage()
             }
             WorkForMembers(*it, [this, &unchanged](auto& member) {
                 if (member.toBeCompiled) {
-                    Walker(&member, instantiationWalkerID, instantiator, contextReset).Walk();
+                    WalkToInstantiate(&member);
                 } else {
                     unchanged.emplace_back(&member);
                 }
@@ -370,10 +394,10 @@ void GIM::GenericInstantiationManagerImpl::InstantiateForIncrementalPackage()
     for (auto it : unchanged) {
         if (it->outerDecl) {
             structContext.push_back(it->outerDecl);
-            Walker(it, instantiationWalkerID, instantiator, contextReset).Walk();
+            WalkToInstantiate(it);
             structContext.pop_back();
         } else {
-            Walker(it, instantiationWalkerID, instantiator, contextReset).Walk();
+            WalkToInstantiate(it);
         }
     }
     needCompile = true;
@@ -412,7 +436,7 @@ void GIM::GenericInstantiationManagerImpl::ClearImportedUnusedInstantiatedDecls(
             removedDecls.emplace(it.get());
         }
     };
-    // Instantiated decls in imported package will not be referenced by any other place.
+    // Instantiated nominal decls in imported package will not be referenced by any other place.
     // The only 'ty->decl' references are already been replaced in previous step.
     for (const auto& it : importManager.GetAllImportedPackages()) {
         bool ignore = it->srcPackage == this->curPkg || !it->srcPackage->TestAttr(Attribute::IMPORTED);
@@ -586,7 +610,7 @@ Ptr<Decl> GIM::GenericInstantiationManagerImpl::GetInstantiatedDeclWithGenericIn
     }
     // Collect extend decls by usage.
     RecordExtend(*instantiatedDecl);
-    Walker(instantiatedDecl, instantiationWalkerID, instantiator, contextReset).Walk();
+    WalkToInstantiate(instantiatedDecl);
     return instantiatedDecl;
 }
 
@@ -595,22 +619,28 @@ Ptr<Decl> GIM::GenericInstantiationManagerImpl::GetInstantiatedDeclWithGenericIn
 {
     curPkg = &pkg;
     auto instantiatedDecl = GetInstantiatedDeclWithGenericInfo(genericInfo);
-    Walker(instantiatedDecl, rearrangeWalkerID, rearranger, contextReset).Walk();
+    WalkToRearrange(instantiatedDecl);
     return instantiatedDecl;
 }
 
 Ptr<Decl> GIM::GenericInstantiationManagerImpl::FindInCache(const GenericInfo& info)
 {
     auto found = declInstantiationByTypeMap.equal_range(info);
-    // Only using instantiated decl in current package.
+    // Only using instantiated decl in current package, or the imported one recorded by 'RecordReusableInstantiations'.
     // If the first and the second of the range is not equal, it means the target GI can be found in cache.
     for (auto it = found.first; it != found.second; ++it) {
         auto instantiatedDecl = it->second;
         CJC_ASSERT(instantiatedDecl != nullptr);
-        if (instantiatedDecl->fullPackageName != curPkg->fullPackageName) {
-            continue;
+        if (instantiatedDecl->fullPackageName == curPkg->fullPackageName) {
+            return instantiatedDecl;
+        }
+        auto fd = DynamicCast<FuncDecl*>(instantiatedDecl);
+        if (shareInstantiations && fd && fd->TestAttr(Attribute::IMPORTED) && IsReusableInstantiatedFunc(*fd)) {
+            if (reusedInstantiationSet.emplace(fd).second) {
+                reusedInstantiations.emplace_back(fd);
+            }
+            return instantiatedDecl;
         }
-        return instantiatedDecl;
     }
     return nullptr;
 }
@@ -627,13 +657,13 @@ void GIM::GenericInstantiationManagerImpl::WalkNonGenericExtendedType()
             continue;
         }
         for (auto& type : extend->inheritedTypes) {
-            Walker(type.get(), instantiationWalkerID, instantiator, contextReset).Walk();
+            WalkToInstantiate(type.get());
         }
     }
     auto decls = typeManager.GetBoxedNonGenericDecls();
     for (auto id : decls) {
         for (auto& type : id->inheritedTypes) {
-            Walker(type.get(), instantiationWalkerID, instantiator, contextReset).Walk();
+            WalkToInstantiate(type.get());
         }
     }
 #endif
@@ -675,7 +705,7 @@ void GIM::GenericInstantiationManagerImpl::InstantiateGenericDeclWithInstTys(
                 Ptr<Decl> func = param->desugarDecl.get();
                 if (func && func->TestAttr(Attribute::SRC_IMPORTED)) {
                     usedSrcImportedDecls.emplace(func);
-                    Walker(func, instantiationWalkerID, instantiator, contextReset).Walk();
+                    WalkToInstantiate(func);
                 }
             }
         }
@@ -684,7 +714,7 @@ void GIM::GenericInstantiationManagerImpl::InstantiateGenericDeclWithInstTys(
         if (generalDecl->TestAttr(Attribute::SRC_IMPORTED)) {
             usedSrcImportedDecls.emplace(generalDecl);
             // Walk inside decl to instantiate all used generics.
-            Walker(&decl, instantiationWalkerID, instantiator, contextReset).Walk();
+            WalkToInstantiate(&decl);
         }
         return;
     }
@@ -914,11 +944,9 @@ Ptr<Decl> GIM::GenericInstantiationManagerImpl::GetInstantiatedMemberTarget(Ty&
 void GIM::GenericInstantiationManagerImpl::GenericMemberAccessInstantiate(MemberAccess& ma)
 {
     for (auto& it : ma.typeArguments) {
-        Walker walkArg(it.get(), instantiationWalkerID, instantiator, contextReset);
-        walkArg.Walk();
+        WalkToInstantiate(it.get());
     }
-    Walker walkBase(ma.baseExpr.get(), instantiationWalkerID, instantiator, contextReset);
-    walkBase.Walk();
+    WalkToInstantiate(ma.baseExpr.get());
     auto invalid = !ma.target || !ma.baseExpr || !Ty::IsTyCorrect(ma.ty);
     if (invalid || ma.target->astKind == ASTKind::PACKAGE_DECL || TestManager::IsMockAccessor(*ma.target)) {
         return;
@@ -962,8 +990,7 @@ void GIM::GenericInstantiationManagerImpl::GenericMemberAccessInstantiate(Member
 void GIM::GenericInstantiationManagerImpl::GenericRefExprInstantiate(RefExpr& re)
 {
     for (auto& it : re.typeArguments) {
-        Walker walkArg(it.get(), instantiationWalkerID, instantiator, contextReset);
-        walkArg.Walk();
+        WalkToInstantiate(it.get());
     }
     // Generic type decleration do not need to be instantiated.
     if (!re.ref.target || re.ref.target->astKind == ASTKind::PACKAGE_DECL || !Ty::IsTyCorrect(re.ty) ||
@@ -1087,8 +1114,7 @@ void GIM::GenericInstantiationManagerImpl::GenericArrayExprInstantiate(const Arr
 void GIM::GenericInstantiationManagerImpl::GenericArrayLitInstantiate(ArrayLit& al)
 {
     for (auto& it : al.children) {
-        Walker walkElement(it.get(), instantiationWalkerID, instantiator, contextReset);
-        walkElement.Walk();
+        WalkToInstantiate(it.get());
     }
     auto target = Ty::GetDeclPtrOfTy(al.ty);
     if (!target) {
@@ -1142,7 +1168,7 @@ VisitAction GIM::GenericInstantiationManagerImpl::CheckNodeInstantiation(Node& n
     // Should not walk generated instantiated decls and source imported decls.
     if (auto pkg = DynamicCast<Package*>(&node); pkg) {
         for (auto& it : pkg->files) {
-            Walker(it.get(), instantiationWalkerID, instantiator, contextReset).Walk();
+            WalkToInstantiate(it.get());
         }
         return VisitAction::SKIP_CHILDREN;
     }
@@ -1153,7 +1179,7 @@ VisitAction GIM::GenericInstantiationManagerImpl::CheckNodeInstantiation(Node& n
     }
 
     if (auto expr = DynamicCast<Expr*>(&node); expr && expr->desugarExpr) {
-        Walker(expr->desugarExpr.get(), instantiationWalkerID, instantiator, contextReset).Walk();
+        WalkToInstantiate(expr->desugarExpr.get());
         return VisitAction::SKIP_CHILDREN;
     }
 
@@ -1199,7 +1225,7 @@ VisitAction GIM::GenericInstantiationManagerImpl::RearrangeReferencePtr(Node& no
     }
 
     if (auto expr = DynamicCast<Expr*>(&node); expr && expr->desugarExpr) {
-        Walker(expr->desugarExpr.get(), rearrangeWalkerID, rearranger, contextReset).Walk();
+        WalkToRearrange(expr->desugarExpr.get());
         ClearInstTysIsNeeded(node);
         return VisitAction::SKIP_CHILDREN;
     }
@@ -1245,7 +1271,7 @@ void GIM::GenericInstantiationManagerImpl::RearrangeCallExprReference(CallExpr&
     if (!ce.resolvedFunction || !ce.baseFunc || !ce.baseFunc->IsReferenceExpr()) {
         return;
     }
-    Walker(ce.baseFunc.get(), rearrangeWalkerID, rearranger, contextReset).Walk();
+    WalkToRearrange(ce.baseFunc.get());
     Ptr<Decl> target = ce.baseFunc->GetTarget(); // Get re-arranged target.
     // Sema guarantees: base's target not null when 'resolvedFunction' is not null and they are pointing to same decl.
     CJC_NULLPTR_CHECK(target);
@@ -1327,7 +1353,7 @@ void GIM::GenericInstantiationManagerImpl::RearrangeRefExprReference(RefExpr& re
 
 void GIM::GenericInstantiationManagerImpl::RearrangeMemberAccessReference(MemberAccess& ma)
 {
-    Walker(ma.baseExpr.get(), rearrangeWalkerID, rearranger, contextReset).Walk();
+    WalkToRearrange(ma.baseExpr.get());
     // BaseExpr of member access may be package decl which does no have sema type.
     if (!ma.target || !ma.baseExpr || Ty::IsInitialTy(ma.ty) || ma.target->IsBuiltIn()) {
         return;
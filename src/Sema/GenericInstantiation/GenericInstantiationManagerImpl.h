@@ -106,6 +106,11 @@ public:
     }
 
     Generic2InsMap GetAllGenericToInsDecls() const;
+    /** Get the imported instantiations referenced by current package instead of being instantiated again. */
+    const std::vector<Ptr<AST::FuncDecl>>& GetReusedInstantiations() const
+    {
+        return reusedInstantiations;
+    }
 
     friend class InstantiatedExtendRecorder;
     friend class MockUtils;
@@ -123,13 +128,13 @@ private:
     unsigned rearrangeWalkerID;
     /** Current compiling backend. */
     Triple::BackendType backend;
+    /** Whether the instantiations of public global generic functions are shared between packages. */
+    bool shareInstantiations;
+    /** The imported instantiations found in cache, in the order they are first used. */
+    std::vector<Ptr<AST::FuncDecl>> reusedInstantiations;
+    std::unordered_set<Ptr<AST::FuncDecl>> reusedInstantiationSet;
     /** The node which triggered current instantiation. */
     Ptr<AST::Node> curTriggerNode{nullptr};
-    /** Lambda function for instantiation walker. */
-    std::function<AST::VisitAction(Ptr<AST::Node>)> instantiator;
-    /** Lambda function for rearrangement walker. */
-    std::function<AST::VisitAction(Ptr<AST::Node>)> rearranger;
-    std::function<AST::VisitAction(Ptr<AST::Node>)> contextReset;
     /** A map stores the original generic decl and all its instantiated decls. */
     Generic2InsMap instantiatedDeclsMap;
     /** Key: generic decl & instantiated types. Value: instantiated decl. */
@@ -170,13 +175,15 @@ private:
     void RestoreInstantiatedDeclTy() const;
     void RestoreInstantiatedDeclTy(AST::Decl& decl) const;
     void RebuildGenericInstantiationManager();
+    /** Record the imported instantiations which can be reused by current package, see 'IsReusableInstantiatedFunc'. */
+    void RecordReusableInstantiations();
     void WalkImportedInstantiations(const std::function<void(AST::Decl&)>& processFunc,
         const std::function<bool(AST::Package&)>& skipChecker) const;
     void UpdateInstantiatedExtendMap();
     void ClearCache();
     void RecordExtend(AST::Node& node);
     /**
-     * Since cjnative backend only generate instantiated decls as local symbols,
+     * Since cjnative backend only generate instantiated nominal decls as local symbols,
      * we need to remove decls in other package which have same type of instantiation in current package.
      */
     void ClearImportedUnusedInstantiatedDecls();
@@ -185,7 +192,7 @@ private:
     TypeSubst BuildTypeMapping(const AST::Decl& instantiatedDecl) const;
     /**
      * Check whether the genericInfo is found in the declInstantiationByTypeMap
-     * and the decl is instantiated in dependent package of current package.
+     * and the decl is instantiated in current package, or reused from the imported package.
      */
     Ptr<AST::Decl> FindInCache(const GenericInfo& info);
     /** Construct GenericInfo. */
@@ -223,6 +230,12 @@ private:
     /** Walker function for reference pointer rearrangement. */
     AST::VisitAction RearrangeReferencePtr(AST::Node& node);
     AST::VisitAction CheckVisitedNode(Ptr<AST::Node> node, bool checkGeneric = false);
+    /** Post-visit function of the walkers, which pops the structure context when leaving it. */
+    AST::VisitAction ResetContext(Ptr<AST::Node> node);
+    /** Walk @p node with the instantiation walker ID to instantiate the generic references in it. */
+    void WalkToInstantiate(Ptr<AST::Node> node);
+    /** Walk @p node with the rearrange walker ID to point its references to the instantiated decls. */
+    void WalkToRearrange(Ptr<AST::Node> node);
 
     /** Instantiate generic MemberAccess @p ma. */
     void GenericMemberAccessInstantiate(AST::MemberAccess& ma);
@@ -39,7 +39,7 @@ void GenericInstantiationManager::InstantiatedExtendRecorder::operator()(AST::No
         // eg: 1. 'obj.extendFunction' -> collect extend decl which defined the 'extendFunction'.
         //     2. func test<T>(a: T) where T <: I { a.interfaceFunction }
         //        collect extend decl of type T <: I which implement the 'interfaceFunction'.
-        Walker(node, recorderId, extendRecorder, gim.contextReset).Walk();
+        Walker(node, recorderId, extendRecorder, [this](auto cur) { return gim.ResetContext(cur); }).Walk();
     };
     if (auto pkg = DynamicCast<Package*>(&node); pkg) {
         for (auto& it : pkg->files) {
@@ -61,7 +61,9 @@ VisitAction GenericInstantiationManager::InstantiatedExtendRecorder::RecordUsedE
     }
 
     if (auto expr = DynamicCast<Expr*>(&node); expr && expr->desugarExpr) {
-        Walker(expr->desugarExpr.get(), recorderId, extendRecorder, gim.contextReset).Walk();
+        Walker(expr->desugarExpr.get(), recorderId, extendRecorder, [this](auto cur) {
+            return gim.ResetContext(cur);
+        }).Walk();
         return VisitAction::SKIP_CHILDREN;
     }
 
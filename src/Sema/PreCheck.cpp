@@ -19,6 +19,7 @@
 #include "cangjie/AST/Clone.h"
 #include "cangjie/AST/Match.h"
 #include "cangjie/AST/Node.h"
+#include "cangjie/AST/StaticWalker.h"
 #include "cangjie/AST/Types.h"
 #include "cangjie/AST/Utils.h"
 #include "cangjie/Basic/DiagnosticEngine.h"
@@ -192,7 +193,7 @@ void TypeChecker::TypeCheckerImpl::CheckRedefinition(ASTContext& ctx)
 {
     std::vector<Symbol*> syms;
     auto enableMacroInLSP = ci->invocation.globalOptions.enableMacroInLSP;
-    std::function<VisitAction(Ptr<Node>)> collector = [&syms, &collector, &enableMacroInLSP](auto node) {
+    auto collector = [&syms, &enableMacroInLSP](auto& self, Ptr<Node> node) -> VisitAction {
         // Collect all decls with symbol, except decls that do not have name.
         static std::vector<ASTKind> ignoredKinds = {
             ASTKind::PRIMARY_CTOR_DECL, ASTKind::EXTEND_DECL, ASTKind::VAR_WITH_PATTERN_DECL};
@@ -204,12 +205,12 @@ void TypeChecker::TypeCheckerImpl::CheckRedefinition(ASTContext& ctx)
             auto file = StaticAs<ASTKind::FILE>(node);
             // Walk decls in macrocall to find references, for lsp.
             for (auto& it : file->originalMacroCallNodes) {
-                Walker(it.get(), collector).Walk();
+                StaticWalk(it.get(), [&self](Ptr<Node> child) { return self(self, child); });
             }
         }
         return VisitAction::WALK_CHILDREN;
     };
-    Walker(ctx.curPackage, collector).Walk();
+    StaticWalk(ctx.curPackage, [&collector](Ptr<Node> node) { return collector(collector, node); });
 
     CheckRedefinitionInDeclHelper(ctx, syms);
     CheckConflictDeclWithSubPackage(*ctx.curPackage);
@@ -781,13 +782,13 @@ void TypeChecker::TypeCheckerImpl::ResolveOneDecl(ASTContext& ctx, Decl& decl)
             break;
         case ASTKind::VAR_WITH_PATTERN_DECL: {
             auto& vpd = StaticCast<VarWithPatternDecl&>(decl);
-            Walker(vpd.irrefutablePattern.get(), [&ctx, &vpd](auto node) {
+            StaticWalk(vpd.irrefutablePattern.get(), [&ctx, &vpd](Ptr<Node> node) {
                 if (auto vd = DynamicCast<VarDecl*>(node)) {
                     // Collect mapping from VarDecl to the outer VarWithPatternDecl.
                     ctx.StoreOuterVarWithPatternDecl(*vd, vpd);
                 }
                 return VisitAction::WALK_CHILDREN;
-            }).Walk();
+            });
             break;
         }
         default:
@@ -863,7 +864,7 @@ void TypeChecker::TypeCheckerImpl::SubstituteTypeAliasForAlias(TypeAliasDecl& ta
         }
         return VisitAction::WALK_CHILDREN;
     };
-    Walker(&tad, resolveTypes).Walk();
+    StaticWalk(&tad, resolveTypes);
 }
 
 void TypeChecker::TypeCheckerImpl::ResolveNames(ASTContext& ctx)
@@ -897,12 +898,12 @@ void TypeChecker::TypeCheckerImpl::ResolveNames(ASTContext& ctx)
     std::vector<Symbol*> syms = GetToplevelDecls(ctx);
     for (auto& sym : syms) {
         CJC_NULLPTR_CHECK(sym);
-        Walker(sym->node, id, resolveSingleType).Walk();
+        StaticWalk(sym->node, resolveSingleType, nullptr, WalkerIDVisited(id));
     }
     if (ci->invocation.globalOptions.enableMacroInLSP) {
         for (auto& file : ctx.curPackage->files) {
             for (auto& it : file->originalMacroCallNodes) {
-                Walker(it.get(), id, resolveSingleType).Walk();
+                StaticWalk(it.get(), resolveSingleType, nullptr, WalkerIDVisited(id));
             }
         }
     }
@@ -1625,7 +1626,7 @@ namespace {
 Ptr<ReturnExpr> GetDanglingReturn(const FuncParam& fp)
 {
     Ptr<ReturnExpr> ret = nullptr;
-    Walker(fp.assignment.get(), [&ret](Ptr<Node> node) {
+    StaticWalk(fp.assignment.get(), [&ret](Ptr<Node> node) {
         if (node->astKind == ASTKind::FUNC_BODY) {
             // We donot check recursively here, since the caller guarantees all the parameters are checked.
             return VisitAction::SKIP_CHILDREN;
@@ -1635,7 +1636,7 @@ Ptr<ReturnExpr> GetDanglingReturn(const FuncParam& fp)
         } else {
             return VisitAction::WALK_CHILDREN;
         }
-    }).Walk();
+    });
     return ret;
 }
 }; // namespace
@@ -100,7 +100,7 @@ void ScopeManager::InitializeScope(ASTContext& ctx)
             ctx.currentScopeName += GetLayerName(charIndexes[ctx.currentScopeLevel]);
         }
     }
-    ctx.invertedIndex.scopeNameTrie->Insert(ctx.currentScopeName);
+    ctx.invertedIndex.sortedScopeNames.Insert(ctx.currentScopeName);
 }
 
 std::string ScopeManager::CalcScopeGateName(const ASTContext& ctx)
@@ -33,6 +33,7 @@
 #include <direct.h>
 #include <fileapi.h>
 #include <io.h>
+#include <sys/utime.h>
 #include <windows.h>
 #include <winerror.h>
 #ifndef PATH_MAX
@@ -40,6 +41,7 @@
 #endif
 #elif defined(__linux__) || defined(__APPLE__)
 #include <dirent.h>
+#include <utime.h>
 #endif
 
 namespace Cangjie::FileUtil {
@@ -650,6 +652,32 @@ size_t GetFileSize(const std::string& filePath)
 #endif
 }
 
+std::optional<int64_t> GetFileModifiedTime(const std::string& filePath)
+{
+#ifdef _WIN32
+    struct __stat64 statBuf;
+    int rc = _stat64(filePath.c_str(), &statBuf);
+#else
+    struct stat statBuf;
+    int rc = stat(filePath.c_str(), &statBuf);
+#endif
+    if (rc != 0) {
+        return std::nullopt;
+    }
+    return static_cast<int64_t>(statBuf.st_mtime);
+}
+
+bool SetFileModifiedTime(const std::string& filePath, int64_t time)
+{
+#ifdef _WIN32
+    struct __utimbuf64 times{time, time};
+    return _utime64(filePath.c_str(), &times) == 0;
+#else
+    struct utimbuf times{static_cast<time_t>(time), static_cast<time_t>(time)};
+    return utime(filePath.c_str(), &times) == 0;
+#endif
+}
+
 inline bool AddFileIfNeeded(const std::string& fileName, std::vector<std::string>& allFiles, bool shouldSkipTestFiles,
     bool shouldSkipRegularFiles)
 {
@@ -0,0 +1,162 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+/**
+ * @file
+ *
+ * This file implements the ThreadPool class.
+ */
+
+#include "cangjie/Utils/ThreadPool.h"
+
+#include <algorithm>
+
+using namespace Cangjie::Utils;
+
+namespace {
+// Index of the pool worker running on this thread, or `NOT_A_WORKER` for threads outside the pool.
+constexpr size_t NOT_A_WORKER = ThreadPool::MAX_WORKERS;
+thread_local size_t g_workerIndex = NOT_A_WORKER;
+} // namespace
+
+ThreadPool& ThreadPool::Get()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+bool ThreadPool::IsWorkerThread()
+{
+    return g_workerIndex != NOT_A_WORKER;
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMtx);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (auto& thread : threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+void ThreadPool::Reserve(size_t threadsNum)
+{
+    threadsNum = std::min(threadsNum, MAX_WORKERS);
+    if (GetWorkersNum() >= threadsNum) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(growMtx);
+    for (size_t index = GetWorkersNum(); index < threadsNum; ++index) {
+        workers[index] = std::make_unique<Worker>();
+        // Publish the worker before its thread starts, thieves only look at slots below `workersNum`.
+        workersNum.store(index + 1, std::memory_order_release);
+        (void)threads.emplace_back([this, index] { WorkerLoop(index); });
+    }
+}
+
+void ThreadPool::Submit(Job&& job)
+{
+    if (g_workerIndex != NOT_A_WORKER) {
+        auto& self = *workers[g_workerIndex];
+        std::lock_guard<std::mutex> lock(self.mtx);
+        self.jobs.emplace_back(std::move(job));
+    } else {
+        std::lock_guard<std::mutex> lock(injectMtx);
+        injected.emplace_back(std::move(job));
+    }
+    pendingJobs.fetch_add(1, std::memory_order_release);
+    NotifyOne();
+}
+
+void ThreadPool::NotifyOne()
+{
+    // Taking the lock orders this notification after any worker that is about to check `pendingJobs` and sleep.
+    { std::lock_guard<std::mutex> lock(sleepMtx); }
+    wakeUp.notify_one();
+}
+
+bool ThreadPool::TakeJob(size_t selfIndex, Job& job)
+{
+    if (pendingJobs.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+    auto taken = [this, &job](std::deque<Job>& jobs, bool fromBack) {
+        if (jobs.empty()) {
+            return false;
+        }
+        if (fromBack) {
+            job = std::move(jobs.back());
+            jobs.pop_back();
+        } else {
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        pendingJobs.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    };
+    // 1. The newest job of our own deque, its data is most likely still in cache.
+    if (selfIndex != NOT_A_WORKER) {
+        auto& self = *workers[selfIndex];
+        std::lock_guard<std::mutex> lock(self.mtx);
+        if (taken(self.jobs, true)) {
+            return true;
+        }
+    }
+    // 2. Jobs submitted from outside the pool.
+    {
+        std::lock_guard<std::mutex> lock(injectMtx);
+        if (taken(injected, false)) {
+            return true;
+        }
+    }
+    // 3. Steal the oldest job of another worker.
+    size_t num = GetWorkersNum();
+    size_t start = selfIndex != NOT_A_WORKER ? selfIndex + 1 : 0;
+    for (size_t i = 0; i < num; ++i) {
+        size_t victim = (start + i) % num;
+        if (victim == selfIndex) {
+            continue;
+        }
+        auto& other = *workers[victim];
+        std::lock_guard<std::mutex> lock(other.mtx);
+        if (taken(other.jobs, false)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::RunPendingJob()
+{
+    Job job;
+    if (!TakeJob(g_workerIndex, job)) {
+        return false;
+    }
+    job();
+    return true;
+}
+
+void ThreadPool::WorkerLoop(size_t index)
+{
+    g_workerIndex = index;
+    while (true) {
+        Job job;
+        if (TakeJob(index, job)) {
+            job();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMtx);
+        wakeUp.wait(lock, [this] { return stopping || pendingJobs.load(std::memory_order_acquire) > 0; });
+        if (stopping) {
+            return;
+        }
+    }
+}
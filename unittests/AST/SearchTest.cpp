@@ -4,6 +4,7 @@
 //
 // See https://cangjie-lang.cn/pages/LICENSE for license information.
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <vector>
@@ -334,40 +335,40 @@ TEST_F(SearchTest, ScopeName)
     EXPECT_EQ(ScopeManagerApi::GetChildScopeName("a_a"), "a0a");
 }
 
-TEST_F(SearchTest, PrefixTrie)
+TEST_F(SearchTest, PrefixIndex)
 {
-    Trie prefixTrie;
-    prefixTrie.Insert("a0b");
-    prefixTrie.Insert("a0b0c0e");
-    prefixTrie.Insert("a0b");
-    prefixTrie.Insert("a0c");
-    prefixTrie.Insert("a0b0d");
-    prefixTrie.Insert("a0d");
-    auto results = prefixTrie.PrefixMatch("a0b");
+    StringIndex prefixIndex;
+    prefixIndex.Insert("a0b");
+    prefixIndex.Insert("a0b0c0e");
+    prefixIndex.Insert("a0b");
+    prefixIndex.Insert("a0c");
+    prefixIndex.Insert("a0b0d");
+    prefixIndex.Insert("a0d");
+    auto results = prefixIndex.PrefixMatch("a0b");
     std::vector<std::string> expectStrings = {"a0b", "a0b0c0e", "a0b0d"};
     EXPECT_TRUE(std::equal(results.begin(), results.end(), expectStrings.begin()));
 
-    prefixTrie.Reset();
-    prefixTrie.Insert("a0b0c");
-    prefixTrie.Insert("a0c");
-    prefixTrie.Insert("a0b0d");
-    prefixTrie.Insert("a0d");
-    results = prefixTrie.PrefixMatch("a0b");
+    prefixIndex.Reset();
+    prefixIndex.Insert("a0b0c");
+    prefixIndex.Insert("a0c");
+    prefixIndex.Insert("a0b0d");
+    prefixIndex.Insert("a0d");
+    results = prefixIndex.PrefixMatch("a0b");
     expectStrings = {"a0b0c", "a0b0d"};
     EXPECT_TRUE(std::equal(results.begin(), results.end(), expectStrings.begin()));
 }
 
-TEST_F(SearchTest, SuffixTrie)
+TEST_F(SearchTest, SuffixIndex)
 {
-    Trie suffixTrie;
-    suffixTrie.Insert("var_decl");
-    suffixTrie.Insert("ref_type");
-    suffixTrie.Insert("member_access");
-    suffixTrie.Insert("func_decl");
-    suffixTrie.Insert("ref_expr");
-    suffixTrie.Insert("record_decl");
-    suffixTrie.Insert("class_decl");
-    auto results = suffixTrie.SuffixMatch("decl");
+    StringIndex suffixIndex;
+    suffixIndex.Insert("var_decl");
+    suffixIndex.Insert("ref_type");
+    suffixIndex.Insert("member_access");
+    suffixIndex.Insert("func_decl");
+    suffixIndex.Insert("ref_expr");
+    suffixIndex.Insert("record_decl");
+    suffixIndex.Insert("class_decl");
+    auto results = suffixIndex.SuffixMatch("decl");
     std::vector<std::string> expectStrings = {"class_decl", "func_decl", "record_decl", "var_decl"};
     EXPECT_TRUE(std::equal(results.begin(), results.end(), expectStrings.begin()));
 }
@@ -433,32 +434,34 @@ TEST_F(SearchTest, RangeQuery)
     std::string posStr = PosSearchApi::PosToStr(pos);
     EXPECT_EQ(posStr, "00000000600016");
 
-    // Test FindCommonRootInPosTrie of PosSearchApi.
+    // Test GetIDsBeginAfter of PosIndex.
     std::set<Symbol*> ids;
-    TrieNode* root = PosSearchApi::FindCommonRootInPosTrie(*ctx.invertedIndex.posBeginTrie, pos);
-    EXPECT_EQ(root->value, "00000000600016");
-    const int expectDepth = 14;
-    EXPECT_EQ(root->depth, expectDepth);
-
-    // Test GetIDsGreaterTheanPos of PosSearchApi.
-    ids = PosSearchApi::GetIDsGreaterThanPos(*ctx.invertedIndex.posBeginTrie, pos);
+    auto& posIndex = ctx.invertedIndex.posIndex;
+    ids = posIndex.GetIDsBeginAfter(pos);
     for (auto i : ids) {
         EXPECT_TRUE(pos <= i->node->begin);
     }
 
-    // Test GetIDsLessThanPos of PosSearchApi.
-    ids = PosSearchApi::GetIDsLessThanPos(*ctx.invertedIndex.posBeginTrie, pos);
+    // Test GetIDsBeginBefore of PosIndex.
+    ids = posIndex.GetIDsBeginBefore(pos);
     for (auto i : ids) {
         EXPECT_TRUE(i->node->begin <= pos);
     }
 
-    // Test GetIDsWithinPosXByRange of PosSearchApi.
+    // Test GetIDsContaining of PosIndex.
+    ids = posIndex.GetIDsContaining(pos);
+    EXPECT_FALSE(ids.empty());
+    for (auto i : ids) {
+        EXPECT_TRUE(i->node->begin <= pos && pos <= i->node->end);
+    }
+
+    // Test GetIDsBeginWithin of PosIndex.
     Position startPos = Position{0, 6, 1};
     Position endPos = Position{0, 6, 16};
-    ids = PosSearchApi::GetIDsWithinPosXByRange(*ctx.invertedIndex.posBeginTrie, startPos, endPos);
+    ids = posIndex.GetIDsBeginWithin(startPos, endPos);
     auto expectSize = 1;
     EXPECT_EQ(ids.size(), expectSize);
-    ids = PosSearchApi::GetIDsWithinPosXByRange(*ctx.invertedIndex.posBeginTrie, startPos, endPos, true, true);
+    ids = posIndex.GetIDsBeginWithin(startPos, endPos, true, true);
     auto expectSize2 = 3;
     EXPECT_EQ(ids.size(), expectSize2);
 
@@ -474,6 +477,53 @@ TEST_F(SearchTest, RangeQuery)
     pkg.reset();
 }
 
+TEST_F(SearchTest, LargeQuery)
+{
+    // Each function takes 4 lines, the let declaration is at line 4 * i + 2.
+    const int funcNum = 2000;
+    std::string largeCode;
+    for (int i = 0; i < funcNum; ++i) {
+        auto idx = std::to_string(i);
+        largeCode += "func f" + idx + "(a: Int64): Int64 {\n    let b = a + " + idx + "\n    return b\n}\n";
+    }
+    diag.SetSourceManager(&sm);
+    Parser parser(largeCode, diag, sm);
+    OwnedPtr<Package> pkg = MakeOwned<Package>();
+    pkg->files.emplace_back(parser.ParseTopLevel());
+    ASTContext ctx(diag, *pkg);
+    ScopeManager scopeManager;
+    Collector collector(scopeManager);
+    collector.BuildSymbolTable(ctx, pkg.get());
+    Searcher searcher;
+
+    auto start = std::chrono::steady_clock::now();
+    const int step = 97;
+    for (int i = 0; i < funcNum; i += step) {
+        Position pos{0, 4 * i + 2, 13};
+        auto res = searcher.Search(ctx,
+            "_ = (0, " + std::to_string(pos.line) + ", " + std::to_string(pos.column) + ")");
+        std::set<Symbol*> expected;
+        for (auto& sym : ctx.symbolTable) {
+            if (sym->node->begin.fileID == 0 && sym->node->begin <= pos && pos <= sym->node->end) {
+                expected.emplace(sym.get());
+            }
+        }
+        EXPECT_EQ(std::set<Symbol*>(res.begin(), res.end()), expected);
+    }
+    auto res = searcher.Search(ctx, "name: f19*");
+    std::set<Symbol*> expected;
+    for (auto& sym : ctx.symbolTable) {
+        if (sym->name.compare(0, std::string("f19").size(), "f19") == 0) {
+            expected.emplace(sym.get());
+        }
+    }
+    EXPECT_EQ(std::set<Symbol*>(res.begin(), res.end()), expected);
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    RecordProperty("SearchMicroseconds", static_cast<int>(elapsed.count()));
+    // Need to release AST before ASTContext.
+    pkg.reset();
+}
+
 TEST_F(SearchTest, DISABLED_SelectedhighlightTest000)
 {
     srcPath = FileUtil::JoinPath(srcPath, "SimpleSearchTest");
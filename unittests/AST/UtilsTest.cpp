@@ -0,0 +1,54 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#include <map>
+#include <string>
+#include "gtest/gtest.h"
+#include "cangjie/AST/ASTCasting.h"
+#include "cangjie/AST/Clone.h"
+#include "cangjie/AST/Utils.h"
+#include "cangjie/Basic/DiagnosticEngine.h"
+#include "cangjie/Parse/Parser.h"
+
+using namespace Cangjie;
+using namespace AST;
+
+TEST(UtilsTest, ReusableInstantiatedFunc)
+{
+    std::string code = R"(
+        public func id<T>(a: T) { a }
+        private func hidden<T>(a: T) { a }
+        public func withDefault<T>(a: T, b!: Int64 = 1) { a }
+        public const func constId<T>(a: T) { a }
+    )";
+    DiagnosticEngine diag;
+    SourceManager sm;
+    Parser parser(code, diag, sm);
+    auto file = parser.ParseTopLevel();
+    // Only the instantiations of public functions without default parameters are shared between packages.
+    std::map<std::string, bool> expected = {
+        {"id", true}, {"hidden", false}, {"withDefault", false}, {"constId", false}};
+    ASSERT_EQ(file->decls.size(), expected.size());
+    for (auto& decl : file->decls) {
+        auto fd = DynamicCast<FuncDecl*>(decl.get());
+        ASSERT_TRUE(fd != nullptr);
+        auto& name = fd->identifier.Val();
+        // The instantiation is a clone of the generic function with the generic types substituted.
+        auto instantiated = ASTCloner::Clone(Ptr(fd));
+        instantiated->genericDecl = fd;
+        instantiated->DisableAttr(Attribute::GENERIC);
+        instantiated->EnableAttr(Attribute::GENERIC_INSTANTIATED);
+        EXPECT_EQ(IsReusableInstantiatedFunc(*instantiated), expected.at(name)) << name;
+        EXPECT_FALSE(IsReusableInstantiatedFunc(*fd)) << name;
+        // An instantiation made by another package than the one of the generic function is never shared.
+        instantiated->fullPackageName = fd->fullPackageName + ".user";
+        EXPECT_FALSE(IsReusableInstantiatedFunc(*instantiated)) << name;
+        instantiated->fullPackageName = fd->fullPackageName;
+        // A partial instantiation is never shared.
+        instantiated->EnableAttr(Attribute::GENERIC);
+        EXPECT_FALSE(IsReusableInstantiatedFunc(*instantiated)) << name;
+    }
+}
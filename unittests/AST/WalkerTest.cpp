@@ -4,12 +4,14 @@
 //
 // See https://cangjie-lang.cn/pages/LICENSE for license information.
 
+#include <thread>
 #include <vector>
 #include "gtest/gtest.h"
 
 #define private public
 #include "cangjie/AST/Match.h"
 #include "cangjie/AST/PrintNode.h"
+#include "cangjie/AST/StaticWalker.h"
 #include "cangjie/AST/Walker.h"
 #include "cangjie/Parse/Parser.h"
 
@@ -163,3 +165,79 @@ TEST_F(WalkerTest, GetCallExprs)
         EXPECT_EQ(expectedCallExprNames[i], callExprNames[i]);
     }
 }
+
+TEST_F(WalkerTest, StaticWalkSameOrder)
+{
+    std::vector<Ptr<Node>> expected;
+    Walker(
+        file.get(),
+        [&expected](Ptr<Node> node) {
+            expected.push_back(node);
+            return node->astKind == ASTKind::CALL_EXPR ? VisitAction::SKIP_CHILDREN : VisitAction::WALK_CHILDREN;
+        },
+        [&expected](Ptr<Node> node) {
+            expected.push_back(node);
+            return VisitAction::KEEP_DECISION;
+        })
+        .Walk();
+
+    std::vector<Ptr<Node>> visited;
+    StaticWalk(
+        file.get(),
+        [&visited](Ptr<Node> node) {
+            visited.push_back(node);
+            return node->astKind == ASTKind::CALL_EXPR ? VisitAction::SKIP_CHILDREN : VisitAction::WALK_CHILDREN;
+        },
+        [&visited](Ptr<Node> node) {
+            visited.push_back(node);
+            return VisitAction::KEEP_DECISION;
+        });
+    EXPECT_EQ(expected, visited);
+}
+
+TEST_F(WalkerTest, StaticWalkStopNow)
+{
+    Ptr<Node> found = nullptr;
+    auto action = StaticWalk(file.get(), [&found](Ptr<Node> node) {
+        if (node->astKind == ASTKind::VAR_DECL) {
+            found = node;
+            return VisitAction::STOP_NOW;
+        }
+        return VisitAction::WALK_CHILDREN;
+    });
+    EXPECT_EQ(VisitAction::STOP_NOW, action);
+    ASSERT_TRUE(found != nullptr);
+    EXPECT_EQ("a", StaticAs<ASTKind::VAR_DECL>(found)->identifier);
+}
+
+TEST_F(WalkerTest, StaticWalkVisitedSetInParallel)
+{
+    size_t expected = 0;
+    Walker(file.get(), [&expected](Ptr<Node>) {
+        ++expected;
+        return VisitAction::WALK_CHILDREN;
+    }).Walk();
+
+    // the walks with their own visited sets don't write the nodes, so they can share the AST
+    constexpr size_t threadNum = 4;
+    std::vector<size_t> counts(threadNum, 0);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threadNum; ++i) {
+        threads.emplace_back([this, &counts, i]() {
+            std::unordered_set<const Node*> visited;
+            StaticConstWalk(
+                file.get(),
+                [&counts, i](Ptr<const Node>) {
+                    ++counts[i];
+                    return VisitAction::WALK_CHILDREN;
+                },
+                nullptr, VisitedSet(visited));
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (auto count : counts) {
+        EXPECT_EQ(expected, count);
+    }
+}
@@ -12,6 +12,7 @@
 #include "cangjie/Parse/Parser.h"
 #include "cangjie/Utils/CheckUtils.h"
 
+#include "DiagSuppressor.h"
 #include "gtest/gtest.h"
 
 #include <cstdlib>
@@ -267,6 +268,46 @@ main(){
     EXPECT_EQ(diag.GetErrorCount(), 0);
 }
 
+TEST(EngineTest, NestedSuppression)
+{
+    DiagnosticEngine diag;
+    auto handler = std::make_unique<LSPDiagnosticHandlerTest>(diag);
+    diag.RegisterHandler(std::move(handler));
+    auto pos = Position{0, 1, 1};
+    {
+        DiagSuppressor outer(diag);
+        diag.DiagnoseRefactor(DiagKindRefactor::parse_expected_name, pos, std::string{"a"}, std::string{"b"},
+            std::string{"c"});
+        EXPECT_EQ(diag.GetStoredDiagsCount(), 1);
+        {
+            DiagSuppressor inner(diag);
+            // the inner scope doesn't see the diagnoses of the outer one
+            EXPECT_EQ(diag.GetStoredDiagsCount(), 0);
+            EXPECT_FALSE(diag.HasStoredError());
+            diag.DiagnoseRefactor(DiagKindRefactor::parse_expected_name, pos, std::string{"d"}, std::string{"e"},
+                std::string{"f"});
+            diag.DiagnoseRefactor(DiagKindRefactor::parse_expected_name, pos, std::string{"g"}, std::string{"h"},
+                std::string{"i"});
+            EXPECT_EQ(diag.GetStoredDiagsCount(), 2);
+            EXPECT_TRUE(diag.HasStoredError());
+            EXPECT_EQ(diag.GetStoredDiags(1).size(), 1);
+        }
+        // the diagnoses of the inner scope are dropped, the ones of the outer scope are kept
+        EXPECT_EQ(diag.GetStoredDiagsCount(), 1);
+        {
+            DiagSuppressor inner(diag);
+            diag.DiagnoseRefactor(DiagKindRefactor::parse_expected_name, pos, std::string{"j"}, std::string{"k"},
+                std::string{"l"});
+            EXPECT_EQ(diag.ConsumeStoredDiags().size(), 1);
+            EXPECT_EQ(diag.GetStoredDiagsCount(), 0);
+        }
+        EXPECT_EQ(diag.ConsumeStoredDiags().size(), 1);
+        EXPECT_EQ(diag.GetErrorCount(), 0);
+    }
+    EXPECT_TRUE(diag.GetEnableDiagnose());
+    EXPECT_EQ(diag.GetStoredDiagsCount(), 0);
+}
+
 #ifdef __unix__
 TEST(EngineTest, ShowColorTest)
 {
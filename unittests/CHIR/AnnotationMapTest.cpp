@@ -0,0 +1,192 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#include <map>
+#include <string>
+#include <typeindex>
+
+#include "gtest/gtest.h"
+
+#include "cangjie/CHIR/Annotation.h"
+#include "cangjie/CHIR/GeneratedFromForIn.h"
+
+using namespace Cangjie;
+using namespace Cangjie::CHIR;
+
+namespace {
+// A rare annotation whose state can be changed through GetAnno.
+struct HitCount : public Annotation {
+    explicit HitCount() = default;
+    explicit HitCount(int n) : count(n)
+    {
+    }
+
+    static int Extract(const HitCount* input)
+    {
+        return input->count;
+    }
+
+    std::unique_ptr<Annotation> Clone() override
+    {
+        return std::make_unique<HitCount>(count);
+    }
+
+    std::string ToString() const override
+    {
+        return "hitCount: " + std::to_string(count);
+    }
+
+    int count{0};
+};
+
+std::map<std::type_index, std::string> CollectAnnotations(const AnnotationMap& annos)
+{
+    std::map<std::type_index, std::string> res;
+    annos.ForEachAnnotation(
+        [&res](const std::type_index& index, const Annotation& anno) { res.emplace(index, anno.ToString()); });
+    return res;
+}
+} // namespace
+
+TEST(AnnotationMapTest, InlineSlotsDefaultSetAndRemove)
+{
+    AnnotationMap annos;
+    // Unset annotations read as the value of their default constructed object.
+    EXPECT_TRUE(annos.Get<NeedCheckArrayBound>());
+    EXPECT_TRUE(annos.Get<NeedCheckCast>());
+    EXPECT_EQ(annos.Get<LinkTypeInfo>(), Linkage::EXTERNAL);
+    EXPECT_EQ(annos.Get<SkipCheck>(), SkipKind::NO_SKIP);
+    EXPECT_FALSE(annos.Get<NeverOverflowInfo>());
+    EXPECT_FALSE(annos.Get<IsAutoEnvClass>());
+    EXPECT_FALSE(annos.Get<IsCapturedClassInCC>());
+    EXPECT_FALSE(annos.Get<GeneratedFromForIn>());
+
+    annos.Set<NeedCheckArrayBound>(false);
+    annos.Set<NeedCheckCast>(false);
+    annos.Set<LinkTypeInfo>(Linkage::INTERNAL);
+    annos.Set<SkipCheck>(SkipKind::SKIP_VIC);
+    annos.Set<NeverOverflowInfo>(true);
+    annos.Set<IsAutoEnvClass>(true);
+    annos.Set<IsCapturedClassInCC>(true);
+    annos.Set<GeneratedFromForIn>(true);
+    EXPECT_FALSE(annos.Get<NeedCheckArrayBound>());
+    EXPECT_FALSE(annos.Get<NeedCheckCast>());
+    EXPECT_EQ(annos.Get<LinkTypeInfo>(), Linkage::INTERNAL);
+    EXPECT_EQ(annos.Get<SkipCheck>(), SkipKind::SKIP_VIC);
+    EXPECT_TRUE(annos.Get<NeverOverflowInfo>());
+    EXPECT_TRUE(annos.Get<IsAutoEnvClass>());
+    EXPECT_TRUE(annos.Get<IsCapturedClassInCC>());
+    EXPECT_TRUE(annos.Get<GeneratedFromForIn>());
+
+    // Setting again overwrites the slot, removing it restores the default without touching the other slots.
+    annos.Set<LinkTypeInfo>(Linkage::WEAK_ODR);
+    EXPECT_EQ(annos.Get<LinkTypeInfo>(), Linkage::WEAK_ODR);
+    annos.Remove<LinkTypeInfo>();
+    annos.Remove<NeedCheckArrayBound>();
+    EXPECT_EQ(annos.Get<LinkTypeInfo>(), Linkage::EXTERNAL);
+    EXPECT_TRUE(annos.Get<NeedCheckArrayBound>());
+    EXPECT_EQ(annos.Get<SkipCheck>(), SkipKind::SKIP_VIC);
+    EXPECT_TRUE(annos.Get<GeneratedFromForIn>());
+}
+
+TEST(AnnotationMapTest, OverflowSlotsSetGetAndRemove)
+{
+    AnnotationMap annos;
+    EXPECT_EQ(annos.Get<EnumCaseIndex>(), std::nullopt);
+    EXPECT_EQ(annos.Get<VirMethodOffset>(), std::nullopt);
+    EXPECT_EQ(annos.Get<HitCount>(), 0);
+
+    // Inserted out of type order on purpose, the overflow slots are kept sorted by type.
+    annos.Set<VirMethodOffset>(std::optional<size_t>(3));
+    annos.Set<HitCount>(7);
+    annos.Set<EnumCaseIndex>(std::optional<size_t>(1));
+    EXPECT_EQ(annos.Get<VirMethodOffset>(), 3U);
+    EXPECT_EQ(annos.Get<HitCount>(), 7);
+    EXPECT_EQ(annos.Get<EnumCaseIndex>(), 1U);
+
+    annos.Set<HitCount>(8);
+    EXPECT_EQ(annos.Get<HitCount>(), 8);
+    annos.Remove<VirMethodOffset>();
+    EXPECT_EQ(annos.Get<VirMethodOffset>(), std::nullopt);
+    EXPECT_EQ(annos.Get<EnumCaseIndex>(), 1U);
+    EXPECT_EQ(annos.Get<HitCount>(), 8);
+    // Removing an absent annotation is a no-op.
+    annos.Remove<VirMethodOffset>();
+    EXPECT_EQ(annos.Get<HitCount>(), 8);
+}
+
+TEST(AnnotationMapTest, ForEachAnnotationVisitsInlineAndOverflowSlots)
+{
+    AnnotationMap annos;
+    annos.SetDebugLocation(DebugLocation());
+    EXPECT_TRUE(CollectAnnotations(annos).empty());
+
+    annos.Set<SkipCheck>(SkipKind::SKIP_DCE_WARNING);
+    annos.Set<NeverOverflowInfo>(true);
+    annos.Set<EnumCaseIndex>(std::optional<size_t>(2));
+    annos.Set<HitCount>(4);
+    auto visited = CollectAnnotations(annos);
+    // The debug location is not an annotation, and unset inline slots are skipped.
+    ASSERT_EQ(visited.size(), 4U);
+    EXPECT_EQ(visited[std::type_index(typeid(SkipCheck))], "skip: dce warning");
+    EXPECT_EQ(visited[std::type_index(typeid(NeverOverflowInfo))], "NeverOverflowInfo: true");
+    EXPECT_EQ(visited[std::type_index(typeid(EnumCaseIndex))], "EnumCaseIndex: 2");
+    EXPECT_EQ(visited[std::type_index(typeid(HitCount))], "hitCount: 4");
+
+    annos.Remove<SkipCheck>();
+    annos.Remove<HitCount>();
+    visited = CollectAnnotations(annos);
+    EXPECT_EQ(visited.size(), 2U);
+    EXPECT_EQ(visited.count(std::type_index(typeid(SkipCheck))), 0U);
+    EXPECT_EQ(visited.count(std::type_index(typeid(HitCount))), 0U);
+}
+
+TEST(AnnotationMapTest, CopiesAreIndependent)
+{
+    AnnotationMap original;
+    original.Set<NeedCheckCast>(false);
+    original.Set<EnumCaseIndex>(std::optional<size_t>(5));
+
+    AnnotationMap copy = original;
+    copy.Set<NeedCheckCast>(true);
+    copy.Set<EnumCaseIndex>(std::optional<size_t>(6));
+    copy.Set<IsAutoEnvClass>(true);
+    EXPECT_FALSE(original.Get<NeedCheckCast>());
+    EXPECT_EQ(original.Get<EnumCaseIndex>(), 5U);
+    EXPECT_FALSE(original.Get<IsAutoEnvClass>());
+
+    copy.Remove<EnumCaseIndex>();
+    EXPECT_EQ(original.Get<EnumCaseIndex>(), 5U);
+}
+
+TEST(AnnotationMapTest, GetAnnoCopiesOnWriteAfterClone)
+{
+    AnnotationMap original;
+    original.Set<HitCount>(1);
+    AnnotationMap copy = original;
+
+    // Writing through the copy detaches it from the object it shares with the original.
+    copy.GetAnno<HitCount>().count = 2;
+    EXPECT_EQ(original.Get<HitCount>(), 1);
+    EXPECT_EQ(copy.Get<HitCount>(), 2);
+
+    // And writing through the original leaves the copy alone.
+    original.GetAnno<HitCount>().count = 3;
+    EXPECT_EQ(original.Get<HitCount>(), 3);
+    EXPECT_EQ(copy.Get<HitCount>(), 2);
+
+    // Once detached, a map writes its own object in place.
+    HitCount& anno = copy.GetAnno<HitCount>();
+    anno.count = 4;
+    EXPECT_EQ(&copy.GetAnno<HitCount>(), &anno);
+    EXPECT_EQ(copy.Get<HitCount>(), 4);
+
+    // GetAnno adds a default object when the annotation is absent.
+    AnnotationMap empty;
+    EXPECT_EQ(empty.GetAnno<HitCount>().count, 0);
+    empty.GetAnno<HitCount>().count = 9;
+    EXPECT_EQ(empty.Get<HitCount>(), 9);
+}
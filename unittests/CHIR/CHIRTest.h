@@ -0,0 +1,83 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+/**
+ * @file
+ *
+ * This file declares the fixture to build CHIR by hand in the CHIR optimization tests.
+ */
+
+#ifndef CANGJIE_CHIR_TEST_H
+#define CANGJIE_CHIR_TEST_H
+#include <gtest/gtest.h>
+
+#include "cangjie/Basic/DiagnosticEngine.h"
+#include "cangjie/CHIR/CHIRBuilder.h"
+#include "cangjie/CHIR/CHIRContext.h"
+#include "cangjie/CHIR/DiagAdapter.h"
+#include "cangjie/CHIR/Expression/Terminator.h"
+#include "cangjie/CHIR/Package.h"
+#include "cangjie/CHIR/Type/Type.h"
+#include "cangjie/CHIR/Utils.h"
+
+using namespace Cangjie::CHIR;
+
+class CHIRTestTemplate : public ::testing::Test {
+protected:
+    CHIRTestTemplate() : Test(), cctx(&fileNameMap), builder(cctx), diagAdapter(diag)
+    {
+        package = builder.CreatePackage(pkgName);
+        int64Ty = builder.GetInt64Ty();
+        boolTy = builder.GetBoolTy();
+        unitTy = builder.GetUnitTy();
+    }
+
+    /// Create a global function whose body only has an empty entry block.
+    Func* CreateFunc(const std::string& name, const std::vector<Type*>& paramTys, Type* retTy)
+    {
+        auto func = builder.CreateFunc(defaultLoc, builder.GetType<FuncType>(paramTys, retTy), name, name, "", pkgName);
+        auto body = builder.CreateBlockGroup(*func);
+        func->InitBody(*body);
+        body->SetEntryBlock(builder.CreateBlock(body));
+        for (auto ty : paramTys) {
+            builder.CreateParameter(ty, defaultLoc, *func);
+        }
+        return func;
+    }
+
+    template <typename TExpr, typename... Args> LocalVar* Append(Type* resultTy, Args&&... args)
+    {
+        return CreateAndAppendExpression<TExpr>(builder, defaultLoc, resultTy, std::forward<Args>(args)...)
+            ->GetResult();
+    }
+
+    template <typename TExpr, typename... Args> TExpr* Terminate(Args&&... args)
+    {
+        return CreateAndAppendTerminator<TExpr>(builder, defaultLoc, std::forward<Args>(args)...);
+    }
+
+    LocalVar* AppendInt(Type* ty, int64_t val, Block* block)
+    {
+        auto expr = builder.CreateConstantExpression<IntLiteral>(defaultLoc, ty, block, static_cast<uint64_t>(val));
+        block->AppendExpression(expr);
+        return expr->GetResult();
+    }
+
+    std::unordered_map<unsigned int, std::string> fileNameMap;
+    CHIRContext cctx;
+    CHIRBuilder builder;
+    Cangjie::DiagnosticEngine diag;
+    DiagAdapter diagAdapter;
+    Package* package;
+
+    Type* int64Ty;
+    Type* boolTy;
+    Type* unitTy;
+    const std::string pkgName{"test"};
+    const std::string testFile{"test.cj"};
+    DebugLocation defaultLoc{testFile, 1, {1, 1}, {1, 1}, {0}};
+};
+#endif // CANGJIE_CHIR_TEST_H
@@ -0,0 +1,138 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#include "CHIRTest.h"
+
+#include "cangjie/CHIR/Transformation/ClosureConversion.h"
+
+using Cangjie::GlobalOptions;
+using Cangjie::OverflowStrategy;
+using Cangjie::StaticCast;
+
+class ClosureConversionTest : public CHIRTestTemplate {
+protected:
+    void SetUp() override
+    {
+        auto objectDef = builder.CreateClass(defaultLoc, "Object", "_CN8std.core6ObjectE", "std.core", true, true);
+        builder.SetObjectTy(builder.GetType<ClassType>(objectDef));
+        opts.optimizationLevel = GlobalOptions::OptimizationLevel::O2;
+        // f(x: Int64): Unit { let l = { => x + 1 }; ... }
+        func = CreateFunc("_CN4test1fHl", {int64Ty}, unitTy);
+        entry = func->GetEntryBlock();
+        auto lambdaTy = builder.GetType<FuncType>(std::vector<Type*>{}, int64Ty);
+        lambda = CreateAndAppendExpression<Lambda>(
+            builder, defaultLoc, lambdaTy, lambdaTy, entry, true, "_CN4test1fHl$lambda0", "$lambda");
+        auto body = builder.CreateBlockGroup(*func);
+        lambda->InitBody(*body);
+        auto lambdaEntry = builder.CreateBlock(body);
+        body->SetEntryBlock(lambdaEntry);
+        auto ret = Append<Allocate>(builder.GetType<RefType>(int64Ty), int64Ty, lambdaEntry);
+        auto sum = Append<BinaryExpression>(int64Ty, ExprKind::ADD, func->GetParam(0),
+            AppendInt(int64Ty, 1, lambdaEntry), OverflowStrategy::WRAPPING, lambdaEntry);
+        Append<Store>(unitTy, sum, ret, lambdaEntry);
+        Terminate<Exit>(lambdaEntry);
+        lambda->SetReturnValue(*ret);
+    }
+
+    void Convert()
+    {
+        Terminate<Exit>(entry);
+        ClosureConversion(*package, builder, opts, srcCodeImportedFuncs).Convert();
+    }
+
+    /// The global function `lambda` is lifted to.
+    Func* GetLiftedFunc() const
+    {
+        for (auto f : package->GetGlobalFuncs()) {
+            if (f->GetIdentifierWithoutPrefix() == "_CN4test1fHl$lambda0") {
+                return f;
+            }
+        }
+        return nullptr;
+    }
+
+    size_t CountAutoEnvDefs() const
+    {
+        size_t res = 0;
+        for (auto def : package->GetClasses()) {
+            res += def->Get<IsAutoEnvClass>() ? 1 : 0;
+        }
+        return res;
+    }
+
+    /// Check `lifted` takes an auto-env object as its first parameter, as every closure converted lambda does.
+    void ExpectLiftedWithAutoEnv(const Func* lifted) const
+    {
+        ASSERT_NE(lifted, nullptr);
+        EXPECT_TRUE(lifted->IsLambda());
+        ASSERT_EQ(lifted->GetNumOfParams(), 1U);
+        auto envTy = lifted->GetParam(0)->GetType();
+        ASSERT_TRUE(envTy->IsRef());
+        EXPECT_TRUE(StaticCast<RefType*>(envTy)->GetBaseType()->IsAutoEnv());
+        EXPECT_NE(CountAutoEnvDefs(), 0U);
+    }
+
+    void CallLambdaDirectly()
+    {
+        Append<Apply>(int64Ty, lambda->GetResult(), FuncCallContext{}, entry);
+    }
+
+    GlobalOptions opts;
+    std::unordered_set<Func*> srcCodeImportedFuncs;
+    Func* func{nullptr};
+    Block* entry{nullptr};
+    Lambda* lambda{nullptr};
+};
+
+TEST_F(ClosureConversionTest, LiftNonEscapingLambdaWithoutAutoEnv)
+{
+    CallLambdaDirectly();
+    Convert();
+    auto lifted = GetLiftedFunc();
+    ASSERT_NE(lifted, nullptr);
+    // the captured `x` is passed as a parameter, so the lifted function is a plain function rather than a lambda
+    EXPECT_FALSE(lifted->IsLambda());
+    ASSERT_EQ(lifted->GetNumOfParams(), 1U);
+    EXPECT_EQ(lifted->GetParam(0)->GetType(), int64Ty);
+    EXPECT_EQ(CountAutoEnvDefs(), 0U);
+
+    std::vector<Apply*> calls;
+    for (auto expr : entry->GetExpressions()) {
+        if (expr->GetExprKind() == ExprKind::APPLY) {
+            calls.emplace_back(StaticCast<Apply*>(expr));
+        }
+    }
+    ASSERT_EQ(calls.size(), 1U);
+    EXPECT_EQ(calls[0]->GetCallee(), lifted);
+    EXPECT_EQ(calls[0]->GetArgs(), std::vector<Value*>{func->GetParam(0)});
+}
+
+TEST_F(ClosureConversionTest, KeepAutoEnvOfEscapingLambda)
+{
+    // g(h: () -> Int64): Unit
+    auto callee = CreateFunc("_CN4test1gHF0l", {lambda->GetFuncType()}, unitTy);
+    Terminate<Exit>(callee->GetEntryBlock());
+    Append<Apply>(unitTy, callee, FuncCallContext{.args = {lambda->GetResult()}}, entry);
+    Convert();
+    ExpectLiftedWithAutoEnv(GetLiftedFunc());
+}
+
+TEST_F(ClosureConversionTest, KeepAutoEnvInDebugMode)
+{
+    // the captured variables are shown by the env object in debugger
+    opts.enableCompileDebug = true;
+    CallLambdaDirectly();
+    Convert();
+    ExpectLiftedWithAutoEnv(GetLiftedFunc());
+}
+
+TEST_F(ClosureConversionTest, KeepAutoEnvBelowO2)
+{
+    opts.optimizationLevel = GlobalOptions::OptimizationLevel::O1;
+    CallLambdaDirectly();
+    Convert();
+    ExpectLiftedWithAutoEnv(GetLiftedFunc());
+}
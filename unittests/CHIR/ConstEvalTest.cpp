@@ -0,0 +1,332 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <set>
+
+#include "CHIRTest.h"
+
+#include "cangjie/Basic/SourceManager.h"
+#include "cangjie/CHIR/Interpreter/BCHIRInterpreter.h"
+#include "cangjie/CHIR/Interpreter/BCHIRLinker.h"
+#include "cangjie/CHIR/Interpreter/CHIR2BCHIR.h"
+#include "cangjie/CHIR/Interpreter/ConstEval.h"
+#include "cangjie/Frontend/CompilerInstance.h"
+
+using namespace Cangjie::CHIR::Interpreter;
+using Cangjie::CompilerInstance;
+using Cangjie::CompilerInvocation;
+using Cangjie::Diagnostic;
+using Cangjie::DiagnosticEngine;
+using Cangjie::DiagnosticHandler;
+using Cangjie::DiagHandlerKind;
+using Cangjie::GlobalOptions;
+using Cangjie::OverflowStrategy;
+using Cangjie::StaticCast;
+
+namespace {
+/// Records the diagnostics in the order they are reported.
+class RecordingDiagnosticHandler : public DiagnosticHandler {
+public:
+    RecordingDiagnosticHandler(DiagnosticEngine& diag, std::vector<std::string>& records)
+        : DiagnosticHandler(diag, DiagHandlerKind::HANDLER), records(records)
+    {
+    }
+    void HandleDiagnose(Diagnostic& d) override
+    {
+        auto record = std::to_string(d.start.line) + ": " + d.GetErrorMessage();
+        for (auto& note : d.subDiags) {
+            record += ", " + note.subDiagMessage;
+        }
+        records.emplace_back(record);
+    }
+
+private:
+    std::vector<std::string>& records;
+};
+} // namespace
+
+class ConstEvalTest : public CHIRTestTemplate {
+protected:
+    void SetUp() override
+    {
+        diag.SetSourceManager(&sm);
+        // the positions of the diagnostics are only reported for a file with some content
+        (void)sm.AddSource(testFile, "const");
+        diag.RegisterHandler(std::make_unique<RecordingDiagnosticHandler>(diag, diags));
+        CreateConstFuncs();
+    }
+
+    /// Start over with an empty package, for const evaluation replaces the initializers it evaluates.
+    void NewPackage()
+    {
+        package = builder.CreatePackage(pkgName);
+        globalVars.clear();
+        initFuncs.clear();
+        diags.clear();
+        CreateConstFuncs();
+    }
+
+    void CreateConstFuncs()
+    {
+        auto pkgInit = CreateFunc("_CN4test8pkg_initHv", {}, unitTy);
+        Terminate<Exit>(pkgInit->GetEntryBlock());
+        package->SetPackageInitFunc(pkgInit);
+
+        // const func add1(x: Int64): Int64 { x + 1 }
+        add1 = CreateConstFunc("_CN4test4add1Hl", {int64Ty}, [this](Func& f, Block* entry) {
+            return Append<BinaryExpression>(int64Ty, ExprKind::ADD, f.GetParam(0), AppendInt(int64Ty, 1, entry),
+                OverflowStrategy::WRAPPING, entry);
+        });
+        // const func applyTwice(g: (Int64) -> Int64, x: Int64): Int64 { g(g(x)) }
+        auto add1Ty = add1->GetType();
+        applyTwice = CreateConstFunc("_CN4test10applyTwiceHFlEl", {add1Ty, int64Ty}, [this](Func& f, Block* entry) {
+            auto once =
+                Append<Apply>(int64Ty, f.GetParam(0), FuncCallContext{.args = {f.GetParam(1)}}, entry);
+            return Append<Apply>(int64Ty, f.GetParam(0), FuncCallContext{.args = {once}}, entry);
+        });
+        // const func unused(): Int64 { 7 }, not called by any const initializer
+        unused = CreateConstFunc("_CN4test6unusedHv", {}, [this](Func&, Block* entry) {
+            return AppendInt(int64Ty, 7, entry);
+        });
+    }
+
+    /// Create a const function returning the value computed by `body`.
+    template <typename F> Func* CreateConstFunc(const std::string& name, const std::vector<Type*>& paramTys, F body)
+    {
+        auto func = CreateFunc(name, paramTys, int64Ty);
+        func->EnableAttr(Attribute::CONST);
+        auto entry = func->GetEntryBlock();
+        auto ret = Append<Allocate>(builder.GetType<RefType>(int64Ty), int64Ty, entry);
+        Append<Store>(unitTy, body(*func, entry), ret, entry);
+        Terminate<Exit>(entry);
+        func->SetReturnValue(*ret);
+        return func;
+    }
+
+    /// Add a const global var of type Int64, whose initializer stores the value computed by `init`.
+    template <typename F> GlobalVar* AddConstGlobalVar(const std::string& name, F init)
+    {
+        auto gv = builder.CreateGlobalVar(
+            defaultLoc, builder.GetType<RefType>(int64Ty), "_CN4test" + name + "E", name, "", pkgName);
+        gv->EnableAttr(Attribute::CONST);
+        auto initFunc = CreateFunc("_CN4test" + name + "iiHv", {}, unitTy);
+        initFunc->EnableAttr(Attribute::CONST);
+        initFunc->SetFuncKind(FuncKind::GLOBALVAR_INIT);
+        auto entry = initFunc->GetEntryBlock();
+        Append<Store>(unitTy, init(entry), gv, entry);
+        Terminate<Exit>(entry);
+        gv->SetInitFunc(*initFunc);
+        globalVars.emplace_back(gv);
+        initFuncs.emplace_back(initFunc);
+        return gv;
+    }
+
+    /// x<i> = add1(i) for each `i < n`, or `Int64.max + i` at line `i + 1` if `i` is in `overflowing`, which throws
+    /// an overflow exception for `i > 0`, plus y = x0 + 100, which depends on x0.
+    void AddIndependentInitializers(size_t n, const std::set<size_t>& overflowing = {})
+    {
+        GlobalVar* x0 = nullptr;
+        for (size_t i = 0; i < n; ++i) {
+            auto gv = AddConstGlobalVar("x" + std::to_string(i), [this, i, &overflowing](Block* entry) {
+                auto arg = AppendInt(int64Ty, static_cast<int64_t>(i), entry);
+                if (overflowing.count(i) == 0) {
+                    return AppendCall(add1, {arg}, entry);
+                }
+                DebugLocation loc{testFile, 1, {static_cast<unsigned>(i + 1), 1}, {static_cast<unsigned>(i + 1), 1},
+                    {0}};
+                return CreateAndAppendExpression<BinaryExpression>(builder, loc, int64Ty, ExprKind::ADD,
+                    AppendInt(int64Ty, std::numeric_limits<int64_t>::max(), entry), arg,
+                    OverflowStrategy::THROWING, entry)
+                    ->GetResult();
+            });
+            x0 = x0 ? x0 : gv;
+        }
+        AddConstGlobalVar("y", [this, x0](Block* entry) {
+            return Append<BinaryExpression>(int64Ty, ExprKind::ADD, Append<Load>(int64Ty, x0, entry),
+                AppendInt(int64Ty, 100, entry), OverflowStrategy::WRAPPING, entry);
+        });
+    }
+
+    /// Run `ConstEvalPass` on the package with `jobs` jobs, returning the values it replaced the initializers of
+    /// the const global vars with, by name.
+    std::map<std::string, int64_t> RunConstEvalPass(size_t jobs)
+    {
+        opts.jobs = jobs;
+        CompilerInvocation invocation;
+        DiagnosticEngine ciDiag;
+        CompilerInstance ci(invocation, ciDiag);
+        std::vector<Bchir> bchirPackages;
+        ConstEvalPass(ci, builder, sm, opts, diag).RunOnPackage(*package, initFuncs, bchirPackages);
+        std::map<std::string, int64_t> values;
+        for (auto gv : globalVars) {
+            if (auto init = gv->GetInitializer()) {
+                values.emplace(gv->GetSrcCodeIdentifier(),
+                    StaticCast<IntLiteral*>(init)->GetSignedVal());
+            }
+        }
+        return values;
+    }
+
+    LocalVar* AppendCall(Func* callee, const std::vector<Value*>& args, Block* block)
+    {
+        return Append<Apply>(int64Ty, callee, FuncCallContext{.args = args}, block);
+    }
+
+    /// Translate the package for const evaluation, link it and run the initializers as `ConstEvalPass` does.
+    /// Returns the values of the const global vars by name, or nothing if const evaluation failed.
+    std::optional<std::map<std::string, int64_t>> Evaluate(bool translateUnreachable)
+    {
+        std::vector<Bchir> packages(1);
+        CHIR2BCHIR::CompileToBCHIR<true>(
+            *package, packages[0], initFuncs, sm, opts, false, false, translateUnreachable);
+        translated = packages[0].GetFunctions().size();
+        skipped = packages[0].skippedConstEvalFuncs;
+        linked = Bchir();
+        BCHIRLinker linker(linked);
+        auto gVarInitIVals = linker.Run<true>(packages, opts);
+        auto fePlayground = linked.GetLinkedByteCode().Size();
+        auto interpPlayground = fePlayground + BCHIRInterpreter::EXTERNAL_PLAYGROUND_SIZE;
+        linked.Resize(fePlayground + BCHIRInterpreter::INTERNAL_PLAYGROUND_SIZE +
+            BCHIRInterpreter::EXTERNAL_PLAYGROUND_SIZE);
+        BCHIRInterpreter interpreter(linked, diag, {}, static_cast<unsigned>(fePlayground),
+            static_cast<unsigned>(interpPlayground), true);
+        interpreter.SetGlobalVars(std::move(gVarInitIVals));
+        if (!std::holds_alternative<INotRun>(interpreter.Run(0, false))) {
+            return std::nullopt;
+        }
+        std::map<std::string, int64_t> values;
+        for (auto gv : globalVars) {
+            auto id = linker.GetGVARId(gv->GetIdentifierWithoutPrefix());
+            EXPECT_NE(id, -1);
+            auto& val = interpreter.PeekValueOfGlobal(static_cast<Bchir::VarIdx>(id));
+            EXPECT_TRUE(std::holds_alternative<IInt64>(val));
+            if (std::holds_alternative<IInt64>(val)) {
+                values.emplace(gv->GetSrcCodeIdentifier(), std::get<IInt64>(val).content);
+            }
+        }
+        return values;
+    }
+
+    /// Whether the linker generated an abort function FRAME :: 0 :: ABORT standing for `mangledName`.
+    bool HasAbortFunctionFor(const std::string& mangledName) const
+    {
+        auto& code = linked.GetLinkedByteCode();
+        for (auto& [idx, name] : code.GetMangledNamesAnnotations()) {
+            if (name == mangledName && static_cast<OpCode>(code.Get(idx)) == OpCode::FRAME &&
+                static_cast<OpCode>(code.Get(idx + Bchir::FLAG_TWO)) == OpCode::ABORT) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    Cangjie::SourceManager sm;
+    std::vector<std::string> diags;
+    GlobalOptions opts;
+    std::vector<GlobalVar*> globalVars;
+    std::vector<FuncBase*> initFuncs;
+    Func* add1{nullptr};
+    Func* applyTwice{nullptr};
+    Func* unused{nullptr};
+
+    Bchir linked;
+    size_t translated{0};
+    std::unordered_set<std::string> skipped;
+};
+
+TEST_F(ConstEvalTest, LazyTranslationGivesSameValuesAsEager)
+{
+    // a = add1(41); b = applyTwice(add1, 40), where `add1` is only used as a value
+    AddConstGlobalVar("a", [this](Block* entry) { return AppendCall(add1, {AppendInt(int64Ty, 41, entry)}, entry); });
+    AddConstGlobalVar("b", [this](Block* entry) {
+        return AppendCall(applyTwice, {add1, AppendInt(int64Ty, 40, entry)}, entry);
+    });
+    auto eager = Evaluate(true);
+    auto eagerTranslated = translated;
+    EXPECT_TRUE(skipped.empty());
+    auto lazy = Evaluate(false);
+    ASSERT_TRUE(eager.has_value());
+    ASSERT_TRUE(lazy.has_value());
+    EXPECT_EQ(*lazy, *eager);
+    EXPECT_EQ(*lazy, (std::map<std::string, int64_t>{{"a", 42}, {"b", 42}}));
+    // only `unused` isn't translated
+    EXPECT_EQ(translated + 1, eagerTranslated);
+    EXPECT_EQ(skipped, std::unordered_set<std::string>{unused->GetIdentifierWithoutPrefix()});
+    EXPECT_EQ(linked.skippedConstEvalFuncs, skipped);
+}
+
+TEST_F(ConstEvalTest, CallToNonConstFunctionFailsBothWays)
+{
+    // c = runtimeOnly(), which isn't translated either way, so the call aborts in its abort function
+    auto runtimeOnly = CreateFunc("_CN4test11runtimeOnlyHv", {}, int64Ty);
+    auto entry = runtimeOnly->GetEntryBlock();
+    auto ret = Append<Allocate>(builder.GetType<RefType>(int64Ty), int64Ty, entry);
+    Append<Store>(unitTy, AppendInt(int64Ty, 1, entry), ret, entry);
+    Terminate<Exit>(entry);
+    runtimeOnly->SetReturnValue(*ret);
+    AddConstGlobalVar("c", [this, runtimeOnly](Block* entry) { return AppendCall(runtimeOnly, {}, entry); });
+    for (bool translateUnreachable : {true, false}) {
+        EXPECT_FALSE(Evaluate(translateUnreachable).has_value());
+        EXPECT_TRUE(HasAbortFunctionFor(runtimeOnly->GetIdentifierWithoutPrefix()));
+        // a function that can't be const evaluated isn't a missed one
+        EXPECT_EQ(linked.skippedConstEvalFuncs.count(runtimeOnly->GetIdentifierWithoutPrefix()), 0U);
+    }
+}
+
+TEST_F(ConstEvalTest, ParallelEvaluationMatchesSequential)
+{
+    constexpr size_t numInitializers = 20;
+    constexpr size_t jobs = 4;
+    AddIndependentInitializers(numInitializers);
+    // x0 and y are evaluated by the same worker
+    ASSERT_GT(SplitIndependentInitFuncs(*package, initFuncs, jobs).size(), 1U);
+    auto parallel = RunConstEvalPass(jobs);
+    auto parallelDiags = diags;
+
+    NewPackage();
+    AddIndependentInitializers(numInitializers);
+    ASSERT_EQ(SplitIndependentInitFuncs(*package, initFuncs, 1).size(), 1U);
+    auto sequential = RunConstEvalPass(1);
+    EXPECT_EQ(parallel, sequential);
+    EXPECT_EQ(parallelDiags, diags);
+    EXPECT_TRUE(diags.empty());
+    ASSERT_EQ(sequential.size(), numInitializers + 1);
+    for (size_t i = 0; i < numInitializers; ++i) {
+        EXPECT_EQ(sequential["x" + std::to_string(i)], static_cast<int64_t>(i + 1));
+    }
+    EXPECT_EQ(sequential["y"], 101);
+}
+
+TEST_F(ConstEvalTest, ParallelEvaluationFailureMatchesSequential)
+{
+    constexpr size_t numInitializers = 20;
+    constexpr size_t jobs = 2;
+    const std::set<size_t> overflowing{5, 18};
+    AddIndependentInitializers(numInitializers, overflowing);
+    // the failing initializers are evaluated by different workers
+    auto batches = SplitIndependentInitFuncs(*package, initFuncs, jobs);
+    ASSERT_EQ(batches.size(), jobs);
+    auto inFirstBatch = [this, &batches](size_t i) {
+        return std::find(batches[0].begin(), batches[0].end(), initFuncs[i]) != batches[0].end();
+    };
+    ASSERT_NE(inFirstBatch(5), inFirstBatch(18));
+    auto parallel = RunConstEvalPass(jobs);
+    auto parallelDiags = diags;
+
+    NewPackage();
+    AddIndependentInitializers(numInitializers, overflowing);
+    auto sequential = RunConstEvalPass(1);
+    // no initializer is replaced, and only the first failure is reported
+    EXPECT_TRUE(parallel.empty());
+    EXPECT_TRUE(sequential.empty());
+    ASSERT_EQ(diags.size(), 1U);
+    // at the line of x5
+    EXPECT_EQ(diags[0].substr(0, 2), "6:");
+    EXPECT_EQ(parallelDiags, diags);
+}
@@ -0,0 +1,180 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#include "CHIRTest.h"
+
+#include "cangjie/CHIR/Analysis/DevirtualizationInfo.h"
+#include "cangjie/CHIR/Transformation/Devirtualization.h"
+#include "cangjie/CHIR/Transformation/GenericSpecialization.h"
+#include "cangjie/CHIR/Type/ClassDef.h"
+
+using Cangjie::DynamicCast;
+using Cangjie::StaticCast;
+
+class DevirtualizationTest : public CHIRTestTemplate {
+protected:
+    ClassType* CreateClass(const std::string& name, ClassType* superClassTy, std::vector<Attribute> attrs)
+    {
+        auto classDef = builder.CreateClass(defaultLoc, name, name, pkgName, true, false);
+        auto classTy = builder.GetType<ClassType>(classDef);
+        classDef->SetType(*classTy);
+        for (auto attr : attrs) {
+            classDef->EnableAttr(attr);
+        }
+        if (superClassTy != nullptr) {
+            classDef->SetSuperClassTy(*superClassTy);
+        }
+        return classTy;
+    }
+
+    /// Create the method `area` of @p classTy overriding the one of @p parentTy, and put it in the vtable.
+    Func* CreateArea(ClassType* classTy, ClassType* parentTy)
+    {
+        auto thisTy = builder.GetType<RefType>(classTy);
+        auto method = CreateFunc(classTy->GetClassDef()->GetSrcCodeIdentifier() + ".area", {thisTy}, int64Ty);
+        Terminate<Exit>(method->GetEntryBlock());
+        auto typeInfo = VirtualFuncTypeInfo{.sigType = builder.GetType<FuncType>(std::vector<Type*>{}, unitTy),
+            .originalType = GetAreaType(parentTy), .parentType = parentTy, .returnType = int64Ty,
+            .methodGenericTypeParams = {}};
+        classTy->GetClassDef()->AddVtableItem(*parentTy, VirtualFuncInfo{"area", method, AttributeInfo{}, typeInfo});
+        return method;
+    }
+
+    FuncType* GetAreaType(ClassType* parentTy)
+    {
+        return builder.GetType<FuncType>(std::vector<Type*>{builder.GetType<RefType>(parentTy)}, int64Ty);
+    }
+
+    void RunDevirtualization(Func* func, const std::vector<Func*>& instFuncs = {})
+    {
+        Cangjie::GlobalOptions opts;
+        DevirtualizationInfo devirtInfo(package, opts);
+        devirtInfo.CollectInfo();
+        TypeValue::SetCHIRBuilder(&builder);
+        Devirtualization::TypeAnalysisWrapper typeAnalysis(builder);
+        typeAnalysis.RunOnPackage(package, false, 1, devirtInfo);
+        Devirtualization devirt(&typeAnalysis, devirtInfo);
+        devirt.AddInstFuncs(instFuncs);
+        devirt.RunOnFuncs({func}, builder, false);
+    }
+};
+
+TEST_F(DevirtualizationTest, SealedHierarchyGetsGuardedFastPaths)
+{
+    // sealed abstract class Shape { func area(): Int64 }
+    // class Circle <: Shape { func area() }
+    // class Square <: Shape { func area() }
+    auto shapeTy = CreateClass("Shape", nullptr, {Attribute::ABSTRACT, Attribute::SEALED});
+    auto circleTy = CreateClass("Circle", shapeTy, {});
+    auto squareTy = CreateClass("Square", shapeTy, {});
+    std::unordered_map<ClassType*, Func*> callees{
+        {circleTy, CreateArea(circleTy, shapeTy)}, {squareTy, CreateArea(squareTy, shapeTy)}};
+
+    // func f(shape: Shape) { shape.area() }
+    auto shapeRefTy = builder.GetType<RefType>(shapeTy);
+    auto func = CreateFunc("f", {shapeRefTy}, unitTy);
+    auto entry = func->GetEntryBlock();
+    auto invokeCtx = InvokeCallContext{.caller = func->GetParam(0),
+        .funcCallCtx = FuncCallContext{.args = {}, .instTypeArgs = {}, .thisType = shapeRefTy},
+        .virMethodCtx = VirMethodContext{
+            .srcCodeIdentifier = "area", .originalFuncType = GetAreaType(shapeTy), .genericTypeParams = {}}};
+    Append<Invoke>(int64Ty, invokeCtx, entry);
+    Terminate<Exit>(entry);
+
+    RunDevirtualization(func);
+
+    // every concrete class is tested once and dispatched to its own method
+    size_t guards = 0;
+    size_t invokes = 0;
+    for (auto block : func->GetBody()->GetBlocks()) {
+        auto exprs = block->GetExpressions();
+        for (auto expr : exprs) {
+            if (expr->GetExprKind() == ExprKind::INVOKE) {
+                ++invokes;
+            }
+            if (expr->GetExprKind() != ExprKind::INSTANCEOF) {
+                continue;
+            }
+            ++guards;
+            auto classTy = StaticCast<ClassType*>(StaticCast<InstanceOf*>(expr)->GetType());
+            ASSERT_EQ(callees.count(classTy), 1U);
+            auto branch = DynamicCast<Branch*>(block->GetTerminator());
+            ASSERT_NE(branch, nullptr);
+            auto fastPath = branch->GetTrueBlock()->GetExpressions();
+            auto apply = std::find_if(fastPath.begin(), fastPath.end(),
+                [](auto e) { return e->GetExprKind() == ExprKind::APPLY; });
+            ASSERT_NE(apply, fastPath.end());
+            EXPECT_EQ(StaticCast<Apply*>(*apply)->GetCallee(), callees.at(classTy));
+            callees.erase(classTy);
+        }
+    }
+    EXPECT_EQ(guards, 2U);
+    EXPECT_TRUE(callees.empty());
+    // the receivers of other classes still go through the virtual call
+    EXPECT_EQ(invokes, 1U);
+}
+
+TEST_F(DevirtualizationTest, ReuseInstantiationOfGenericSpecialization)
+{
+    // class C { func id<T>(x: T): T { x } }
+    auto classTy = CreateClass("C", nullptr, {});
+    auto thisTy = builder.GetType<RefType>(classTy);
+    auto genericTy = builder.GetType<GenericType>("T", "T");
+    auto idTy = builder.GetType<FuncType>(std::vector<Type*>{thisTy, genericTy}, genericTy);
+    auto id = builder.CreateFunc(defaultLoc, idTy, "_CN4test1C2idHl", "id", "", pkgName, {genericTy});
+    id->EnableAttr(Attribute::GENERIC);
+    auto idBody = builder.CreateBlockGroup(*id);
+    id->InitBody(*idBody);
+    auto idEntry = builder.CreateBlock(idBody);
+    idBody->SetEntryBlock(idEntry);
+    builder.CreateParameter(thisTy, defaultLoc, *id);
+    auto x = builder.CreateParameter(genericTy, defaultLoc, *id);
+    auto ret = Append<Allocate>(builder.GetType<RefType>(genericTy), genericTy, idEntry);
+    id->SetReturnValue(*ret);
+    Append<Store>(unitTy, x, ret, idEntry);
+    Terminate<Exit>(idEntry);
+    auto typeInfo = VirtualFuncTypeInfo{.sigType = builder.GetType<FuncType>(std::vector<Type*>{genericTy}, unitTy),
+        .originalType = idTy, .parentType = classTy, .returnType = genericTy,
+        .methodGenericTypeParams = {genericTy}};
+    classTy->GetClassDef()->AddVtableItem(*classTy, VirtualFuncInfo{"id", id, AttributeInfo{}, typeInfo});
+
+    // func f(c: C) { c.id<Int64>(1); c.id<Int64>(1); c.id<Int64>(1) }
+    // the first two calls are direct, and specialized as they are enough, the last one is virtual
+    auto func = CreateFunc("f", {thisTy}, unitTy);
+    auto entry = func->GetEntryBlock();
+    auto one = AppendInt(int64Ty, 1, entry);
+    auto callCtx = FuncCallContext{.args = {func->GetParam(0), one}, .instTypeArgs = {int64Ty}, .thisType = thisTy};
+    Append<Apply>(int64Ty, id, callCtx, entry);
+    Append<Apply>(int64Ty, id, callCtx, entry);
+    auto invokeCtx = InvokeCallContext{.caller = func->GetParam(0),
+        .funcCallCtx = FuncCallContext{.args = {one}, .instTypeArgs = {int64Ty}, .thisType = thisTy},
+        .virMethodCtx = VirMethodContext{.srcCodeIdentifier = "id", .originalFuncType = idTy,
+            .genericTypeParams = {genericTy}}};
+    Append<Invoke>(int64Ty, invokeCtx, entry);
+    Terminate<Exit>(entry);
+
+    GenericSpecialization specialization(builder, false);
+    specialization.RunOnPackage(*package);
+    ASSERT_EQ(specialization.GetSpecializedFuncs().size(), 1U);
+    auto instFunc = specialization.GetSpecializedFuncs().front();
+    RunDevirtualization(func, specialization.GetSpecializedFuncs());
+
+    // the devirtualized call reuses the copy instead of creating another function with the same identifier
+    size_t applies = 0;
+    for (auto expr : entry->GetExpressions()) {
+        EXPECT_NE(expr->GetExprKind(), ExprKind::INVOKE);
+        if (expr->GetExprKind() == ExprKind::APPLY) {
+            ++applies;
+            EXPECT_EQ(StaticCast<Apply*>(expr)->GetCallee(), instFunc);
+        }
+    }
+    EXPECT_EQ(applies, 3U);
+    size_t sameIdentifiers = 0;
+    for (auto f : package->GetGlobalFuncs()) {
+        sameIdentifiers += f->GetIdentifier() == instFunc->GetIdentifier() ? 1 : 0;
+    }
+    EXPECT_EQ(sameIdentifiers, 1U);
+}
@@ -0,0 +1,332 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#include <fstream>
+#include <map>
+#include <optional>
+
+#include "CHIRTest.h"
+
+#include "cangjie/CHIR/Transformation/FunctionInline.h"
+#include "cangjie/Utils/FileUtil.h"
+
+using namespace Cangjie;
+
+namespace {
+/// A minimal parser of the flat JSON objects in the remarks file, values are kept as their text.
+class RemarkParser {
+public:
+    explicit RemarkParser(const std::string& text) : text(text)
+    {
+    }
+
+    std::optional<std::map<std::string, std::string>> ParseObject()
+    {
+        std::map<std::string, std::string> res;
+        if (!Consume('{')) {
+            return std::nullopt;
+        }
+        do {
+            auto key = ParseString();
+            if (!key || !Consume(':')) {
+                return std::nullopt;
+            }
+            auto value = pos < text.size() && text[pos] == '"' ? ParseString() : ParseLiteral();
+            if (!value) {
+                return std::nullopt;
+            }
+            res.emplace(*key, *value);
+        } while (Consume(','));
+        if (!Consume('}') || pos != text.size()) {
+            return std::nullopt;
+        }
+        return res;
+    }
+
+private:
+    bool Consume(char c)
+    {
+        if (pos < text.size() && text[pos] == c) {
+            ++pos;
+            return true;
+        }
+        return false;
+    }
+
+    std::optional<std::string> ParseString()
+    {
+        if (!Consume('"')) {
+            return std::nullopt;
+        }
+        std::string res;
+        while (pos < text.size() && text[pos] != '"') {
+            auto c = static_cast<unsigned char>(text[pos++]);
+            if (c < 0x20) {
+                return std::nullopt; // control characters must be escaped
+            }
+            if (c != '\\') {
+                res += static_cast<char>(c);
+                continue;
+            }
+            if (pos == text.size()) {
+                return std::nullopt;
+            }
+            auto escaped = text[pos++];
+            if (escaped == '"' || escaped == '\\' || escaped == '/') {
+                res += escaped;
+            } else if (escaped == 'u' && pos + 4 <= text.size()) {
+                res += static_cast<char>(std::stoul(text.substr(pos, 4), nullptr, 16));
+                pos += 4;
+            } else {
+                return std::nullopt;
+            }
+        }
+        if (!Consume('"')) {
+            return std::nullopt;
+        }
+        return res;
+    }
+
+    std::optional<std::string> ParseLiteral()
+    {
+        auto begin = pos;
+        while (pos < text.size() && (std::isalnum(static_cast<unsigned char>(text[pos])) || text[pos] == '-')) {
+            ++pos;
+        }
+        if (pos == begin) {
+            return std::nullopt;
+        }
+        return text.substr(begin, pos - begin);
+    }
+
+    const std::string& text;
+    size_t pos{0};
+};
+} // namespace
+
+class FunctionInlineTest : public CHIRTestTemplate {
+protected:
+    /// Create a function whose size, as counted by the pass, is @p size.
+    Func* CreateCallee(const std::string& name, size_t size)
+    {
+        auto callee = CreateFunc(name, {}, unitTy);
+        for (size_t i = 1; i < size; ++i) {
+            AppendInt(int64Ty, static_cast<int64_t>(i), callee->GetEntryBlock());
+        }
+        Terminate<Exit>(callee->GetEntryBlock());
+        return callee;
+    }
+
+    /**
+     * Create a function calling @p callee in @p depth nested loops and return the call.
+     * entry: goto h0
+     * hi: branch(c, h(i+1), h(i-1)), the outermost header leaves to exit, the innermost one enters body
+     * body: call; goto h(depth-1)
+     */
+    Apply* CreateCallInLoops(const std::string& name, Func* callee, size_t depth)
+    {
+        auto caller = CreateFunc(name, {boolTy}, unitTy);
+        auto entry = caller->GetEntryBlock();
+        auto body = builder.CreateBlock(caller->GetBody());
+        auto apply = StaticCast<Apply*>(Append<Apply>(unitTy, callee, FuncCallContext{}, body)->GetExpr());
+        if (depth == 0) {
+            Terminate<GoTo>(body, entry);
+            Terminate<Exit>(body);
+            return apply;
+        }
+        std::vector<Block*> headers;
+        for (size_t i = 0; i < depth; ++i) {
+            headers.emplace_back(builder.CreateBlock(caller->GetBody()));
+        }
+        auto exit = builder.CreateBlock(caller->GetBody());
+        Terminate<Exit>(exit);
+        Terminate<GoTo>(headers[0], entry);
+        for (size_t i = 0; i < depth; ++i) {
+            auto next = i + 1 < depth ? headers[i + 1] : body;
+            auto leave = i == 0 ? exit : headers[i - 1];
+            Terminate<Branch>(caller->GetParam(0), next, leave, headers[i]);
+        }
+        Terminate<GoTo>(headers.back(), body);
+        return apply;
+    }
+
+    /// Create @p callerNum functions, each calling @p callee @p callsPerCaller times in its entry block.
+    std::vector<Func*> CreateCallers(Func* callee, size_t callerNum, size_t callsPerCaller)
+    {
+        std::vector<Func*> callers;
+        for (size_t i = 0; i < callerNum; ++i) {
+            auto caller = CreateFunc("caller" + std::to_string(i), {}, unitTy);
+            for (size_t j = 0; j < callsPerCaller; ++j) {
+                Append<Apply>(unitTy, callee, FuncCallContext{}, caller->GetEntryBlock());
+            }
+            Terminate<Exit>(caller->GetEntryBlock());
+            callers.emplace_back(caller);
+        }
+        return callers;
+    }
+
+    /// Run @p pass on @p callers and parse the remarks it records.
+    std::vector<std::map<std::string, std::string>> RunWithRemarks(FunctionInline& pass,
+        const std::vector<Func*>& callers)
+    {
+        pass.EnableRemarks();
+        for (auto caller : callers) {
+            pass.Run(*caller);
+        }
+        auto path = ::testing::TempDir() + "inline_remarks.json";
+        EXPECT_TRUE(pass.WriteRemarks(path));
+        std::vector<std::map<std::string, std::string>> res;
+        std::ifstream file(path);
+        std::string line;
+        while (std::getline(file, line)) {
+            auto remark = RemarkParser(line).ParseObject();
+            EXPECT_TRUE(remark.has_value()) << line;
+            if (remark.has_value()) {
+                res.emplace_back(std::move(*remark));
+            }
+        }
+        (void)std::remove(path.c_str());
+        return res;
+    }
+
+    /// Write @p content as a text profile and load it.
+    std::unique_ptr<PGOProfileInfo> LoadProfile(const std::string& content)
+    {
+        auto path = ::testing::TempDir() + "inline_profile.proftext";
+        EXPECT_TRUE(FileUtil::WriteToFile(path, content));
+        auto res = PGOProfileInfo::Load(path);
+        (void)std::remove(path.c_str());
+        return res;
+    }
+
+    GlobalOptions::OptimizationLevel optLevel{GlobalOptions::OptimizationLevel::O2};
+};
+
+TEST_F(FunctionInlineTest, RemarksAreValidJson)
+{
+    const std::string calleeName = "callee\"\\\n\t\x01";
+    auto callee = CreateFunc(calleeName, {}, unitTy);
+    Terminate<Exit>(callee->GetEntryBlock());
+    auto caller = CreateFunc("caller", {}, unitTy);
+    Append<Apply>(unitTy, callee, FuncCallContext{}, caller->GetEntryBlock());
+    Terminate<Exit>(caller->GetEntryBlock());
+
+    FunctionInline pass(builder, optLevel, false);
+    pass.EnableRemarks();
+    pass.Run(*caller);
+    auto path = ::testing::TempDir() + "inline_remarks.json";
+    ASSERT_TRUE(pass.WriteRemarks(path));
+
+    std::ifstream file(path);
+    std::string line;
+    size_t lineNum = 0;
+    while (std::getline(file, line)) {
+        ++lineNum;
+        auto remark = RemarkParser(line).ParseObject();
+        ASSERT_TRUE(remark.has_value()) << line;
+        EXPECT_EQ((*remark)["caller"], "caller");
+        EXPECT_EQ((*remark)["callee"], calleeName);
+        EXPECT_EQ((*remark)["file"], testFile);
+        EXPECT_EQ((*remark)["inlined"], "true");
+    }
+    EXPECT_EQ(lineNum, 1U);
+    (void)std::remove(path.c_str());
+}
+
+TEST_F(FunctionInlineTest, LoopDepthRaisesThreshold)
+{
+    // Every callee is called once, which raises the initial threshold 20 by 20%. A call in a loop gets the same
+    // threshold, each further level of nesting adds another 20%, up to 3 levels.
+    const std::vector<std::pair<size_t, size_t>> depthToThreshold = {{0, 24}, {1, 24}, {2, 28}, {3, 32}, {5, 32}};
+    std::vector<Func*> callers;
+    for (auto [depth, _] : depthToThreshold) {
+        auto callee = CreateCallee("callee" + std::to_string(depth), 28);
+        callers.emplace_back(CreateCallInLoops("caller" + std::to_string(depth), callee, depth)->GetTopLevelFunc());
+    }
+    FunctionInline pass(builder, optLevel, false);
+    auto remarks = RunWithRemarks(pass, callers);
+    ASSERT_EQ(remarks.size(), depthToThreshold.size());
+    for (size_t i = 0; i < remarks.size(); ++i) {
+        auto [depth, threshold] = depthToThreshold[i];
+        EXPECT_EQ(remarks[i]["loopDepth"], std::to_string(depth));
+        EXPECT_EQ(remarks[i]["size"], "28");
+        EXPECT_EQ(remarks[i]["threshold"], std::to_string(threshold));
+        EXPECT_EQ(remarks[i]["inlined"], threshold >= 28 ? "true" : "false");
+    }
+}
+
+TEST_F(FunctionInlineTest, LoopDepthIgnoredWhenOptimizingForSize)
+{
+    auto callee = CreateCallee("callee", 28);
+    auto caller = CreateCallInLoops("caller", callee, 3)->GetTopLevelFunc();
+    FunctionInline pass(builder, GlobalOptions::OptimizationLevel::Os, false);
+    auto remarks = RunWithRemarks(pass, {caller});
+    ASSERT_EQ(remarks.size(), 1U);
+    EXPECT_EQ(remarks[0]["threshold"], "24");
+    EXPECT_EQ(remarks[0]["inlined"], "false");
+}
+
+TEST_F(FunctionInlineTest, ProfileHotnessAdjustsThreshold)
+{
+    // Both the caller and the callee must be hot for a hot call site, a never executed caller makes it cold.
+    auto profile = LoadProfile("hotCaller\n1\n1\n1000\n\nhotCallee\n2\n1\n1000\n\n"
+                               "warmCaller\n3\n1\n1\n\ncoldCaller\n4\n1\n0\n");
+    ASSERT_NE(profile, nullptr);
+    auto hotCallee = CreateCallee("hotCallee", 40);
+    auto hotCaller = CreateCallInLoops("hotCaller", hotCallee, 0)->GetTopLevelFunc();
+    auto warmCallee = CreateCallee("warmCallee", 24);
+    auto warmCaller = CreateCallInLoops("warmCaller", warmCallee, 0)->GetTopLevelFunc();
+    // the cold threshold takes precedence over the loop bonus
+    auto coldCallee = CreateCallee("coldCallee", 6);
+    auto coldCaller = CreateCallInLoops("coldCaller", coldCallee, 2)->GetTopLevelFunc();
+
+    FunctionInline pass(builder, optLevel, false);
+    pass.SetProfile(profile.get());
+    auto remarks = RunWithRemarks(pass, {hotCaller, warmCaller, coldCaller});
+    ASSERT_EQ(remarks.size(), 3U);
+    EXPECT_EQ(remarks[0]["hotness"], "hot");
+    EXPECT_EQ(remarks[0]["threshold"], "48");
+    EXPECT_EQ(remarks[0]["inlined"], "true");
+    EXPECT_EQ(remarks[1]["hotness"], "normal");
+    EXPECT_EQ(remarks[1]["threshold"], "24");
+    EXPECT_EQ(remarks[1]["inlined"], "true");
+    EXPECT_EQ(remarks[2]["hotness"], "cold");
+    EXPECT_EQ(remarks[2]["threshold"], "5");
+    EXPECT_EQ(remarks[2]["inlined"], "false");
+}
+
+TEST_F(FunctionInlineTest, CodeGrowthBudgetStopsInlining)
+{
+    // The package is tiny, so the budget is its minimum, which is 20 inlined functions of the initial threshold.
+    const size_t calleeSize = 20;
+    const size_t callsPerCaller = 11;
+    auto callee = CreateCallee("callee", calleeSize);
+    auto callers = CreateCallers(callee, 2, callsPerCaller);
+    FunctionInline pass(builder, optLevel, false);
+    pass.SetCodeGrowthBudget({callee, callers[0], callers[1]});
+    auto remarks = RunWithRemarks(pass, callers);
+    ASSERT_EQ(remarks.size(), callsPerCaller * callers.size());
+    const size_t inlinedNum = 20;
+    for (size_t i = 0; i < remarks.size(); ++i) {
+        EXPECT_EQ(remarks[i]["size"], std::to_string(calleeSize));
+        EXPECT_EQ(remarks[i]["inlined"], i < inlinedNum ? "true" : "false") << i;
+        EXPECT_EQ(remarks[i]["reason"], i < inlinedNum ? "within-threshold" : "code-growth-budget") << i;
+    }
+}
+
+TEST_F(FunctionInlineTest, NoBudgetWithoutPackageSize)
+{
+    const size_t calleeSize = 20;
+    const size_t callsPerCaller = 11;
+    auto callee = CreateCallee("callee", calleeSize);
+    auto callers = CreateCallers(callee, 2, callsPerCaller);
+    FunctionInline pass(builder, optLevel, false);
+    auto remarks = RunWithRemarks(pass, callers);
+    ASSERT_EQ(remarks.size(), callsPerCaller * callers.size());
+    for (auto& remark : remarks) {
+        EXPECT_EQ(remark["inlined"], "true");
+    }
+}
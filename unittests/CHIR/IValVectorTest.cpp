@@ -0,0 +1,151 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#include "gtest/gtest.h"
+
+#include "cangjie/CHIR/Interpreter/InterpreterValue.h"
+
+using namespace Cangjie::CHIR::Interpreter;
+
+namespace {
+IVal MakeInt(std::int64_t v)
+{
+    return IInt64{v};
+}
+
+std::int64_t GetInt(const IVal& v)
+{
+    return std::get<IInt64>(v).content;
+}
+
+IValVector MakeInts(std::int64_t n)
+{
+    IValVector res;
+    for (std::int64_t i = 0; i < n; ++i) {
+        res.push_back(MakeInt(i));
+    }
+    return res;
+}
+} // namespace
+
+TEST(IValVectorTest, EmptyVector)
+{
+    IValVector v;
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(v.size(), 0U);
+    EXPECT_EQ(v.capacity(), 0U);
+    EXPECT_EQ(v.data(), nullptr);
+    EXPECT_EQ(v.begin(), v.end());
+    EXPECT_EQ(v.Release(), nullptr);
+    EXPECT_TRUE(IValVector::CopyOf(nullptr).empty());
+    v.clear();
+    EXPECT_TRUE(v.empty());
+}
+
+TEST(IValVectorTest, PushAndPop)
+{
+    constexpr std::int64_t n = 100;
+    auto v = MakeInts(n);
+    ASSERT_EQ(v.size(), static_cast<size_t>(n));
+    EXPECT_GE(v.capacity(), v.size());
+    for (std::int64_t i = 0; i < n; ++i) {
+        EXPECT_EQ(GetInt(v[static_cast<size_t>(i)]), i);
+    }
+    EXPECT_EQ(GetInt(v.back()), n - 1);
+    v.pop_back();
+    EXPECT_EQ(v.size(), static_cast<size_t>(n - 1));
+    EXPECT_EQ(GetInt(v.back()), n - 2);
+    auto capacity = v.capacity();
+    v.clear();
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(v.capacity(), capacity);
+}
+
+TEST(IValVectorTest, Reserve)
+{
+    auto v = MakeInts(3);
+    v.reserve(64);
+    EXPECT_EQ(v.capacity(), 64U);
+    auto data = v.data();
+    for (std::int64_t i = 3; i < 64; ++i) {
+        v.push_back(MakeInt(i));
+    }
+    // no reallocation within the reserved capacity
+    EXPECT_EQ(v.data(), data);
+    v.reserve(1);
+    EXPECT_EQ(v.capacity(), 64U);
+    for (std::int64_t i = 0; i < 64; ++i) {
+        EXPECT_EQ(GetInt(v[static_cast<size_t>(i)]), i);
+    }
+}
+
+TEST(IValVectorTest, EmplaceElementOfItself)
+{
+    IValVector v{MakeInt(7)};
+    ASSERT_EQ(v.size(), v.capacity());
+    // the argument refers to the old storage, which is freed when the vector grows
+    v.emplace_back(v[0]);
+    v.push_back(v.back());
+    ASSERT_EQ(v.size(), 3U);
+    for (auto& elem : v) {
+        EXPECT_EQ(GetInt(elem), 7);
+    }
+}
+
+TEST(IValVectorTest, CopyAndMoveNestedAggregates)
+{
+    IValVector inner{MakeInt(1), MakeInt(2)};
+    IValVector outer;
+    outer.push_back(ITuple{inner});
+    outer.push_back(IArray{MakeInts(10)});
+    outer.push_back(IObject{42, IValVector{MakeInt(3)}});
+
+    IValVector copy(outer);
+    std::get<ITuple>(copy[0]).content[0] = MakeInt(100);
+    // the copy is deep
+    EXPECT_EQ(GetInt(std::get<ITuple>(outer[0]).content[0]), 1);
+    EXPECT_EQ(std::get<IArray>(copy[1]).content.size(), 10U);
+    EXPECT_EQ(std::get<IObject>(copy[2]).classId, 42U);
+
+    auto data = copy.data();
+    IValVector moved(std::move(copy));
+    EXPECT_EQ(moved.data(), data);
+    EXPECT_TRUE(copy.empty());
+
+    copy = moved;
+    EXPECT_EQ(GetInt(std::get<ITuple>(copy[0]).content[0]), 100);
+    auto& self = copy;
+    copy = self;
+    EXPECT_EQ(copy.size(), 3U);
+    // assign an aggregate from an element of the vector itself
+    copy = std::move(std::get<IArray>(copy[1]).content);
+    ASSERT_EQ(copy.size(), 10U);
+    EXPECT_EQ(GetInt(copy[9]), 9);
+}
+
+TEST(IValVectorTest, ReleaseAndAdopt)
+{
+    auto v = MakeInts(5);
+    auto block = v.Release();
+    EXPECT_TRUE(v.empty());
+    ASSERT_NE(block, nullptr);
+    EXPECT_EQ(block->size, 5U);
+    EXPECT_EQ(GetInt(IValVector::ElementsOf(block)[4]), 4);
+
+    auto copy = IValVector::CopyOf(block);
+    ASSERT_EQ(copy.size(), 5U);
+    EXPECT_NE(copy.data(), IValVector::ElementsOf(block));
+
+    auto adopted = IValVector::Adopt(block);
+    EXPECT_EQ(adopted.data(), IValVector::ElementsOf(block));
+    EXPECT_EQ(GetInt(adopted[2]), 2);
+}
+
+TEST(IValVectorTest, PointerSized)
+{
+    EXPECT_EQ(sizeof(IValVector), sizeof(void*));
+    EXPECT_EQ(IValVector().max_size(), std::numeric_limits<std::uint32_t>::max());
+}
@@ -0,0 +1,86 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cangjie/CHIR/InternedString.h"
+
+using namespace Cangjie::CHIR;
+
+TEST(InternedStringTest, EqualityAndText)
+{
+    InternedString::PoolLease lease;
+    InternedString a("foo");
+    InternedString b(std::string("foo"));
+    InternedString c("bar");
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a.GetId(), b.GetId());
+    EXPECT_NE(a, c);
+    EXPECT_EQ(a.Str(), "foo");
+    EXPECT_EQ(c.Str(), "bar");
+    EXPECT_EQ(std::hash<InternedString>{}(a), std::hash<InternedString>{}(b));
+
+    InternedString empty;
+    EXPECT_TRUE(empty.Empty());
+    EXPECT_EQ(empty, InternedString(""));
+    EXPECT_EQ(empty.Str(), "");
+    EXPECT_FALSE(a.Empty());
+}
+
+TEST(InternedStringTest, ConcurrentInterning)
+{
+    InternedString::PoolLease lease;
+    constexpr size_t threadNum = 8;
+    constexpr size_t strNum = 1000;
+    std::vector<std::vector<InternedString>> results(threadNum);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threadNum; ++t) {
+        threads.emplace_back([&results, t]() {
+            for (size_t i = 0; i < strNum; ++i) {
+                results[t].emplace_back("concurrent" + std::to_string(i));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    std::unordered_set<uint32_t> ids;
+    for (size_t i = 0; i < strNum; ++i) {
+        for (size_t t = 1; t < threadNum; ++t) {
+            EXPECT_EQ(results[t][i], results[0][i]);
+        }
+        EXPECT_EQ(results[0][i].Str(), "concurrent" + std::to_string(i));
+        ids.emplace(results[0][i].GetId());
+    }
+    EXPECT_EQ(ids.size(), strNum);
+}
+
+TEST(InternedStringTest, PoolIsEmptiedWithTheLastLease)
+{
+    size_t usedStrNum = 0;
+    {
+        InternedString::PoolLease outer;
+        {
+            InternedString::PoolLease inner;
+            InternedString first("first compilation");
+            usedStrNum = InternedString::GetPoolUsage().first;
+        }
+        // another compilation is still running, its strings are kept
+        EXPECT_EQ(InternedString::GetPoolUsage().first, usedStrNum);
+        EXPECT_EQ(InternedString("first compilation").Str(), "first compilation");
+    }
+    // only the empty string is left
+    EXPECT_EQ(InternedString::GetPoolUsage(), std::make_pair(size_t{1}, size_t{0}));
+    InternedString::PoolLease next;
+    InternedString second("second compilation");
+    EXPECT_EQ(second.Str(), "second compilation");
+    EXPECT_EQ(second.GetId(), 1U);
+}
@@ -0,0 +1,207 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#include "gtest/gtest.h"
+
+#include "cangjie/Basic/DiagnosticEngine.h"
+#include "cangjie/Basic/SourceManager.h"
+#include "cangjie/CHIR/Interpreter/BCHIR.h"
+#include "cangjie/CHIR/Interpreter/BCHIRInterpreter.h"
+#include "cangjie/CHIR/Interpreter/BCHIRLinker.h"
+
+using namespace Cangjie;
+using namespace Cangjie::CHIR::Interpreter;
+
+namespace {
+class MessageCollector : public DiagnosticHandler {
+public:
+    MessageCollector(DiagnosticEngine& diag, std::vector<std::string>& messages)
+        : DiagnosticHandler(diag, DiagHandlerKind::LSP_HANDLER), messages(messages)
+    {
+    }
+    void HandleDiagnose(Diagnostic& d) override
+    {
+        messages.emplace_back(d.GetErrorMessage());
+    }
+
+private:
+    std::vector<std::string>& messages;
+};
+
+class InterpreterLimitsTest : public ::testing::Test {
+protected:
+    static constexpr size_t MEMORY_LIMIT = 1024 * 1024;
+    static constexpr size_t STEP_LIMIT = 1000;
+    /** @brief elements of each array allocated by the programs, so that the memory limit is exceeded in fewer steps
+     * than the step limit if nothing is reclaimed */
+    static constexpr Bchir::ByteCodeContent ARRAY_SIZE = 1000;
+
+    void SetUp() override
+    {
+        diag.SetSourceManager(&sm);
+        diag.RegisterHandler(std::make_unique<MessageCollector>(diag, messages));
+        // the diagnostics refer to the file of the code position, which is the first one by default
+        (void)bchir.AddFileName("");
+    }
+
+    void Emit(OpCode op, std::initializer_list<Bchir::ByteCodeContent> operands = {})
+    {
+        code.emplace_back(static_cast<Bchir::ByteCodeContent>(op));
+        code.insert(code.end(), operands.begin(), operands.end());
+    }
+    void EmitInt64(int64_t value)
+    {
+        auto bits = static_cast<uint64_t>(value);
+        Emit(OpCode::INT64,
+            {static_cast<Bchir::ByteCodeContent>(bits), static_cast<Bchir::ByteCodeContent>(bits >> 32U)});
+    }
+    Bchir::ByteCodeContent Here() const
+    {
+        return static_cast<Bchir::ByteCodeContent>(code.size());
+    }
+
+    IResult Run(size_t maxMemory, size_t maxSteps)
+    {
+        bchir.Resize(code.size());
+        for (size_t i = 0; i < code.size(); ++i) {
+            bchir.Set(static_cast<Bchir::ByteCodeIndex>(i), code[i]);
+        }
+        BCHIRInterpreter interpreter(bchir, diag, {}, 0, 0, true);
+        interpreter.SetLimits(maxMemory, maxSteps);
+        return interpreter.Run(0, false);
+    }
+
+    /** @brief Link `code` as the body of a function with `numLVars` local vars, so that its superinstructions are
+     * fused as in const evaluation, and run it. The body starts after the FRAME added by the linker. */
+    IResult RunLinked(Bchir::ByteCodeContent numLVars, size_t maxMemory, size_t maxSteps, bool expectsReturn = false)
+    {
+        Bchir::Definition def;
+        for (auto c : code) {
+            def.Push(c);
+        }
+        def.SetNumLVars(numLVars);
+        std::vector<Bchir> packages(1);
+        (void)packages[0].AddFileName("");
+        packages[0].AddFunction(FUNC_NAME, std::move(def));
+        BCHIRLinker linker(bchir);
+        (void)linker.Run(packages, GlobalOptions{});
+        linkedBodyIdx = static_cast<Bchir::ByteCodeIndex>(linker.GetFuncBodyIdx(FUNC_NAME));
+        BCHIRInterpreter interpreter(bchir, diag, {}, 0, 0, true);
+        interpreter.SetLimits(maxMemory, maxSteps);
+        return interpreter.Run(linkedBodyIdx, expectsReturn);
+    }
+    /** @brief the op code at `idx` of `code` once linked by `RunLinked` */
+    OpCode LinkedOpAt(Bchir::ByteCodeContent idx) const
+    {
+        // FRAME :: NUMBER_OF_LVARS
+        return static_cast<OpCode>(bchir.Get(linkedBodyIdx + Bchir::FLAG_TWO + idx));
+    }
+
+    static constexpr const char* FUNC_NAME = "f";
+    SourceManager sm;
+    DiagnosticEngine diag;
+    std::vector<std::string> messages;
+    Bchir bchir;
+    std::vector<Bchir::ByteCodeContent> code;
+    Bchir::ByteCodeIndex linkedBodyIdx{0};
+};
+} // namespace
+
+TEST_F(InterpreterLimitsTest, DroppedArraysAreReclaimed)
+{
+    // for (i = 0; i < 1000; i++) { RawArray<Int64>(1000) }
+    const int64_t iterations = 1000;
+    Emit(OpCode::FRAME, {1});
+    EmitInt64(0);
+    Emit(OpCode::LVAR_SET, {0});
+    auto header = Here();
+    Emit(OpCode::LVAR, {0});
+    EmitInt64(iterations);
+    Emit(OpCode::BIN_LT,
+        {static_cast<Bchir::ByteCodeContent>(CHIR::Type::TypeKind::TYPE_INT64),
+            static_cast<Bchir::ByteCodeContent>(OverflowStrategy::WRAPPING)});
+    auto branch = Here();
+    Emit(OpCode::BRANCH, {0, 0});
+    code[branch + 1] = Here();
+    EmitInt64(ARRAY_SIZE);
+    Emit(OpCode::ALLOCATE_RAW_ARRAY);
+    Emit(OpCode::DROP);
+    Emit(OpCode::LVAR, {0});
+    EmitInt64(1);
+    Emit(OpCode::BIN_ADD,
+        {static_cast<Bchir::ByteCodeContent>(CHIR::Type::TypeKind::TYPE_INT64),
+            static_cast<Bchir::ByteCodeContent>(OverflowStrategy::WRAPPING)});
+    Emit(OpCode::LVAR_SET, {0});
+    Emit(OpCode::JUMP, {header});
+    code[branch + 2] = Here();
+    Emit(OpCode::EXIT);
+
+    // about 16 MiB are allocated in total, but only one array is alive at a time
+    auto result = Run(MEMORY_LIMIT, iterations * 3);
+    EXPECT_TRUE(std::holds_alternative<INotRun>(result));
+    EXPECT_TRUE(messages.empty());
+}
+
+TEST_F(InterpreterLimitsTest, MemoryLimitIsExceeded)
+{
+    // var list = null; while (true) { list = [list, RawArray<Int64>(1000)] }
+    Emit(OpCode::FRAME, {2});
+    Emit(OpCode::NULLPTR);
+    Emit(OpCode::LVAR_SET, {0});
+    auto header = Here();
+    EmitInt64(2);
+    Emit(OpCode::ALLOCATE_RAW_ARRAY);
+    Emit(OpCode::LVAR_SET, {1});
+    Emit(OpCode::LVAR, {1});
+    Emit(OpCode::LVAR, {0});
+    EmitInt64(ARRAY_SIZE);
+    Emit(OpCode::ALLOCATE_RAW_ARRAY);
+    Emit(OpCode::RAW_ARRAY_LITERAL_INIT, {2});
+    Emit(OpCode::DROP);
+    Emit(OpCode::LVAR, {1});
+    Emit(OpCode::LVAR_SET, {0});
+    Emit(OpCode::JUMP, {header});
+
+    // the arrays exceed the memory limit long before the step limit, which must be reported rather than the steps
+    auto result = Run(MEMORY_LIMIT, STEP_LIMIT);
+    EXPECT_TRUE(std::holds_alternative<IException>(result));
+    ASSERT_EQ(messages.size(), 1U);
+    EXPECT_NE(messages[0].find("memory"), std::string::npos) << messages[0];
+}
+
+TEST_F(InterpreterLimitsTest, StepLimitIsExceeded)
+{
+    // while (true) {}
+    Emit(OpCode::FRAME, {0});
+    auto header = Here();
+    Emit(OpCode::JUMP, {header});
+
+    auto result = Run(MEMORY_LIMIT, STEP_LIMIT);
+    EXPECT_TRUE(std::holds_alternative<IException>(result));
+    ASSERT_EQ(messages.size(), 1U);
+    EXPECT_NE(messages[0].find("step"), std::string::npos) << messages[0];
+}
+
+TEST_F(InterpreterLimitsTest, StepLimitIsExceededByFusedBranch)
+{
+    // while (true) {}, where the condition is stored in a local var and loaded again by the branch, which the linker
+    // fuses into LVAR_SET_BRANCH
+    auto header = Here();
+    Emit(OpCode::BOOL, {1});
+    auto fused = Here();
+    Emit(OpCode::LVAR_SET, {0});
+    Emit(OpCode::LVAR, {0});
+    auto branch = Here();
+    Emit(OpCode::BRANCH, {header, 0});
+    code[branch + 2] = Here();
+    Emit(OpCode::EXIT);
+
+    auto result = RunLinked(1, MEMORY_LIMIT, STEP_LIMIT);
+    ASSERT_EQ(LinkedOpAt(fused), OpCode::LVAR_SET_BRANCH);
+    EXPECT_TRUE(std::holds_alternative<IException>(result));
+    ASSERT_EQ(messages.size(), 1U);
+    EXPECT_NE(messages[0].find("step"), std::string::npos) << messages[0];
+}
@@ -0,0 +1,244 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#include <limits>
+
+#include "gtest/gtest.h"
+
+#include "cangjie/Basic/DiagnosticEngine.h"
+#include "cangjie/Basic/SourceManager.h"
+#include "cangjie/CHIR/Interpreter/BCHIR.h"
+#include "cangjie/CHIR/Interpreter/BCHIRInterpreter.h"
+#include "cangjie/CHIR/Interpreter/BCHIRLinker.h"
+
+using namespace Cangjie;
+using namespace Cangjie::CHIR::Interpreter;
+
+namespace {
+class InterpreterSuperInstructionTest : public ::testing::Test {
+protected:
+    /** @brief so that a wrong jump fails the test rather than looping forever */
+    static constexpr size_t STEP_LIMIT = 1000;
+
+    void SetUp() override
+    {
+        diag.SetSourceManager(&sm);
+    }
+
+    void Emit(OpCode op, std::initializer_list<Bchir::ByteCodeContent> operands = {})
+    {
+        ops.emplace_back(Here());
+        code.emplace_back(static_cast<Bchir::ByteCodeContent>(op));
+        code.insert(code.end(), operands.begin(), operands.end());
+    }
+    void EmitInt64(int64_t value)
+    {
+        auto bits = static_cast<uint64_t>(value);
+        Emit(OpCode::INT64,
+            {static_cast<Bchir::ByteCodeContent>(bits), static_cast<Bchir::ByteCodeContent>(bits >> 32U)});
+    }
+    void EmitBinOp(OpCode op)
+    {
+        Emit(op,
+            {static_cast<Bchir::ByteCodeContent>(CHIR::Type::TypeKind::TYPE_INT64),
+                static_cast<Bchir::ByteCodeContent>(OverflowStrategy::WRAPPING)});
+    }
+    /** @brief the index of the next operation, the jump targets are relative to the start of `code` */
+    Bchir::ByteCodeContent Here() const
+    {
+        return static_cast<Bchir::ByteCodeContent>(code.size());
+    }
+
+    /** @brief Link `code` as the body of a function with `numLVars` local vars. */
+    void Link(Bchir::ByteCodeContent numLVars)
+    {
+        Bchir::Definition def;
+        for (auto c : code) {
+            def.Push(c);
+        }
+        def.SetNumLVars(numLVars);
+        std::vector<Bchir> packages(1);
+        (void)packages[0].AddFileName("");
+        packages[0].AddFunction("f", std::move(def));
+        BCHIRLinker linker(bchir);
+        (void)linker.Run(packages, GlobalOptions{});
+        bodyIdx = static_cast<Bchir::ByteCodeIndex>(linker.GetFuncBodyIdx("f"));
+    }
+    OpCode LinkedOpAt(Bchir::ByteCodeContent idx) const
+    {
+        // FRAME :: NUMBER_OF_LVARS
+        return static_cast<OpCode>(bchir.Get(bodyIdx + Bchir::FLAG_TWO + idx));
+    }
+    int64_t RunLinked()
+    {
+        BCHIRInterpreter interpreter(bchir, diag, {}, 0, 0, true);
+        interpreter.SetLimits(std::numeric_limits<size_t>::max(), STEP_LIMIT);
+        auto result = interpreter.Run(bodyIdx, true);
+        EXPECT_TRUE(std::holds_alternative<ISuccess>(result));
+        if (!std::holds_alternative<ISuccess>(result)) {
+            return 0;
+        }
+        return std::get<IInt64>(std::get<ISuccess>(result).val).content;
+    }
+
+    /** @brief Link `code`, check the operation at `idx` was fused into `fused`, and expect the linked code to give
+     * `expected` both with the superinstructions and once they are replaced by their original operations again. Only
+     * the op code of the first operation of a sequence is replaced by the linker, so restoring it gives the code
+     * that would have been linked without fusion. */
+    void ExpectSameResultWhenFused(
+        Bchir::ByteCodeContent numLVars, Bchir::ByteCodeContent idx, OpCode fused, int64_t expected)
+    {
+        Link(numLVars);
+        ASSERT_EQ(LinkedOpAt(idx), fused);
+        EXPECT_EQ(RunLinked(), expected);
+        size_t numFused = 0;
+        for (auto op : ops) {
+            if (LinkedOpAt(op) != static_cast<OpCode>(code[op])) {
+                bchir.Set(bodyIdx + Bchir::FLAG_TWO + op, code[op]);
+                ++numFused;
+            }
+        }
+        EXPECT_NE(numFused, 0U);
+        EXPECT_EQ(RunLinked(), expected);
+    }
+
+    /** `a < b ? 10 : 20`, plus 1 if the condition stored in a local var by the fused branch is true */
+    void EmitConditional(int64_t a, int64_t b, Bchir::ByteCodeContent& fusedIdx)
+    {
+        EmitInt64(a);
+        EmitInt64(b);
+        EmitBinOp(OpCode::BIN_LT);
+        fusedIdx = Here();
+        Emit(OpCode::LVAR_SET, {0});
+        Emit(OpCode::LVAR, {0});
+        auto branch = Here();
+        Emit(OpCode::BRANCH, {0, 0});
+        code[branch + 1] = Here();
+        EmitInt64(10);
+        auto jump = Here();
+        Emit(OpCode::JUMP, {0});
+        code[branch + Bchir::FLAG_TWO] = Here();
+        EmitInt64(20);
+        code[jump + 1] = Here();
+        // a plain BRANCH, the JUMP before it isn't fused
+        Emit(OpCode::LVAR, {0});
+        auto check = Here();
+        Emit(OpCode::BRANCH, {0, 0});
+        code[check + 1] = Here();
+        EmitInt64(1);
+        auto checkJump = Here();
+        Emit(OpCode::JUMP, {0});
+        code[check + Bchir::FLAG_TWO] = Here();
+        EmitInt64(0);
+        code[checkJump + 1] = Here();
+        EmitBinOp(OpCode::BIN_ADD);
+        Emit(OpCode::EXIT);
+    }
+
+    SourceManager sm;
+    DiagnosticEngine diag;
+    Bchir bchir;
+    std::vector<Bchir::ByteCodeContent> code;
+    /** @brief the index in `code` of each operation */
+    std::vector<Bchir::ByteCodeContent> ops;
+    Bchir::ByteCodeIndex bodyIdx{0};
+};
+} // namespace
+
+TEST_F(InterpreterSuperInstructionTest, LvarLvarKeepsOperandOrder)
+{
+    // a = 7; b = 3; a - b
+    EmitInt64(7);
+    Emit(OpCode::LVAR_SET, {0});
+    EmitInt64(3);
+    Emit(OpCode::LVAR_SET, {1});
+    // keeps the LVAR_SET above from being fused with the loads
+    Emit(OpCode::UNIT);
+    Emit(OpCode::DROP);
+    auto fused = Here();
+    Emit(OpCode::LVAR, {0});
+    Emit(OpCode::LVAR, {1});
+    EmitBinOp(OpCode::BIN_SUB);
+    Emit(OpCode::EXIT);
+    ExpectSameResultWhenFused(2, fused, OpCode::LVAR_LVAR, 4);
+}
+
+TEST_F(InterpreterSuperInstructionTest, LvarSetLvarStoresBeforeLoadingAnotherVar)
+{
+    // a = 5; b = 2; (a - 1) * b
+    EmitInt64(5);
+    Emit(OpCode::LVAR_SET, {0});
+    EmitInt64(2);
+    auto fused = Here();
+    Emit(OpCode::LVAR_SET, {1});
+    Emit(OpCode::LVAR, {0});
+    EmitInt64(1);
+    EmitBinOp(OpCode::BIN_SUB);
+    Emit(OpCode::LVAR, {1});
+    EmitBinOp(OpCode::BIN_MUL);
+    Emit(OpCode::EXIT);
+    ExpectSameResultWhenFused(2, fused, OpCode::LVAR_SET_LVAR, 8);
+}
+
+TEST_F(InterpreterSuperInstructionTest, LvarSetLvarReloadsTheSameVar)
+{
+    // a = 3; a * a, where the first load follows the store and isn't a branch condition
+    EmitInt64(3);
+    auto fused = Here();
+    Emit(OpCode::LVAR_SET, {0});
+    Emit(OpCode::LVAR, {0});
+    Emit(OpCode::LVAR, {0});
+    EmitBinOp(OpCode::BIN_MUL);
+    Emit(OpCode::EXIT);
+    ExpectSameResultWhenFused(1, fused, OpCode::LVAR_SET_LVAR, 9);
+}
+
+TEST_F(InterpreterSuperInstructionTest, LvarSetBranchTaken)
+{
+    Bchir::ByteCodeContent fused = 0;
+    EmitConditional(1, 2, fused);
+    ExpectSameResultWhenFused(1, fused, OpCode::LVAR_SET_BRANCH, 11);
+}
+
+TEST_F(InterpreterSuperInstructionTest, LvarSetBranchNotTaken)
+{
+    Bchir::ByteCodeContent fused = 0;
+    EmitConditional(2, 1, fused);
+    ExpectSameResultWhenFused(1, fused, OpCode::LVAR_SET_BRANCH, 20);
+}
+
+TEST_F(InterpreterSuperInstructionTest, JumpIntoFusedSequence)
+{
+    // sum = 0; i = 0; while (i < 5) { sum = sum + i; i = i + 1 }; sum
+    // the loop header is the LVAR of the LVAR_SET_LVAR initializing `i`, which the back edge jumps to
+    EmitInt64(0);
+    Emit(OpCode::LVAR_SET, {1});
+    EmitInt64(0);
+    auto fused = Here();
+    Emit(OpCode::LVAR_SET, {0});
+    auto header = Here();
+    Emit(OpCode::LVAR, {0});
+    EmitInt64(5);
+    EmitBinOp(OpCode::BIN_LT);
+    Emit(OpCode::LVAR_SET, {2});
+    Emit(OpCode::LVAR, {2});
+    auto branch = Here();
+    Emit(OpCode::BRANCH, {0, 0});
+    code[branch + 1] = Here();
+    Emit(OpCode::LVAR, {1});
+    Emit(OpCode::LVAR, {0});
+    EmitBinOp(OpCode::BIN_ADD);
+    Emit(OpCode::LVAR_SET, {1});
+    Emit(OpCode::LVAR, {0});
+    EmitInt64(1);
+    EmitBinOp(OpCode::BIN_ADD);
+    Emit(OpCode::LVAR_SET, {0});
+    Emit(OpCode::JUMP, {header});
+    code[branch + Bchir::FLAG_TWO] = Here();
+    Emit(OpCode::LVAR, {1});
+    Emit(OpCode::EXIT);
+    ExpectSameResultWhenFused(3, fused, OpCode::LVAR_SET_LVAR, 10);
+}
@@ -0,0 +1,72 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#include "CHIRTest.h"
+
+#include "cangjie/CHIR/Transformation/LoopInvariantCodeMotion.h"
+
+class LoopInvariantCodeMotionTest : public CHIRTestTemplate {
+protected:
+    void SetUp() override
+    {
+        pure = CreateFunc("pure", {}, int64Ty);
+        pure->EnableAttr(Attribute::NO_SIDE_EFFECT);
+        auto entry = pure->GetEntryBlock();
+        AppendInt(int64Ty, 1, entry);
+        Terminate<Exit>(entry);
+        func = CreateFunc("f", {boolTy, boolTy}, unitTy);
+        entry = func->GetEntryBlock();
+        header = builder.CreateBlock(func->GetBody());
+        Terminate<GoTo>(header, entry);
+    }
+
+    Expression* AppendCall(Block* block)
+    {
+        return Append<Apply>(int64Ty, pure, FuncCallContext{}, block)->GetExpr();
+    }
+
+    Func* pure{nullptr};
+    Func* func{nullptr};
+    Block* header{nullptr};
+};
+
+TEST_F(LoopInvariantCodeMotionTest, HoistCallExecutedInEveryIteration)
+{
+    // header: call; branch(c, header, exit)
+    auto exit = builder.CreateBlock(func->GetBody());
+    auto call = AppendCall(header);
+    Terminate<Branch>(func->GetParam(0), header, exit, header);
+    Terminate<Exit>(exit);
+    LoopInvariantCodeMotion::RunOnPackage(*package, builder, false);
+    EXPECT_NE(call->GetParentBlock(), header);
+    EXPECT_EQ(call->GetParentBlock()->GetSuccessors(), std::vector<Block*>{header});
+}
+
+TEST_F(LoopInvariantCodeMotionTest, KeepCallInLoopWithoutExit)
+{
+    // header: call; goto header
+    auto call = AppendCall(header);
+    Terminate<GoTo>(header, header);
+    LoopInvariantCodeMotion::RunOnPackage(*package, builder, false);
+    EXPECT_EQ(call->GetParentBlock(), header);
+}
+
+TEST_F(LoopInvariantCodeMotionTest, KeepCallNotDominatingLatch)
+{
+    // header: branch(c0, callBlock, other)
+    // callBlock: call; branch(c1, header, exit)
+    // other: goto header
+    auto callBlock = builder.CreateBlock(func->GetBody());
+    auto other = builder.CreateBlock(func->GetBody());
+    auto exit = builder.CreateBlock(func->GetBody());
+    Terminate<Branch>(func->GetParam(0), callBlock, other, header);
+    auto call = AppendCall(callBlock);
+    Terminate<Branch>(func->GetParam(1), header, exit, callBlock);
+    Terminate<GoTo>(header, other);
+    Terminate<Exit>(exit);
+    LoopInvariantCodeMotion::RunOnPackage(*package, builder, false);
+    EXPECT_EQ(call->GetParentBlock(), callBlock);
+}
@@ -0,0 +1,160 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#include "CHIRTest.h"
+
+#include "cangjie/CHIR/Transformation/Mem2Reg.h"
+
+using Cangjie::OverflowStrategy;
+using Cangjie::StaticCast;
+
+class Mem2RegTest : public CHIRTestTemplate {
+protected:
+    void SetUp() override
+    {
+        func = CreateFunc("f", {boolTy}, unitTy);
+        entry = func->GetEntryBlock();
+        var = Append<Allocate>(builder.GetType<RefType>(int64Ty), int64Ty, entry);
+    }
+
+    /// Append `value + 1`, whose first operand tells what the value is replaced with.
+    Expression* AppendUse(Value* value, Block* block)
+    {
+        return Append<BinaryExpression>(
+            int64Ty, ExprKind::ADD, value, AppendInt(int64Ty, 1, block), OverflowStrategy::WRAPPING, block)
+            ->GetExpr();
+    }
+
+    static size_t CountExprs(const Func& f, ExprKind kind)
+    {
+        size_t res = 0;
+        for (auto block : f.GetBody()->GetBlocks()) {
+            for (auto expr : block->GetExpressions()) {
+                res += expr->GetExprKind() == kind ? 1 : 0;
+            }
+        }
+        return res;
+    }
+
+    Func* func{nullptr};
+    Block* entry{nullptr};
+    LocalVar* var{nullptr};
+};
+
+TEST_F(Mem2RegTest, ForwardStoreInSameBlock)
+{
+    // entry: var = 1; var = 2; use(var)
+    Append<Store>(unitTy, AppendInt(int64Ty, 1, entry), var, entry);
+    auto two = AppendInt(int64Ty, 2, entry);
+    Append<Store>(unitTy, two, var, entry);
+    auto use = AppendUse(Append<Load>(int64Ty, var, entry), entry);
+    Terminate<Exit>(entry);
+    Mem2Reg::RunOnPackage(*package, false);
+    EXPECT_EQ(use->GetOperand(0), two);
+    EXPECT_EQ(CountExprs(*func, ExprKind::ALLOCATE), 0U);
+    EXPECT_EQ(CountExprs(*func, ExprKind::STORE), 0U);
+    EXPECT_EQ(CountExprs(*func, ExprKind::LOAD), 0U);
+}
+
+TEST_F(Mem2RegTest, ForwardSingleStoreToDominatedBlocks)
+{
+    // entry: var = 1; debug(var); branch(c, a, b)
+    // a: use(var); goto b
+    // b: use(var); exit
+    auto one = AppendInt(int64Ty, 1, entry);
+    Append<Store>(unitTy, one, var, entry);
+    Append<Debug>(unitTy, var, std::string("x"), entry);
+    auto a = builder.CreateBlock(func->GetBody());
+    auto b = builder.CreateBlock(func->GetBody());
+    Terminate<Branch>(func->GetParam(0), a, b, entry);
+    auto useA = AppendUse(Append<Load>(int64Ty, var, a), a);
+    Terminate<GoTo>(b, a);
+    auto useB = AppendUse(Append<Load>(int64Ty, var, b), b);
+    Terminate<Exit>(b);
+    Mem2Reg::RunOnPackage(*package, false);
+    EXPECT_EQ(useA->GetOperand(0), one);
+    EXPECT_EQ(useB->GetOperand(0), one);
+    // the debug info of a promoted variable is dropped with it, the pass doesn't run when compiling with `-g`
+    EXPECT_EQ(CountExprs(*func, ExprKind::ALLOCATE), 0U);
+    EXPECT_EQ(CountExprs(*func, ExprKind::DEBUGEXPR), 0U);
+}
+
+TEST_F(Mem2RegTest, KeepLoadAtJoinOfDifferentStores)
+{
+    // entry: branch(c, a, b)
+    // a: var = 1; goto join
+    // b: var = 2; goto join
+    // join: use(var)
+    // CHIR blocks have no parameters to merge the stored values, so the load and the variable are kept.
+    auto a = builder.CreateBlock(func->GetBody());
+    auto b = builder.CreateBlock(func->GetBody());
+    auto join = builder.CreateBlock(func->GetBody());
+    Terminate<Branch>(func->GetParam(0), a, b, entry);
+    Append<Store>(unitTy, AppendInt(int64Ty, 1, a), var, a);
+    Terminate<GoTo>(join, a);
+    Append<Store>(unitTy, AppendInt(int64Ty, 2, b), var, b);
+    Terminate<GoTo>(join, b);
+    auto load = Append<Load>(int64Ty, var, join);
+    auto use = AppendUse(load, join);
+    Terminate<Exit>(join);
+    Mem2Reg::RunOnPackage(*package, false);
+    EXPECT_EQ(use->GetOperand(0), load);
+    EXPECT_EQ(CountExprs(*func, ExprKind::ALLOCATE), 1U);
+    EXPECT_EQ(CountExprs(*func, ExprKind::STORE), 2U);
+}
+
+TEST_F(Mem2RegTest, KeepLoopCarriedLoad)
+{
+    // entry: var = 0; goto header
+    // header: i = var; branch(c, body, exit)
+    // body: var = i + 1; use(var); goto header
+    Append<Store>(unitTy, AppendInt(int64Ty, 0, entry), var, entry);
+    auto header = builder.CreateBlock(func->GetBody());
+    auto body = builder.CreateBlock(func->GetBody());
+    auto exit = builder.CreateBlock(func->GetBody());
+    Terminate<GoTo>(header, entry);
+    auto i = Append<Load>(int64Ty, var, header);
+    Terminate<Branch>(func->GetParam(0), body, exit, header);
+    auto next = AppendUse(i, body)->GetResult();
+    Append<Store>(unitTy, next, var, body);
+    auto use = AppendUse(Append<Load>(int64Ty, var, body), body);
+    Terminate<GoTo>(header, body);
+    Terminate<Exit>(exit);
+    Mem2Reg::RunOnPackage(*package, false);
+    // the load in the header is reached by the stores of the entry and of the previous iteration
+    EXPECT_EQ(i->GetExpr()->GetParentBlock(), header);
+    EXPECT_EQ(CountExprs(*func, ExprKind::LOAD), 1U);
+    // while the load after the store in the body is forwarded
+    EXPECT_EQ(use->GetOperand(0), next);
+}
+
+TEST_F(Mem2RegTest, KeepVarWhoseAddressEscapes)
+{
+    // entry: var = 1; callee(var); use(var)
+    auto callee = CreateFunc("callee", {var->GetType()}, unitTy);
+    Terminate<Exit>(callee->GetEntryBlock());
+    Append<Store>(unitTy, AppendInt(int64Ty, 1, entry), var, entry);
+    Append<Apply>(unitTy, callee, FuncCallContext{.args = {var}}, entry);
+    auto load = Append<Load>(int64Ty, var, entry);
+    auto use = AppendUse(load, entry);
+    Terminate<Exit>(entry);
+    Mem2Reg::RunOnPackage(*package, false);
+    EXPECT_EQ(use->GetOperand(0), load);
+    EXPECT_EQ(CountExprs(*func, ExprKind::ALLOCATE), 1U);
+}
+
+TEST_F(Mem2RegTest, KeepVarWhoseAddressIsStored)
+{
+    // entry: other = &var; var = 1; use(var)
+    auto other = Append<Allocate>(builder.GetType<RefType>(var->GetType()), var->GetType(), entry);
+    Append<Store>(unitTy, var, other, entry);
+    Append<Store>(unitTy, AppendInt(int64Ty, 1, entry), var, entry);
+    auto load = Append<Load>(int64Ty, var, entry);
+    auto use = AppendUse(load, entry);
+    Terminate<Exit>(entry);
+    Mem2Reg::RunOnPackage(*package, false);
+    EXPECT_EQ(use->GetOperand(0), load);
+}
@@ -0,0 +1,124 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cangjie/CHIR/Analysis/PGOProfileInfo.h"
+#include "cangjie/Utils/FileUtil.h"
+
+using namespace Cangjie;
+using namespace Cangjie::CHIR;
+
+namespace {
+std::unique_ptr<PGOProfileInfo> LoadProfile(const std::string& content)
+{
+    auto path = ::testing::TempDir() + "pgo_profile_test.proftext";
+    EXPECT_TRUE(FileUtil::WriteToFile(path, content));
+    auto res = PGOProfileInfo::Load(path);
+    (void)std::remove(path.c_str());
+    return res;
+}
+} // namespace
+
+TEST(PGOProfileInfoTest, ParseTextProfile)
+{
+    // header flags, comments, value profile data, CRLF line ends and file name prefixes of local functions are
+    // accepted, and the max counter of a function is its count
+    auto profile = LoadProfile("# IR level Instrumentation Flag\n"
+                               ":ir\n"
+                               "hot\n"
+                               "# Func Hash:\n"
+                               "1234\n"
+                               "# Num Counters:\n"
+                               "3\n"
+                               "# Counter Values:\n"
+                               "10\n"
+                               "5000\n"
+                               "7\n"
+                               "# Num Value Kinds:\n"
+                               "0\n"
+                               "\n"
+                               "main.cj;local\r\n"
+                               "1\r\n"
+                               "1\r\n"
+                               "4000\r\n"
+                               "\r\n"
+                               "normal\n"
+                               "2\n"
+                               "2\n"
+                               "0\n"
+                               "3\n"
+                               "\n"
+                               "cold\n"
+                               "3\n"
+                               "1\n"
+                               "0\n");
+    ASSERT_NE(profile, nullptr);
+    EXPECT_EQ(profile->GetFuncHotness("hot"), PGOProfileInfo::Hotness::HOT);
+    EXPECT_EQ(profile->GetFuncHotness("local"), PGOProfileInfo::Hotness::HOT);
+    EXPECT_EQ(profile->GetFuncHotness("main.cj;local"), PGOProfileInfo::Hotness::UNKNOWN);
+    EXPECT_EQ(profile->GetFuncHotness("normal"), PGOProfileInfo::Hotness::NORMAL);
+    EXPECT_EQ(profile->GetFuncHotness("cold"), PGOProfileInfo::Hotness::COLD);
+    EXPECT_EQ(profile->GetFuncHotness("missing"), PGOProfileInfo::Hotness::UNKNOWN);
+}
+
+TEST(PGOProfileInfoTest, HotThresholdCoversMostCounts)
+{
+    // 99% of the total count 1000 + 989 + 10 + 1 = 2000 is covered by the first two functions, so the others are
+    // normal even though they are executed
+    auto profile = LoadProfile("a\n1\n1\n1000\n\nb\n1\n1\n989\n\nc\n1\n1\n10\n\nd\n1\n1\n1\n");
+    ASSERT_NE(profile, nullptr);
+    EXPECT_EQ(profile->GetFuncHotness("a"), PGOProfileInfo::Hotness::HOT);
+    EXPECT_EQ(profile->GetFuncHotness("b"), PGOProfileInfo::Hotness::HOT);
+    EXPECT_EQ(profile->GetFuncHotness("c"), PGOProfileInfo::Hotness::NORMAL);
+    EXPECT_EQ(profile->GetFuncHotness("d"), PGOProfileInfo::Hotness::NORMAL);
+}
+
+TEST(PGOProfileInfoTest, RepeatedFunctionKeepsMaxCount)
+{
+    // local functions of different files may have the same name once their prefixes are stripped
+    auto profile = LoadProfile("a.cj;f\n1\n1\n0\n\nb.cj;f\n2\n1\n100\n\ng\n3\n1\n1\n");
+    ASSERT_NE(profile, nullptr);
+    EXPECT_EQ(profile->GetFuncHotness("f"), PGOProfileInfo::Hotness::HOT);
+}
+
+TEST(PGOProfileInfoTest, RejectMalformedProfile)
+{
+    const std::vector<std::pair<std::string, std::string>> malformed = {
+        {"empty", ""},
+        {"only comments", "# comment\n:ir\n"},
+        {"missing hash and counters", "f\n"},
+        {"missing counters", "f\n1\n"},
+        {"non-numeric hash", "f\n0x12\n1\n5\n"},
+        {"non-numeric counter number", "f\n1\ntwo\n5\n5\n"},
+        {"negative counter", "f\n1\n1\n-5\n"},
+        {"too few counters", "f\n1\n3\n5\n6\n"},
+        {"too few counters before the next record", "f\n1\n3\n5\n\ng\n1\n1\n5\n"},
+        {"non-numeric counter", "f\n1\n2\n5\nfive\n"},
+    };
+    for (auto& [reason, content] : malformed) {
+        EXPECT_EQ(LoadProfile(content), nullptr) << reason;
+    }
+}
+
+TEST(PGOProfileInfoTest, IgnoreIndexedProfile)
+{
+    // indexed profiles are only read by LLVM
+    EXPECT_EQ(LoadProfile(std::string("\xff") + "lprofi\x08"), nullptr);
+    EXPECT_EQ(PGOProfileInfo::Load(::testing::TempDir() + "pgo_profile_test_not_exist.profdata"), nullptr);
+}
+
+TEST(PGOProfileInfoTest, HotnessToString)
+{
+    EXPECT_EQ(HotnessToString(PGOProfileInfo::Hotness::UNKNOWN), "unknown");
+    EXPECT_EQ(HotnessToString(PGOProfileInfo::Hotness::COLD), "cold");
+    EXPECT_EQ(HotnessToString(PGOProfileInfo::Hotness::NORMAL), "normal");
+    EXPECT_EQ(HotnessToString(PGOProfileInfo::Hotness::HOT), "hot");
+}
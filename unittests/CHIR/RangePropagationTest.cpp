@@ -0,0 +1,203 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#include "CHIRTest.h"
+
+#include "cangjie/CHIR/Analysis/ValueRangeAnalysis.h"
+#include "cangjie/CHIR/Transformation/RangePropagation.h"
+
+using Cangjie::OverflowStrategy;
+using Cangjie::StaticCast;
+
+class RangePropagationTest : public CHIRTestTemplate {
+protected:
+    /**
+     * Build
+     *   func f(arr: RawArray<Int64>) {
+     *       var i = start
+     *       while (i `cmp` arr.size) { arr[i]; i++ }
+     *   }
+     * and return the ARRAY_GET in the loop body.
+     */
+    Intrinsic* BuildArrayLoop(int64_t start, ExprKind cmp)
+    {
+        auto arrTy = builder.GetType<RefType>(builder.GetType<RawArrayType>(int64Ty, 1U));
+        auto func = CreateFunc("f", {arrTy}, unitTy);
+        auto arr = func->GetParam(0);
+        auto body = func->GetBody();
+        auto entry = body->GetEntryBlock();
+        auto header = builder.CreateBlock(body);
+        auto loop = builder.CreateBlock(body);
+        auto exit = builder.CreateBlock(body);
+
+        auto iVar = Append<Allocate>(builder.GetType<RefType>(int64Ty), int64Ty, entry);
+        Append<Store>(unitTy, AppendInt(int64Ty, start, entry), iVar, entry);
+        auto sizeCtx = IntrisicCallContext{.kind = IntrinsicKind::ARRAY_SIZE, .args = {arr}, .instTypeArgs = {}};
+        auto size = Append<Intrinsic>(int64Ty, sizeCtx, entry);
+        Terminate<GoTo>(header, entry);
+
+        auto i = Append<Load>(int64Ty, iVar, header);
+        auto cond = Append<BinaryExpression>(boolTy, cmp, i, size, header);
+        Terminate<Branch>(cond, loop, exit, header);
+
+        auto getCtx = IntrisicCallContext{.kind = IntrinsicKind::ARRAY_GET, .args = {arr, i}, .instTypeArgs = {}};
+        auto get = StaticCast<Intrinsic*>(Append<Intrinsic>(int64Ty, getCtx, loop)->GetExpr());
+        auto next = Append<BinaryExpression>(
+            int64Ty, ExprKind::ADD, i, AppendInt(int64Ty, 1, loop), OverflowStrategy::THROWING, loop);
+        Append<Store>(unitTy, next, iVar, loop);
+        Terminate<GoTo>(header, loop);
+
+        Terminate<Exit>(exit);
+        return get;
+    }
+
+    void RunRangePropagation()
+    {
+        RangePropagation::RangeAnalysisWrapper vra(builder);
+        vra.RunOnPackage(package, false, 1, &diagAdapter);
+        RangePropagation rp(builder, &vra, &diagAdapter, false);
+        rp.RunOnPackage(package, false);
+    }
+
+    static IntrinsicKind GetArrayAccessKind(const Block& block)
+    {
+        for (auto expr : block.GetExpressions()) {
+            if (expr->GetExprKind() == ExprKind::INTRINSIC) {
+                return StaticCast<Intrinsic*>(expr)->GetIntrinsicKind();
+            }
+        }
+        return IntrinsicKind::NOT_INTRINSIC;
+    }
+};
+
+TEST_F(RangePropagationTest, IndexBelowSizeIsUnchecked)
+{
+    auto get = BuildArrayLoop(0, ExprKind::LT);
+    auto loop = get->GetParentBlock();
+    RunRangePropagation();
+    EXPECT_EQ(GetArrayAccessKind(*loop), IntrinsicKind::ARRAY_GET_UNCHECKED);
+}
+
+TEST_F(RangePropagationTest, IndexUpToSizeIsChecked)
+{
+    auto get = BuildArrayLoop(0, ExprKind::LE);
+    auto loop = get->GetParentBlock();
+    RunRangePropagation();
+    EXPECT_EQ(GetArrayAccessKind(*loop), IntrinsicKind::ARRAY_GET);
+}
+
+TEST_F(RangePropagationTest, NegativeIndexIsChecked)
+{
+    auto get = BuildArrayLoop(-1, ExprKind::LT);
+    auto loop = get->GetParentBlock();
+    RunRangePropagation();
+    EXPECT_EQ(GetArrayAccessKind(*loop), IntrinsicKind::ARRAY_GET);
+}
+
+class NeverOverflowTest : public RangePropagationTest {
+protected:
+    /**
+     * Build
+     *   func g(x: Int64, y: Int64) {
+     *       if (x < 100) { if (x >= 0) { x + 1; x + y } }
+     *   }
+     * with throwing additions, and return them.
+     */
+    std::pair<Expression*, Expression*> BuildBoundedAdds()
+    {
+        auto func = CreateFunc("g", {int64Ty, int64Ty}, unitTy);
+        auto x = func->GetParam(0);
+        auto y = func->GetParam(1);
+        auto body = func->GetBody();
+        auto entry = body->GetEntryBlock();
+        auto nonNegCheck = builder.CreateBlock(body);
+        auto bounded = builder.CreateBlock(body);
+        auto exit = builder.CreateBlock(body);
+
+        auto belowMax = Append<BinaryExpression>(boolTy, ExprKind::LT, x, AppendInt(int64Ty, 100, entry), entry);
+        Terminate<Branch>(belowMax, nonNegCheck, exit, entry);
+        auto nonNeg =
+            Append<BinaryExpression>(boolTy, ExprKind::GE, x, AppendInt(int64Ty, 0, nonNegCheck), nonNegCheck);
+        Terminate<Branch>(nonNeg, bounded, exit, nonNegCheck);
+
+        auto addOne = Append<BinaryExpression>(
+            int64Ty, ExprKind::ADD, x, AppendInt(int64Ty, 1, bounded), OverflowStrategy::THROWING, bounded);
+        auto addY = Append<BinaryExpression>(int64Ty, ExprKind::ADD, x, y, OverflowStrategy::THROWING, bounded);
+        Terminate<GoTo>(exit, bounded);
+
+        Terminate<Exit>(exit);
+        return {addOne->GetExpr(), addY->GetExpr()};
+    }
+};
+
+TEST_F(NeverOverflowTest, BoundedAddNeverOverflows)
+{
+    // x is in [0, 99], so x + 1 is in [1, 100]
+    auto [addOne, addY] = BuildBoundedAdds();
+    RunRangePropagation();
+    EXPECT_TRUE(addOne->Get<NeverOverflowInfo>());
+}
+
+TEST_F(NeverOverflowTest, UnboundedAddMayOverflow)
+{
+    // y is unknown, so x + y may exceed the range of Int64
+    auto [addOne, addY] = BuildBoundedAdds();
+    RunRangePropagation();
+    EXPECT_FALSE(addY->Get<NeverOverflowInfo>());
+}
+
+class SparseRangeAnalysisTest : public RangePropagationTest {
+protected:
+    /**
+     * Build
+     *   func h(b: UInt8) {
+     *       let x = Int64(b); var v = x
+     *       // `blockNum` blocks jumping to the next one
+     *       x + 1; v + 1
+     *   }
+     * with throwing additions, and return them.
+     */
+    std::pair<Expression*, Expression*> BuildAddsAfterBlocks(size_t blockNum)
+    {
+        auto func = CreateFunc("h", {builder.GetUInt8Ty()}, unitTy);
+        auto body = func->GetBody();
+        auto block = body->GetEntryBlock();
+        // x is in [0, 255]
+        auto x = Append<TypeCast>(int64Ty, func->GetParam(0), OverflowStrategy::THROWING, block);
+        auto v = Append<Allocate>(builder.GetType<RefType>(int64Ty), int64Ty, block);
+        Append<Store>(unitTy, x, v, block);
+        for (size_t i = 0; i < blockNum; ++i) {
+            auto next = builder.CreateBlock(body);
+            Terminate<GoTo>(next, block);
+            block = next;
+        }
+        auto addX = Append<BinaryExpression>(
+            int64Ty, ExprKind::ADD, x, AppendInt(int64Ty, 1, block), OverflowStrategy::THROWING, block);
+        auto addV = Append<BinaryExpression>(int64Ty, ExprKind::ADD, Append<Load>(int64Ty, v, block),
+            AppendInt(int64Ty, 1, block), OverflowStrategy::THROWING, block);
+        Terminate<Exit>(block);
+        return {addX->GetExpr(), addV->GetExpr()};
+    }
+};
+
+TEST_F(SparseRangeAnalysisTest, DenseBelowBlockLimit)
+{
+    auto [addX, addV] = BuildAddsAfterBlocks(10);
+    RunRangePropagation();
+    EXPECT_TRUE(addX->Get<NeverOverflowInfo>());
+    EXPECT_TRUE(addV->Get<NeverOverflowInfo>());
+}
+
+TEST_F(SparseRangeAnalysisTest, SparseOverBlockLimit)
+{
+    // a function over the block limit used to get no range at all, it now keeps the ranges of the values
+    ASSERT_TRUE(Cangjie::CHIR::Analysis<RangeDomain>::GetBlockLimit().has_value());
+    auto [addX, addV] = BuildAddsAfterBlocks(*Cangjie::CHIR::Analysis<RangeDomain>::GetBlockLimit() + 1);
+    RunRangePropagation();
+    EXPECT_TRUE(addX->Get<NeverOverflowInfo>());
+    // but forgets the memory at the entry of each block
+    EXPECT_FALSE(addV->Get<NeverOverflowInfo>());
+}
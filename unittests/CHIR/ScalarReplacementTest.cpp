@@ -0,0 +1,89 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#include "CHIRTest.h"
+
+#include "cangjie/CHIR/Transformation/ScalarReplacement.h"
+#include "cangjie/CHIR/Type/ClassDef.h"
+
+using Cangjie::StaticCast;
+
+class ScalarReplacementTest : public CHIRTestTemplate {
+protected:
+    /// Create `class C { var x: Int64 }` and return its type.
+    ClassType* CreateClass()
+    {
+        auto classDef = builder.CreateClass(defaultLoc, "C", "C", pkgName, true, false);
+        auto classTy = builder.GetType<ClassType>(classDef);
+        classDef->SetType(*classTy);
+        classDef->AddInstanceVar(MemberVarInfo{"x", "", int64Ty, AttributeInfo{}});
+        return classTy;
+    }
+
+    /**
+     * Build
+     *   func f(sink: Ref<Ref<Int64>>) {
+     *       let obj = C()
+     *       obj.x = 1
+     *       let addr = &obj.x
+     *       addr
+     *   }
+     * where the address of the field is stored to `sink` if @p escape, and only loaded from otherwise.
+     */
+    Func* BuildFieldAccess(bool escape)
+    {
+        auto classTy = CreateClass();
+        auto fieldRefTy = builder.GetType<RefType>(int64Ty);
+        auto func = CreateFunc("f", {builder.GetType<RefType>(fieldRefTy)}, unitTy);
+        auto entry = func->GetEntryBlock();
+        auto obj = Append<Allocate>(builder.GetType<RefType>(classTy), classTy, entry);
+        Append<StoreElementRef>(unitTy, AppendInt(int64Ty, 1, entry), obj, std::vector<uint64_t>{0}, entry);
+        auto addr = Append<GetElementRef>(fieldRefTy, obj, std::vector<uint64_t>{0}, entry);
+        if (escape) {
+            Append<Store>(unitTy, addr, func->GetParam(0), entry);
+        } else {
+            Append<Load>(int64Ty, addr, entry);
+        }
+        Terminate<Exit>(entry);
+        return func;
+    }
+
+    static size_t CountAllocations(const Block& block, bool ofClass)
+    {
+        size_t count = 0;
+        for (auto expr : block.GetExpressions()) {
+            if (expr->GetExprKind() == ExprKind::ALLOCATE &&
+                StaticCast<Allocate*>(expr)->GetType()->IsClass() == ofClass) {
+                ++count;
+            }
+        }
+        return count;
+    }
+};
+
+TEST_F(ScalarReplacementTest, NonEscapingObjectIsReplaced)
+{
+    auto func = BuildFieldAccess(false);
+    ScalarReplacement::RunOnPackage(*package, builder, false);
+    auto entry = func->GetEntryBlock();
+    EXPECT_EQ(CountAllocations(*entry, true), 0U);
+    // the field becomes a local variable, which is stored and loaded directly
+    EXPECT_EQ(CountAllocations(*entry, false), 1U);
+    for (auto expr : entry->GetExpressions()) {
+        EXPECT_NE(expr->GetExprKind(), ExprKind::STORE_ELEMENT_REF);
+        EXPECT_NE(expr->GetExprKind(), ExprKind::GET_ELEMENT_REF);
+    }
+}
+
+TEST_F(ScalarReplacementTest, EscapingObjectIsKept)
+{
+    // the address of the field outlives the function, so the object must stay on the heap
+    auto func = BuildFieldAccess(true);
+    ScalarReplacement::RunOnPackage(*package, builder, false);
+    auto entry = func->GetEntryBlock();
+    EXPECT_EQ(CountAllocations(*entry, true), 1U);
+    EXPECT_EQ(CountAllocations(*entry, false), 0U);
+}
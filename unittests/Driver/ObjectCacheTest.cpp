@@ -0,0 +1,99 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+#include "gtest/gtest.h"
+#include "cangjie/Driver/ObjectCache.h"
+
+#include <string>
+
+#include "cangjie/Utils/FileUtil.h"
+
+using namespace Cangjie;
+
+class ObjectCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        cacheDir = FileUtil::JoinPath(".", "objectCacheTemp");
+        for (auto& file : FileUtil::GetAllFilesUnderCurrentPath(cacheDir, "o", false)) {
+            (void)FileUtil::Remove(FileUtil::JoinPath(cacheDir, file));
+        }
+        ASSERT_EQ(FileUtil::CreateDirs(cacheDir + "/"), 0);
+        prefix = FileUtil::JoinPath(cacheDir, "pkg.objcache.");
+    }
+
+    /// Create a cached object of @p size bytes, last used @p age seconds ago.
+    std::string AddObj(const std::string& name, size_t size, int64_t age)
+    {
+        auto path = prefix + name + ".o";
+        EXPECT_TRUE(FileUtil::WriteToFile(path, std::string(size, 'x')));
+        EXPECT_TRUE(FileUtil::SetFileModifiedTime(path, now - age));
+        return path;
+    }
+
+    std::string cacheDir;
+    std::string prefix;
+    const int64_t now = 1700000000;
+    const int64_t day = 24 * 60 * 60;
+};
+
+TEST_F(ObjectCacheTest, KeyDependsOnContentAndOptions)
+{
+    auto bc1 = FileUtil::JoinPath(cacheDir, "a.bc");
+    auto bc2 = FileUtil::JoinPath(cacheDir, "b.bc");
+    ASSERT_TRUE(FileUtil::WriteToFile(bc1, "BC\xC0\xDE content"));
+    ASSERT_TRUE(FileUtil::WriteToFile(bc2, "BC\xC0\xDE other content"));
+    auto o0 = ObjectCache::HashOptions("version -O0");
+    auto o2 = ObjectCache::HashOptions("version -O2");
+    auto key = ObjectCache::GetKey(bc1, o0);
+    ASSERT_TRUE(key.has_value());
+    EXPECT_EQ(key, ObjectCache::GetKey(bc1, o0));
+    EXPECT_NE(key, ObjectCache::GetKey(bc2, o0));
+    EXPECT_NE(key, ObjectCache::GetKey(bc1, o2));
+    EXPECT_FALSE(ObjectCache::GetKey(FileUtil::JoinPath(cacheDir, "missing.bc"), o0).has_value());
+    (void)FileUtil::Remove(bc1);
+    (void)FileUtil::Remove(bc2);
+}
+
+TEST_F(ObjectCacheTest, EvictByAge)
+{
+    auto used = AddObj("used", 1, 30 * day);
+    auto recent = AddObj("recent", 1, day);
+    auto old = AddObj("old", 1, 8 * day);
+    auto other = FileUtil::JoinPath(cacheDir, "pkg.o");
+    ASSERT_TRUE(FileUtil::WriteToFile(other, "x"));
+    ASSERT_TRUE(FileUtil::SetFileModifiedTime(other, now - 30 * day));
+
+    ObjectCache::Evict(cacheDir, prefix, {used}, {}, now);
+    EXPECT_TRUE(FileUtil::FileExist(used));
+    EXPECT_EQ(FileUtil::GetFileModifiedTime(used), now);
+    EXPECT_TRUE(FileUtil::FileExist(recent));
+    EXPECT_FALSE(FileUtil::FileExist(old));
+    // the files that are not cached objects are left untouched
+    EXPECT_TRUE(FileUtil::FileExist(other));
+    (void)FileUtil::Remove(other);
+}
+
+TEST_F(ObjectCacheTest, EvictBySize)
+{
+    // the objects of another configuration, e.g. -O0 while this build is -O2
+    auto older = AddObj("older", 100, 3 * day);
+    auto newer = AddObj("newer", 100, 2 * day);
+    auto used = AddObj("used", 100, 4 * day);
+
+    ObjectCache::EvictionPolicy policy;
+    policy.maxSize = 250;
+    ObjectCache::Evict(cacheDir, prefix, {used}, policy, now);
+    EXPECT_TRUE(FileUtil::FileExist(used));
+    EXPECT_TRUE(FileUtil::FileExist(newer));
+    EXPECT_FALSE(FileUtil::FileExist(older));
+
+    // the used objects are kept even if they exceed the limit alone
+    policy.maxSize = 0;
+    ObjectCache::Evict(cacheDir, prefix, {used}, policy, now);
+    EXPECT_TRUE(FileUtil::FileExist(used));
+    EXPECT_FALSE(FileUtil::FileExist(newer));
+}
@@ -1202,3 +1202,49 @@ TEST_F(PackageTest, DISABLED_LoadPackageFromCjo)
         }
     }
 }
+
+TEST_F(PackageTest, DISABLED_ReuseImportedInstantiations)
+{
+    auto idInstantiations = [](const Package& pkg) {
+        std::vector<Ptr<const FuncDecl>> instantiations;
+        for (auto& decl : pkg.genericInstantiatedDecls) {
+            if (auto fd = DynamicCast<const FuncDecl*>(decl.get()); fd && fd->identifier == "id") {
+                instantiations.emplace_back(fd);
+            }
+        }
+        return instantiations;
+    };
+    diag.ClearError();
+    instance = std::make_unique<TestCompilerInstance>(invocation, diag);
+    instance->invocation.globalOptions.compilePackage = true;
+    instance->code = R"(
+        package generics
+        public func id<T>(a: T): T { a }
+        public func idInt64(a: Int64): Int64 { id<Int64>(a) }
+    )";
+    instance->Compile();
+    ASSERT_EQ(diag.GetErrorCount(), 0);
+    auto exported = idInstantiations(*instance->GetSourcePackages()[0]);
+    ASSERT_EQ(exported.size(), 1);
+    EXPECT_EQ(exported[0]->linkage, Linkage::WEAK_ODR);
+    std::vector<uint8_t> astData;
+    instance->importManager.ExportAST(false, astData, *instance->GetSourcePackages()[0]);
+
+    // The instantiation for Int64 is loaded from the cjo of 'generics', the one for Bool is made by the importer.
+    instance = std::make_unique<TestCompilerInstance>(invocation, diag);
+    instance->importManager.SetPackageCjoCache("generics", astData);
+    instance->invocation.globalOptions.compilePackage = true;
+    instance->code = R"(
+        package user
+        import generics.*
+        public func useInt64(a: Int64): Int64 { id<Int64>(a) }
+        public func useBool(a: Bool): Bool { id<Bool>(a) }
+    )";
+    instance->Compile();
+    ASSERT_EQ(diag.GetErrorCount(), 0);
+    auto instantiated = idInstantiations(*instance->GetSourcePackages()[0]);
+    ASSERT_EQ(instantiated.size(), 1);
+    EXPECT_EQ(Ty::ToString(instantiated[0]->ty), "(Bool) -> Bool");
+    // The instantiation of an imported generic function is not shared again.
+    EXPECT_EQ(instantiated[0]->linkage, Linkage::INTERNAL);
+}
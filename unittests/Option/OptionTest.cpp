@@ -118,6 +118,34 @@ TEST_F(OptionTest, StackTraceFormatTest)
         EXPECT_FALSE(succ);
     }
 }
+
+TEST_F(OptionTest, EnumInlineLayoutTest)
+{
+    {
+        std::vector<std::string> argStrs = {"cjc"};
+        ArgList argList;
+        bool succ = optTbl->ParseArgs(argStrs, argList);
+        EXPECT_TRUE(succ);
+        succ = gblOpts->ParseFromArgs(argList);
+        EXPECT_FALSE(gblOpts->enableEnumInlineLayout);
+    }
+    {
+        std::vector<std::string> argStrs = {"cjc", "--fenum-inline-layout"};
+        ArgList argList;
+        bool succ = optTbl->ParseArgs(argStrs, argList);
+        EXPECT_TRUE(succ);
+        succ = gblOpts->ParseFromArgs(argList);
+        EXPECT_TRUE(gblOpts->enableEnumInlineLayout);
+    }
+    {
+        std::vector<std::string> argStrs = {"cjc", "--fenum-inline-layout", "--fno-enum-inline-layout"};
+        ArgList argList;
+        bool succ = optTbl->ParseArgs(argStrs, argList);
+        EXPECT_TRUE(succ);
+        succ = gblOpts->ParseFromArgs(argList);
+        EXPECT_FALSE(gblOpts->enableEnumInlineLayout);
+    }
+}
 #endif
 
 TEST_F(OptionTest, EmptyModuleNameTest)
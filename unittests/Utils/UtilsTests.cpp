@@ -16,6 +16,7 @@
 #include "cangjie/Utils/FloatFormat.h"
 #include "cangjie/Utils/ProfileRecorder.h"
 #include "cangjie/Utils/SipHash.h"
+#include "cangjie/Utils/TaskQueue.h"
 #include "cangjie/Utils/Utils.h"
 
 using namespace Cangjie;
@@ -830,3 +831,55 @@ TEST(UtilsTest, IsUnderFlowFloat)
     // This should not occur in actual calls.
     EXPECT_EQ(underUse("1.0"), false);
 }
+
+TEST(UtilsTest, TaskQueuePriority)
+{
+    // With one thread the tasks are executed by the waiting thread in order of priority.
+    TaskQueue taskQueue(1);
+    std::vector<int> order;
+    for (int i = 0; i < 5; ++i) {
+        taskQueue.AddTask<void>([&order, i]() { order.emplace_back(i); }, static_cast<uint64_t>(i));
+    }
+    taskQueue.RunAndWaitForAllTasksCompleted();
+    EXPECT_EQ(order, std::vector<int>({4, 3, 2, 1, 0}));
+}
+
+TEST(UtilsTest, TaskQueueNested)
+{
+    std::atomic<int> count{0};
+    TaskQueue outer(4);
+    std::vector<TaskResult<int>> results;
+    for (int i = 0; i < 16; ++i) {
+        results.emplace_back(outer.AddTask<int>([&count, i]() {
+            TaskQueue inner(4);
+            for (int j = 0; j < 50; ++j) {
+                inner.AddTask<void>([&count]() { ++count; });
+            }
+            inner.RunAndWaitForAllTasksCompleted();
+            return i;
+        }));
+    }
+    outer.RunAndWaitForAllTasksCompleted();
+    int sum = 0;
+    for (auto& res : results) {
+        sum += res.get();
+    }
+    EXPECT_EQ(sum, 120);
+    EXPECT_EQ(count.load(), 800);
+}
+
+TEST(UtilsTest, TaskQueueSpawnSubtasks)
+{
+    std::atomic<int> count{0};
+    TaskQueue taskQueue(3);
+    std::function<void(int)> spawn = [&taskQueue, &count, &spawn](int depth) {
+        ++count;
+        if (depth < 6) {
+            taskQueue.AddTask<void>([&spawn, depth]() { spawn(depth + 1); });
+            taskQueue.AddTask<void>([&spawn, depth]() { spawn(depth + 1); });
+        }
+    };
+    taskQueue.AddTask<void>([&spawn]() { spawn(0); });
+    taskQueue.RunAndWaitForAllTasksCompleted();
+    EXPECT_EQ(count.load(), 127);
+}